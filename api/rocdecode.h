@@ -1368,6 +1368,22 @@ typedef struct _RocdecAv1SliceParams {
     uint32_t reserved[4];
 } RocdecAv1SliceParams;
 
+/******************************************************************************************/
+//! \enum RocdecSliceBatchFlags
+//! \ingroup group_amd_rocdecode
+//! Flags of RocdecPicParams::slice_batch_flags for submitting the slices of a picture in
+//! several rocDecDecodeFrame calls. 0 submits the complete picture in one call. A first batch
+//! submitted while a picture is not ended fails: the incomplete picture is ended, leaving its
+//! surface partially decoded, and the next picture can be started.
+/******************************************************************************************/
+typedef enum {
+    ROCDEC_SLICE_BATCH = 0x01,       /**< The call carries a batch of slices of the picture: bitstream_data, bitstream_data_len,
+                                          num_slices and slice_params only describe this batch                               */
+    ROCDEC_SLICE_BATCH_FIRST = 0x02, /**< First batch of the picture: the picture is started with the picture parameters and
+                                          the IQ matrix of this call, which are ignored in the following batches             */
+    ROCDEC_SLICE_BATCH_LAST = 0x04,  /**< Last batch of the picture: the picture is ended and decoded                        */
+} RocdecSliceBatchFlags;
+
 /******************************************************************************************/
 //! \struct _RocdecPicParams
 //! \ingroup group_amd_rocdecode
@@ -1389,7 +1405,8 @@ typedef struct _RocdecPicParams {
 
     int ref_pic_flag;      /**< IN: This picture is a reference picture */
     int intra_pic_flag;    /**< IN: This picture is entirely intra coded */
-    uint32_t reserved[30]; /**< Reserved for future use */
+    uint32_t slice_batch_flags; /**< IN: RocdecSliceBatchFlags; 0 for a complete picture */
+    uint32_t reserved[29]; /**< Reserved for future use */
 
     // IN: Codec-specific data
     union {
@@ -1468,6 +1485,7 @@ extern rocDecStatus ROCDECAPI rocDecGetDecoderCaps(RocdecDecodeCaps *decode_caps
 //! \ingroup group_amd_rocdecode
 //! Decodes a single picture
 //! Submits the frame for HW decoding
+//! A picture can also be submitted in batches of slices with one call per batch (see RocdecSliceBatchFlags)
 /*****************************************************************************************************/
 extern rocDecStatus ROCDECAPI rocDecDecodeFrame(rocDecDecoderHandle decoder_handle, RocdecPicParams *pic_params);
 
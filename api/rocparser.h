@@ -136,7 +136,9 @@ typedef enum {
     ROCDEC_PKT_ENDOFSTREAM = 0x01,   /**< Set when this is the last packet for this stream                              */
     ROCDEC_PKT_TIMESTAMP = 0x02,     /**< Timestamp is valid                                                            */
     ROCDEC_PKT_DISCONTINUITY = 0x04, /**< Set when a discontinuity has to be signalled                                  */
-    ROCDEC_PKT_ENDOFPICTURE = 0x08,  /**< Set when the packet contains exactly one frame or one field                   */
+    ROCDEC_PKT_ENDOFPICTURE = 0x08,  /**< Set when the packet ends a frame or a field: the picture is submitted for decode
+                                            (also in byte stream mode, without waiting for the next access unit) and the ready
+                                            pictures are displayed without max_display_delay                              */
     ROCDEC_PKT_NOTIFY_EOS = 0x10,    /**< If this flag is set along with ROCDEC_PKT_ENDOFSTREAM, an additional (dummy)
                                             display callback will be invoked with null value of ROCDECPARSERDISPINFO which
                                             should be interpreted as end of the stream.                                   */
@@ -224,13 +226,17 @@ typedef struct _RocdecSeiMessageInfo {
  * \ while creating parser)
  * \ PFNVIDDECODECALLBACK   : 0: fail, >=1: succeeded
  * \ PFNVIDDISPLAYCALLBACK  : 0: fail, >=1: succeeded
- * \ PFNVIDOPPOINTCALLBACK  : <0: fail, >=0: succeeded (bit 0-9: OperatingPoint, bit 10-10: outputAllLayers, bit 11-30: reserved)
+ * \ PFNVIDOPPOINTCALLBACK  : < -1: fail, -1: succeeded with the default (OperatingPoint 0, outputAllLayers 0), >=0: succeeded (bit 0-9:
+ * \ OperatingPoint, bit 10-10: outputAllLayers, bit 11-30: reserved). Note that -1 is not a failure: a callback that has to stop parsing
+ * \ must return a value below -1.
+ * \ The OBUs of the layers that are not in the selected operating point are dropped by the parser. Unless outputAllLayers is set,
+ * \ only the frame of the highest spatial layer of a temporal unit is displayed.
  * \ PFNVIDSEIMSGCALLBACK   : 0: fail, >=1: succeeded
  */
 typedef int(ROCDECAPI *PFNVIDSEQUENCECALLBACK)(void *, RocdecVideoFormat *);
 typedef int(ROCDECAPI *PFNVIDDECODECALLBACK)(void *, RocdecPicParams *);
 typedef int(ROCDECAPI *PFNVIDDISPLAYCALLBACK)(void *, RocdecParserDispInfo *);
-// typedef int (ROCDECAPI *PFNVIDOPPOINTCALLBACK)(void *, RocdecOperatingPointInfo*);        // reserved for future (AV1 specific)
+typedef int(ROCDECAPI *PFNVIDOPPOINTCALLBACK)(void *, RocdecOperatingPointInfo *);
 typedef int(ROCDECAPI *PFNVIDSEIMSGCALLBACK)(void *, RocdecSeiMessageInfo *);
 
 /**
@@ -244,15 +250,25 @@ typedef struct _RocdecParserParams {
     uint32_t clock_rate;                          /**< IN: Timestamp units in Hz (0=default=10000000Hz)                        */
     uint32_t error_threshold;                     /**< IN: % Error threshold (0-100) for calling pfn_decode_picture (100=always IN: call pfn_decode_picture even if picture bitstream is fully corrupted) */
     uint32_t max_display_delay;                   /**< IN: Max display queue delay (improves pipelining of decode with display) 0 = no delay (recommended values: 2..4) */
-    uint32_t annex_b : 1;                         /**< IN: AV1 annexB stream                                                   */
-    uint32_t reserved : 31;                       /**< Reserved for future use - set to zero                                   */
+    uint32_t annex_b : 1;                         /**< IN: AV1 annexB stream: the packets are length delimited temporal units (Annex B), starting
+                                                           with temporal_unit_size; OBUs without obu_size are allowed                         */
+    uint32_t byte_stream : 1;                     /**< IN: Packets are arbitrary chunks of an Annex-B (AVC/HEVC), low overhead or annexB (AV1) byte stream;
+                                                           the parser finds the access unit boundaries and parses each access unit as soon as
+                                                           the next one starts (AV1 annexB: as soon as it is complete). The last access unit is
+                                                           parsed with ROCDEC_PKT_ENDOFSTREAM.                                                */
+    uint32_t slice_submission : 1;                /**< IN: AVC/HEVC: the slices of a picture are passed to pfn_decode_picture in batches as they
+                                                           are parsed (see RocdecSliceBatchFlags). With byte_stream, the slices are parsed as soon
+                                                           as they are received instead of when the access unit is complete.                 */
+    uint32_t reserved : 29;                       /**< Reserved for future use - set to zero                                   */
     uint32_t reserved_1[4];                       /**< IN: Reserved for future use - set to 0                                  */
     void *user_data;                              /**< IN: User data for callbacks                                             */
     PFNVIDSEQUENCECALLBACK pfn_sequence_callback; /**< IN: Called before decoding frames and/or whenever there is a fmt change */
     PFNVIDDECODECALLBACK pfn_decode_picture;      /**< IN: Called when a picture is ready to be decoded (decode order)         */
     PFNVIDDISPLAYCALLBACK pfn_display_picture;    /**< IN: Called whenever a picture is ready to be displayed (display order)  */
     PFNVIDSEIMSGCALLBACK pfn_get_sei_msg;         /**< IN: Called when all SEI messages are parsed for particular frame        */
-    void *reserved_2[5];                          /**< Reserved for future use - set to NULL                                   */
+    PFNVIDOPPOINTCALLBACK pfn_get_operating_point; /**< IN: [Optional] AV1: called when a sequence header is parsed to select the operating point;
+                                                            -1 selects the default operating point 0, values below -1 fail    */
+    void *reserved_2[4];                          /**< Reserved for future use - set to NULL                                   */
     RocdecVideoFormatEx *ext_video_info;          /**< IN: [Optional] sequence header data from system layer                   */
 } RocdecParserParams;
 
@@ -51,19 +51,22 @@ void ShowHelpAndExit(const char *option = NULL) {
     << "-sei extract SEI messages; optional;" << std::endl
     << "-md5 generate MD5 message digest on the decoded YUV image sequence; optional;" << std::endl
     << "-md5_check MD5 File Path - generate MD5 message digest on the decoded YUV image sequence and compare to the reference MD5 string in a file; optional;" << std::endl
+    << "-md5_out MD5 File Path - generate MD5 message digest on the decoded YUV image sequence and write the MD5 string to a file"
+    << " (the reference of -md5_check); optional;" << std::endl
     << "-crop crop rectangle for output (not used when using interopped decoded frame); optional; default: 0" << std::endl
     << "-m output_surface_memory_type - decoded surface memory; optional; default - 0"
     << " [0 : OUT_SURFACE_MEM_DEV_INTERNAL/ 1 : OUT_SURFACE_MEM_DEV_COPIED/ 2 : OUT_SURFACE_MEM_HOST_COPIED/ 3 : OUT_SURFACE_MEM_NOT_MAPPED]" << std::endl
     << "-seek_criteria - Demux seek criteria & value - optional; default - 0,0; "
     << "[0: no seek; 1: SEEK_CRITERIA_FRAME_NUM, frame number; 2: SEEK_CRITERIA_TIME_STAMP, frame number (time calculated internally)]" << std::endl
     << "-seek_mode - Seek to previous key frame or exact - optional; default - 0"
-    << "[0: SEEK_MODE_PREV_KEY_FRAME; 1: SEEK_MODE_EXACT_FRAME]" << std::endl;
+    << "[0: SEEK_MODE_PREV_KEY_FRAME; 1: SEEK_MODE_EXACT_FRAME]" << std::endl
+    << "-read_ahead - number of packets demuxed ahead in a background thread (e.g. 32 for network file systems); optional; default - 0 (demux on the decode thread)" << std::endl;
     exit(0);
 }
 
 int main(int argc, char **argv) {
 
-    std::string input_file_path, output_file_path, md5_file_path;
+    std::string input_file_path, output_file_path, md5_file_path, md5_out_file_path;
     std::fstream ref_md5_file;
     int dump_output_frames = 0;
     int device_id = 0;
@@ -82,6 +85,7 @@ int main(int argc, char **argv) {
     // seek options
     uint64_t seek_to_frame = 0;
     int seek_criteria = 0, seek_mode = 0;
+    int read_ahead_depth = 0;
 
     // Parse command-line arguments
     if(argc <= 1) {
@@ -157,6 +161,14 @@ int main(int argc, char **argv) {
             md5_file_path = argv[i];
             continue;
         }
+        if (!strcmp(argv[i], "-md5_out")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-md5_out");
+            }
+            b_generate_md5 = true;
+            md5_out_file_path = argv[i];
+            continue;
+        }
         if (!strcmp(argv[i], "-crop")) {
             if (++i == argc || 4 != sscanf(argv[i], "%d,%d,%d,%d", &crop_rect.left, &crop_rect.top, &crop_rect.right, &crop_rect.bottom)) {
                 ShowHelpAndExit("-crop");
@@ -196,6 +208,13 @@ int main(int argc, char **argv) {
                 ShowHelpAndExit("-seek_mode");
             continue;
         }
+        if (!strcmp(argv[i], "-read_ahead")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-read_ahead");
+            }
+            read_ahead_depth = atoi(argv[i]);
+            continue;
+        }
 
         ShowHelpAndExit(argv[i]);
     }
@@ -204,6 +223,7 @@ int main(int argc, char **argv) {
         std::size_t found_file = input_file_path.find_last_of('/');
         std::cout << "info: Input file: " << input_file_path.substr(found_file + 1) << std::endl;
         VideoDemuxer demuxer(input_file_path.c_str());
+        demuxer.SetReadAheadDepth(read_ahead_depth);
         VideoSeekContext video_seek_ctx;
         rocDecVideoCodec rocdec_codec_id = AVCodec2RocDecVideoCodec(demuxer.GetCodecID());
         RocVideoDecoder viddec(device_id, mem_type, rocdec_codec_id, b_force_zero_latency, p_crop_rect, b_extract_sei_messages, disp_delay);
@@ -326,6 +346,17 @@ int main(int argc, char **argv) {
                 std::cout << std::setfill('0') << std::setw(2) << std::hex << static_cast<int>(digest[i]);
             }
             std::cout << std::endl;
+            if (!md5_out_file_path.empty()) {
+                std::ofstream md5_out_file(md5_out_file_path.c_str(), std::ios::out);
+                for (int i = 0; i < 16; i++) {
+                    md5_out_file << std::setfill('0') << std::setw(2) << std::hex << static_cast<int>(digest[i]);
+                }
+                md5_out_file << std::endl;
+                if (!md5_out_file) {
+                    std::cerr << "Failed to write MD5 file." << std::endl;
+                    return 1;
+                }
+            }
             if (b_md5_check) {
                 std::string ref_md5_string(33, 0);
                 uint8_t ref_md5[16];
@@ -28,6 +28,8 @@ THE SOFTWARE.
 #include <string>
 #include <fstream>
 #include <chrono>
+#include <memory>
+#include <iterator>
 #include <sys/stat.h>
 #include <libgen.h>
 #if __cplusplus >= 201703L && __has_include(<filesystem>)
@@ -76,6 +78,8 @@ void ShowHelpAndExit(const char *option = NULL) {
     << "-md5 generate MD5 message digest on the decoded YUV image sequence; optional;" << std::endl
     << "-md5_check MD5 File Path - generate MD5 message digest on the decoded YUV image sequence and compare to the reference MD5 string in a file; optional;" << std::endl
     << "-crop crop rectangle for output (not used when using interopped decoded frame); optional; default: 0" << std::endl
+    << "-buf read the whole input into a memory buffer and demux directly from it instead of using the stream provider; optional;" << std::endl
+    << "-mmap demux directly from the memory mapped input file instead of using the stream provider; optional;" << std::endl
     << "-m output_surface_memory_type - decoded surface memory; optional; default - 0"
     << " [0 : OUT_SURFACE_MEM_DEV_INTERNAL/ 1 : OUT_SURFACE_MEM_DEV_COPIED/ 2 : OUT_SURFACE_MEM_HOST_COPIED/ 3 : OUT_SURFACE_MEM_NOT_MAPPED]" << std::endl;
     exit(0);
@@ -94,6 +98,8 @@ int main(int argc, char **argv) {
     Rect crop_rect = {};
     Rect *p_crop_rect = nullptr;
     OutputSurfaceMemoryType mem_type = OUT_SURFACE_MEM_DEV_INTERNAL;        // set to internal
+    bool b_use_mem_buffer = false;
+    bool b_use_mmap = false;
     // Parse command-line arguments
     if(argc <= 1) {
         ShowHelpAndExit();
@@ -172,11 +178,37 @@ int main(int argc, char **argv) {
             mem_type = static_cast<OutputSurfaceMemoryType>(atoi(argv[i]));
             continue;
         }
+        if (!strcmp(argv[i], "-buf")) {
+            b_use_mem_buffer = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-mmap")) {
+            b_use_mmap = true;
+            continue;
+        }
         ShowHelpAndExit(argv[i]);
     }
     try {
-        FileStreamProvider stream_provider(input_file_path.c_str());
-        VideoDemuxer demuxer(&stream_provider);
+        // the stream provider and the input buffer are declared first so they outlive the demuxer reading from them
+        std::unique_ptr<FileStreamProvider> stream_provider;
+        std::vector<uint8_t> input_buffer;
+        std::unique_ptr<VideoDemuxer> p_demuxer;
+        if (b_use_mmap) {
+            p_demuxer.reset(new VideoDemuxer(input_file_path.c_str(), true));
+        } else if (b_use_mem_buffer) {
+            // the whole input is already in memory (e.g. received from network): the demuxer reads from it directly
+            std::ifstream fp_in(input_file_path.c_str(), std::ifstream::in | std::ifstream::binary);
+            if (!fp_in) {
+                std::cerr << "Unable to open input file: " << input_file_path << std::endl;
+                return -1;
+            }
+            input_buffer.assign(std::istreambuf_iterator<char>(fp_in), std::istreambuf_iterator<char>());
+            p_demuxer.reset(new VideoDemuxer(input_buffer.data(), input_buffer.size()));
+        } else {
+            stream_provider.reset(new FileStreamProvider(input_file_path.c_str()));
+            p_demuxer.reset(new VideoDemuxer(stream_provider.get()));
+        }
+        VideoDemuxer &demuxer = *p_demuxer;
         rocDecVideoCodec rocdec_codec_id = AVCodec2RocDecVideoCodec(demuxer.GetCodecID());
         RocVideoDecoder viddec(device_id, mem_type, rocdec_codec_id, b_force_zero_latency, p_crop_rect, b_extract_sei_messages);
         if(!viddec.CodecSupported(device_id, rocdec_codec_id, demuxer.GetBitDepth())) {
@@ -39,20 +39,43 @@ THE SOFTWARE.
 #include <condition_variable>
 #include <queue>
 #include <atomic>
+#include <memory>
+#include <sstream>
+#include <cmath>
+#include <algorithm>
+#include <hip/hip_fp16.h>
 #include "video_demuxer.h"
 #include "roc_video_dec.h"
 #include "video_post_process.h"
+#include "resample_kernels.h"
 
-std::vector<std::string> st_output_format_name = {"native", "bgr", "bgr48", "rgb", "rgb48", "bgra", "bgra64", "rgba", "rgba64"};
+std::vector<std::string> st_output_format_name = {"native", "bgr", "bgr48", "rgb", "rgb48", "bgra", "bgra64", "rgba", "rgba64", "bgr_planar", "rgb_planar",
+                                                  "bgr_planar_fp32", "rgb_planar_fp32", "bgr_planar_fp16", "rgb_planar_fp16", "bgr_planar_bf16", "rgb_planar_bf16"};
+std::vector<std::string> st_resize_filter_name = {"area", "bilinear", "bicubic", "lanczos3"};
 
 void ShowHelpAndExit(const char *option = NULL) {
     std::cout << "Options:" << std::endl
     << "-i Input File Path - required" << std::endl
     << "-o Output File Path - dumps output if requested; optional" << std::endl
     << "-d GPU device ID (0 for the first device, 1 for the second, etc.); optional; default: 0" << std::endl
-    << "-of Output Format name - (native, bgr, bgr48, rgb, rgb48, bgra, bgra64, rgba, rgba64; converts native YUV frame to RGB image format; optional; default: 0" << std::endl
+    << "-of Output Format name - (native, bgr, bgr48, rgb, rgb48, bgra, bgra64, rgba, rgba64, bgr_planar, rgb_planar, bgr_planar_fp32, rgb_planar_fp32,"
+    << " bgr_planar_fp16, rgb_planar_fp16, bgr_planar_bf16, rgb_planar_bf16; converts native YUV frame to RGB image format; optional; default: 0" << std::endl
+    << "-scale_bias s0,s1,s2,b0,b1,b2 - per channel scale and bias of the floating point planar outputs applied on the [0, 1] color values"
+    << " (out = value * s + b); optional; default: 1,1,1,0,0,0" << std::endl
     << "-resize WxH - (where W is resize width and H is resize height) optional; default: no resize " << std::endl
-    << "-crop crop rectangle for output (not used when using interopped decoded frame); optional; default: 0" << std::endl;
+    << "-resize_filter resampling filter of -resize and -ladder - (area, bilinear, bicubic, lanczos3); optional; default: texture bilinear for -resize, area for -ladder" << std::endl
+    << "-ladder W1xH1,W2xH2,... - produces a thumbnail ladder of NV12/P016 renditions of every frame with one resampler launch per pass;"
+    << " dumps them to <output>_WxH.yuv with -o; optional; default: no ladder" << std::endl
+    << "-verify compares the resampler outputs of -resize_filter and -ladder with the CPU reference (resample_filter.h) on every frame; fails on a"
+    << " difference above 1; with a floating point planar output format also compares the planes with the CPU reference (tensor_convert.h); fails on a"
+    << " relative difference above 1e-3 (FP32), 5e-3 (FP16) or 1.6e-2 (BF16); not with -direct or -host; optional" << std::endl
+    << "-crop crop rectangle for output (not used when using interopped decoded frame); optional; default: 0" << std::endl
+    << "-direct color convert the mapped decoded surface in the decoder display callback (OUT_SURFACE_MEM_DEV_POST_PROCESSED) instead of copying it first;"
+    << " requires an RGB output format and no -resize or -ladder; with -md5 the output is compared with a second decode that copies the decoded"
+    << " surfaces (OUT_SURFACE_MEM_DEV_COPIED) before converting them; optional" << std::endl
+    << "-host num_threads - copies the decoded frames to host memory (OUT_SURFACE_MEM_HOST_COPIED) and resizes (bilinear) and color converts them on"
+    << " the CPU with num_threads threads (0: all hardware threads); requires a packed RGB output format and no -resize_filter, -ladder or -direct; optional" << std::endl
+    << "-sdr tone map HDR (PQ/HLG) streams to SDR BT.709 RGB; optional; default: keep the HDR encoded values" << std::endl;
 
     exit(0);
 }
@@ -62,9 +85,171 @@ std::queue<uint8_t*> frame_queue[frame_buffers_size];
 std::mutex mutex[frame_buffers_size];
 std::condition_variable cv[frame_buffers_size];
 
+/**
+ * @brief -verify: compares the outputs of the separable resampler with the CPU reference computed from the same decoded frame
+ */
+struct ResampleVerifier {
+    static constexpr int tolerance = 1;     // the kernels and the reference only differ by the floating point contraction of the device compiler
+    std::vector<uint8_t> frame_host, out_host, ref_host;
+    int max_diff = 0;
+    uint64_t num_outputs = 0, num_mismatched_outputs = 0;
+
+    /**
+     * @brief Copies the decoded frame that the next Verify calls compare with; the stream of the resampler must be synchronized
+     */
+    void SetFrame(const uint8_t *p_frame, OutputSurfaceInfo *surf_info) {
+        frame_host.resize(surf_info->output_surface_size_in_bytes);
+        HIP_API_CALL(hipMemcpyDtoH(frame_host.data(), const_cast<uint8_t *>(p_frame), frame_host.size()));
+    }
+
+    void Verify(OutputSurfaceInfo *surf_info, ResampleFilter filter, const ResampleOutput &output) {
+        size_t size = static_cast<size_t>(output.dst_pitch) * (output.dst_height + (output.dst_height >> 1));
+        out_host.resize(size);
+        ref_host.resize(size);
+        HIP_API_CALL(hipMemcpyDtoH(out_host.data(), output.dp_dst, size));
+        bool is_16bit = surf_info->bytes_per_pixel == 2;
+        ResampleYuv420Ref(filter, frame_host.data(), surf_info->output_pitch, surf_info->output_width, surf_info->output_height, surf_info->output_vstride,
+                          is_16bit, ref_host.data(), output.dst_pitch, output.dst_width, output.dst_height);
+        int diff = 0;
+        for (int y = 0; y < output.dst_height + (output.dst_height >> 1); y++) {
+            const uint8_t *p_out = out_host.data() + static_cast<size_t>(y) * output.dst_pitch, *p_ref = ref_host.data() + static_cast<size_t>(y) * output.dst_pitch;
+            for (int x = 0; x < output.dst_width; x++) {
+                diff = std::max(diff, is_16bit ? std::abs(reinterpret_cast<const uint16_t *>(p_out)[x] - reinterpret_cast<const uint16_t *>(p_ref)[x])
+                                               : std::abs(p_out[x] - p_ref[x]));
+            }
+        }
+        max_diff = std::max(max_diff, diff);
+        num_outputs++;
+        num_mismatched_outputs += diff > tolerance ? 1 : 0;
+    }
+};
+
+/**
+ * @brief -verify: compares the floating point planar outputs with the CPU reference (YuvToPlanarTensorRef) computed from the converted frame
+ */
+struct PlanarVerifier {
+    TensorScaleBias scale_bias;
+    std::vector<uint8_t> frame_host;
+    std::vector<float> out_host, ref_host;
+    float max_diff = 0;
+    uint64_t num_outputs = 0, num_mismatched_outputs = 0;
+
+    /**
+     * @brief Tolerance relative to max(1, |reference|): the FP16 and BF16 outputs are rounded once, the reference is only off by the contraction
+     */
+    static float Tolerance(OutputFormatEnum e_output_format) {
+        return (e_output_format == bgr_planar_fp16 || e_output_format == rgb_planar_fp16) ? 5e-3f :
+               (e_output_format == bgr_planar_bf16 || e_output_format == rgb_planar_bf16) ? 1.6e-2f : 1e-3f;
+    }
+
+    /**
+     * @brief Compares the output of ColorConvertYUV2RGB for p_frame; the stream of the conversion must be synchronized
+     */
+    void Verify(const uint8_t *p_frame, OutputSurfaceInfo *surf_info, const uint8_t *p_planar, OutputFormatEnum e_output_format,
+                const ColorSpaceInfo &color_info) {
+        size_t num_elements = 3 * static_cast<size_t>(surf_info->output_width) * surf_info->output_height;
+        frame_host.resize(surf_info->output_surface_size_in_bytes);
+        out_host.resize(num_elements);
+        ref_host.resize(num_elements);
+        HIP_API_CALL(hipMemcpyDtoH(frame_host.data(), const_cast<uint8_t *>(p_frame), frame_host.size()));
+        if (e_output_format == bgr_planar_fp16 || e_output_format == rgb_planar_fp16) {
+            std::vector<__half> out_half(num_elements);
+            HIP_API_CALL(hipMemcpyDtoH(out_half.data(), const_cast<uint8_t *>(p_planar), num_elements * sizeof(__half)));
+            std::transform(out_half.begin(), out_half.end(), out_host.begin(), [](const __half &h) { return __half2float(h); });
+        } else if (e_output_format == bgr_planar_bf16 || e_output_format == rgb_planar_bf16) {
+            std::vector<uint16_t> out_bf16(num_elements);
+            HIP_API_CALL(hipMemcpyDtoH(out_bf16.data(), const_cast<uint8_t *>(p_planar), num_elements * sizeof(uint16_t)));
+            std::transform(out_bf16.begin(), out_bf16.end(), out_host.begin(), [](uint16_t b) {
+                uint32_t bits = static_cast<uint32_t>(b) << 16;
+                float value;
+                memcpy(&value, &bits, sizeof(value));
+                return value;
+            });
+        } else {
+            HIP_API_CALL(hipMemcpyDtoH(out_host.data(), const_cast<uint8_t *>(p_planar), num_elements * sizeof(float)));
+        }
+        bool is_16bit = surf_info->surface_format == rocDecVideoSurfaceFormat_P016 || surf_info->surface_format == rocDecVideoSurfaceFormat_YUV444_16Bit;
+        bool is_444 = surf_info->surface_format == rocDecVideoSurfaceFormat_YUV444 || surf_info->surface_format == rocDecVideoSurfaceFormat_YUV444_16Bit;
+        bool bgr = e_output_format == bgr_planar_fp32 || e_output_format == bgr_planar_fp16 || e_output_format == bgr_planar_bf16;
+        YuvToPlanarTensorRef(frame_host.data(), surf_info->output_pitch, surf_info->output_width, surf_info->output_height, surf_info->output_vstride,
+                             is_16bit, is_444, ref_host.data(), bgr, scale_bias, color_info);
+        float diff = 0;
+        bool mismatched = false;
+        for (size_t i = 0; i < num_elements; i++) {
+            float element_diff = std::fabs(out_host[i] - ref_host[i]);
+            diff = std::max(diff, element_diff);
+            mismatched |= !(element_diff <= Tolerance(e_output_format) * std::max(1.0f, std::fabs(ref_host[i])));
+        }
+        max_diff = std::max(max_diff, diff);
+        num_outputs++;
+        num_mismatched_outputs += mismatched ? 1 : 0;
+    }
+};
+
+/**
+ * @brief Renditions of every decoded frame produced by the separable resampler
+ */
+struct ThumbnailLadder {
+    YuvResampler resampler;
+    std::vector<Dim> dims;
+    std::vector<uint8_t *> dev_mem;
+    std::vector<std::ofstream> files;
+
+    ~ThumbnailLadder() {
+        for (auto p_dev_mem : dev_mem) {
+            hipFree(p_dev_mem);
+        }
+    }
+
+    bool Process(uint8_t *frame, OutputSurfaceInfo *surf_info, bool dump_output_frames, std::string &output_file_path, hipStream_t hip_stream,
+                 ResampleVerifier *p_verifier) {
+        std::vector<ResampleOutput> outputs(dims.size());
+        for (size_t i = 0; i < dims.size(); i++) {
+            size_t pitch = dims[i].w * surf_info->bytes_per_pixel, size = pitch * (dims[i].h + (dims[i].h >> 1));
+            if (dev_mem.size() <= i) {
+                uint8_t *p_dev_mem = nullptr;
+                if (hipMalloc(&p_dev_mem, size) != hipSuccess) {
+                    std::cerr << "ERROR: hipMalloc failed to allocate the device memory for the ladder!" << std::endl;
+                    return false;
+                }
+                dev_mem.push_back(p_dev_mem);
+            }
+            outputs[i] = {dev_mem[i], static_cast<int>(pitch), dims[i].w, dims[i].h};
+        }
+        if (!resampler.ResizeLadder(frame, surf_info->output_pitch, surf_info->output_width, surf_info->output_height, surf_info->output_vstride,
+                                    surf_info->bytes_per_pixel == 2, outputs.data(), static_cast<int>(outputs.size()), hip_stream)) {
+            return false;
+        }
+        if (p_verifier) {
+            HIP_API_CALL(hipStreamSynchronize(hip_stream));
+            p_verifier->SetFrame(frame, surf_info);
+            for (auto &output : outputs) {
+                p_verifier->Verify(surf_info, resampler.GetFilter(), output);
+            }
+        }
+        if (dump_output_frames) {
+            HIP_API_CALL(hipStreamSynchronize(hip_stream));
+            for (size_t i = 0; i < dims.size(); i++) {
+                if (files.size() <= i) {
+                    std::string file_name = output_file_path;
+                    std::string::size_type const pos(file_name.find_last_of('.'));
+                    std::string to_append = "_" + std::to_string(dims[i].w) + "x" + std::to_string(dims[i].h);
+                    file_name.insert(pos != std::string::npos ? pos : file_name.size(), to_append);
+                    files.emplace_back(file_name, std::ios::binary);
+                }
+                std::vector<char> host_mem(static_cast<size_t>(outputs[i].dst_pitch) * (dims[i].h + (dims[i].h >> 1)));
+                HIP_API_CALL(hipMemcpyDtoH(host_mem.data(), dev_mem[i], host_mem.size()));
+                files[i].write(host_mem.data(), host_mem.size());
+            }
+        }
+        return true;
+    }
+};
+
 void ColorSpaceConversionThread(std::atomic<bool>& continue_processing, bool convert_to_rgb, Dim *p_resize_dim, OutputSurfaceInfo **surf_info, OutputSurfaceInfo **res_surf_info,
         OutputFormatEnum e_output_format, uint8_t *p_rgb_dev_mem, uint8_t *p_resize_dev_mem, bool dump_output_frames,
-        std::string &output_file_path, RocVideoDecoder &viddec, VideoPostProcess &post_proc, bool b_generate_md5) {
+        std::string &output_file_path, RocVideoDecoder &viddec, VideoPostProcess &post_proc, bool b_generate_md5, YuvResampler *p_resampler,
+        ThumbnailLadder &ladder, ResampleVerifier *p_verifier, PlanarVerifier *p_planar_verifier) {
 
     size_t rgb_image_size, resize_image_size;
     hipError_t hip_status = hipSuccess;
@@ -100,7 +285,16 @@ void ColorSpaceConversionThread(std::atomic<bool>& continue_processing, bool con
                     }
                  }
                  // call resize kernel
-                 if ((*surf_info)->bytes_per_pixel == 2) {
+                 if (p_resampler) {
+                    ResampleOutput output = {p_resize_dev_mem, p_resize_dim->w * static_cast<int>((*surf_info)->bytes_per_pixel), p_resize_dim->w, p_resize_dim->h};
+                    p_resampler->Resize(frame, (*surf_info)->output_pitch, (*surf_info)->output_width, (*surf_info)->output_height,
+                                        (*surf_info)->output_vstride, (*surf_info)->bytes_per_pixel == 2, output, viddec.GetStream());
+                    if (p_verifier) {
+                        HIP_API_CALL(hipStreamSynchronize(viddec.GetStream()));
+                        p_verifier->SetFrame(frame, *surf_info);
+                        p_verifier->Verify(*surf_info, p_resampler->GetFilter(), output);
+                    }
+                 } else if ((*surf_info)->bytes_per_pixel == 2) {
                     ResizeP016(p_resize_dev_mem, p_resize_dim->w * 2, p_resize_dim->w, p_resize_dim->h, frame, (*surf_info)->output_pitch, (*surf_info)->output_width,
                         (*surf_info)->output_height, (frame + (*surf_info)->output_vstride * (*surf_info)->output_pitch), nullptr, viddec.GetStream());
                  } else {                        
@@ -118,6 +312,11 @@ void ColorSpaceConversionThread(std::atomic<bool>& continue_processing, bool con
             }
         }
 
+        if (!ladder.dims.empty()) {
+            // the ladder is built from the decoded frame, not from the -resize output
+            ladder.Process(frame, *surf_info, dump_output_frames, output_file_path, viddec.GetStream(), p_verifier);
+        }
+
         if (convert_to_rgb) {
             uint32_t rgb_stride = post_proc.GetRgbStride(e_output_format, p_surf_info);
             rgb_image_size = p_surf_info->output_height * rgb_stride;
@@ -129,6 +328,10 @@ void ColorSpaceConversionThread(std::atomic<bool>& continue_processing, bool con
                 }
             }
             post_proc.ColorConvertYUV2RGB(out_frame, p_surf_info, p_rgb_dev_mem, e_output_format, viddec.GetStream());
+            if (p_planar_verifier) {
+                HIP_API_CALL(hipStreamSynchronize(viddec.GetStream()));
+                p_planar_verifier->Verify(out_frame, p_surf_info, p_rgb_dev_mem, e_output_format, post_proc.GetColorSpaceInfo(p_surf_info));
+            }
         }
         if (dump_output_frames) {
             if (convert_to_rgb)
@@ -146,6 +349,51 @@ void ColorSpaceConversionThread(std::atomic<bool>& continue_processing, bool con
     }
 }
 
+/**
+ * @brief Reference of -direct: decodes the stream again with the decoded surfaces copied to device memory (OUT_SURFACE_MEM_DEV_COPIED), converts
+ *        the copies with the same post-processing and returns the MD5 digest of the outputs in digest; returns the number of frames or -1
+ */
+int CopiedReferenceProc(const std::string &input_file_path, int device_id, Rect *p_crop_rect, OutputFormatEnum e_output_format, VideoPostProcess &post_process,
+                        uint8_t *digest) {
+    VideoDemuxer demuxer(input_file_path.c_str());
+    rocDecVideoCodec rocdec_codec_id = AVCodec2RocDecVideoCodec(demuxer.GetCodecID());
+    RocVideoDecoder viddec(device_id, OUT_SURFACE_MEM_DEV_COPIED, rocdec_codec_id, false, p_crop_rect);
+    viddec.InitMd5();
+    int n_video_bytes = 0, n_frames_returned = 0, n_frame = 0;
+    uint8_t *p_video = nullptr, *p_frame = nullptr, *p_rgb_dev_mem = nullptr;
+    size_t rgb_image_size = 0;
+    int64_t pts = 0;
+    OutputSurfaceInfo *surf_info = nullptr;
+    do {
+        demuxer.Demux(&p_video, &n_video_bytes, &pts);
+        n_frames_returned = viddec.DecodeFrame(p_video, n_video_bytes, 0, pts);
+        if (!n_frame && !viddec.GetOutputSurfaceInfo(&surf_info)) {
+            std::cerr << "Error: Failed to get Output Image Info!" << std::endl;
+            n_frame = -1;
+            break;
+        }
+        for (int i = 0; i < n_frames_returned; i++) {
+            p_frame = viddec.GetFrame(&pts);
+            if (p_rgb_dev_mem == nullptr) {
+                rgb_image_size = surf_info->output_height * post_process.GetRgbStride(e_output_format, surf_info);
+                HIP_API_CALL(hipMalloc(&p_rgb_dev_mem, rgb_image_size));
+            }
+            post_process.ColorConvertYUV2RGB(p_frame, surf_info, p_rgb_dev_mem, e_output_format, viddec.GetStream());
+            HIP_API_CALL(hipStreamSynchronize(viddec.GetStream()));
+            viddec.UpdateMd5ForDataBuffer(p_rgb_dev_mem, rgb_image_size);
+            viddec.ReleaseFrame(pts);
+        }
+        n_frame += n_frames_returned;
+    } while (n_video_bytes && n_frame >= 0);
+    if (p_rgb_dev_mem != nullptr) {
+        HIP_API_CALL(hipFree(p_rgb_dev_mem));
+    }
+    uint8_t *p_digest;
+    viddec.FinalizeMd5(&p_digest);
+    memcpy(digest, p_digest, 16);
+    return n_frame;
+}
+
 int main(int argc, char **argv) {
 
     std::string input_file_path, output_file_path, md5_file_path;
@@ -154,6 +402,16 @@ int main(int argc, char **argv) {
     bool b_md5_check = false;
     bool dump_output_frames = false;
     bool convert_to_rgb = false;
+    bool hdr_to_sdr = false;
+    TensorScaleBias scale_bias;
+    bool b_direct = false;
+    bool b_host = false;
+    int num_host_threads = 0;
+    int resize_filter = -1;
+    ThumbnailLadder ladder;
+    bool b_verify = false;
+    ResampleVerifier resample_verifier;
+    PlanarVerifier planar_verifier;
     int device_id = 0;
     Rect crop_rect = {};
     Dim resize_dim = {};
@@ -221,6 +479,36 @@ int main(int argc, char **argv) {
             }
             continue;
         }
+        if (!strcmp(argv[i], "-resize_filter")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-resize_filter");
+            }
+            auto it = std::find(st_resize_filter_name.begin(), st_resize_filter_name.end(), argv[i]);
+            if (it == st_resize_filter_name.end()) {
+                ShowHelpAndExit("-resize_filter");
+            }
+            resize_filter = static_cast<int>(it - st_resize_filter_name.begin());
+            continue;
+        }
+        if (!strcmp(argv[i], "-ladder")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-ladder");
+            }
+            std::stringstream ladder_list(argv[i]);
+            std::string rendition;
+            while (std::getline(ladder_list, rendition, ',')) {
+                Dim dim = {};
+                if (2 != sscanf(rendition.c_str(), "%dx%d", &dim.w, &dim.h) || dim.w <= 0 || dim.h <= 0) {
+                    ShowHelpAndExit("-ladder");
+                }
+                if (dim.w % 2 == 1 || dim.h % 2 == 1) {
+                    std::cout << "Ladder dimensions must have width and height of even numbers" << std::endl;
+                    exit(1);
+                }
+                ladder.dims.push_back(dim);
+            }
+            continue;
+        }
         if (!strcmp(argv[i], "-of")) {
             if (++i == argc) {
                 ShowHelpAndExit("-of");
@@ -232,6 +520,33 @@ int main(int argc, char **argv) {
             e_output_format = (OutputFormatEnum)(it - st_output_format_name.begin());
             continue;
         }
+        if (!strcmp(argv[i], "-verify")) {
+            b_verify = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-direct")) {
+            b_direct = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-host")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-host");
+            }
+            b_host = true;
+            num_host_threads = atoi(argv[i]);
+            continue;
+        }
+        if (!strcmp(argv[i], "-sdr")) {
+            hdr_to_sdr = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-scale_bias")) {
+            if (++i == argc || sscanf(argv[i], "%f,%f,%f,%f,%f,%f", &scale_bias.scale[0], &scale_bias.scale[1], &scale_bias.scale[2],
+                                      &scale_bias.bias[0], &scale_bias.bias[1], &scale_bias.bias[2]) != 6) {
+                ShowHelpAndExit("-scale_bias");
+            }
+            continue;
+        }
         if (!strcmp(argv[i], "-md5")) {
             if (i == argc) {
                 ShowHelpAndExit("-md5");
@@ -251,6 +566,25 @@ int main(int argc, char **argv) {
         ShowHelpAndExit(argv[i]);
     }
 
+    // the floating point planar outputs are verified after the resize, the 8-bit outputs only through the resampler
+    bool verify_planar = b_verify && e_output_format >= bgr_planar_fp32;
+    if (b_verify && ((resize_filter < 0 && ladder.dims.empty() && !verify_planar) || b_direct || b_host)) {
+        ShowHelpAndExit("-verify");
+    }
+    planar_verifier.scale_bias = scale_bias;
+    if (b_direct) {
+        if (e_output_format == native || (resize_dim.w && resize_dim.h) || !ladder.dims.empty()) {
+            ShowHelpAndExit("-direct");
+        }
+        mem_type = OUT_SURFACE_MEM_DEV_POST_PROCESSED;
+    }
+    if (b_host) {
+        if (e_output_format == native || e_output_format >= bgr_planar || resize_filter >= 0 || !ladder.dims.empty() || b_direct) {
+            ShowHelpAndExit("-host");
+        }
+        mem_type = OUT_SURFACE_MEM_HOST_COPIED;
+    }
+
     try {
         VideoDemuxer demuxer(input_file_path.c_str());
         rocDecVideoCodec rocdec_codec_id = AVCodec2RocDecVideoCodec(demuxer.GetCodecID());
@@ -260,6 +594,14 @@ int main(int argc, char **argv) {
             return 0;
         }  
         VideoPostProcess post_process;
+        post_process.SetHdrToSdr(hdr_to_sdr);
+        post_process.SetPlanarScaleBias(scale_bias);
+        // -resize keeps the texture path unless a filter is requested
+        std::unique_ptr<YuvResampler> resampler;
+        if (resize_filter >= 0) {
+            resampler.reset(new YuvResampler(static_cast<ResampleFilter>(resize_filter)));
+            ladder.resampler.SetFilter(static_cast<ResampleFilter>(resize_filter));
+        }
 
         std::string device_name, gcn_arch_name;
         int pci_bus_id, pci_domain_id, pci_device_id;
@@ -285,8 +627,29 @@ int main(int argc, char **argv) {
         double total_dec_time = 0;
         convert_to_rgb = e_output_format != native;
         std::atomic<bool> continue_processing(true);
-        std::thread color_space_conversion_thread(ColorSpaceConversionThread, std::ref(continue_processing), std::ref(convert_to_rgb), &resize_dim, &surf_info, &resize_surf_info, std::ref(e_output_format),
-                                    std::ref(p_rgb_dev_mem), std::ref(p_resize_dev_mem), std::ref(dump_output_frames), std::ref(output_file_path), std::ref(viddec), std::ref(post_process), b_generate_md5);
+        // -direct: the frames are converted in the display callback of the decoder, one output buffer per frame returned by a DecodeFrame call
+        std::vector<uint8_t *> direct_rgb_buffers;
+        size_t direct_rgb_index = 0;
+        if (b_direct) {
+            viddec.SetPostProcessCallback([&](uint8_t *p_surface, OutputSurfaceInfo *p_surf_info, int64_t, hipStream_t hip_stream) -> uint8_t * {
+                rgb_image_size = p_surf_info->output_height * post_process.GetRgbStride(e_output_format, p_surf_info);
+                if (direct_rgb_index == direct_rgb_buffers.size()) {
+                    uint8_t *p_rgb_buffer = nullptr;
+                    HIP_API_CALL(hipMalloc(&p_rgb_buffer, rgb_image_size));
+                    direct_rgb_buffers.push_back(p_rgb_buffer);
+                }
+                uint8_t *p_rgb_buffer = direct_rgb_buffers[direct_rgb_index++];
+                post_process.ColorConvertYUV2RGB(p_surface, p_surf_info, p_rgb_buffer, e_output_format, hip_stream);
+                return p_rgb_buffer;
+            });
+        }
+        // -host: the frames are resized and converted on the CPU from the host copy of the decoder
+        std::vector<uint8_t> host_resize_image, host_rgb_image;
+        std::thread color_space_conversion_thread;
+        if (!b_direct && !b_host) color_space_conversion_thread = std::thread(ColorSpaceConversionThread, std::ref(continue_processing), std::ref(convert_to_rgb), &resize_dim, &surf_info, &resize_surf_info, std::ref(e_output_format),
+                                    std::ref(p_rgb_dev_mem), std::ref(p_resize_dev_mem), std::ref(dump_output_frames), std::ref(output_file_path), std::ref(viddec), std::ref(post_process), b_generate_md5,
+                                    resampler.get(), std::ref(ladder), b_verify ? &resample_verifier : nullptr,
+                                    verify_planar ? &planar_verifier : nullptr);
 
         auto startTime = std::chrono::high_resolution_clock::now();
         do {
@@ -301,6 +664,58 @@ int main(int argc, char **argv) {
                 memcpy(resize_surf_info, surf_info, sizeof(OutputSurfaceInfo));
             }
 
+            if (b_direct) {
+                for (int i = 0; i < n_frames_returned; i++) {
+                    p_frame = viddec.GetFrame(&pts);
+                    if (dump_output_frames) {
+                        viddec.SaveFrameToFile(output_file_path, p_frame, surf_info, rgb_image_size);
+                    }
+                    if (b_generate_md5) {
+                        viddec.UpdateMd5ForDataBuffer(p_frame, rgb_image_size);
+                    }
+                    viddec.ReleaseFrame(pts);
+                }
+                direct_rgb_index = 0;
+                n_frame += n_frames_returned;
+                continue;
+            }
+
+            if (b_host) {
+                for (int i = 0; i < n_frames_returned; i++) {
+                    p_frame = viddec.GetFrame(&pts);
+                    const uint8_t *p_yuv = p_frame;
+                    OutputSurfaceInfo *p_yuv_info = surf_info;
+                    if (resize_surf_info && (surf_info->output_width != resize_dim.w || surf_info->output_height != resize_dim.h)) {
+                        resize_surf_info->output_width = resize_dim.w;
+                        resize_surf_info->output_height = resize_dim.h;
+                        resize_surf_info->output_pitch = resize_dim.w * surf_info->bytes_per_pixel;
+                        resize_surf_info->output_vstride = resize_dim.h;
+                        resize_surf_info->output_surface_size_in_bytes = resize_surf_info->output_pitch * (resize_dim.h + (resize_dim.h >> 1));
+                        resize_surf_info->mem_type = OUT_SURFACE_MEM_HOST_COPIED;
+                        host_resize_image.resize(resize_surf_info->output_surface_size_in_bytes);
+                        post_process.ResizeYUVHost(p_frame, surf_info, host_resize_image.data(), resize_surf_info->output_pitch, resize_dim.w, resize_dim.h,
+                                                   num_host_threads);
+                        p_yuv = host_resize_image.data();
+                        p_yuv_info = resize_surf_info;
+                    }
+                    rgb_image_size = p_yuv_info->output_height * post_process.GetRgbStride(e_output_format, p_yuv_info);
+                    host_rgb_image.resize(rgb_image_size);
+                    bool converted = post_process.ColorConvertYUV2RGBHost(p_yuv, p_yuv_info, host_rgb_image.data(), e_output_format, num_host_threads);
+                    viddec.ReleaseFrame(pts);
+                    if (!converted) {
+                        return -1;
+                    }
+                    if (dump_output_frames) {
+                        viddec.SaveFrameToFile(output_file_path, host_rgb_image.data(), p_yuv_info, rgb_image_size);
+                    }
+                    if (b_generate_md5) {
+                        viddec.UpdateMd5ForDataBuffer(host_rgb_image.data(), rgb_image_size);
+                    }
+                }
+                n_frame += n_frames_returned;
+                continue;
+            }
+
             int last_index = 0;
             for (int i = 0; i < n_frames_returned; i++) {
                 p_frame = viddec.GetFrame(&pts);
@@ -339,7 +754,15 @@ int main(int argc, char **argv) {
         auto time_per_frame = std::chrono::duration<double, std::milli>(end_time - startTime).count();
         total_dec_time += time_per_frame;
 
-        color_space_conversion_thread.join();
+        if (color_space_conversion_thread.joinable()) {
+            color_space_conversion_thread.join();
+        }
+        for (auto p_rgb_buffer : direct_rgb_buffers) {
+            hip_status = hipFree(p_rgb_buffer);
+            if (hip_status != hipSuccess) {
+                std::cout << "ERROR: hipFree failed! (" << hip_status << ")" << std::endl;
+            }
+        }
 
         if (p_rgb_dev_mem != nullptr) {
             hip_status = hipFree(p_rgb_dev_mem);
@@ -367,6 +790,26 @@ int main(int argc, char **argv) {
         if (resize_surf_info != nullptr) {
             delete resize_surf_info;
         }
+        if (verify_planar) {
+            std::cout << "info: max absolute difference of " << planar_verifier.num_outputs << " planar outputs against the CPU reference: "
+                      << planar_verifier.max_diff << std::endl;
+            if (planar_verifier.num_mismatched_outputs || !planar_verifier.num_outputs) {
+                std::cerr << "ERROR: " << planar_verifier.num_mismatched_outputs << " planar outputs exceed the tolerance of "
+                          << PlanarVerifier::Tolerance(e_output_format) << "!" << std::endl;
+                return -1;
+            }
+            std::cout << "info: all the planar outputs match the CPU reference" << std::endl;
+        }
+        if (b_verify && (resize_filter >= 0 || !ladder.dims.empty())) {
+            std::cout << "info: max absolute difference of " << resample_verifier.num_outputs << " resampler outputs against the CPU reference: "
+                      << resample_verifier.max_diff << std::endl;
+            if (resample_verifier.num_mismatched_outputs || !resample_verifier.num_outputs) {
+                std::cerr << "ERROR: " << resample_verifier.num_mismatched_outputs << " resampler outputs exceed the tolerance of "
+                          << ResampleVerifier::tolerance << "!" << std::endl;
+                return -1;
+            }
+            std::cout << "info: all the resampler outputs match the CPU reference" << std::endl;
+        }
         if (b_generate_md5) {
             uint8_t *digest;
             viddec.FinalizeMd5(&digest);
@@ -375,6 +818,23 @@ int main(int argc, char **argv) {
                 std::cout << std::setfill('0') << std::setw(2) << std::hex << static_cast<int>(digest[i]);
             }
             std::cout << std::endl;
+            if (b_direct) {
+                // the post-processed output of the mapped surfaces must match the conversion of the copied surfaces
+                uint8_t direct_digest[16], copied_digest[16];
+                memcpy(direct_digest, digest, 16);
+                std::cout << "info: reference run with the decoded surfaces copied to device memory started, please wait!" << std::endl;
+                int n_ref_frame = CopiedReferenceProc(input_file_path, device_id, p_crop_rect, e_output_format, post_process, copied_digest);
+                std::cout << "MD5 message digest (copied surfaces): ";
+                for (int i = 0; i < 16; i++) {
+                    std::cout << std::setfill('0') << std::setw(2) << std::hex << static_cast<int>(copied_digest[i]);
+                }
+                std::cout << std::dec << std::endl;
+                if (n_ref_frame != n_frame || memcmp(direct_digest, copied_digest, 16) != 0) {
+                    std::cout << "MD5 digest does not match the copied surfaces MD5 digest (" << n_frame << " frames, reference " << n_ref_frame << ")" << std::endl;
+                    return -1;
+                }
+                std::cout << "MD5 digest matches the copied surfaces MD5 digest" << std::endl;
+            }
             if (b_md5_check) {
                 std::string ref_md5_string(33, 0);
                 uint8_t ref_md5[16];
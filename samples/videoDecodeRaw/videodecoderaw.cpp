@@ -0,0 +1,291 @@
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <unistd.h>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <chrono>
+#include <sys/stat.h>
+#include <libgen.h>
+#include "elementary_stream_demuxer.h"
+#include "roc_video_dec.h"
+
+void ShowHelpAndExit(const char *option = NULL) {
+    std::cout << "Options:" << std::endl
+    << "-i Input File Path (raw H.264/HEVC Annex-B stream, AV1 IVF or AV1 OBU stream in the Section 5 or Annex B format) - required" << std::endl
+    << "-o Output File Path - dumps output if requested; optional" << std::endl
+    << "-d GPU device ID (0 for the first device, 1 for the second, etc.); optional; default: 0" << std::endl
+    << "-z force_zero_latency (force_zero_latency, Decoded frames will be flushed out for display immediately); optional;" << std::endl
+    << "-md5 generate MD5 message digest on the decoded YUV image sequence; optional;" << std::endl
+    << "-md5_check MD5 File Path - generate MD5 message digest on the decoded YUV image sequence and compare to the reference MD5 string in a file"
+    << " (e.g. written by videoDecode -md5_out from the container of the stream); fails on a mismatch; optional;" << std::endl
+    << "-chunk feed the raw H.264/HEVC Annex-B or AV1 OBU stream to the parser in chunks of this many bytes instead of access units"
+    << " (byte stream mode of the parser); optional; default: 0 (access units)" << std::endl
+    << "-eop mark every access unit with ROCDEC_PKT_ENDOFPICTURE to display the pictures without delay (low latency); optional;" << std::endl
+    << "-slice submit the slices of H.264/HEVC pictures to the decoder as soon as they are parsed (with -chunk, as soon as they are received); optional;" << std::endl
+    << "-op AV1 operating point to decode (0-31); the layers that are not in the operating point are dropped; optional; default: 0" << std::endl
+    << "-all_layers output the frames of all the spatial layers of the AV1 operating point instead of the highest one; optional;" << std::endl
+    << "-m output_surface_memory_type - decoded surface memory; optional; default - 0"
+    << " [0 : OUT_SURFACE_MEM_DEV_INTERNAL/ 1 : OUT_SURFACE_MEM_DEV_COPIED/ 2 : OUT_SURFACE_MEM_HOST_COPIED/ 3 : OUT_SURFACE_MEM_NOT_MAPPED]" << std::endl;
+    exit(0);
+}
+
+int main(int argc, char **argv) {
+
+    std::string input_file_path, output_file_path, md5_file_path;
+    int dump_output_frames = 0;
+    int device_id = 0;
+    bool b_force_zero_latency = false;     // false by default: enabling this option might affect decoding performance
+    bool b_generate_md5 = false;
+    bool b_md5_check = false;
+    int chunk_size = 0;
+    bool b_end_of_picture = false;
+    bool b_slice_submission = false;
+    int operating_point = 0;
+    bool b_output_all_layers = false;
+    OutputSurfaceMemoryType mem_type = OUT_SURFACE_MEM_DEV_INTERNAL;        // set to internal
+    // Parse command-line arguments
+    if(argc <= 1) {
+        ShowHelpAndExit();
+    }
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-i")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-i");
+            }
+            input_file_path = argv[i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-o")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-o");
+            }
+            output_file_path = argv[i];
+            dump_output_frames = 1;
+            continue;
+        }
+        if (!strcmp(argv[i], "-d")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-d");
+            }
+            device_id = atoi(argv[i]);
+            continue;
+        }
+        if (!strcmp(argv[i], "-z")) {
+            b_force_zero_latency = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-md5")) {
+            b_generate_md5 = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-md5_check")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-md5_check");
+            }
+            b_generate_md5 = true;
+            b_md5_check = true;
+            md5_file_path = argv[i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-eop")) {
+            b_end_of_picture = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-slice")) {
+            b_slice_submission = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-op")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-op");
+            }
+            operating_point = atoi(argv[i]);
+            if (operating_point < 0 || operating_point > 31) {
+                ShowHelpAndExit("-op");
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-all_layers")) {
+            b_output_all_layers = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-chunk")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-chunk");
+            }
+            chunk_size = atoi(argv[i]);
+            continue;
+        }
+        if (!strcmp(argv[i], "-m")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-m");
+            }
+            mem_type = static_cast<OutputSurfaceMemoryType>(atoi(argv[i]));
+            continue;
+        }
+        ShowHelpAndExit(argv[i]);
+    }
+    try {
+        auto startup_start_time = std::chrono::high_resolution_clock::now();
+        ElementaryStreamDemuxer demuxer(input_file_path.c_str());
+        if (!demuxer.IsValid()) {
+            std::cerr << "ERROR: unsupported input " << input_file_path << std::endl;
+            return -1;
+        }
+        rocDecVideoCodec rocdec_codec_id = demuxer.GetCodecID();
+        if (b_slice_submission && rocdec_codec_id != rocDecVideoCodec_AVC && rocdec_codec_id != rocDecVideoCodec_HEVC) {
+            std::cerr << "ERROR: -slice requires an H.264 or HEVC stream" << std::endl;
+            return -1;
+        }
+        size_t stream_size = 0, stream_offset = 0;
+        const uint8_t *p_stream = nullptr;
+        if (chunk_size > 0) {
+            if (b_end_of_picture) {
+                std::cerr << "ERROR: -eop requires access unit input and can't be used with -chunk" << std::endl;
+                return -1;
+            }
+            p_stream = demuxer.GetStreamData(&stream_size);
+            if (!p_stream) {
+                std::cerr << "ERROR: -chunk requires a raw H.264/HEVC Annex-B or AV1 OBU stream" << std::endl;
+                return -1;
+            }
+        }
+        bool b_annex_b = demuxer.GetStreamType() == ES_TYPE_OBU_ANNEXB;
+        RocVideoDecoder viddec(device_id, mem_type, rocdec_codec_id, b_force_zero_latency, nullptr, false, 0, 0, 0, 1000, chunk_size > 0, b_slice_submission, b_annex_b);
+        if(!viddec.CodecSupported(device_id, rocdec_codec_id, demuxer.GetBitDepth())) {
+            std::cerr << "GPU doesn't support codec!" << std::endl;
+            return 0;
+        }
+        viddec.SetOperatingPoint(operating_point, b_output_all_layers);
+        auto startup_end_time = std::chrono::high_resolution_clock::now();
+        double startup_time = std::chrono::duration<double, std::milli>(startup_end_time - startup_start_time).count();
+
+        std::string device_name, gcn_arch_name;
+        int pci_bus_id, pci_domain_id, pci_device_id;
+
+        viddec.GetDeviceinfo(device_name, gcn_arch_name, pci_bus_id, pci_domain_id, pci_device_id);
+        std::cout << "info: Using GPU device " << device_id << " - " << device_name << "[" << gcn_arch_name << "] on PCI bus " <<
+        std::setfill('0') << std::setw(2) << std::right << std::hex << pci_bus_id << ":" << std::setfill('0') << std::setw(2) <<
+        std::right << std::hex << pci_domain_id << "." << pci_device_id << std::dec << std::endl;
+        std::cout << "info: input stream: " << demuxer.GetWidth() << "x" << demuxer.GetHeight() << " " << demuxer.GetBitDepth() << "-bit" << std::endl;
+        std::cout << "info: decoding started, please wait!" << std::endl;
+
+        int n_video_bytes = 0, n_frame_returned = 0, n_frame = 0;
+        uint8_t *pvideo = nullptr;
+        int pkg_flags = b_end_of_picture ? ROCDEC_PKT_ENDOFPICTURE : 0;
+        uint8_t *pframe = nullptr;
+        int64_t pts = 0;
+        OutputSurfaceInfo *surf_info;
+        double total_dec_time = 0;
+
+        if (b_generate_md5) {
+            viddec.InitMd5();
+        }
+
+        do {
+            auto start_time = std::chrono::high_resolution_clock::now();
+            if (p_stream) {
+                // Arbitrary chunks: the parser finds the access units itself
+                n_video_bytes = static_cast<int>(std::min(static_cast<size_t>(chunk_size), stream_size - stream_offset));
+                pvideo = const_cast<uint8_t *>(p_stream + stream_offset);
+                stream_offset += n_video_bytes;
+            } else {
+                demuxer.Demux(&pvideo, &n_video_bytes, &pts);
+            }
+            // Treat 0 bitstream size as end of stream indicator
+            if (n_video_bytes == 0) {
+                pkg_flags |= ROCDEC_PKT_ENDOFSTREAM;
+            }
+            n_frame_returned = viddec.DecodeFrame(pvideo, n_video_bytes, pkg_flags, pts);
+            auto end_time = std::chrono::high_resolution_clock::now();
+            total_dec_time += std::chrono::duration<double, std::milli>(end_time - start_time).count();
+            if (!n_frame && !viddec.GetOutputSurfaceInfo(&surf_info)) {
+                std::cerr << "Error: Failed to get Output Surface Info!" << std::endl;
+                break;
+            }
+            for (int i = 0; i < n_frame_returned; i++) {
+                pframe = viddec.GetFrame(&pts);
+                if (b_generate_md5) {
+                    viddec.UpdateMd5ForFrame(pframe, surf_info);
+                }
+                if (dump_output_frames && mem_type != OUT_SURFACE_MEM_NOT_MAPPED) {
+                    viddec.SaveFrameToFile(output_file_path, pframe, surf_info);
+                }
+                // release frame
+                viddec.ReleaseFrame(pts);
+            }
+            n_frame += n_frame_returned;
+        } while (n_video_bytes);
+
+        std::cout << "info: Total frame decoded: " << n_frame << std::endl;
+        std::cout << "info: startup time (demuxer + decoder creation) (ms): " << startup_time << std::endl;
+        if (!dump_output_frames) {
+            std::cout << "info: avg decoding time per frame (ms): " << total_dec_time / n_frame << std::endl;
+            std::cout << "info: avg FPS: " << (n_frame / total_dec_time) * 1000 << std::endl;
+        } else {
+            if (mem_type == OUT_SURFACE_MEM_NOT_MAPPED) {
+                std::cout << "info: saving frames with -m 3 option is not supported!" << std::endl;
+            } else {
+                std::cout << "info: saved frames into " << output_file_path << std::endl;
+            }
+        }
+        if (b_generate_md5) {
+            uint8_t *digest;
+            viddec.FinalizeMd5(&digest);
+            std::cout << "MD5 message digest: ";
+            for (int i = 0; i < 16; i++) {
+                std::cout << std::setfill('0') << std::setw(2) << std::hex << static_cast<int>(digest[i]);
+            }
+            std::cout << std::endl;
+            if (b_md5_check) {
+                std::ifstream ref_md5_file(md5_file_path.c_str(), std::ios::in);
+                std::string ref_md5_string;
+                if (!std::getline(ref_md5_file, ref_md5_string) || ref_md5_string.length() < 32) {
+                    std::cerr << "Failed to read the MD5 digest string from " << md5_file_path << std::endl;
+                    return 1;
+                }
+                uint8_t ref_md5[16];
+                for (int i = 0; i < 16; i++) {
+                    ref_md5[i] = std::stoi(ref_md5_string.substr(i * 2, 2), nullptr, 16);
+                }
+                if (memcmp(digest, ref_md5, 16) != 0) {
+                    std::cout << "MD5 digest does not match the reference MD5 digest: " << ref_md5_string << std::endl;
+                    return -1;
+                }
+                std::cout << "MD5 digest matches the reference MD5 digest: " << ref_md5_string << std::endl;
+            }
+        }
+    } catch (const std::exception &ex) {
+      std::cout << ex.what() << std::endl;
+      exit(1);
+    }
+
+    return 0;
+}
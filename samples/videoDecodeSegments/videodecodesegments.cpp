@@ -0,0 +1,319 @@
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <climits>
+#include <sys/stat.h>
+#include <libgen.h>
+#if __cplusplus >= 201703L && __has_include(<filesystem>)
+    #include <filesystem>
+#else
+    #include <experimental/filesystem>
+#endif
+#include "video_demuxer.h"
+#include "video_segment_decoder.h"
+#include "roc_video_dec.h"
+#include "common.h"
+
+void ShowHelpAndExit(const char *option = NULL) {
+    std::cout << "Options:" << std::endl
+    << "-i Input File Path - required" << std::endl
+    << "-s Number of segments (>= 1) - optional; default: 2" << std::endl
+    << "-d Device ID of the first GPU to use (>= 0) - optional; default: 0" << std::endl
+    << "-g Number of GPUs to distribute the segments on (>= 1) - optional; default: 1" << std::endl
+    << "-q Max number of decoded frames buffered per segment - optional; default: 16" << std::endl
+    << "-disp_delay -specify the number of frames to be delayed for display; optional" << std::endl
+    << "-md5 generate MD5 message digest on the decoded YUV image sequence and compare it to the single decoder output; optional" << std::endl
+    << "-no_ref skip the single decoder reference run; optional" << std::endl
+    << "-m output_surface_memory_type - decoded surface memory; optional; default - 0"
+    << " [0 : OUT_SURFACE_MEM_DEV_INTERNAL/ 1 : OUT_SURFACE_MEM_DEV_COPIED/ 2 : OUT_SURFACE_MEM_HOST_COPIED/ 3 : OUT_SURFACE_MEM_NOT_MAPPED]" << std::endl;
+    exit(0);
+}
+
+void PrintDigest(uint8_t *digest) {
+    for (int i = 0; i < 16; i++) {
+        std::cout << std::setfill('0') << std::setw(2) << std::hex << static_cast<int>(digest[i]);
+    }
+    std::cout << std::dec << std::endl;
+}
+
+// decodes the whole file with a single demuxer and decoder: reference for the output and the speedup
+int SingleDecoderProc(const std::string &input_file_path, int device_id, OutputSurfaceMemoryType mem_type, uint32_t disp_delay, bool b_generate_md5,
+                      uint8_t *digest, double *p_time_ms) {
+    VideoDemuxer demuxer(input_file_path.c_str());
+    rocDecVideoCodec rocdec_codec_id = AVCodec2RocDecVideoCodec(demuxer.GetCodecID());
+    RocVideoDecoder viddec(device_id, mem_type, rocdec_codec_id, false, nullptr, false, disp_delay);
+    if (!viddec.CodecSupported(device_id, rocdec_codec_id, demuxer.GetBitDepth())) {
+        std::cerr << "Codec not supported on GPU, skipping the reference run!" << std::endl;
+        return -1;
+    }
+    if (b_generate_md5) {
+        viddec.InitMd5();
+    }
+    int n_video_bytes = 0, n_frame_returned = 0, n_frame = 0;
+    uint8_t *p_video = nullptr, *p_frame = nullptr;
+    int64_t pts = 0;
+    OutputSurfaceInfo *surf_info = nullptr;
+    auto start_time = std::chrono::high_resolution_clock::now();
+    do {
+        demuxer.Demux(&p_video, &n_video_bytes, &pts);
+        n_frame_returned = viddec.DecodeFrame(p_video, n_video_bytes, 0, pts);
+        if (!n_frame && !viddec.GetOutputSurfaceInfo(&surf_info)) {
+            std::cerr << "Error: Failed to get Output Surface Info!" << std::endl;
+            break;
+        }
+        for (int i = 0; i < n_frame_returned; i++) {
+            p_frame = viddec.GetFrame(&pts);
+            if (b_generate_md5 && p_frame) {
+                viddec.UpdateMd5ForFrame(p_frame, surf_info);
+            }
+            viddec.ReleaseFrame(pts);
+        }
+        n_frame += n_frame_returned;
+    } while (n_video_bytes);
+    if (mem_type == OUT_SURFACE_MEM_NOT_MAPPED) {
+        viddec.WaitForDecodeCompletion();
+    }
+    auto end_time = std::chrono::high_resolution_clock::now();
+    // wall clock time including the decoder session creation, measured like the segmented decode
+    *p_time_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    if (b_generate_md5) {
+        uint8_t *p_digest;
+        viddec.FinalizeMd5(&p_digest);
+        memcpy(digest, p_digest, 16);
+    }
+    return n_frame;
+}
+
+int main(int argc, char **argv) {
+
+    std::string input_file_path;
+    int device_id = 0;
+    int num_gpus = 1;
+    int num_segments = 2;
+    uint32_t max_frames_in_flight = 16;
+    int disp_delay = 0;
+    bool b_generate_md5 = false;
+    bool b_run_reference = true;
+    OutputSurfaceMemoryType mem_type = OUT_SURFACE_MEM_DEV_INTERNAL;
+
+    // Parse command-line arguments
+    if(argc <= 1) {
+        ShowHelpAndExit();
+    }
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-i")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-i");
+            }
+            input_file_path = argv[i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-s")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-s");
+            }
+            num_segments = atoi(argv[i]);
+            if (num_segments <= 0) {
+                ShowHelpAndExit(argv[i]);
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-d")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-d");
+            }
+            device_id = atoi(argv[i]);
+            if (device_id < 0) {
+                ShowHelpAndExit(argv[i]);
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-g")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-g");
+            }
+            num_gpus = atoi(argv[i]);
+            if (num_gpus <= 0) {
+                ShowHelpAndExit(argv[i]);
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-q")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-q");
+            }
+            max_frames_in_flight = atoi(argv[i]);
+            continue;
+        }
+        if (!strcmp(argv[i], "-disp_delay")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-disp_delay");
+            }
+            disp_delay = atoi(argv[i]);
+            continue;
+        }
+        if (!strcmp(argv[i], "-md5")) {
+            b_generate_md5 = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-no_ref")) {
+            b_run_reference = false;
+            continue;
+        }
+        if (!strcmp(argv[i], "-m")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-m");
+            }
+            mem_type = static_cast<OutputSurfaceMemoryType>(atoi(argv[i]));
+            continue;
+        }
+        ShowHelpAndExit(argv[i]);
+    }
+    if (b_generate_md5 && mem_type == OUT_SURFACE_MEM_NOT_MAPPED) {
+        std::cerr << "MD5 generation isn't available with OUT_SURFACE_MEM_NOT_MAPPED, disabling it" << std::endl;
+        b_generate_md5 = false;
+    }
+
+    try {
+        int num_devices = 0;
+        hipError_t hip_status = hipGetDeviceCount(&num_devices);
+        if (hip_status != hipSuccess) {
+            std::cerr << "ERROR: hipGetDeviceCount failed! (" << hip_status << ")" << std::endl;
+            return -1;
+        }
+        if (num_devices < 1) {
+            std::cerr << "ERROR: didn't find any GPU!" << std::endl;
+            return -1;
+        }
+        if (device_id >= num_devices) {
+            std::cerr << "ERROR: invalid device ID " << device_id << std::endl;
+            return -1;
+        }
+        std::vector<int> device_ids;
+        for (int i = 0; i < num_gpus && device_id + i < num_devices; i++) {
+            device_ids.push_back(device_id + i);
+        }
+
+        std::size_t found_file = input_file_path.find_last_of('/');
+        std::cout << "info: Input file: " << input_file_path.substr(found_file + 1) << std::endl;
+
+        VideoSegmentDecoder seg_dec(input_file_path.c_str(), num_segments, device_ids, mem_type, max_frames_in_flight, disp_delay);
+        int n_seg = seg_dec.GetNumSegments();
+        if (n_seg < num_segments) {
+            std::cout << "info: the stream can only be split in " << n_seg << " segment(s)" << std::endl;
+        }
+        std::cout << "info: Number of segments: " << n_seg << " on " << device_ids.size() << " GPU(s)" << std::endl;
+        std::cout << "info: key frame scan time: " << seg_dec.GetScanTime() << " ms" << std::endl;
+
+        if (b_generate_md5) {
+            seg_dec.GetDecoder(0)->InitMd5();
+        }
+        int64_t last_pts = INT64_MIN;
+        int n_out_of_order = 0;
+        auto frame_cb = [&](VideoSegmentInfo *seg_info, uint8_t *p_frame, int64_t pts, OutputSurfaceInfo *surf_info) {
+            if (pts <= last_pts) {
+                n_out_of_order++;
+            }
+            last_pts = pts;
+            if (b_generate_md5) {
+                seg_dec.GetDecoder(0)->UpdateMd5ForFrame(p_frame, surf_info);
+            }
+        };
+
+        std::cout << "info: decoding started, please wait!" << std::endl;
+        auto start_time = std::chrono::high_resolution_clock::now();
+        int n_frame = seg_dec.Decode(frame_cb);
+        auto end_time = std::chrono::high_resolution_clock::now();
+        double seg_time_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+        if (n_frame < 0) {
+            std::cerr << "ERROR: segment decoding failed!" << std::endl;
+            return -1;
+        }
+
+        int n_pic_decoded = 0;
+        for (int i = 0; i < n_seg; i++) {
+            VideoSegmentInfo *seg_info = seg_dec.GetSegmentInfo(i);
+            n_pic_decoded += seg_info->num_pics_decoded;
+            std::cout << "info: segment " << i << " on device " << seg_info->device_id << ": packets " << seg_info->num_packets
+                      << ", frames output " << seg_info->num_frames_output << ", pictures decoded " << seg_info->num_pics_decoded
+                      << ", time " << seg_info->decode_time_ms << " ms" << std::endl;
+        }
+        std::cout << "info: Total pictures decoded: " << n_pic_decoded << std::endl;
+        std::cout << "info: Total frames output/displayed: " << n_frame << std::endl;
+        if (mem_type != OUT_SURFACE_MEM_NOT_MAPPED) {
+            std::cout << "info: frames out of order: " << n_out_of_order << std::endl;
+        }
+        std::cout << "info: segmented decode time: " << seg_time_ms << " ms" << std::endl;
+        std::cout << "info: segmented output/display FPS: " << n_frame / seg_time_ms * 1000 << std::endl;
+
+        uint8_t seg_digest[16] = {0};
+        if (b_generate_md5) {
+            uint8_t *p_digest;
+            seg_dec.GetDecoder(0)->FinalizeMd5(&p_digest);
+            memcpy(seg_digest, p_digest, 16);
+            std::cout << "MD5 message digest: ";
+            PrintDigest(seg_digest);
+        }
+
+        if (b_run_reference) {
+            uint8_t ref_digest[16] = {0};
+            double ref_time_ms = 0;
+            std::cout << "info: single decoder reference run started, please wait!" << std::endl;
+            int n_ref_frame = SingleDecoderProc(input_file_path, device_ids[0], mem_type, disp_delay, b_generate_md5, ref_digest, &ref_time_ms);
+            if (n_ref_frame >= 0) {
+                std::cout << "info: single decoder frames output/displayed: " << n_ref_frame << std::endl;
+                std::cout << "info: single decoder decode time: " << ref_time_ms << " ms" << std::endl;
+                std::cout << "info: single decoder output/display FPS: " << n_ref_frame / ref_time_ms * 1000 << std::endl;
+                std::cout << "info: speedup versus single decoder: " << ref_time_ms / seg_time_ms << "x" << std::endl;
+                if (b_generate_md5) {
+                    std::cout << "MD5 message digest (single decoder): ";
+                    PrintDigest(ref_digest);
+                    if (memcmp(seg_digest, ref_digest, 16) == 0) {
+                        std::cout << "MD5 digest matches the single decoder MD5 digest" << std::endl;
+                    } else {
+                        std::cout << "MD5 digest does not match the single decoder MD5 digest" << std::endl;
+                        return -1;
+                    }
+                }
+            }
+        }
+        if (n_out_of_order) {
+            std::cerr << "ERROR: frames were output out of order!" << std::endl;
+            return -1;
+        }
+    } catch (const std::exception &ex) {
+      std::cout << ex.what() << std::endl;
+      exit(1);
+    }
+
+    return 0;
+}
@@ -0,0 +1,475 @@
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <algorithm>
+#include <hip/hip_fp16.h>
+#include "video_demuxer.h"
+#include "roc_video_dec.h"
+#include "video_post_process.h"
+
+void ShowHelpAndExit(const char *option = NULL) {
+    std::cout << "Options:" << std::endl
+    << "-i Input File Path - required; can be repeated to decode several files into the same batch" << std::endl
+    << "-o Output File Path - dumps the output tensors if requested; optional" << std::endl
+    << "-d GPU device ID (0 for the first device, 1 for the second, etc.); optional; default: 0" << std::endl
+    << "-batch N - number of decoded streams converted into one batch tensor with a single kernel launch; the input files are assigned to the streams"
+    << " in a round robin fashion; optional; default: number of input files" << std::endl
+    << "-resize WxH - (where W is tensor width and H is tensor height) optional; default: 224x224" << std::endl
+    << "-fp16 - write FP16 tensors instead of FP32; optional" << std::endl
+    << "-bf16 - write BF16 (bfloat16) tensors instead of FP32; optional" << std::endl
+    << "-bgr - order the tensor channels as B, G, R instead of R, G, B; optional" << std::endl
+    << "-nhwc - write interleaved NHWC tensors instead of planar NCHW tensors; optional" << std::endl
+    << "-mean m0,m1,m2 - per channel mean subtracted from the [0, 1] color values; optional; default: 0.485,0.456,0.406" << std::endl
+    << "-std s0,s1,s2 - per channel standard deviation dividing the mean subtracted values; optional; default: 0.229,0.224,0.225" << std::endl
+    << "-rois N - also crop N boxes of every frame and resize them to WxH 8-bit RGB images with one kernel launch per frame; optional; default: 0" << std::endl
+    << "-verify - compare every output tensor (and crop) against the CPU reference; optional" << std::endl
+    << "-f Number of decoded frames - specify the number of pictures to be decoded; optional" << std::endl;
+    exit(0);
+}
+
+/**
+ * @brief One decoded stream of the batch
+ */
+struct TensorStream {
+    std::unique_ptr<VideoDemuxer> demuxer;
+    std::unique_ptr<RocVideoDecoder> viddec;
+    OutputSurfaceInfo *surf_info = nullptr;
+    int num_pending_frames = 0;     // frames returned by the last DecodeFrame call which are not retrieved yet
+    bool end_of_stream = false;
+};
+
+/**
+ * @brief Decodes the stream until a frame is available and retrieves it
+ *
+ * @return false at the end of the stream
+ */
+bool GetNextFrame(TensorStream &stream, uint8_t **pp_frame, int64_t *pts) {
+    while (!stream.num_pending_frames) {
+        if (stream.end_of_stream) {
+            return false;
+        }
+        uint8_t *p_video = nullptr;
+        int n_video_bytes = 0;
+        stream.demuxer->Demux(&p_video, &n_video_bytes, pts);
+        stream.num_pending_frames = stream.viddec->DecodeFrame(p_video, n_video_bytes, 0, *pts);
+        stream.end_of_stream = !n_video_bytes;
+    }
+    if (!stream.surf_info && !stream.viddec->GetOutputSurfaceInfo(&stream.surf_info)) {
+        std::cerr << "Error: Failed to get Output Surface Info!" << std::endl;
+        return false;
+    }
+    *pp_frame = stream.viddec->GetFrame(pts);
+    stream.num_pending_frames--;
+    return true;
+}
+
+/**
+ * @brief Compares the tensor produced on the GPU against the CPU reference computed from the same decoded surface
+ *
+ * @return the maximum absolute difference of all the tensor elements
+ */
+float VerifyTensor(uint8_t *p_frame, OutputSurfaceInfo *surf_info, void *p_tensor_dev_mem, TensorDataType data_type, TensorLayout layout,
+                   int dst_width, int dst_height, bool bgr, const TensorNormParams &norm_params, const ColorSpaceInfo &color_info) {
+    size_t plane_size = static_cast<size_t>(dst_width) * dst_height;
+    size_t num_elements = 3 * plane_size;
+    std::vector<uint8_t> yuv_host(surf_info->output_surface_size_in_bytes);
+    std::vector<float> ref_tensor(num_elements), out_tensor(num_elements);
+    HIP_API_CALL(hipMemcpyDtoH(yuv_host.data(), p_frame, surf_info->output_surface_size_in_bytes));
+    if (data_type == TensorDataType_FP16) {
+        std::vector<__half> out_half(num_elements);
+        HIP_API_CALL(hipMemcpyDtoH(out_half.data(), p_tensor_dev_mem, num_elements * sizeof(__half)));
+        std::transform(out_half.begin(), out_half.end(), out_tensor.begin(), [](const __half &h) { return __half2float(h); });
+    } else if (data_type == TensorDataType_BF16) {
+        std::vector<uint16_t> out_bf16(num_elements);
+        HIP_API_CALL(hipMemcpyDtoH(out_bf16.data(), p_tensor_dev_mem, num_elements * sizeof(uint16_t)));
+        std::transform(out_bf16.begin(), out_bf16.end(), out_tensor.begin(), [](uint16_t b) {
+            uint32_t bits = static_cast<uint32_t>(b) << 16;
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        });
+    } else {
+        HIP_API_CALL(hipMemcpyDtoH(out_tensor.data(), p_tensor_dev_mem, num_elements * sizeof(float)));
+    }
+    ResizeYuv420ToTensorRef(yuv_host.data(), surf_info->output_pitch, surf_info->output_width, surf_info->output_height, surf_info->output_vstride,
+                            surf_info->bytes_per_pixel == 2, ref_tensor.data(), dst_width, dst_height, bgr, norm_params, color_info);
+    float max_diff = 0;
+    for (size_t i = 0; i < plane_size; i++) {
+        for (int c = 0; c < 3; c++) {
+            float out_value = layout == TensorLayout_NHWC ? out_tensor[3 * i + c] : out_tensor[c * plane_size + i];
+            max_diff = std::max(max_diff, std::fabs(out_value - ref_tensor[c * plane_size + i]));
+        }
+    }
+    return max_diff;
+}
+
+/**
+ * @brief Generates num_rois pseudo random boxes standing in for the detections of a frame; some of them extend beyond the surface edges
+ */
+void GenerateRois(int frame_idx, OutputSurfaceInfo *surf_info, int num_rois, std::vector<RoiBox> &rois) {
+    uint32_t seed = 2166136261u ^ static_cast<uint32_t>(frame_idx);
+    auto next_rand = [&seed](int range) { seed = seed * 1664525u + 1013904223u; return static_cast<int>((seed >> 8) % static_cast<uint32_t>(range)); };
+    int width = static_cast<int>(surf_info->output_width), height = static_cast<int>(surf_info->output_height);
+    rois.resize(num_rois);
+    for (auto &roi : rois) {
+        int box_width = 8 + next_rand(std::max(width / 2, 1)), box_height = 8 + next_rand(std::max(height / 2, 1));
+        roi.left = static_cast<float>(next_rand(width) - box_width / 4) + next_rand(4) * 0.25f;
+        roi.top = static_cast<float>(next_rand(height) - box_height / 4) + next_rand(4) * 0.25f;
+        roi.right = roi.left + box_width;
+        roi.bottom = roi.top + box_height;
+    }
+}
+
+/**
+ * @brief Compares the crops produced on the GPU against the CPU reference computed from the same decoded surface
+ *
+ * @return the maximum absolute difference of all the crop values
+ */
+int VerifyRois(uint8_t *p_frame, OutputSurfaceInfo *surf_info, const std::vector<RoiBox> &rois, uint8_t *p_rgb_dev_mem, int dst_width, int dst_height,
+               bool bgr, const ColorSpaceInfo &color_info) {
+    size_t rgb_size = rois.size() * dst_width * dst_height * 3;
+    std::vector<uint8_t> yuv_host(surf_info->output_surface_size_in_bytes);
+    std::vector<uint8_t> ref_rgb(rgb_size), out_rgb(rgb_size);
+    HIP_API_CALL(hipMemcpyDtoH(yuv_host.data(), p_frame, surf_info->output_surface_size_in_bytes));
+    HIP_API_CALL(hipMemcpyDtoH(out_rgb.data(), p_rgb_dev_mem, rgb_size));
+    CropResizeYuv420ToRgbBatchRef(yuv_host.data(), surf_info->output_pitch, surf_info->output_width, surf_info->output_height, surf_info->output_vstride,
+                                  surf_info->bytes_per_pixel == 2, rois.data(), static_cast<int>(rois.size()), ref_rgb.data(), dst_width, dst_height, bgr,
+                                  color_info);
+    int max_diff = 0;
+    for (size_t i = 0; i < rgb_size; i++) {
+        max_diff = std::max(max_diff, std::abs(out_rgb[i] - ref_rgb[i]));
+    }
+    return max_diff;
+}
+
+int main(int argc, char **argv) {
+
+    std::vector<std::string> input_file_paths;
+    std::string output_file_path;
+    std::ofstream fp_out;
+    bool dump_output_frames = false;
+    bool b_verify = false;
+    bool bgr = false;
+    int device_id = 0;
+    int batch_size = 0;
+    int dst_width = 224, dst_height = 224;
+    TensorDataType data_type = TensorDataType_FP32;
+    TensorLayout layout = TensorLayout_NCHW;
+    TensorNormParams norm_params = {{0.485f, 0.456f, 0.406f}, {0.229f, 0.224f, 0.225f}};
+    int num_decoded_frames = 0;  // zero means decoding the entire stream
+    int num_rois = 0;
+    void *p_tensor_dev_mem = nullptr;
+    uint8_t *p_roi_dev_mem = nullptr;
+    hipError_t hip_status = hipSuccess;
+    OutputSurfaceMemoryType mem_type = OUT_SURFACE_MEM_DEV_INTERNAL;
+
+    // Parse command-line arguments
+    if(argc <= 1) {
+        ShowHelpAndExit();
+    }
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-i")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-i");
+            }
+            input_file_paths.push_back(argv[i]);
+            continue;
+        }
+        if (!strcmp(argv[i], "-o")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-o");
+            }
+            output_file_path = argv[i];
+            dump_output_frames = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-d")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-d");
+            }
+            device_id = atoi(argv[i]);
+            continue;
+        }
+        if (!strcmp(argv[i], "-batch")) {
+            if (++i == argc || (batch_size = atoi(argv[i])) <= 0) {
+                ShowHelpAndExit("-batch");
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-resize")) {
+            if (++i == argc || 2 != sscanf(argv[i], "%dx%d", &dst_width, &dst_height) || dst_width <= 0 || dst_height <= 0) {
+                ShowHelpAndExit("-resize");
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-fp16")) {
+            data_type = TensorDataType_FP16;
+            continue;
+        }
+        if (!strcmp(argv[i], "-bf16")) {
+            data_type = TensorDataType_BF16;
+            continue;
+        }
+        if (!strcmp(argv[i], "-bgr")) {
+            bgr = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-nhwc")) {
+            layout = TensorLayout_NHWC;
+            continue;
+        }
+        if (!strcmp(argv[i], "-mean")) {
+            if (++i == argc || 3 != sscanf(argv[i], "%f,%f,%f", &norm_params.mean[0], &norm_params.mean[1], &norm_params.mean[2])) {
+                ShowHelpAndExit("-mean");
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-std")) {
+            if (++i == argc || 3 != sscanf(argv[i], "%f,%f,%f", &norm_params.std_dev[0], &norm_params.std_dev[1], &norm_params.std_dev[2])) {
+                ShowHelpAndExit("-std");
+            }
+            if (norm_params.std_dev[0] == 0 || norm_params.std_dev[1] == 0 || norm_params.std_dev[2] == 0) {
+                std::cout << "standard deviation values must be non-zero" << std::endl;
+                exit(1);
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-rois")) {
+            if (++i == argc || (num_rois = atoi(argv[i])) < 0) {
+                ShowHelpAndExit("-rois");
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-verify")) {
+            b_verify = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-f")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-f");
+            }
+            num_decoded_frames = atoi(argv[i]);
+            continue;
+        }
+        ShowHelpAndExit(argv[i]);
+    }
+    if (input_file_paths.empty()) {
+        ShowHelpAndExit("-i");
+    }
+    if (!batch_size) {
+        batch_size = static_cast<int>(input_file_paths.size());
+    }
+
+    try {
+        std::vector<TensorStream> streams(batch_size);
+        for (int i = 0; i < batch_size; i++) {
+            TensorStream &stream = streams[i];
+            stream.demuxer.reset(new VideoDemuxer(input_file_paths[i % input_file_paths.size()].c_str()));
+            rocDecVideoCodec rocdec_codec_id = AVCodec2RocDecVideoCodec(stream.demuxer->GetCodecID());
+            stream.viddec.reset(new RocVideoDecoder(device_id, mem_type, rocdec_codec_id));
+            if(!stream.viddec->CodecSupported(device_id, rocdec_codec_id, stream.demuxer->GetBitDepth())) {
+                std::cerr << "GPU doesn't support codec!" << std::endl;
+                return 0;
+            }
+        }
+        VideoPostProcess post_process;
+        hipStream_t hip_stream = streams[0].viddec->GetStream();
+
+        std::string device_name, gcn_arch_name;
+        int pci_bus_id, pci_domain_id, pci_device_id;
+
+        streams[0].viddec->GetDeviceinfo(device_name, gcn_arch_name, pci_bus_id, pci_domain_id, pci_device_id);
+        std::cout << "info: Using GPU device " << device_id << " " << device_name << "[" << gcn_arch_name << "] on PCI bus " <<
+        std::setfill('0') << std::setw(2) << std::right << std::hex << pci_bus_id << ":" << std::setfill('0') << std::setw(2) <<
+        std::right << std::hex << pci_domain_id << "." << pci_device_id << std::dec << std::endl;
+        std::cout << "info: decoding started, please wait!" << std::endl;
+
+        int n_frame = 0, n_batch = 0;
+        size_t tensor_size = post_process.GetTensorSize(data_type, dst_width, dst_height);
+        std::vector<uint8_t> tensor_host;
+        std::vector<uint8_t *> batch_frames(batch_size);
+        std::vector<OutputSurfaceInfo *> batch_surf_infos(batch_size);
+        std::vector<int64_t> batch_pts(batch_size);
+        std::vector<int> batch_stream_idx(batch_size);
+        // the fused kernel output matches the CPU reference up to the floating point contraction on the device and the FP16/BF16 rounding
+        const float tolerance = data_type == TensorDataType_FP16 ? 5e-3f : data_type == TensorDataType_BF16 ? 1.6e-2f : 1e-3f;
+        float max_diff = 0;
+        int num_mismatched_frames = 0;
+        // the crops are rounded to 8 bits, so the contraction differences can flip the rounding of a value
+        const int roi_tolerance = 1;
+        int roi_max_diff = 0, num_mismatched_rois = 0, n_roi = 0;
+        std::vector<RoiBox> rois;
+        double total_dec_time = 0;
+
+        auto start_time = std::chrono::high_resolution_clock::now();
+        while (!num_decoded_frames || n_frame < num_decoded_frames) {
+            // gather one frame from each stream which has not ended
+            int num_frames = 0;
+            for (int i = 0; i < batch_size; i++) {
+                if (GetNextFrame(streams[i], &batch_frames[num_frames], &batch_pts[num_frames])) {
+                    batch_surf_infos[num_frames] = streams[i].surf_info;
+                    batch_stream_idx[num_frames++] = i;
+                }
+            }
+            if (!num_frames) {
+                break;
+            }
+            if (p_tensor_dev_mem == nullptr) {
+                hip_status = hipMalloc(&p_tensor_dev_mem, tensor_size * batch_size);
+                if (hip_status != hipSuccess) {
+                    std::cerr << "ERROR: hipMalloc failed to allocate the device memory for the tensor!" << hip_status << std::endl;
+                    return -1;
+                }
+            }
+            bool status;
+            if (batch_size == 1 && layout == TensorLayout_NCHW) {
+                status = post_process.ResizeColorConvertNormalize(batch_frames[0], batch_surf_infos[0], p_tensor_dev_mem, data_type, dst_width, dst_height,
+                                                                  bgr, norm_params, hip_stream);
+            } else {
+                status = post_process.ColorConvertBatchToTensor(batch_frames.data(), batch_surf_infos.data(), num_frames, p_tensor_dev_mem, data_type,
+                                                                layout, dst_width, dst_height, bgr, norm_params, hip_stream);
+            }
+            if (!status) {
+                return -1;
+            }
+            // the decoded surfaces are released after the kernel has read them
+            HIP_API_CALL(hipStreamSynchronize(hip_stream));
+            if (b_verify) {
+                for (int i = 0; i < num_frames; i++) {
+                    float frame_diff = VerifyTensor(batch_frames[i], batch_surf_infos[i], static_cast<uint8_t *>(p_tensor_dev_mem) + i * tensor_size,
+                                                    data_type, layout, dst_width, dst_height, bgr, norm_params,
+                                                    post_process.GetColorSpaceInfo(batch_surf_infos[i]));
+                    max_diff = std::max(max_diff, frame_diff);
+                    if (frame_diff > tolerance) {
+                        num_mismatched_frames++;
+                    }
+                }
+            }
+            if (num_rois) {
+                if (p_roi_dev_mem == nullptr) {
+                    hip_status = hipMalloc(&p_roi_dev_mem, static_cast<size_t>(num_rois) * dst_width * dst_height * 3);
+                    if (hip_status != hipSuccess) {
+                        std::cerr << "ERROR: hipMalloc failed to allocate the device memory for the crops!" << hip_status << std::endl;
+                        return -1;
+                    }
+                }
+                for (int i = 0; i < num_frames; i++) {
+                    GenerateRois(n_frame + i, batch_surf_infos[i], num_rois, rois);
+                    if (!post_process.CropResizeToRgbBatch(batch_frames[i], batch_surf_infos[i], rois.data(), num_rois, p_roi_dev_mem, dst_width, dst_height,
+                                                           bgr, hip_stream)) {
+                        return -1;
+                    }
+                    HIP_API_CALL(hipStreamSynchronize(hip_stream));
+                    if (b_verify) {
+                        int roi_diff = VerifyRois(batch_frames[i], batch_surf_infos[i], rois, p_roi_dev_mem, dst_width, dst_height, bgr,
+                                                  post_process.GetColorSpaceInfo(batch_surf_infos[i]));
+                        roi_max_diff = std::max(roi_max_diff, roi_diff);
+                        if (roi_diff > roi_tolerance) {
+                            num_mismatched_rois++;
+                        }
+                    }
+                    n_roi += num_rois;
+                }
+            }
+            if (dump_output_frames) {
+                if (!fp_out.is_open()) {
+                    fp_out.open(output_file_path, std::ios::out | std::ios::binary);
+                    tensor_host.resize(tensor_size * batch_size);
+                }
+                HIP_API_CALL(hipMemcpyDtoH(tensor_host.data(), p_tensor_dev_mem, tensor_size * num_frames));
+                fp_out.write(reinterpret_cast<char *>(tensor_host.data()), tensor_size * num_frames);
+            }
+            // release frames
+            for (int i = 0; i < num_frames; i++) {
+                streams[batch_stream_idx[i]].viddec->ReleaseFrame(batch_pts[i]);
+            }
+            n_frame += num_frames;
+            n_batch++;
+        }
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        total_dec_time = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        if (p_tensor_dev_mem != nullptr) {
+            hip_status = hipFree(p_tensor_dev_mem);
+            if (hip_status != hipSuccess) {
+                std::cout << "ERROR: hipFree failed! (" << hip_status << ")" << std::endl;
+                return -1;
+            }
+        }
+        if (p_roi_dev_mem != nullptr) {
+            hip_status = hipFree(p_roi_dev_mem);
+            if (hip_status != hipSuccess) {
+                std::cout << "ERROR: hipFree failed! (" << hip_status << ")" << std::endl;
+                return -1;
+            }
+        }
+        if (fp_out.is_open()) {
+            fp_out.close();
+        }
+
+        std::cout << "info: Total frame decoded: " << n_frame << " in " << n_batch << " batches of up to " << batch_size << " streams" << std::endl;
+        std::cout << "info: Tensor: " << (layout == TensorLayout_NHWC ? "NHWC " : "NCHW ") << batch_size << "x" <<
+        (layout == TensorLayout_NHWC ? std::to_string(dst_height) + "x" + std::to_string(dst_width) + "x3" : "3x" + std::to_string(dst_height) + "x" + std::to_string(dst_width)) <<
+        (data_type == TensorDataType_FP16 ? " FP16 " : data_type == TensorDataType_BF16 ? " BF16 " : " FP32 ") << (bgr ? "BGR" : "RGB") << std::endl;
+        if (num_rois) {
+            std::cout << "info: Total crops: " << n_roi << " of " << dst_width << "x" << dst_height << (bgr ? " BGR" : " RGB") << std::endl;
+        }
+        if (!dump_output_frames && !b_verify && n_frame) {
+            std::cout << "info: avg decoding and tensor conversion time per frame (ms): " << total_dec_time / n_frame << std::endl;
+            std::cout << "info: avg FPS: " << (n_frame / total_dec_time) * 1000 << std::endl;
+        }
+        if (b_verify) {
+            std::cout << "info: max absolute difference against the CPU reference: " << max_diff << std::endl;
+            if (num_mismatched_frames) {
+                std::cerr << "ERROR: " << num_mismatched_frames << " tensors exceed the tolerance of " << tolerance << "!" << std::endl;
+                return -1;
+            }
+            std::cout << "info: all the tensors match the CPU reference" << std::endl;
+            if (num_rois) {
+                std::cout << "info: max absolute difference of the crops against the CPU reference: " << roi_max_diff << std::endl;
+                if (num_mismatched_rois) {
+                    std::cerr << "ERROR: " << num_mismatched_rois << " frames have crops exceeding the tolerance of " << roi_tolerance << "!" << std::endl;
+                    return -1;
+                }
+                std::cout << "info: all the crops match the CPU reference" << std::endl;
+            }
+        }
+    } catch (const std::exception &ex) {
+        std::cout << ex.what() << std::endl;
+        exit(1);
+    }
+
+    return 0;
+}
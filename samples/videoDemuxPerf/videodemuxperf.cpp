@@ -0,0 +1,152 @@
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <string>
+#include <cstring>
+#include <chrono>
+#include <memory>
+#include "video_demuxer.h"
+
+void ShowHelpAndExit(const char *option = NULL) {
+    std::cout << "Options:" << std::endl
+    << "-i Input File Path - required" << std::endl
+    << "-n Number of passes over the input; optional; default: 1" << std::endl
+    << "-mmap demux from the memory mapped input file (excludes the file I/O from the measurement); optional;" << std::endl
+    << "-read_ahead number of packets demuxed ahead in a background thread; optional; default: 0" << std::endl
+    << "-o Output File Path - writes the packets of the first pass as a raw elementary stream (H.264/HEVC Annex-B, AV1 OBU stream in the Section 5"
+    << " format), the input of the videoDecodeRaw sample; the writes are included in the measured time; optional" << std::endl;
+    exit(0);
+}
+
+int main(int argc, char **argv) {
+
+    std::string input_file_path, output_file_path;
+    int num_passes = 1;
+    bool b_use_mmap = false;
+    int read_ahead_depth = 0;
+    // Parse command-line arguments
+    if(argc <= 1) {
+        ShowHelpAndExit();
+    }
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-i")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-i");
+            }
+            input_file_path = argv[i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-n")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-n");
+            }
+            num_passes = atoi(argv[i]);
+            if (num_passes < 1) {
+                ShowHelpAndExit("-n");
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-mmap")) {
+            b_use_mmap = true;
+            continue;
+        }
+        if (!strcmp(argv[i], "-read_ahead")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-read_ahead");
+            }
+            read_ahead_depth = atoi(argv[i]);
+            continue;
+        }
+        if (!strcmp(argv[i], "-o")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-o");
+            }
+            output_file_path = argv[i];
+            continue;
+        }
+        ShowHelpAndExit(argv[i]);
+    }
+
+    uint64_t num_packets = 0, num_key_frames = 0, total_bytes = 0;
+    size_t min_packet_size = SIZE_MAX, max_packet_size = 0;
+    double total_demux_time = 0;
+    std::ofstream es_file;
+    if (!output_file_path.empty()) {
+        es_file.open(output_file_path, std::ios::out | std::ios::binary);
+        if (!es_file) {
+            std::cerr << "ERROR: failed to open " << output_file_path << std::endl;
+            return 1;
+        }
+    }
+    for (int pass = 0; pass < num_passes; pass++) {
+        std::unique_ptr<VideoDemuxer> demuxer(b_use_mmap ? new VideoDemuxer(input_file_path.c_str(), true) : new VideoDemuxer(input_file_path.c_str()));
+        demuxer->SetReadAheadDepth(read_ahead_depth);
+        bool b_write_es = es_file.is_open() && pass == 0;
+        bool b_av1 = demuxer->GetCodecID() == AV_CODEC_ID_AV1;
+        PacketSpan packet;
+        auto start_time = std::chrono::high_resolution_clock::now();
+        // the packet stays valid until the next Demux call: it is only measured, or written out with -o
+        while (demuxer->Demux(packet)) {
+            num_packets++;
+            num_key_frames += packet.is_key_frame ? 1 : 0;
+            total_bytes += packet.size;
+            min_packet_size = std::min(min_packet_size, packet.size);
+            max_packet_size = std::max(max_packet_size, packet.size);
+            if (b_write_es) {
+                // the AV1 samples of MP4/MKV files don't carry the temporal delimiter that starts a Section 5 temporal unit
+                static const char temporal_delimiter[2] = {0x12, 0x00};
+                if (b_av1 && (packet.size == 0 || ((packet.data[0] >> 3) & 0xF) != 2)) {
+                    es_file.write(temporal_delimiter, sizeof(temporal_delimiter));
+                }
+                es_file.write(reinterpret_cast<const char *>(packet.data), packet.size);
+            }
+        }
+        auto end_time = std::chrono::high_resolution_clock::now();
+        total_demux_time += std::chrono::duration<double, std::milli>(end_time - start_time).count();
+    }
+    if (!num_packets) {
+        std::cerr << "ERROR: no packets demuxed from " << input_file_path << std::endl;
+        return 1;
+    }
+    if (es_file.is_open()) {
+        es_file.close();
+        if (!es_file) {
+            std::cerr << "ERROR: failed to write " << output_file_path << std::endl;
+            return 1;
+        }
+        std::cout << "info: saved the elementary stream into " << output_file_path << std::endl;
+    }
+
+    std::cout << "info: Total packets demuxed: " << num_packets << " (" << num_key_frames << " key frames) in " << num_passes << " pass(es)" << std::endl;
+    std::cout << "info: packet size (bytes): min " << min_packet_size << " / avg " << total_bytes / num_packets << " / max " << max_packet_size << std::endl;
+    std::cout << "info: avg demux time per packet (us): " << std::fixed << std::setprecision(3) << total_demux_time * 1000 / num_packets << std::endl;
+    std::cout << "info: packets/sec: " << std::setprecision(1) << num_packets / total_demux_time * 1000 << std::endl;
+    std::cout << "info: MB/sec: " << std::setprecision(1) << total_bytes / total_demux_time / 1000 << std::endl;
+
+    return 0;
+}
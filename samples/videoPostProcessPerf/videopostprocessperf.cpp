@@ -0,0 +1,473 @@
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstring>
+#include <vector>
+#include <map>
+#include <functional>
+#include <algorithm>
+#include "colorspace_kernels.h"
+#include "resize_kernels.h"
+#include "tensor_kernels.h"
+#include "roc_video_dec.h"      // for HIP_API_CALL
+
+void ShowHelpAndExit(const char *option = NULL) {
+    std::cout << "Options:" << std::endl
+    << "-d GPU device ID (0 for the first device, 1 for the second, etc.); optional; default: 0" << std::endl
+    << "-resolution WxH[,WxH...] - sizes of the synthetic decoded surfaces; optional; default: 854x480,1280x720,1920x1080,2560x1440,3840x2160,7680x4320" << std::endl
+    << "-n Number of timed launches per measurement; optional; default: 100" << std::endl
+    << "-filter Only benchmark the entry points whose name contains this string (e.g. Nv12, Resize, Planar); optional; default: all" << std::endl
+    << "-o Output file of the results: JSON if the name ends with .json, CSV otherwise; optional" << std::endl
+    << "-baseline CSV results of a previous run (-o); the bandwidth of each measurement is compared with it; optional" << std::endl
+    << "-tolerance Bandwidth drop in percent reported as a regression with -baseline; optional; default: 10" << std::endl
+    << "-peak_bw Peak memory bandwidth in GB/s used for the efficiency; optional; default: computed from the device properties" << std::endl;
+    exit(0);
+}
+
+typedef enum SurfaceType_ {
+    SurfaceType_NV12 = 0,
+    SurfaceType_P016 = 1,
+    SurfaceType_YUV444 = 2,
+    SurfaceType_YUV444P16 = 3,
+} SurfaceType;
+
+typedef void (*ColorConvertFunc)(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgb, int rgb_pitch, int width, int height, int v_pitch,
+                                 const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+
+/**
+ * @brief One exported color conversion instantiation of colorspace_kernels.cpp
+ */
+struct ColorConvertEntry {
+    const char *name;
+    ColorConvertFunc func;
+    SurfaceType surface_type;
+    int rgb_bytes_per_pixel;    // bytes written per pixel (3 for the planar outputs)
+    bool planar;
+};
+
+static const std::vector<ColorConvertEntry> color_convert_entries = {
+    {"Nv12ToColor24<BGR24>", Nv12ToColor24<BGR24>, SurfaceType_NV12, 3, false},
+    {"Nv12ToColor24<RGB24>", Nv12ToColor24<RGB24>, SurfaceType_NV12, 3, false},
+    {"Nv12ToColor32<BGRA32>", Nv12ToColor32<BGRA32>, SurfaceType_NV12, 4, false},
+    {"Nv12ToColor32<RGBA32>", Nv12ToColor32<RGBA32>, SurfaceType_NV12, 4, false},
+    {"Nv12ToColor48<BGR48>", Nv12ToColor48<BGR48>, SurfaceType_NV12, 6, false},
+    {"Nv12ToColor48<RGB48>", Nv12ToColor48<RGB48>, SurfaceType_NV12, 6, false},
+    {"Nv12ToColor64<BGRA64>", Nv12ToColor64<BGRA64>, SurfaceType_NV12, 8, false},
+    {"Nv12ToColor64<RGBA64>", Nv12ToColor64<RGBA64>, SurfaceType_NV12, 8, false},
+    {"Nv12ToColorPlanar<BGRA32>", Nv12ToColorPlanar<BGRA32>, SurfaceType_NV12, 3, true},
+    {"Nv12ToColorPlanar<RGBA32>", Nv12ToColorPlanar<RGBA32>, SurfaceType_NV12, 3, true},
+    {"P016ToColor24<BGR24>", P016ToColor24<BGR24>, SurfaceType_P016, 3, false},
+    {"P016ToColor24<RGB24>", P016ToColor24<RGB24>, SurfaceType_P016, 3, false},
+    {"P016ToColor32<BGRA32>", P016ToColor32<BGRA32>, SurfaceType_P016, 4, false},
+    {"P016ToColor32<RGBA32>", P016ToColor32<RGBA32>, SurfaceType_P016, 4, false},
+    {"P016ToColor48<BGR48>", P016ToColor48<BGR48>, SurfaceType_P016, 6, false},
+    {"P016ToColor48<RGB48>", P016ToColor48<RGB48>, SurfaceType_P016, 6, false},
+    {"P016ToColor64<BGRA64>", P016ToColor64<BGRA64>, SurfaceType_P016, 8, false},
+    {"P016ToColor64<RGBA64>", P016ToColor64<RGBA64>, SurfaceType_P016, 8, false},
+    {"P016ToColorPlanar<BGRA32>", P016ToColorPlanar<BGRA32>, SurfaceType_P016, 3, true},
+    {"P016ToColorPlanar<RGBA32>", P016ToColorPlanar<RGBA32>, SurfaceType_P016, 3, true},
+    {"YUV444ToColor24<BGR24>", YUV444ToColor24<BGR24>, SurfaceType_YUV444, 3, false},
+    {"YUV444ToColor24<RGB24>", YUV444ToColor24<RGB24>, SurfaceType_YUV444, 3, false},
+    {"YUV444ToColor32<BGRA32>", YUV444ToColor32<BGRA32>, SurfaceType_YUV444, 4, false},
+    {"YUV444ToColor32<RGBA32>", YUV444ToColor32<RGBA32>, SurfaceType_YUV444, 4, false},
+    {"YUV444ToColor48<BGR48>", YUV444ToColor48<BGR48>, SurfaceType_YUV444, 6, false},
+    {"YUV444ToColor48<RGB48>", YUV444ToColor48<RGB48>, SurfaceType_YUV444, 6, false},
+    {"YUV444ToColor64<BGRA64>", YUV444ToColor64<BGRA64>, SurfaceType_YUV444, 8, false},
+    {"YUV444ToColor64<RGBA64>", YUV444ToColor64<RGBA64>, SurfaceType_YUV444, 8, false},
+    {"YUV444ToColorPlanar<BGRA32>", YUV444ToColorPlanar<BGRA32>, SurfaceType_YUV444, 3, true},
+    {"YUV444ToColorPlanar<RGBA32>", YUV444ToColorPlanar<RGBA32>, SurfaceType_YUV444, 3, true},
+    {"YUV444P16ToColor24<BGR24>", YUV444P16ToColor24<BGR24>, SurfaceType_YUV444P16, 3, false},
+    {"YUV444P16ToColor24<RGB24>", YUV444P16ToColor24<RGB24>, SurfaceType_YUV444P16, 3, false},
+    {"YUV444P16ToColor32<BGRA32>", YUV444P16ToColor32<BGRA32>, SurfaceType_YUV444P16, 4, false},
+    {"YUV444P16ToColor32<RGBA32>", YUV444P16ToColor32<RGBA32>, SurfaceType_YUV444P16, 4, false},
+    {"YUV444P16ToColor48<BGR48>", YUV444P16ToColor48<BGR48>, SurfaceType_YUV444P16, 6, false},
+    {"YUV444P16ToColor48<RGB48>", YUV444P16ToColor48<RGB48>, SurfaceType_YUV444P16, 6, false},
+    {"YUV444P16ToColor64<BGRA64>", YUV444P16ToColor64<BGRA64>, SurfaceType_YUV444P16, 8, false},
+    {"YUV444P16ToColor64<RGBA64>", YUV444P16ToColor64<RGBA64>, SurfaceType_YUV444P16, 8, false},
+    {"YUV444P16ToColorPlanar<BGRA32>", YUV444P16ToColorPlanar<BGRA32>, SurfaceType_YUV444P16, 3, true},
+    {"YUV444P16ToColorPlanar<RGBA32>", YUV444P16ToColorPlanar<RGBA32>, SurfaceType_YUV444P16, 3, true},
+};
+
+static const char *surface_type_names[] = {"NV12", "P016", "YUV444", "YUV444P16"};
+
+// scale factors of the resize benchmarks, applied to both dimensions of the source surface
+static const std::vector<float> resize_factors = {0.25f, 0.5f, 0.75f, 1.5f};
+
+/**
+ * @brief One measurement; the bytes are the minimum traffic of one launch: the source surface read once plus the destination written once
+ */
+struct BenchResult {
+    std::string entry_point;
+    std::string variant;
+    int src_width, src_height;
+    int dst_width, dst_height;
+    double time_us;
+    double bytes;
+    double GetBandwidth() const { return bytes / time_us / 1e3; }   // GB/s
+};
+
+static std::string GetResultKey(const std::string &entry_point, const std::string &variant, int src_width, int src_height, int dst_width, int dst_height) {
+    std::ostringstream key;
+    key << entry_point << "," << variant << "," << src_width << "," << src_height << "," << dst_width << "," << dst_height;
+    return key.str();
+}
+
+/**
+ * @brief Returns the average time in us of one launch, over num_iterations back to back launches on the stream
+ */
+static double TimeLaunch(const std::function<void(hipStream_t)> &launch, int num_iterations, hipStream_t stream) {
+    hipEvent_t start, stop;
+    HIP_API_CALL(hipEventCreate(&start));
+    HIP_API_CALL(hipEventCreate(&stop));
+    launch(stream);     // warm up
+    HIP_API_CALL(hipEventRecord(start, stream));
+    for (int i = 0; i < num_iterations; i++) {
+        launch(stream);
+    }
+    HIP_API_CALL(hipEventRecord(stop, stream));
+    HIP_API_CALL(hipEventSynchronize(stop));
+    float time_ms = 0;
+    HIP_API_CALL(hipEventElapsedTime(&time_ms, start, stop));
+    HIP_API_CALL(hipEventDestroy(start));
+    HIP_API_CALL(hipEventDestroy(stop));
+    return time_ms * 1e3 / num_iterations;
+}
+
+static void PrintResult(const BenchResult &result, double peak_bw) {
+    std::ostringstream dst_size;
+    dst_size << result.dst_width << "x" << result.dst_height;
+    std::cout << std::left << std::setw(32) << result.entry_point << std::setw(8) << result.variant << std::setw(12) << dst_size.str() << std::right
+              << std::fixed << std::setprecision(1) << std::setw(12) << result.time_us << std::setw(10) << 1e6 / result.time_us
+              << std::setw(10) << result.GetBandwidth();
+    if (peak_bw > 0) {
+        std::cout << std::setw(9) << 100.0 * result.GetBandwidth() / peak_bw << "%";
+    }
+    std::cout << std::endl;
+}
+
+static bool WriteResults(const std::string &file_path, const std::vector<BenchResult> &results, const std::string &arch, double peak_bw) {
+    std::ofstream fp_out(file_path);
+    if (!fp_out.is_open()) {
+        std::cerr << "ERROR: failed to open " << file_path << std::endl;
+        return false;
+    }
+    bool json = file_path.size() >= 5 && file_path.compare(file_path.size() - 5, 5, ".json") == 0;
+    fp_out << std::fixed << std::setprecision(3);
+    if (json) {
+        fp_out << "{" << std::endl << "  \"arch\": \"" << arch << "\"," << std::endl << "  \"peak_bandwidth_gbps\": " << peak_bw << "," << std::endl
+               << "  \"results\": [" << std::endl;
+    } else {
+        fp_out << "arch,entry_point,variant,src_width,src_height,dst_width,dst_height,time_us,frames_per_sec,bytes_per_frame,bandwidth_gbps,efficiency_pct" << std::endl;
+    }
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult &r = results[i];
+        double efficiency = peak_bw > 0 ? 100.0 * r.GetBandwidth() / peak_bw : 0;
+        if (json) {
+            fp_out << "    {\"entry_point\": \"" << r.entry_point << "\", \"variant\": \"" << r.variant << "\", \"src_width\": " << r.src_width
+                   << ", \"src_height\": " << r.src_height << ", \"dst_width\": " << r.dst_width << ", \"dst_height\": " << r.dst_height
+                   << ", \"time_us\": " << r.time_us << ", \"frames_per_sec\": " << 1e6 / r.time_us << ", \"bytes_per_frame\": " << std::setprecision(0)
+                   << r.bytes << std::setprecision(3) << ", \"bandwidth_gbps\": " << r.GetBandwidth() << ", \"efficiency_pct\": " << efficiency << "}"
+                   << (i + 1 < results.size() ? "," : "") << std::endl;
+        } else {
+            fp_out << arch << "," << GetResultKey(r.entry_point, r.variant, r.src_width, r.src_height, r.dst_width, r.dst_height) << "," << r.time_us << ","
+                   << 1e6 / r.time_us << "," << std::setprecision(0) << r.bytes << std::setprecision(3) << "," << r.GetBandwidth() << "," << efficiency << std::endl;
+        }
+    }
+    if (json) {
+        fp_out << "  ]" << std::endl << "}" << std::endl;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads the bandwidth of each measurement of a CSV file written by WriteResults
+ */
+static bool ReadBaseline(const std::string &file_path, std::map<std::string, double> &baseline) {
+    std::ifstream fp_in(file_path);
+    if (!fp_in.is_open()) {
+        std::cerr << "ERROR: failed to open " << file_path << std::endl;
+        return false;
+    }
+    std::string line;
+    std::getline(fp_in, line);      // header
+    while (std::getline(fp_in, line)) {
+        std::vector<std::string> fields;
+        std::istringstream line_stream(line);
+        std::string field;
+        while (std::getline(line_stream, field, ',')) {
+            fields.push_back(field);
+        }
+        if (fields.size() < 12) {
+            continue;
+        }
+        baseline[GetResultKey(fields[1], fields[2], std::stoi(fields[3]), std::stoi(fields[4]), std::stoi(fields[5]), std::stoi(fields[6]))] = std::stod(fields[10]);
+    }
+    return true;
+}
+
+int main(int argc, char **argv) {
+    int device_id = 0;
+    std::vector<std::pair<int, int>> resolutions = {{854, 480}, {1280, 720}, {1920, 1080}, {2560, 1440}, {3840, 2160}, {7680, 4320}};
+    int num_iterations = 100;
+    std::string filter, output_file_path, baseline_file_path;
+    double tolerance = 10.0;
+    double peak_bw = 0;
+
+    // Parse command-line arguments
+    for (int i = 1; i < argc; i++) {
+        if (!strcmp(argv[i], "-h")) {
+            ShowHelpAndExit();
+        }
+        if (!strcmp(argv[i], "-d")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-d");
+            }
+            device_id = atoi(argv[i]);
+            continue;
+        }
+        if (!strcmp(argv[i], "-resolution")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-resolution");
+            }
+            resolutions.clear();
+            std::istringstream resolution_list(argv[i]);
+            std::string resolution;
+            while (std::getline(resolution_list, resolution, ',')) {
+                int width = 0, height = 0;
+                if (sscanf(resolution.c_str(), "%dx%d", &width, &height) != 2 || width < 2 || height < 2) {
+                    ShowHelpAndExit("-resolution");
+                }
+                resolutions.push_back(std::make_pair(width, height));
+            }
+            if (resolutions.empty()) {
+                ShowHelpAndExit("-resolution");
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-n")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-n");
+            }
+            num_iterations = atoi(argv[i]);
+            if (num_iterations < 1) {
+                ShowHelpAndExit("-n");
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-filter")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-filter");
+            }
+            filter = argv[i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-o")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-o");
+            }
+            output_file_path = argv[i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-baseline")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-baseline");
+            }
+            baseline_file_path = argv[i];
+            continue;
+        }
+        if (!strcmp(argv[i], "-tolerance")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-tolerance");
+            }
+            tolerance = atof(argv[i]);
+            if (tolerance < 0) {
+                ShowHelpAndExit("-tolerance");
+            }
+            continue;
+        }
+        if (!strcmp(argv[i], "-peak_bw")) {
+            if (++i == argc) {
+                ShowHelpAndExit("-peak_bw");
+            }
+            peak_bw = atof(argv[i]);
+            if (peak_bw <= 0) {
+                ShowHelpAndExit("-peak_bw");
+            }
+            continue;
+        }
+        ShowHelpAndExit(argv[i]);
+    }
+
+    std::map<std::string, double> baseline;
+    if (!baseline_file_path.empty() && !ReadBaseline(baseline_file_path, baseline)) {
+        return 1;
+    }
+
+    HIP_API_CALL(hipSetDevice(device_id));
+    hipDeviceProp_t hip_dev_prop;
+    HIP_API_CALL(hipGetDeviceProperties(&hip_dev_prop, device_id));
+    if (peak_bw == 0) {
+        // memoryClockRate is in kHz; two transfers per clock
+        peak_bw = 2.0 * hip_dev_prop.memoryClockRate * 1e3 * (hip_dev_prop.memoryBusWidth / 8) / 1e9;
+    }
+    std::string arch = hip_dev_prop.gcnArchName;
+    arch = arch.substr(0, arch.find(':'));
+    hipStream_t stream;
+    HIP_API_CALL(hipStreamCreate(&stream));
+    ColorSpaceInfo color_info(ColorSpaceStandard_BT709);
+
+    std::cout << "info: device " << device_id << ": " << hip_dev_prop.name << " (" << arch << "), peak memory bandwidth " << std::fixed
+              << std::setprecision(1) << peak_bw << " GB/s, " << num_iterations << " launches per measurement" << std::endl;
+    std::vector<BenchResult> results;
+    for (const std::pair<int, int> &resolution : resolutions) {
+        int width = resolution.first, height = resolution.second;
+        // synthetic decoded surfaces: 256-byte aligned pitch and 16-line aligned vertical stride, sized for the largest (YUV444P16) surface
+        int pitch_8bit = (width + 255) & ~255, pitch_16bit = (width * 2 + 255) & ~255;
+        int v_pitch = (height + 15) & ~15;
+        size_t src_size = static_cast<size_t>(pitch_16bit) * v_pitch * 3;
+        int rgb_width = (width + 1) & ~1;       // the kernels process pixel pairs
+        size_t dst_size = static_cast<size_t>(rgb_width) * 12 * height;    // FP32 planar output
+        int max_resize_width = static_cast<int>(width * resize_factors.back()) + 2, max_resize_height = static_cast<int>(height * resize_factors.back()) + 2;
+        dst_size = std::max(dst_size, static_cast<size_t>(max_resize_width) * 2 * max_resize_height * 3 / 2);
+        uint8_t *p_src = nullptr, *p_dst = nullptr;
+        HIP_API_CALL(hipMalloc(&p_src, src_size));
+        HIP_API_CALL(hipMalloc(&p_dst, dst_size));
+        HIP_API_CALL(hipMemset(p_src, 0x80, src_size));
+
+        std::cout << std::endl << "info: " << width << "x" << height << " source surfaces" << std::endl;
+        std::cout << std::left << std::setw(32) << "entry point" << std::setw(8) << "kernel" << std::setw(12) << "output" << std::right << std::setw(12)
+                  << "time (us)" << std::setw(10) << "fps" << std::setw(10) << "GB/s" << std::setw(10) << "eff" << std::endl;
+        auto add_result = [&](const std::string &entry_point, const std::string &variant, int dst_width, int dst_height, double bytes,
+                              const std::function<void(hipStream_t)> &launch) {
+            BenchResult result = {entry_point, variant, width, height, dst_width, dst_height, TimeLaunch(launch, num_iterations, stream), bytes};
+            PrintResult(result, peak_bw);
+            results.push_back(result);
+        };
+
+        for (const ColorConvertEntry &entry : color_convert_entries) {
+            if (!filter.empty() && std::string(entry.name).find(filter) == std::string::npos) {
+                continue;
+            }
+            bool is_16bit = entry.surface_type == SurfaceType_P016 || entry.surface_type == SurfaceType_YUV444P16;
+            bool is_444 = entry.surface_type == SurfaceType_YUV444 || entry.surface_type == SurfaceType_YUV444P16;
+            int pitch = is_16bit ? pitch_16bit : pitch_8bit;
+            int rgb_pitch = entry.planar ? rgb_width : rgb_width * entry.rgb_bytes_per_pixel;
+            double bytes = static_cast<double>(width) * height * (is_444 ? 3 : 1.5) * (is_16bit ? 2 : 1) + static_cast<double>(rgb_width) * entry.rgb_bytes_per_pixel * height;
+            auto launch = [&](hipStream_t hip_stream) {
+                entry.func(p_src, pitch, p_dst, rgb_pitch, width, height, v_pitch, color_info, hip_stream);
+            };
+            if (!is_444 && !entry.planar) {
+                // the NV12/P016 packed conversions have two kernel variants
+                SetColorConvertKernel(ColorConvertKernel_Pixel2x2);
+                add_result(entry.name, "2x2", width, height, bytes, launch);
+                SetColorConvertKernel(ColorConvertKernel_Tiled);
+                add_result(entry.name, "tiled", width, height, bytes, launch);
+            } else {
+                add_result(entry.name, "-", width, height, bytes, launch);
+            }
+        }
+
+        // floating point planar outputs of the same size
+        const std::pair<TensorDataType, const char *> tensor_types[] = {{TensorDataType_FP32, "FP32"}, {TensorDataType_FP16, "FP16"}, {TensorDataType_BF16, "BF16"}};
+        for (int surface_type = SurfaceType_NV12; surface_type <= SurfaceType_YUV444P16; surface_type++) {
+            for (const auto &tensor_type : tensor_types) {
+                std::string name = std::string("YuvToPlanarTensor<") + surface_type_names[surface_type] + "," + tensor_type.second + ">";
+                if (!filter.empty() && name.find(filter) == std::string::npos) {
+                    continue;
+                }
+                bool is_16bit = surface_type == SurfaceType_P016 || surface_type == SurfaceType_YUV444P16;
+                bool is_444 = surface_type == SurfaceType_YUV444 || surface_type == SurfaceType_YUV444P16;
+                int pitch = is_16bit ? pitch_16bit : pitch_8bit;
+                double bytes = static_cast<double>(width) * height * (is_444 ? 3 : 1.5) * (is_16bit ? 2 : 1) +
+                               static_cast<double>(width) * height * 3 * (tensor_type.first == TensorDataType_FP32 ? 4 : 2);
+                TensorScaleBias scale_bias;
+                add_result(name, "-", width, height, bytes, [&](hipStream_t hip_stream) {
+                    YuvToPlanarTensor(p_src, pitch, width, height, v_pitch, is_16bit, is_444, p_dst, tensor_type.first, false, scale_bias, color_info, hip_stream);
+                });
+            }
+        }
+
+        for (float factor : resize_factors) {
+            int dst_width = std::max(2, static_cast<int>(width * factor) & ~1), dst_height = std::max(2, static_cast<int>(height * factor) & ~1);
+            double src_bytes = static_cast<double>(width) * height * 3 / 2, dst_bytes = static_cast<double>(dst_width) * dst_height * 3 / 2;
+            if (filter.empty() || std::string("ResizeNv12").find(filter) != std::string::npos) {
+                add_result("ResizeNv12", "-", dst_width, dst_height, src_bytes + dst_bytes, [&](hipStream_t hip_stream) {
+                    ResizeNv12(p_dst, dst_width, dst_width, dst_height, p_src, pitch_8bit, width, height, p_src + static_cast<size_t>(pitch_8bit) * v_pitch,
+                               p_dst + static_cast<size_t>(dst_width) * dst_height, hip_stream);
+                });
+            }
+            if (filter.empty() || std::string("ResizeP016").find(filter) != std::string::npos) {
+                add_result("ResizeP016", "-", dst_width, dst_height, 2 * (src_bytes + dst_bytes), [&](hipStream_t hip_stream) {
+                    ResizeP016(p_dst, dst_width * 2, dst_width, dst_height, p_src, pitch_16bit, width, height, p_src + static_cast<size_t>(pitch_16bit) * v_pitch,
+                               p_dst + static_cast<size_t>(dst_width) * 2 * dst_height, hip_stream);
+                });
+            }
+            if (filter.empty() || std::string("ResizeYUV420").find(filter) != std::string::npos) {
+                // I420 source: the U and V planes of pitch_8bit / 2 bytes follow the luma plane
+                uint8_t *p_src_u = p_src + static_cast<size_t>(pitch_8bit) * v_pitch, *p_src_v = p_src_u + static_cast<size_t>(pitch_8bit / 2) * (v_pitch / 2);
+                uint8_t *p_dst_u = p_dst + static_cast<size_t>(dst_width) * dst_height, *p_dst_v = p_dst_u + static_cast<size_t>(dst_width / 2) * (dst_height / 2);
+                add_result("ResizeYUV420", "-", dst_width, dst_height, src_bytes + dst_bytes, [&](hipStream_t hip_stream) {
+                    ResizeYUV420(p_dst, p_dst_u, p_dst_v, dst_width, dst_width / 2, dst_width, dst_height, p_src, p_src_u, p_src_v, pitch_8bit, pitch_8bit / 2,
+                                 width, height, false, hip_stream);
+                });
+            }
+        }
+        HIP_API_CALL(hipFree(p_src));
+        HIP_API_CALL(hipFree(p_dst));
+    }
+    HIP_API_CALL(hipStreamDestroy(stream));
+
+    if (!output_file_path.empty()) {
+        if (!WriteResults(output_file_path, results, arch, peak_bw)) {
+            return 1;
+        }
+        std::cout << std::endl << "info: results written to " << output_file_path << std::endl;
+    }
+    int num_regressions = 0, num_compared = 0;
+    if (!baseline.empty()) {
+        std::cout << std::endl;
+        for (const BenchResult &r : results) {
+            auto it = baseline.find(GetResultKey(r.entry_point, r.variant, r.src_width, r.src_height, r.dst_width, r.dst_height));
+            if (it == baseline.end() || it->second <= 0) {
+                continue;
+            }
+            num_compared++;
+            double change = 100.0 * (r.GetBandwidth() - it->second) / it->second;
+            if (change < -tolerance) {
+                num_regressions++;
+                std::cout << "REGRESSION: " << r.entry_point << " " << r.variant << " " << r.src_width << "x" << r.src_height << " -> " << r.dst_width << "x"
+                          << r.dst_height << ": " << std::setprecision(1) << r.GetBandwidth() << " GB/s, baseline " << it->second << " GB/s ("
+                          << change << "%)" << std::endl;
+            }
+        }
+        std::cout << "info: " << num_compared << " measurements compared with " << baseline_file_path << ", " << num_regressions
+                  << " regressions beyond " << tolerance << "%" << std::endl;
+    }
+    return num_regressions ? 1 : 0;
+}
@@ -25,6 +25,13 @@ THE SOFTWARE.
 
 Av1VideoParser::Av1VideoParser() {
     seen_frame_header_ = 0;
+    temporal_id_ = 0;
+    spatial_id_ = 0;
+    operating_point_ = 0;
+    operating_point_idc_ = 0;
+    output_all_layers_ = false;
+    temporal_unit_end_ = 0;
+    frame_unit_end_ = 0;
     tile_param_list_.assign(INIT_SLICE_LIST_NUM, {0});
     memset(&curr_pic_, 0, sizeof(Av1Picture));
     memset(&dpb_buffer_, 0, sizeof(DecodedPictureBuffer));
@@ -57,6 +64,7 @@ rocDecStatus Av1VideoParser::UnInitialize() {
 rocDecStatus Av1VideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) { 
     if (p_data->payload && p_data->payload_size) {
         curr_pts_ = p_data->pts;
+        end_of_picture_ = (p_data->flags & ROCDEC_PKT_ENDOFPICTURE) != 0;
         if (ParsePictureData(p_data->payload, p_data->payload_size) != PARSER_OK) {
             ERR(STR("Parser failed!"));
             return ROCDEC_RUNTIME_ERROR;
@@ -73,13 +81,106 @@ rocDecStatus Av1VideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) {
     return ROCDEC_SUCCESS;
 }
 
+ParserResult Av1VideoParser::FindAccessUnitEnd(int *p_au_end) {
+    const uint8_t *p_buf = stream_buf_.data();
+    if (parser_params_.annex_b) {
+        // stream_scan_offset_ is at the temporal_unit_size of the next temporal unit, which is complete after that many bytes
+        int pos = stream_scan_offset_;
+        uint64_t temporal_unit_size = 0;
+        int i;
+        for (i = 0; i < 8; i++) {
+            if (pos + i >= stream_write_offset_) {
+                return PARSER_NOT_FOUND;
+            }
+            uint8_t leb128_byte = p_buf[pos + i];
+            temporal_unit_size |= static_cast<uint64_t>(leb128_byte & 0x7F) << (i * 7);
+            if (!(leb128_byte & 0x80)) {
+                break;
+            }
+        }
+        if (i == 8 || temporal_unit_size > static_cast<uint64_t>(INT32_MAX - pos - i - 1)) {
+            ERR("Invalid temporal unit size.");
+            return PARSER_INVALID_ARG;
+        }
+        int temporal_unit_end = pos + i + 1 + static_cast<int>(temporal_unit_size);
+        if (temporal_unit_end > stream_write_offset_) {
+            return PARSER_NOT_FOUND;
+        }
+        // The frame units must fill the temporal unit, and the OBUs their frame unit
+        uint32_t bytes_read;
+        for (pos += i + 1; pos < temporal_unit_end;) {
+            uint64_t frame_unit_size = ReadLeb128(p_buf + pos, temporal_unit_end - pos, &bytes_read);
+            pos += bytes_read;
+            if (bytes_read == 0 || frame_unit_size > static_cast<uint64_t>(temporal_unit_end - pos)) {
+                ERR("Frame unit size error.");
+                return PARSER_INVALID_ARG;
+            }
+            int frame_unit_end = pos + static_cast<int>(frame_unit_size);
+            while (pos < frame_unit_end) {
+                uint64_t obu_length = ReadLeb128(p_buf + pos, frame_unit_end - pos, &bytes_read);
+                pos += bytes_read;
+                if (bytes_read == 0 || obu_length == 0 || obu_length > static_cast<uint64_t>(frame_unit_end - pos)) {
+                    ERR("OBU length error.");
+                    return PARSER_INVALID_ARG;
+                }
+                pos += static_cast<int>(obu_length);
+            }
+        }
+        stream_scan_offset_ = temporal_unit_end;
+        *p_au_end = temporal_unit_end;
+        return PARSER_OK;
+    }
+    // stream_scan_offset_ is always at an OBU header. It can be beyond the buffered data while an OBU is incomplete.
+    while (stream_scan_offset_ < stream_write_offset_) {
+        int pos = stream_scan_offset_;
+        uint32_t obu_type = (p_buf[pos] >> 3) & 0x0F;
+        uint32_t obu_extension_flag = (p_buf[pos] >> 2) & 1;
+        uint32_t obu_has_size_field = (p_buf[pos] >> 1) & 1;
+        if (obu_type == kObuTemporalDelimiter && pos > stream_read_offset_) {
+            *p_au_end = pos;
+            return PARSER_OK;
+        }
+        if (!obu_has_size_field) {
+            ERR("OBUs without obu_size are not supported in byte stream mode.");
+            return PARSER_INVALID_FORMAT;
+        }
+        int header_size = 1 + obu_extension_flag;
+        uint64_t obu_size = 0;
+        int i;
+        for (i = 0; i < 8; i++) {
+            if (pos + header_size + i >= stream_write_offset_) {
+                return PARSER_NOT_FOUND;
+            }
+            uint8_t leb128_byte = p_buf[pos + header_size + i];
+            obu_size |= static_cast<uint64_t>(leb128_byte & 0x7F) << (i * 7);
+            if (!(leb128_byte & 0x80)) {
+                break;
+            }
+        }
+        if (i == 8 || obu_size > static_cast<uint64_t>(INT32_MAX - pos - header_size - i - 1)) {
+            ERR("Invalid OBU size.");
+            return PARSER_INVALID_FORMAT;
+        }
+        stream_scan_offset_ = pos + header_size + i + 1 + static_cast<int>(obu_size);
+    }
+    return PARSER_NOT_FOUND;
+}
+
 ParserResult Av1VideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t pic_data_size) {
     ParserResult ret = PARSER_OK;
     pic_data_buffer_ptr_ = (uint8_t*)p_stream;
     pic_data_size_ = pic_data_size;
     curr_byte_offset_ = 0;
+    temporal_unit_end_ = 0;
+    frame_unit_end_ = 0;
 
-    while (ReadObuHeaderAndSize() != PARSER_EOF) {
+    while ((ret = ReadObuHeaderAndSize()) != PARSER_EOF) {
+        if (ret != PARSER_OK) {
+            return ret;
+        }
+        if (IsObuDropped()) {
+            continue;
+        }
         switch (obu_header_.obu_type) {
             case kObuTemporalDelimiter: {
                 seen_frame_header_ = 0;
@@ -87,6 +188,9 @@ ParserResult Av1VideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
             }
             case kObuSequenceHeader: {
                 ParseSequenceHeaderObu(pic_data_buffer_ptr_ + obu_byte_offset_, obu_size_);
+                if ((ret = ChooseOperatingPoint()) != PARSER_OK) {
+                    return ret;
+                }
                 break;
             }
             case kObuFrameHeader: {
@@ -119,7 +223,9 @@ ParserResult Av1VideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
                 obu_byte_offset_ += bytes_parsed;
                 if (obu_size_ > bytes_parsed) {
                     obu_size_ -= bytes_parsed;
-                    ParseTileGroupObu(pic_data_buffer_ptr_ + obu_byte_offset_, obu_size_);
+                    if ((ret = ParseTileGroupObu(pic_data_buffer_ptr_ + obu_byte_offset_, obu_size_)) != PARSER_OK) {
+                        return ret;
+                    }
                 } else {
                     ERR("Frame OBU size error.");
                     return PARSER_OUT_OF_RANGE;
@@ -127,7 +233,9 @@ ParserResult Av1VideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
                 break;
             }
             case kObuTileGroup: {
-                ParseTileGroupObu(pic_data_buffer_ptr_ + obu_byte_offset_, obu_size_);
+                if ((ret = ParseTileGroupObu(pic_data_buffer_ptr_ + obu_byte_offset_, obu_size_)) != PARSER_OK) {
+                    return ret;
+                }
                 break;
             }
             default:
@@ -149,7 +257,7 @@ ParserResult Av1VideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
                 ERR("Invalid existing frame index to show.");
                 return PARSER_INVALID_ARG;
             }
-            if (pfn_display_picture_cb_) {
+            if (pfn_display_picture_cb_ && IsFrameOutput()) {
                 if (seq_header_.film_grain_params_present && frame_header_.film_grain_params.apply_grain) {
                     disp_idx = dpb_buffer_.frame_store[disp_idx].fg_buf_idx;
                 } else {
@@ -231,6 +339,11 @@ ParserResult Av1VideoParser::NotifyNewSequence(Av1SequenceHeader *p_seq_header,
     video_format_params_.display_aspect_ratio.y = disp_height / gcd;
 
     video_format_params_.video_signal_description = {0};
+    video_format_params_.video_signal_description.video_format = 5;  // unspecified
+    video_format_params_.video_signal_description.video_full_range_flag = p_seq_header->color_config.color_range;
+    video_format_params_.video_signal_description.color_primaries = p_seq_header->color_config.color_primaries;
+    video_format_params_.video_signal_description.transfer_characteristics = p_seq_header->color_config.transfer_characteristics;
+    video_format_params_.video_signal_description.matrix_coefficients = p_seq_header->color_config.matrix_coefficients;
     video_format_params_.seqhdr_data_length = 0;
 
     // callback function with RocdecVideoFormat params filled out
@@ -447,23 +560,7 @@ ParserResult Av1VideoParser::SendPicForDecode() {
         }
     }
 
-    // Set up tile parameter buffers
-    if (tile_group_data_.num_tiles > tile_param_list_.size()) {
-        tile_param_list_.resize(tile_group_data_.num_tiles, {0});
-    }
-    for (i = 0; i < tile_group_data_.num_tiles; i++) {
-        RocdecAv1SliceParams *p_tile_param = &tile_param_list_[i];
-        Av1TileDataInfo *p_tile_info = &tile_group_data_.tile_data_info[i];
-        p_tile_param->slice_data_size = p_tile_info->tile_size;
-        p_tile_param->slice_data_offset = p_tile_info->tile_offset;
-        p_tile_param->slice_data_flag = 0; // VA_SLICE_DATA_FLAG_ALL;
-        p_tile_param->tile_row = p_tile_info->tile_row;
-        p_tile_param->tile_column = p_tile_info->tile_col;
-        p_tile_param->tg_start = tile_group_data_.tg_start;
-        p_tile_param->tg_end = tile_group_data_.tg_end;
-        p_tile_param->anchor_frame_idx = 0; // Todo for large scale tile
-        p_tile_param->tile_idx_in_tile_list = 0; // Todo large scale tile 
-    }
+    // The tile parameters are written by ParseTileGroupObu()
     dec_pic_params_.slice_params.av1 = tile_param_list_.data();
 
 #if DBGINFO
@@ -656,7 +753,7 @@ ParserResult Av1VideoParser::FindFreeInDpbAndMark() {
     dpb_buffer_.frame_store[curr_pic_.pic_idx] = curr_pic_;
     dpb_buffer_.dec_ref_count[curr_pic_.pic_idx]++;
     // Mark as used in decode/display buffer pool
-    if (pfn_display_picture_cb_ && curr_pic_.show_frame) {
+    if (pfn_display_picture_cb_ && curr_pic_.show_frame && IsFrameOutput()) {
         int disp_idx = 0xFF;
         if (seq_header_.film_grain_params_present && frame_header_.film_grain_params.apply_grain) {
             disp_idx = curr_pic_.fg_buf_idx;
@@ -687,17 +784,21 @@ void Av1VideoParser::CheckAndUpdateDecStatus() {
     }
 }
 
-ParserResult Av1VideoParser::ParseObuHeader(const uint8_t *p_stream) {
+ParserResult Av1VideoParser::ParseObuHeader(const uint8_t *p_stream, int size, Av1ObuHeader *p_obu_header) {
     size_t offset = 0;
-    obu_header_.size = 1;
+    if (size < 1 || (size < 2 && (p_stream[0] & 0x04))) {
+        ERR("OBU header size error.");
+        return PARSER_INVALID_ARG;
+    }
+    p_obu_header->size = 1;
     if (Parser::GetBit(p_stream, offset) != 0) {
         ERR("Syntax error: obu_forbidden_bit must be set to 0.");
         return PARSER_INVALID_ARG;
     }
-    obu_header_.obu_type = Parser::ReadBits(p_stream, offset, 4);
-    obu_header_.obu_extension_flag = Parser::GetBit(p_stream, offset);
-    obu_header_.obu_has_size_field = Parser::GetBit(p_stream, offset);
-    if (!obu_header_.obu_has_size_field) {
+    p_obu_header->obu_type = Parser::ReadBits(p_stream, offset, 4);
+    p_obu_header->obu_extension_flag = Parser::GetBit(p_stream, offset);
+    p_obu_header->obu_has_size_field = Parser::GetBit(p_stream, offset);
+    if (!p_obu_header->obu_has_size_field && !parser_params_.annex_b) {
         ERR("Syntax error: Section 5.2: obu_has_size_field must be equal to 1.");
         return PARSER_INVALID_ARG;
     }
@@ -705,37 +806,151 @@ ParserResult Av1VideoParser::ParseObuHeader(const uint8_t *p_stream) {
         ERR("Syntax error: obu_reserved_1bit must be set to 0.");
         return PARSER_INVALID_ARG;
     }
-    if (obu_header_.obu_extension_flag) {
-        obu_header_.size += 1;
-        obu_header_.temporal_id = Parser::ReadBits(p_stream, offset, 3);
-        obu_header_.spatial_id = Parser::ReadBits(p_stream, offset, 2);
+    if (p_obu_header->obu_extension_flag) {
+        p_obu_header->size += 1;
+        p_obu_header->temporal_id = Parser::ReadBits(p_stream, offset, 3);
+        p_obu_header->spatial_id = Parser::ReadBits(p_stream, offset, 2);
         if (Parser::ReadBits(p_stream, offset, 3) != 0) {
             ERR("Syntax error: extension_header_reserved_3bits must be set to 0.\n");
         return PARSER_INVALID_ARG;
         }
+    } else {
+        p_obu_header->temporal_id = 0;
+        p_obu_header->spatial_id = 0;
     }
     return PARSER_OK;
 }
 
-ParserResult Av1VideoParser::ReadObuHeaderAndSize() {
+ParserResult Av1VideoParser::ReadObu(int *p_offset, int *p_temporal_unit_end, int *p_frame_unit_end, Av1ObuHeader *p_obu_header, uint32_t *p_obu_byte_offset, uint64_t *p_obu_size) {
     ParserResult ret = PARSER_OK;
-    if (curr_byte_offset_ >= pic_data_size_) {
+    uint32_t bytes_read;
+    int offset = *p_offset;
+    int obu_end = pic_data_size_;
+    if (offset >= pic_data_size_) {
         return PARSER_EOF;
     }
-    uint8_t *p_stream = pic_data_buffer_ptr_ + curr_byte_offset_;
-    if ((ret = ParseObuHeader(p_stream)) != PARSER_OK) {
+    if (parser_params_.annex_b) {
+        // Length delimited bitstream format (Annex B): the temporal units hold frame units, which hold the OBUs prefixed with obu_length
+        while (offset >= *p_frame_unit_end) {
+            if (offset >= pic_data_size_) {
+                return PARSER_EOF;
+            }
+            bool is_temporal_unit = offset >= *p_temporal_unit_end;
+            int unit_end = is_temporal_unit ? pic_data_size_ : *p_temporal_unit_end;
+            uint64_t unit_size = ReadLeb128(pic_data_buffer_ptr_ + offset, unit_end - offset, &bytes_read);
+            offset += bytes_read;
+            if (bytes_read == 0 || unit_size > static_cast<uint64_t>(unit_end - offset)) {
+                ERR(STR(is_temporal_unit ? "Temporal unit size error." : "Frame unit size error."));
+                return PARSER_INVALID_ARG;
+            }
+            if (is_temporal_unit) {
+                *p_temporal_unit_end = offset + unit_size;
+                *p_frame_unit_end = offset;
+            } else {
+                *p_frame_unit_end = offset + unit_size;
+            }
+        }
+        uint64_t obu_length = ReadLeb128(pic_data_buffer_ptr_ + offset, *p_frame_unit_end - offset, &bytes_read);
+        offset += bytes_read;
+        if (bytes_read == 0 || obu_length == 0 || obu_length > static_cast<uint64_t>(*p_frame_unit_end - offset)) {
+            ERR("OBU length error.");
+            return PARSER_INVALID_ARG;
+        }
+        obu_end = offset + obu_length;
+    }
+    if ((ret = ParseObuHeader(pic_data_buffer_ptr_ + offset, obu_end - offset, p_obu_header)) != PARSER_OK) {
         return ret;
     }
-    curr_byte_offset_ += obu_header_.size;
-    p_stream += obu_header_.size;
+    offset += p_obu_header->size;
+    if (p_obu_header->obu_has_size_field) {
+        *p_obu_size = ReadLeb128(pic_data_buffer_ptr_ + offset, obu_end - offset, &bytes_read);
+        offset += bytes_read;
+        if (bytes_read == 0 || *p_obu_size > static_cast<uint64_t>(obu_end - offset)) {
+            ERR("OBU size error.");
+            return PARSER_INVALID_ARG;
+        }
+    } else {
+        // Annex B only: the OBU fills the rest of obu_length
+        *p_obu_size = obu_end - offset;
+    }
+    *p_obu_byte_offset = offset;
+    *p_offset = parser_params_.annex_b ? obu_end : offset + static_cast<int>(*p_obu_size);
+    return PARSER_OK;
+}
 
-    uint32_t bytes_read;
-    obu_size_ = ReadLeb128(p_stream, &bytes_read);
-    obu_byte_offset_ = curr_byte_offset_ + bytes_read;
-    curr_byte_offset_ = obu_byte_offset_ + obu_size_;
+ParserResult Av1VideoParser::ReadObuHeaderAndSize() {
+    ParserResult ret = ReadObu(&curr_byte_offset_, &temporal_unit_end_, &frame_unit_end_, &obu_header_, &obu_byte_offset_, &obu_size_);
+    if (ret == PARSER_OK) {
+        temporal_id_ = obu_header_.temporal_id;
+        spatial_id_ = obu_header_.spatial_id;
+    }
+    return ret;
+}
+
+ParserResult Av1VideoParser::ChooseOperatingPoint() {
+    Av1SequenceHeader *p_seq_header = &seq_header_;
+    int num_operating_points = p_seq_header->operating_points_cnt_minus_1 + 1;
+    operating_point_ = 0;
+    output_all_layers_ = false;
+    if (parser_params_.pfn_get_operating_point) {
+        RocdecOperatingPointInfo op_point_info = {};
+        op_point_info.codec = rocDecVideoCodec_AV1;
+        op_point_info.av1.operating_points_cnt = num_operating_points;
+        for (int i = 0; i < num_operating_points; i++) {
+            op_point_info.av1.operating_points_idc[i] = p_seq_header->operating_point_idc[i];
+        }
+        int ret = parser_params_.pfn_get_operating_point(parser_params_.user_data, &op_point_info);
+        if (ret < -1) {
+            ERR("Operating point selection failed.");
+            return PARSER_FAIL;
+        }
+        if (ret >= 0 && (ret & 0x3FF) < num_operating_points) {
+            operating_point_ = ret & 0x3FF;
+            output_all_layers_ = (ret >> 10) & 1;
+        }
+    }
+    operating_point_idc_ = p_seq_header->operating_point_idc[operating_point_];
     return PARSER_OK;
 }
 
+bool Av1VideoParser::IsObuDropped() {
+    if (obu_header_.obu_type == kObuSequenceHeader || obu_header_.obu_type == kObuTemporalDelimiter || operating_point_idc_ == 0 || !obu_header_.obu_extension_flag) {
+        return false;
+    }
+    uint32_t in_temporal_layer = (operating_point_idc_ >> temporal_id_) & 1;
+    uint32_t in_spatial_layer = (operating_point_idc_ >> (spatial_id_ + 8)) & 1;
+    return !in_temporal_layer || !in_spatial_layer;
+}
+
+bool Av1VideoParser::IsFrameOutput() {
+    uint32_t spatial_layers = (operating_point_idc_ >> 8) & 0xF;
+    if (output_all_layers_ || (spatial_layers & (spatial_layers - 1)) == 0) {
+        return true;
+    }
+    // Look for a frame of a higher spatial layer of the operating point in the rest of the temporal unit. The OBUs are read with the
+    // same checks as in ParsePictureData, which reports the errors: the walk just stops at invalid data.
+    int offset = curr_byte_offset_;
+    int temporal_unit_end = temporal_unit_end_;
+    int frame_unit_end = frame_unit_end_;
+    Av1ObuHeader obu_header;
+    uint32_t obu_byte_offset;
+    uint64_t obu_size;
+    while (!(parser_params_.annex_b && offset >= temporal_unit_end) &&
+           ReadObu(&offset, &temporal_unit_end, &frame_unit_end, &obu_header, &obu_byte_offset, &obu_size) == PARSER_OK) {
+        if (obu_header.obu_type == kObuTemporalDelimiter) {
+            break;
+        }
+        if ((obu_header.obu_type == kObuFrame || obu_header.obu_type == kObuFrameHeader) && obu_header.obu_extension_flag) {
+            int temporal_id = obu_header.temporal_id;
+            int spatial_id = obu_header.spatial_id;
+            if (spatial_id > spatial_id_ && ((operating_point_idc_ >> temporal_id) & 1) && ((operating_point_idc_ >> (spatial_id + 8)) & 1)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 void Av1VideoParser::ParseSequenceHeaderObu(uint8_t *p_stream, size_t size) {
     Av1SequenceHeader *p_seq_header = &seq_header_;
     size_t offset = 0;  // current bit offset
@@ -808,8 +1023,6 @@ void Av1VideoParser::ParseSequenceHeaderObu(uint8_t *p_stream, size_t size) {
         }
     }
 
-    // Todo: Choose operating point.
-
     p_seq_header->frame_width_bits_minus_1 = Parser::ReadBits(p_stream, offset, 4);
     p_seq_header->frame_height_bits_minus_1 = Parser::ReadBits(p_stream, offset, 4);
     p_seq_header->max_frame_width_minus_1 = Parser::ReadBits(p_stream, offset, p_seq_header->frame_width_bits_minus_1 + 1);
@@ -1225,20 +1438,27 @@ ParserResult Av1VideoParser::ParseUncompressedHeader(uint8_t *p_stream, size_t s
     return PARSER_OK;
 }
 
-void Av1VideoParser::ParseTileGroupObu(uint8_t *p_stream, size_t size) {
+ParserResult Av1VideoParser::ParseTileGroupObu(uint8_t *p_stream, size_t size) {
     size_t offset = 0;  // current bit offset
-    Av1SequenceHeader *p_seq_header = &seq_header_;
     Av1FrameHeader *p_frame_header = &frame_header_;
     Av1TileGroupDataInfo *p_tile_group = &tile_group_data_;
     uint32_t tile_start_and_end_present_flag = 0;
     uint32_t header_bytes = 0;
     uint32_t tile_cols = p_frame_header->tile_info.tile_cols;
     uint32_t tile_rows = p_frame_header->tile_info.tile_rows;
+    uint32_t tile_size_bytes = p_frame_header->tile_info.tile_size_bytes_minus_1 + 1;
     uint8_t *p_tg_buf = p_stream;
-    uint32_t tg_size = size;
+    size_t tg_size = size;
+    uint32_t tg_start, tg_end;
 
+    // The tile data of all the tile groups is sent as one buffer starting at the first tile group, so the tile groups
+    // of a frame have to be in the same input buffer.
     if (p_tile_group->tile_group_num == 0) {
         p_tile_group->buffer_ptr = p_stream;
+        p_tile_group->input_buffer_ptr = pic_data_buffer_ptr_;
+    } else if (p_tile_group->input_buffer_ptr != pic_data_buffer_ptr_) {
+        ERR("The tile groups of a frame are not in the same input buffer.");
+        return PARSER_INVALID_FORMAT;
     }
 
     // First parse the header
@@ -1247,38 +1467,63 @@ void Av1VideoParser::ParseTileGroupObu(uint8_t *p_stream, size_t size) {
         tile_start_and_end_present_flag = Parser::GetBit(p_stream, offset);
     }
     if (p_tile_group->num_tiles == 1 || !tile_start_and_end_present_flag) {
-        p_tile_group->tg_start = 0;
-        p_tile_group->tg_end = p_tile_group->num_tiles - 1;
+        tg_start = 0;
+        tg_end = p_tile_group->num_tiles - 1;
     } else {
         uint32_t tile_bits = p_frame_header->tile_info.tile_cols_log2 + p_frame_header->tile_info.tile_rows_log2;
-        p_tile_group->tg_start = Parser::ReadBits(p_stream, offset, tile_bits);
-        p_tile_group->tg_end = Parser::ReadBits(p_stream, offset, tile_bits);
+        tg_start = Parser::ReadBits(p_stream, offset, tile_bits);
+        tg_end = Parser::ReadBits(p_stream, offset, tile_bits);
+    }
+    if (tg_start != p_tile_group->num_tiles_parsed || tg_end < tg_start || tg_end >= p_tile_group->num_tiles) {
+        ERR("Invalid tile group: tg_start = " + TOSTR(tg_start) + ", tg_end = " + TOSTR(tg_end) + ", NumTiles = " + TOSTR(p_tile_group->num_tiles));
+        return PARSER_INVALID_FORMAT;
     }
 
     header_bytes = ((offset + 7) >> 3);
+    if (header_bytes > tg_size) {
+        ERR("Tile group OBU size error.");
+        return PARSER_OUT_OF_RANGE;
+    }
     p_tg_buf += header_bytes;
     tg_size -= header_bytes;
-    for (int tile_num = p_tile_group->tg_start; tile_num <= p_tile_group->tg_end; tile_num++) {
-        p_tile_group->tile_data_info[tile_num].tile_row = tile_num / tile_cols;
-        p_tile_group->tile_data_info[tile_num].tile_col = tile_num % tile_cols;
-        int last_tile = (tile_num == p_tile_group->tg_end);
-        if (last_tile) {
-            p_tile_group->tile_data_info[tile_num].tile_size = tg_size;
-            p_tile_group->tile_data_info[tile_num].tile_offset = p_tg_buf - p_tile_group->buffer_ptr;
+    // Write the tile parameters for the decoder in the same pass. tile_param_list_ is sized for NumTiles in TileInfo().
+    for (uint32_t tile_num = tg_start; tile_num <= tg_end; tile_num++) {
+        RocdecAv1SliceParams *p_tile_param = &tile_param_list_[tile_num];
+        uint32_t tile_size;
+        if (tile_num == tg_end) {
+            tile_size = tg_size;
         } else {
-            uint32_t tile_size_bytes = p_frame_header->tile_info.tile_size_bytes_minus_1 + 1;
-            uint32_t tile_size = ReadLeBytes(p_tg_buf, tile_size_bytes) + 1;
-            p_tile_group->tile_data_info[tile_num].tile_size = tile_size;
-            p_tile_group->tile_data_info[tile_num].tile_offset = p_tg_buf + tile_size_bytes - p_tile_group->buffer_ptr;
-            tg_size -= tile_size + tile_size_bytes;
-            p_tg_buf += tile_size + tile_size_bytes;
+            if (tile_size_bytes > tg_size) {
+                ERR("Tile group OBU size error.");
+                return PARSER_OUT_OF_RANGE;
+            }
+            // tile_size_minus_1 + 1 in 64 bits: a 4-byte tile_size_minus_1 of 0xFFFFFFFF wraps to 0 in 32 bits
+            uint64_t coded_tile_size = static_cast<uint64_t>(ReadLeBytes(p_tg_buf, tile_size_bytes)) + 1;
+            p_tg_buf += tile_size_bytes;
+            tg_size -= tile_size_bytes;
+            if (coded_tile_size > tg_size) {
+                ERR("Tile size error.");
+                return PARSER_OUT_OF_RANGE;
+            }
+            tile_size = static_cast<uint32_t>(coded_tile_size);
         }
-        p_tile_group->num_tiles_parsed++;
+        p_tile_param->slice_data_size = tile_size;
+        p_tile_param->slice_data_offset = p_tg_buf - p_tile_group->buffer_ptr;
+        p_tile_param->slice_data_flag = 0; // VA_SLICE_DATA_FLAG_ALL;
+        p_tile_param->tile_row = tile_num / tile_cols;
+        p_tile_param->tile_column = tile_num % tile_cols;
+        // The frame is submitted as one tile group covering all the tiles
+        p_tile_param->tg_start = 0;
+        p_tile_param->tg_end = p_tile_group->num_tiles - 1;
+        p_tile_param->anchor_frame_idx = 0; // Todo for large scale tile
+        p_tile_param->tile_idx_in_tile_list = 0; // Todo large scale tile
+        p_tg_buf += tile_size;
+        tg_size -= tile_size;
     }
+    p_tile_group->num_tiles_parsed = tg_end + 1;
     p_tile_group->tile_group_num++;
-    if (p_tile_group->tg_end == p_tile_group->num_tiles - 1) {
-        p_tile_group->buffer_size = p_tile_group->tile_data_info[p_tile_group->tg_end].tile_offset + p_tile_group->tile_data_info[p_tile_group->tg_end].tile_size;
-        p_tile_group->tg_start = 0;
+    if (tg_end == p_tile_group->num_tiles - 1) {
+        p_tile_group->buffer_size = p_tg_buf - p_tile_group->buffer_ptr;
         pic_stream_data_ptr_ = p_tile_group->buffer_ptr;
         pic_stream_data_size_ = p_tile_group->buffer_size;
         if (!frame_header_.disable_frame_end_update_cdf) {
@@ -1286,6 +1531,7 @@ void Av1VideoParser::ParseTileGroupObu(uint8_t *p_stream, size_t size) {
         }
         seen_frame_header_ = 0;
     }
+    return PARSER_OK;
 }
 
 void Av1VideoParser::ParseColorConfig(const uint8_t *p_stream, size_t &offset, Av1SequenceHeader *p_seq_header) {
@@ -1745,6 +1991,12 @@ void Av1VideoParser::TileInfo(const uint8_t *p_stream, size_t &offset, Av1Sequen
     } else {
         p_frame_header->tile_info.context_update_tile_id = 0;
     }
+
+    // Tile parameters of the frame, filled by the tile group OBUs
+    uint32_t num_tiles = p_frame_header->tile_info.tile_cols * p_frame_header->tile_info.tile_rows;
+    if (num_tiles > tile_param_list_.size()) {
+        tile_param_list_.resize(num_tiles, {0});
+    }
 }
 
 uint32_t Av1VideoParser::TileLog2(uint32_t blk_size, uint32_t target) {
@@ -55,22 +55,13 @@ public:
      */
     virtual rocDecStatus UnInitialize();     // derived method
 
-    typedef struct {
-        uint32_t tile_offset;
-        uint32_t tile_size;
-        uint32_t tile_col;
-        uint32_t tile_row;
-    } Av1TileDataInfo;
-
     typedef struct {
         uint8_t *buffer_ptr;  // base pointer to all tile data.
         uint32_t buffer_size;  // total size of all tile data, can come from multiple tile group OBUs.
+        const uint8_t *input_buffer_ptr;  // input buffer of the first tile group
         uint32_t num_tiles; // total number of tiles in the picture
         uint32_t tile_group_num; // current tile group number, counting from 0.
-        uint32_t tg_start; // tg_start of the current tile group
-        uint32_t tg_end; // tg_end of the current tile group
         uint32_t num_tiles_parsed; // number of parsed tiles for the current frame
-        Av1TileDataInfo tile_data_info[MAX_TILE_ROWS * MAX_TILE_COLS];
     } Av1TileGroupDataInfo;
 
     typedef struct {
@@ -115,6 +106,8 @@ protected:
     Av1ObuHeader obu_header_;
     uint64_t obu_size_; // current OBU size in byte, not including header and size bytes
     uint32_t obu_byte_offset_; // current OBU byte offset, not including header and obu_size syntax elements
+    int temporal_unit_end_;  // Annex B: end offset of the current temporal unit in the picture data
+    int frame_unit_end_;  // Annex B: end offset of the current frame unit in the picture data
 
     uint32_t seen_frame_header_; // SeenFrameHeader
     Av1SequenceHeader seq_header_;
@@ -124,6 +117,9 @@ protected:
 
     int temporal_id_; //  temporal level of the data contained in the OBU
     int spatial_id_;  // spatial level of the data contained in the OBU
+    int operating_point_;  // operatingPoint, selected with pfn_get_operating_point, 0 by default
+    uint32_t operating_point_idc_;  // OperatingPointIdc
+    bool output_all_layers_;  // OutputAllLayers
 
     DecodedPictureBuffer dpb_buffer_;
     Av1Picture curr_pic_;
@@ -137,6 +133,15 @@ protected:
      */
     ParserResult ParsePictureData(const uint8_t *p_stream, uint32_t pic_data_size);
 
+    /*! \brief Function to find the end of the current temporal unit of a low overhead bitstream format (Section 5) byte stream in the
+     *         stream buffer: a temporal unit ends before the next temporal delimiter OBU. The OBUs are skipped with their obu_size, so
+     *         the payload is not scanned. A length delimited (Annex B) temporal unit ends after its temporal_unit_size bytes, so it is
+     *         parsed as soon as it is received.
+     * \param [out] p_au_end Offset of the first byte of the next temporal unit in stream_buf_
+     * \return <tt>ParserResult</tt> PARSER_OK if a temporal unit is complete, PARSER_NOT_FOUND if more data is needed, else error code
+     */
+    virtual ParserResult FindAccessUnitEnd(int *p_au_end);
+
     /*! \brief Function to notify decoder about new sequence format through callback
      * \param [in] p_seq_header Pointer to the current sequence header
      * \param [in] p_frame_header Ponter to the current frame header
@@ -191,12 +196,27 @@ protected:
 
     /*! \brief Function to parse an OBU header
      * \param [in] p_stream Pointer to the bit stream
+     * \param [in] size Byte size of the stream
+     * \param [out] p_obu_header Pointer to the OBU header
      * \return <tt>ParserResult</tt>
      */
-    ParserResult ParseObuHeader(const uint8_t *p_stream);
+    ParserResult ParseObuHeader(const uint8_t *p_stream, int size, Av1ObuHeader *p_obu_header);
 
-    /*! \brief Function to parse an OBU header and size
-     * \return <tt>ParserResult</tt>
+    /*! \brief Function to read the OBU header and size at a byte offset of the picture data. With annex_b, the temporal_unit_size,
+     *         frame_unit_size and obu_length fields (Annex B) before the OBU are read as well, and obu_size is derived from obu_length
+     *         if not present. Every field is read within the picture data and every size is checked against the enclosing unit.
+     * \param [in/out] p_offset Byte offset of the OBU, moved to the end of the OBU
+     * \param [in/out] p_temporal_unit_end Annex B: end offset of the current temporal unit
+     * \param [in/out] p_frame_unit_end Annex B: end offset of the current frame unit
+     * \param [out] p_obu_header Pointer to the OBU header
+     * \param [out] p_obu_byte_offset Byte offset of the OBU payload
+     * \param [out] p_obu_size Byte size of the OBU payload
+     * \return <tt>ParserResult</tt> PARSER_EOF at the end of the picture data
+     */
+    ParserResult ReadObu(int *p_offset, int *p_temporal_unit_end, int *p_frame_unit_end, Av1ObuHeader *p_obu_header, uint32_t *p_obu_byte_offset, uint64_t *p_obu_size);
+
+    /*! \brief Function to read the header and size of the next OBU of the picture data into obu_header_, obu_byte_offset_ and obu_size_
+     * \return <tt>ParserResult</tt> PARSER_EOF at the end of the picture data
      */
     ParserResult ReadObuHeaderAndSize();
 
@@ -207,6 +227,23 @@ protected:
      */
     void ParseSequenceHeaderObu(uint8_t *p_stream, size_t size);
 
+    /*! \brief Function to select the operating point of the current sequence header with the pfn_get_operating_point callback.
+     *         Operating point 0 is used if the callback is not set, returns -1 or returns an invalid operating point.
+     * \return <tt>ParserResult</tt>
+     */
+    ParserResult ChooseOperatingPoint();
+
+    /*! \brief Function to check if the OBU of the current temporal_id_ and spatial_id_ is dropped by the selected operating point. 7.5.
+     * \return true if the OBU is not decoded
+     */
+    bool IsObuDropped();
+
+    /*! \brief Function to check if the current frame is output. If OutputAllLayers is 0 and the operating point has multiple spatial layers,
+     *         only the frame of the highest spatial layer in the rest of the temporal unit is output.
+     * \return true if the frame is output
+     */
+    bool IsFrameOutput();
+
     /*! \brief Function to parse a frame header OBU. 5.9.
      * \param [in] p_stream Pointer to the bit stream
      * \param [in] size Byte size of the stream
@@ -223,12 +260,12 @@ protected:
      */
     ParserResult ParseUncompressedHeader(uint8_t *p_stream, size_t size, int *p_bytes_parsed);
 
-    /*! \brief Function to parse a tile group OBU
+    /*! \brief Function to parse a tile group OBU and set up the tile parameters of its tiles
      * \param [in] p_stream Pointer to the bit stream
      * \param [in] size Byte size of the stream
-     * \return None
+     * \return <tt>ParserResult</tt>
      */
-    void ParseTileGroupObu(uint8_t *p_stream, size_t size);
+    ParserResult ParseTileGroupObu(uint8_t *p_stream, size_t size);
 
     /*! \brief Function to parse color config in sequence header
      * \param [in] p_stream Pointer to the bit stream
@@ -597,15 +634,16 @@ protected:
     /*! \brief Function to read unsigned integer represented by a variable number of little-endian bytes, which
      *         is less than or equal to (1 << 32) - 1. 4.10.5. leb128().
      * \param [in] p_stream Bit stream pointer
-     * \param [out] p_num_bytes_read Number of bytes read
+     * \param [in] size Byte size of the stream; at most 8 bytes are read
+     * \param [out] p_num_bytes_read Number of bytes read, 0 if the value does not end within the stream or 8 bytes
      * \return The unsigned value
      */
-    inline uint64_t ReadLeb128(const uint8_t *p_stream, uint32_t *p_num_bytes_read) {
-        uint32_t value = 0;
+    inline uint64_t ReadLeb128(const uint8_t *p_stream, int size, uint32_t *p_num_bytes_read) {
+        uint64_t value = 0;
         *p_num_bytes_read = 0;
         uint32_t len;
-        for (len = 0; len < 8; ++len) {
-            value |= (p_stream[len] & 0x7F) << (len * 7);
+        for (len = 0; len < 8 && static_cast<int>(len) < size; ++len) {
+            value |= static_cast<uint64_t>(p_stream[len] & 0x7F) << (len * 7);
             if ((p_stream[len] & 0x80) == 0) {
                 ++len;
                 *p_num_bytes_read = len;
@@ -63,12 +63,27 @@ rocDecStatus AvcVideoParser::UnInitialize() {
 
 rocDecStatus AvcVideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) {
     if (p_data->payload && p_data->payload_size) {
-        curr_pts_ = p_data->pts;
+        if (!au_in_progress_) {
+            curr_pts_ = p_data->pts;
+        }
+        end_of_picture_ = (p_data->flags & ROCDEC_PKT_ENDOFPICTURE) != 0;
         if (ParsePictureData(p_data->payload, p_data->payload_size) != PARSER_OK) {
             ERR(STR("Parser failed!"));
+            au_in_progress_ = false;
             return ROCDEC_RUNTIME_ERROR;
         }
 
+        // The access unit continues in the next packet: submit the slices of this one, which are not the last ones of the picture
+        if (partial_au_) {
+            au_in_progress_ = true;
+            if (num_slices_ > num_submitted_slices_ && SendSliceBatch(false) != PARSER_OK) {
+                ERR(STR("Failed to decode!"));
+                return ROCDEC_RUNTIME_ERROR;
+            }
+            return ROCDEC_SUCCESS;
+        }
+        au_in_progress_ = false;
+
         // Init Roc decoder for the first time or reconfigure the existing decoder
         if (new_seq_activated_) {
             if (NotifyNewSps(&sps_list_[active_sps_id_]) != PARSER_OK) {
@@ -87,17 +102,25 @@ rocDecStatus AvcVideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) {
             return ROCDEC_SUCCESS;
         }
 
-        // Output decoded pictures from DPB if any are ready in case of frame_num gaps.
-        if (pfn_display_picture_cb_ && num_output_pics_ > 0) {
-            if (OutputDecodedPictures(false) != PARSER_OK) {
+        if (parser_params_.slice_submission) {
+            // Submit the remaining slices and end the picture
+            if (SendSliceBatch(true) != PARSER_OK) {
+                ERR(STR("Failed to decode!"));
                 return ROCDEC_RUNTIME_ERROR;
             }
-        }
+        } else {
+            // Output decoded pictures from DPB if any are ready in case of frame_num gaps.
+            if (pfn_display_picture_cb_ && num_output_pics_ > 0) {
+                if (OutputDecodedPictures(false) != PARSER_OK) {
+                    return ROCDEC_RUNTIME_ERROR;
+                }
+            }
 
-        // Decode the picture
-        if (SendPicForDecode() != PARSER_OK) {
-            ERR(STR("Failed to decode!"));
-            return ROCDEC_RUNTIME_ERROR;
+            // Decode the picture
+            if (SendPicForDecode() != PARSER_OK) {
+                ERR(STR("Failed to decode!"));
+                return ROCDEC_RUNTIME_ERROR;
+            }
         }
 
         // Decoded reference picture marking (8.2.5) for later pictures
@@ -138,10 +161,13 @@ ParserResult AvcVideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
     curr_start_code_offset_ = 0;
     next_start_code_offset_ = 0;
 
-    num_slices_ = 0;
-    sei_message_count_ = 0;
-    sei_payload_size_ = 0;
-    curr_pic_ = {0};
+    if (!au_in_progress_) {
+        num_slices_ = 0;
+        num_submitted_slices_ = 0;
+        sei_message_count_ = 0;
+        sei_payload_size_ = 0;
+        curr_pic_ = {0};
+    }
 
     do {
         ret = GetNalUnit();
@@ -178,6 +204,13 @@ ParserResult AvcVideoParser::ParsePictureData(const uint8_t *p_stream, uint32_t
                 case kAvcNalTypeSlice_Data_Partition_A:
                 case kAvcNalTypeSlice_Data_Partition_B:
                 case kAvcNalTypeSlice_Data_Partition_C: {
+                    // Slice submission: the slices parsed so far are not the last ones of the picture
+                    if (parser_params_.slice_submission && num_slices_ > num_submitted_slices_) {
+                        if ((ret2 = SendSliceBatch(false)) != PARSER_OK) {
+                            return ret2;
+                        }
+                    }
+
                     // Save slice NAL unit header
                     slice_nal_unit_header_ = nal_unit_header_;
 
@@ -387,13 +420,21 @@ ParserResult AvcVideoParser::NotifyNewSps(AvcSeqParameterSet *p_sps) {
     video_format_params_.display_aspect_ratio.x = disp_width / gcd;
     video_format_params_.display_aspect_ratio.y = disp_height / gcd;
 
-    if (p_sps->vui_parameters_present_flag) {
+    // values inferred when not present: unspecified video format (5), limited range, unspecified colour description (2)
+    video_format_params_.video_signal_description.video_format = 5;
+    video_format_params_.video_signal_description.video_full_range_flag = 0;
+    video_format_params_.video_signal_description.color_primaries = 2;
+    video_format_params_.video_signal_description.transfer_characteristics = 2;
+    video_format_params_.video_signal_description.matrix_coefficients = 2;
+    video_format_params_.video_signal_description.reserved_zero_bits = 0;
+    if (p_sps->vui_parameters_present_flag && p_sps->vui_seq_parameters.video_signal_type_present_flag) {
         video_format_params_.video_signal_description.video_format = p_sps->vui_seq_parameters.video_format;
         video_format_params_.video_signal_description.video_full_range_flag = p_sps->vui_seq_parameters.video_full_range_flag;
-        video_format_params_.video_signal_description.color_primaries = p_sps->vui_seq_parameters.colour_primaries;
-        video_format_params_.video_signal_description.transfer_characteristics = p_sps->vui_seq_parameters.transfer_characteristics;
-        video_format_params_.video_signal_description.matrix_coefficients = p_sps->vui_seq_parameters.matrix_coefficients;
-        video_format_params_.video_signal_description.reserved_zero_bits = 0;
+        if (p_sps->vui_seq_parameters.colour_description_present_flag) {
+            video_format_params_.video_signal_description.color_primaries = p_sps->vui_seq_parameters.colour_primaries;
+            video_format_params_.video_signal_description.transfer_characteristics = p_sps->vui_seq_parameters.transfer_characteristics;
+            video_format_params_.video_signal_description.matrix_coefficients = p_sps->vui_seq_parameters.matrix_coefficients;
+        }
     }
     video_format_params_.seqhdr_data_length = 0;
 
@@ -434,7 +475,7 @@ static const int diag_scan_8x8[64] = {
     53, 60, 61, 54, 47, 55, 62, 63
 };
 
-ParserResult AvcVideoParser::SendPicForDecode() {
+void AvcVideoParser::FillPicParams() {
     int i, j;
     AvcSeqParameterSet *p_sps = &sps_list_[active_sps_id_];
     AvcPicParameterSet *p_pps = &pps_list_[active_pps_id_];
@@ -568,136 +609,145 @@ ParserResult AvcVideoParser::SendPicForDecode() {
 
     p_pic_param->frame_num = p_slice_header->frame_num;
 
-    // Set up slice parameters
-    // Resize if needed
-    if (num_slices_ > slice_param_list_.size()) {
-        slice_param_list_.resize(num_slices_, {0});
+    // Set up scaling lists
+    RocdecAvcIQMatrix *p_iq_matrix = &dec_pic_params_.iq_matrix.avc;
+    for (i = 0; i < 6; i++) {
+        for (j = 0; j < 16; j++) {
+            p_iq_matrix->scaling_list_4x4[i][diag_scan_4x4[j]] = p_pps->scaling_list_4x4[i][j];
+        }
     }
-    for (int slice_index = 0; slice_index < num_slices_; slice_index++) {
-        RocdecAvcSliceParams *p_slice_param = &slice_param_list_[slice_index];
-        AvcSliceInfo *p_slice_info = &slice_info_list_[slice_index];
-        AvcSliceHeader *p_slice_header = &p_slice_info->slice_header;
-
-        p_slice_param->slice_data_size = p_slice_info->slice_data_size;
-        p_slice_param->slice_data_offset = p_slice_info->slice_data_offset;
-        p_slice_param->slice_data_flag = 0; // VA_SLICE_DATA_FLAG_ALL;
-        p_slice_param->slice_data_bit_offset = 0;
-        p_slice_param->first_mb_in_slice = p_slice_header->first_mb_in_slice;
-        p_slice_param->slice_type = p_slice_header->slice_type;
-        p_slice_param->direct_spatial_mv_pred_flag = p_slice_header->direct_spatial_mv_pred_flag;
-        p_slice_param->num_ref_idx_l0_active_minus1 = p_slice_header->num_ref_idx_l0_active_minus1;
-        p_slice_param->num_ref_idx_l1_active_minus1 = p_slice_header->num_ref_idx_l1_active_minus1;
-        p_slice_param->cabac_init_idc = p_slice_header->cabac_init_idc;
-        p_slice_param->slice_qp_delta = p_slice_header->slice_qp_delta;
-        p_slice_param->disable_deblocking_filter_idc = p_slice_header->disable_deblocking_filter_idc;
-        p_slice_param->slice_alpha_c0_offset_div2 = p_slice_header->slice_alpha_c0_offset_div2;
-        p_slice_param->slice_beta_offset_div2 = p_slice_header->slice_beta_offset_div2;
-        p_slice_param->luma_log2_weight_denom = p_slice_header->pred_weight_table.luma_log2_weight_denom;
-        p_slice_param->chroma_log2_weight_denom = p_slice_header->pred_weight_table.chroma_log2_weight_denom;
-
-        // Ref lists
-        for (j = 0; j < 32; j++) {
-            p_slice_param->ref_pic_list_0[j].pic_idx = 0xFF;
-            p_slice_param->ref_pic_list_1[j].pic_idx = 0xFF;
-            p_slice_param->ref_pic_list_0[j].frame_idx = 0;
-            p_slice_param->ref_pic_list_1[j].frame_idx = 0;
-            p_slice_param->ref_pic_list_0[j].flags = RocdecAvcPicture_FLAGS_INVALID;
-            p_slice_param->ref_pic_list_1[j].flags = RocdecAvcPicture_FLAGS_INVALID;
-            p_slice_param->ref_pic_list_0[j].top_field_order_cnt = 0;
-            p_slice_param->ref_pic_list_1[j].top_field_order_cnt = 0;
-            p_slice_param->ref_pic_list_0[j].bottom_field_order_cnt = 0;
-            p_slice_param->ref_pic_list_1[j].bottom_field_order_cnt = 0;
-        }
-
-        if (p_slice_header->slice_type == kAvcSliceTypeP || p_slice_header->slice_type == kAvcSliceTypeP_5 || p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6) {
-            for (i = 0; i <= p_slice_info->slice_header.num_ref_idx_l0_active_minus1; i++) {
-                AvcPicture *p_ref_pic = &p_slice_info->ref_list_0_[i];
-                if (p_ref_pic->is_reference != kUnusedForReference) {
-                    p_slice_param->ref_pic_list_0[i].pic_idx = p_ref_pic->dec_buf_idx;
-                    if ( p_ref_pic->is_reference == kUsedForLongTerm) {
-                        p_slice_param->ref_pic_list_0[i].frame_idx = p_ref_pic->long_term_pic_num;
-                    } else {
-                        p_slice_param->ref_pic_list_0[i].frame_idx = p_ref_pic->frame_num;
-                    }
-                    p_slice_param->ref_pic_list_0[i].top_field_order_cnt = p_ref_pic->top_field_order_cnt;
-                    p_slice_param->ref_pic_list_0[i].bottom_field_order_cnt = p_ref_pic->bottom_field_order_cnt;
-                    p_slice_param->ref_pic_list_0[i].flags = 0;
-                    if (p_ref_pic->pic_structure != kFrame) {
-                        p_slice_param->ref_pic_list_0[i].flags |= p_ref_pic->pic_structure == kBottomField ? RocdecAvcPicture_FLAGS_BOTTOM_FIELD : RocdecAvcPicture_FLAGS_TOP_FIELD;
-                    }
-                    p_slice_param->ref_pic_list_0[i].flags |= p_ref_pic->is_reference == kUsedForShortTerm ? RocdecAvcPicture_FLAGS_SHORT_TERM_REFERENCE : RocdecAvcPicture_FLAGS_LONG_TERM_REFERENCE;
+    for (i = 0; i < 2; i++) {
+        for (j = 0; j < 64; j++) {
+            p_iq_matrix->scaling_list_8x8[i][diag_scan_8x8[j]] = p_pps->scaling_list_8x8[i][j];
+        }
+    }
+}
+
+void AvcVideoParser::FillSliceParams(int slice_index) {
+    int i, j;
+    RocdecAvcSliceParams *p_slice_param = &slice_param_list_[slice_index];
+    AvcSliceInfo *p_slice_info = &slice_info_list_[slice_index];
+    AvcSliceHeader *p_slice_header = &p_slice_info->slice_header;
+
+    p_slice_param->slice_data_size = p_slice_info->slice_data_size;
+    p_slice_param->slice_data_offset = p_slice_info->slice_data_offset;
+    p_slice_param->slice_data_flag = 0; // VA_SLICE_DATA_FLAG_ALL;
+    p_slice_param->slice_data_bit_offset = 0;
+    p_slice_param->first_mb_in_slice = p_slice_header->first_mb_in_slice;
+    p_slice_param->slice_type = p_slice_header->slice_type;
+    p_slice_param->direct_spatial_mv_pred_flag = p_slice_header->direct_spatial_mv_pred_flag;
+    p_slice_param->num_ref_idx_l0_active_minus1 = p_slice_header->num_ref_idx_l0_active_minus1;
+    p_slice_param->num_ref_idx_l1_active_minus1 = p_slice_header->num_ref_idx_l1_active_minus1;
+    p_slice_param->cabac_init_idc = p_slice_header->cabac_init_idc;
+    p_slice_param->slice_qp_delta = p_slice_header->slice_qp_delta;
+    p_slice_param->disable_deblocking_filter_idc = p_slice_header->disable_deblocking_filter_idc;
+    p_slice_param->slice_alpha_c0_offset_div2 = p_slice_header->slice_alpha_c0_offset_div2;
+    p_slice_param->slice_beta_offset_div2 = p_slice_header->slice_beta_offset_div2;
+    p_slice_param->luma_log2_weight_denom = p_slice_header->pred_weight_table.luma_log2_weight_denom;
+    p_slice_param->chroma_log2_weight_denom = p_slice_header->pred_weight_table.chroma_log2_weight_denom;
+
+    // Ref lists
+    for (j = 0; j < 32; j++) {
+        p_slice_param->ref_pic_list_0[j].pic_idx = 0xFF;
+        p_slice_param->ref_pic_list_1[j].pic_idx = 0xFF;
+        p_slice_param->ref_pic_list_0[j].frame_idx = 0;
+        p_slice_param->ref_pic_list_1[j].frame_idx = 0;
+        p_slice_param->ref_pic_list_0[j].flags = RocdecAvcPicture_FLAGS_INVALID;
+        p_slice_param->ref_pic_list_1[j].flags = RocdecAvcPicture_FLAGS_INVALID;
+        p_slice_param->ref_pic_list_0[j].top_field_order_cnt = 0;
+        p_slice_param->ref_pic_list_1[j].top_field_order_cnt = 0;
+        p_slice_param->ref_pic_list_0[j].bottom_field_order_cnt = 0;
+        p_slice_param->ref_pic_list_1[j].bottom_field_order_cnt = 0;
+    }
+
+    if (p_slice_header->slice_type == kAvcSliceTypeP || p_slice_header->slice_type == kAvcSliceTypeP_5 || p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6) {
+        for (i = 0; i <= p_slice_info->slice_header.num_ref_idx_l0_active_minus1; i++) {
+            AvcPicture *p_ref_pic = &p_slice_info->ref_list_0_[i];
+            if (p_ref_pic->is_reference != kUnusedForReference) {
+                p_slice_param->ref_pic_list_0[i].pic_idx = p_ref_pic->dec_buf_idx;
+                if ( p_ref_pic->is_reference == kUsedForLongTerm) {
+                    p_slice_param->ref_pic_list_0[i].frame_idx = p_ref_pic->long_term_pic_num;
+                } else {
+                    p_slice_param->ref_pic_list_0[i].frame_idx = p_ref_pic->frame_num;
+                }
+                p_slice_param->ref_pic_list_0[i].top_field_order_cnt = p_ref_pic->top_field_order_cnt;
+                p_slice_param->ref_pic_list_0[i].bottom_field_order_cnt = p_ref_pic->bottom_field_order_cnt;
+                p_slice_param->ref_pic_list_0[i].flags = 0;
+                if (p_ref_pic->pic_structure != kFrame) {
+                    p_slice_param->ref_pic_list_0[i].flags |= p_ref_pic->pic_structure == kBottomField ? RocdecAvcPicture_FLAGS_BOTTOM_FIELD : RocdecAvcPicture_FLAGS_TOP_FIELD;
                 }
+                p_slice_param->ref_pic_list_0[i].flags |= p_ref_pic->is_reference == kUsedForShortTerm ? RocdecAvcPicture_FLAGS_SHORT_TERM_REFERENCE : RocdecAvcPicture_FLAGS_LONG_TERM_REFERENCE;
             }
         }
+    }
 
-        if (p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6 ) {
-            for (i = 0; i <= p_slice_info->slice_header.num_ref_idx_l1_active_minus1; i++) {
-                AvcPicture *p_ref_pic = &p_slice_info->ref_list_1_[i];
-                if (p_ref_pic->is_reference != kUnusedForReference) {
-                    p_slice_param->ref_pic_list_1[i].pic_idx = p_ref_pic->dec_buf_idx;
-                    if ( p_ref_pic->is_reference == kUsedForLongTerm) {
-                        p_slice_param->ref_pic_list_1[i].frame_idx = p_ref_pic->long_term_pic_num;
-                    } else {
-                        p_slice_param->ref_pic_list_1[i].frame_idx = p_ref_pic->frame_num;
-                    }
-                    p_slice_param->ref_pic_list_1[i].top_field_order_cnt = p_ref_pic->top_field_order_cnt;
-                    p_slice_param->ref_pic_list_1[i].bottom_field_order_cnt = p_ref_pic->bottom_field_order_cnt;
-                    p_slice_param->ref_pic_list_1[i].flags = 0;
-                    if (p_ref_pic->pic_structure != kFrame) {
-                        p_slice_param->ref_pic_list_1[i].flags |= p_ref_pic->pic_structure == kBottomField ? RocdecAvcPicture_FLAGS_BOTTOM_FIELD : RocdecAvcPicture_FLAGS_TOP_FIELD;
-                    }
-                    p_slice_param->ref_pic_list_1[i].flags |= p_ref_pic->is_reference == kUsedForShortTerm ? RocdecAvcPicture_FLAGS_SHORT_TERM_REFERENCE : RocdecAvcPicture_FLAGS_LONG_TERM_REFERENCE;
+    if (p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6 ) {
+        for (i = 0; i <= p_slice_info->slice_header.num_ref_idx_l1_active_minus1; i++) {
+            AvcPicture *p_ref_pic = &p_slice_info->ref_list_1_[i];
+            if (p_ref_pic->is_reference != kUnusedForReference) {
+                p_slice_param->ref_pic_list_1[i].pic_idx = p_ref_pic->dec_buf_idx;
+                if ( p_ref_pic->is_reference == kUsedForLongTerm) {
+                    p_slice_param->ref_pic_list_1[i].frame_idx = p_ref_pic->long_term_pic_num;
+                } else {
+                    p_slice_param->ref_pic_list_1[i].frame_idx = p_ref_pic->frame_num;
+                }
+                p_slice_param->ref_pic_list_1[i].top_field_order_cnt = p_ref_pic->top_field_order_cnt;
+                p_slice_param->ref_pic_list_1[i].bottom_field_order_cnt = p_ref_pic->bottom_field_order_cnt;
+                p_slice_param->ref_pic_list_1[i].flags = 0;
+                if (p_ref_pic->pic_structure != kFrame) {
+                    p_slice_param->ref_pic_list_1[i].flags |= p_ref_pic->pic_structure == kBottomField ? RocdecAvcPicture_FLAGS_BOTTOM_FIELD : RocdecAvcPicture_FLAGS_TOP_FIELD;
                 }
+                p_slice_param->ref_pic_list_1[i].flags |= p_ref_pic->is_reference == kUsedForShortTerm ? RocdecAvcPicture_FLAGS_SHORT_TERM_REFERENCE : RocdecAvcPicture_FLAGS_LONG_TERM_REFERENCE;
             }
         }
+    }
 
-        // Prediction weight table
-        // Note luma_weight_l0_flag should be an array. Set it using the first one in the table.
-        p_slice_param->luma_weight_l0_flag = p_slice_header->pred_weight_table.weight_factor[0].luma_weight_l0_flag;
-        for (i = 0; i <= p_slice_header->num_ref_idx_l0_active_minus1; i++) {
-            p_slice_param->luma_weight_l0[i] = p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l0;
-            p_slice_param->luma_offset_l0[i] = p_slice_header->pred_weight_table.weight_factor[i].luma_offset_l0;
-        }
+    // Prediction weight table
+    // Note luma_weight_l0_flag should be an array. Set it using the first one in the table.
+    p_slice_param->luma_weight_l0_flag = p_slice_header->pred_weight_table.weight_factor[0].luma_weight_l0_flag;
+    for (i = 0; i <= p_slice_header->num_ref_idx_l0_active_minus1; i++) {
+        p_slice_param->luma_weight_l0[i] = p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l0;
+        p_slice_param->luma_offset_l0[i] = p_slice_header->pred_weight_table.weight_factor[i].luma_offset_l0;
+    }
 
+    // Note chroma_weight_l0_flag should be an array. Set it using the first one in the table.
+    p_slice_param->chroma_weight_l0_flag = p_slice_header->pred_weight_table.weight_factor[0].chroma_weight_l0_flag;
+    for (i = 0; i <= p_slice_header->num_ref_idx_l0_active_minus1; i++) {
+        for (j = 0; j < 2; j++) {
+            p_slice_param->chroma_weight_l0[i][j] = p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l0[j];
+            p_slice_param->chroma_offset_l0[i][j] = p_slice_header->pred_weight_table.weight_factor[i].chroma_offset_l0[j];
+        }
+    }
+    if (p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6 ) {
+        // Note luma_weight_l1_flag should be an array. Set it using the first one in the table.
+        p_slice_param->luma_weight_l1_flag = p_slice_header->pred_weight_table.weight_factor[0].luma_weight_l1_flag;
+        for (i = 0; i <= p_slice_header->num_ref_idx_l1_active_minus1; i++) {
+            p_slice_param->luma_weight_l1[i] = p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l1;
+            p_slice_param->luma_offset_l1[i] = p_slice_header->pred_weight_table.weight_factor[i].luma_offset_l1;
+        }
         // Note chroma_weight_l0_flag should be an array. Set it using the first one in the table.
-        p_slice_param->chroma_weight_l0_flag = p_slice_header->pred_weight_table.weight_factor[0].chroma_weight_l0_flag;
-        for (i = 0; i <= p_slice_header->num_ref_idx_l0_active_minus1; i++) {
+        p_slice_param->chroma_weight_l1_flag = p_slice_header->pred_weight_table.weight_factor[0].chroma_weight_l1_flag;
+        for (i = 0; i <= p_slice_header->num_ref_idx_l1_active_minus1; i++) {
             for (j = 0; j < 2; j++) {
-                p_slice_param->chroma_weight_l0[i][j] = p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l0[j];
-                p_slice_param->chroma_offset_l0[i][j] = p_slice_header->pred_weight_table.weight_factor[i].chroma_offset_l0[j];
-            }
-        }
-        if (p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6 ) {
-            // Note luma_weight_l1_flag should be an array. Set it using the first one in the table.
-            p_slice_param->luma_weight_l1_flag = p_slice_header->pred_weight_table.weight_factor[0].luma_weight_l1_flag;
-            for (i = 0; i <= p_slice_header->num_ref_idx_l1_active_minus1; i++) {
-                p_slice_param->luma_weight_l1[i] = p_slice_header->pred_weight_table.weight_factor[i].luma_weight_l1;
-                p_slice_param->luma_offset_l1[i] = p_slice_header->pred_weight_table.weight_factor[i].luma_offset_l1;
-            }
-            // Note chroma_weight_l0_flag should be an array. Set it using the first one in the table.
-            p_slice_param->chroma_weight_l1_flag = p_slice_header->pred_weight_table.weight_factor[0].chroma_weight_l1_flag;
-            for (i = 0; i <= p_slice_header->num_ref_idx_l1_active_minus1; i++) {
-                for (j = 0; j < 2; j++) {
-                    p_slice_param->chroma_weight_l1[i][j] = p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l1[j];
-                    p_slice_param->chroma_offset_l1[i][j] = p_slice_header->pred_weight_table.weight_factor[i].chroma_offset_l1[j];
-                }
+                p_slice_param->chroma_weight_l1[i][j] = p_slice_header->pred_weight_table.weight_factor[i].chroma_weight_l1[j];
+                p_slice_param->chroma_offset_l1[i][j] = p_slice_header->pred_weight_table.weight_factor[i].chroma_offset_l1[j];
             }
         }
     }
-    dec_pic_params_.slice_params.avc = slice_param_list_.data();
+}
 
-    // Set up scaling lists
-    RocdecAvcIQMatrix *p_iq_matrix = &dec_pic_params_.iq_matrix.avc;
-    for (i = 0; i < 6; i++) {
-        for (j = 0; j < 16; j++) {
-            p_iq_matrix->scaling_list_4x4[i][diag_scan_4x4[j]] = p_pps->scaling_list_4x4[i][j];
-        }
+ParserResult AvcVideoParser::SendPicForDecode() {
+    FillPicParams();
+
+    // Set up slice parameters
+    // Resize if needed
+    if (num_slices_ > slice_param_list_.size()) {
+        slice_param_list_.resize(num_slices_, {0});
     }
-    for (i = 0; i < 2; i++) {
-        for (j = 0; j < 64; j++) {
-            p_iq_matrix->scaling_list_8x8[i][diag_scan_8x8[j]] = p_pps->scaling_list_8x8[i][j];
-        }
+    for (int slice_index = 0; slice_index < num_slices_; slice_index++) {
+        FillSliceParams(slice_index);
     }
+    dec_pic_params_.slice_params.avc = slice_param_list_.data();
 
 #if DBGINFO
     PrintVappiBufInfo();
@@ -711,6 +761,82 @@ ParserResult AvcVideoParser::SendPicForDecode() {
     }
 }
 
+ParserResult AvcVideoParser::SendSliceBatch(bool last_batch) {
+    if (num_submitted_slices_ == 0) {
+        // Init Roc decoder for the first time or reconfigure the existing decoder before starting the picture
+        if (new_seq_activated_) {
+            if (NotifyNewSps(&sps_list_[active_sps_id_]) != PARSER_OK) {
+                return PARSER_FAIL;
+            }
+            new_seq_activated_ = false;
+        }
+        // Output decoded pictures from DPB if any are ready in case of frame_num gaps.
+        if (pfn_display_picture_cb_ && num_output_pics_ > 0) {
+            if (OutputDecodedPictures(false) != PARSER_OK) {
+                return PARSER_FAIL;
+            }
+        }
+        FillPicParams();
+        dec_pic_params_.slice_batch_flags = ROCDEC_SLICE_BATCH | ROCDEC_SLICE_BATCH_FIRST;
+    } else {
+        dec_pic_params_.slice_batch_flags = ROCDEC_SLICE_BATCH;
+    }
+    if (last_batch) {
+        dec_pic_params_.slice_batch_flags |= ROCDEC_SLICE_BATCH_LAST;
+    }
+
+    // The batch data runs from the start code of its first slice to the end of its last slice
+    int first_slice = num_submitted_slices_;
+    int data_offset = slice_info_list_[first_slice].slice_data_offset;
+    AvcSliceInfo *p_last_slice_info = &slice_info_list_[num_slices_ - 1];
+    dec_pic_params_.bitstream_data = pic_data_buffer_ptr_ + data_offset;
+    dec_pic_params_.bitstream_data_len = p_last_slice_info->slice_data_offset + p_last_slice_info->slice_data_size - data_offset;
+    dec_pic_params_.num_slices = num_slices_ - first_slice;
+
+    // Resize if needed
+    if (num_slices_ > slice_param_list_.size()) {
+        slice_param_list_.resize(num_slices_, {0});
+    }
+    for (int slice_index = first_slice; slice_index < num_slices_; slice_index++) {
+        FillSliceParams(slice_index);
+        slice_param_list_[slice_index].slice_data_offset -= data_offset;
+    }
+    dec_pic_params_.slice_params.avc = &slice_param_list_[first_slice];
+    num_submitted_slices_ = num_slices_;
+
+    if (pfn_decode_picture_cb_(parser_params_.user_data, &dec_pic_params_) == 0) {
+        ERR("Decode error occurred.");
+        return PARSER_FAIL;
+    } else {
+        return PARSER_OK;
+    }
+}
+
+RocVideoParser::AuNalType AvcVideoParser::GetAuNalType(const uint8_t *nal_unit) {
+    uint32_t nal_unit_type = nal_unit[0] & 0x1F;
+    switch (nal_unit_type) {
+        case kAvcNalTypeSlice_Non_IDR:
+        case kAvcNalTypeSlice_Data_Partition_A:
+        case kAvcNalTypeSlice_IDR:
+            return (nal_unit[1] & 0x80) ? kAuNalFirstVcl : kAuNalVcl; // first_mb_in_slice == 0
+        case kAvcNalTypeSlice_Data_Partition_B:
+        case kAvcNalTypeSlice_Data_Partition_C:
+            return kAuNalVcl;
+        case kAvcNalTypeSEI_Info:
+        case kAvcNalTypeSeq_Parameter_Set:
+        case kAvcNalTypePic_Parameter_Set:
+        case kAvcNalTypeAccess_Unit_Delimiter:
+        case kAvcNalTypePrefix_NAL_Unit:
+        case kAvcNalTypeSubset_Seq_Parameter_Set:
+        case kAvcNalTypeDepth_Parameter_Set:
+        case 17:    // reserved
+        case 18:    // reserved
+            return kAuNalPrefix;
+        default:
+            return kAuNalOther;
+    }
+}
+
 AvcNalUnitHeader AvcVideoParser::ParseNalUnitHeader(uint8_t header_byte) {
     size_t bit_offset = 0;
     AvcNalUnitHeader nal_header;
@@ -2078,6 +2204,10 @@ ParserResult AvcVideoParser::SetupReflist(AvcSliceInfo *p_slice_info) {
 
     // 8.2.4.1. Calculate picture numbers. Only do it once.
     if (num_slices_ == 0) {
+        short_term_pic_num_index_.Clear();
+        long_term_pic_num_index_.Clear();
+        init_ref_lists_valid_[0] = false;
+        init_ref_lists_valid_[1] = false;
         if (p_slice_header->field_pic_flag == 0) {
             for (i = 0; i < dpb_buffer_.dpb_size; i++) {
                 AvcPicture *p_ref_pic = &dpb_buffer_.frame_buffer_list[i];
@@ -2089,8 +2219,10 @@ ParserResult AvcVideoParser::SetupReflist(AvcSliceInfo *p_slice_info) {
                         p_ref_pic->frame_num_wrap = p_ref_pic->frame_num;
                     }
                     p_ref_pic->pic_num = p_ref_pic->frame_num_wrap;  // Eq. 8-28
+                    short_term_pic_num_index_.Insert(i, p_ref_pic->pic_num);
                 } else if (p_ref_pic->is_reference == kUsedForLongTerm) {
                     p_ref_pic->long_term_pic_num = p_ref_pic->long_term_frame_idx;  // Eq. 8-29
+                    long_term_pic_num_index_.Insert(i, p_ref_pic->long_term_pic_num);
                 }
             }
         } else {
@@ -2110,12 +2242,14 @@ ParserResult AvcVideoParser::SetupReflist(AvcSliceInfo *p_slice_info) {
                     } else {
                         p_ref_pic->pic_num = 2 * p_ref_pic->frame_num_wrap;  // Eq. 8-31
                     }
+                    short_term_pic_num_index_.Insert(i, p_ref_pic->pic_num);
                 } else if (p_ref_pic->is_reference == kUsedForLongTerm) {
                     if (((curr_pic_.pic_structure == kTopField) && (p_ref_pic->pic_structure == kTopField)) || ((curr_pic_.pic_structure == kBottomField) && (p_ref_pic->pic_structure == kBottomField))) {
                         p_ref_pic->long_term_pic_num = 2 * p_ref_pic->long_term_frame_idx + 1;  // Eq. 8-32
                     } else {
                         p_ref_pic->long_term_pic_num = 2 * p_ref_pic->long_term_frame_idx;  // Eq. 8-33
                     }
+                    long_term_pic_num_index_.Insert(i, p_ref_pic->long_term_pic_num);
                 }
             }
         }
@@ -2126,15 +2260,57 @@ ParserResult AvcVideoParser::SetupReflist(AvcSliceInfo *p_slice_info) {
         return PARSER_OK;
     }
 
-    // 8.2.4.2 Initialisation process for reference picture lists
-    if (p_slice_header->slice_type == kAvcSliceTypeP || p_slice_header->slice_type == kAvcSliceTypeP_5) {
+    // 8.2.4.2 Initialisation process for reference picture lists. The initial lists only depend on the DPB and the current picture
+    // for a slice type, so they are derived by the first P and the first B slice of the picture and copied to the following slices.
+    int list_type = (p_slice_header->slice_type == kAvcSliceTypeP || p_slice_header->slice_type == kAvcSliceTypeP_5) ? 0 : 1;
+    if (!init_ref_lists_valid_[list_type]) {
+        InitRefPicLists(list_type == 0, init_ref_list_0_[list_type], init_ref_list_1_);
+        init_ref_lists_valid_[list_type] = true;
+    }
+    memcpy(p_slice_info->ref_list_0_, init_ref_list_0_[list_type], sizeof(p_slice_info->ref_list_0_));
+    if (list_type == 1) {
+        memcpy(p_slice_info->ref_list_1_, init_ref_list_1_, sizeof(p_slice_info->ref_list_1_));
+    }
+
+    // 8.2.4.3 Modification process for reference picture lists
+    if (p_slice_header->ref_pic_list.ref_pic_list_modification_flag_l0 == 1) {
+        AvcPicture *ref_pic_list_x = p_slice_info->ref_list_0_; // RefPicListX
+        AvcListMod *p_list_mod = p_slice_header->ref_pic_list.modification_l0;
+        int num_ref_idx_lx_active = p_slice_header->num_ref_idx_l0_active_minus1 + 1;
+        if (ModifiyRefList(ref_pic_list_x, p_list_mod, num_ref_idx_lx_active, p_slice_header) != PARSER_OK) {
+            return PARSER_FAIL;
+        }
+    }
+
+    if (p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6) {
+        if (p_slice_header->ref_pic_list.ref_pic_list_modification_flag_l1 == 1) {
+            AvcPicture *ref_pic_list_x = p_slice_info->ref_list_1_; // RefPicListX
+            AvcListMod *p_list_mod = p_slice_header->ref_pic_list.modification_l1;
+            int num_ref_idx_lx_active = p_slice_header->num_ref_idx_l1_active_minus1 + 1;
+            if (ModifiyRefList(ref_pic_list_x, p_list_mod, num_ref_idx_lx_active, p_slice_header) != PARSER_OK) {
+                return PARSER_FAIL;
+            }
+        }
+    }
+    return PARSER_OK;
+}
+
+void AvcVideoParser::InitRefPicLists(bool is_p_slice, AvcPicture *ref_list_0, AvcPicture *ref_list_1) {
+    int i;
+
+    memset(ref_list_0, 0, sizeof(AvcPicture) * AVC_MAX_REF_PICTURE_NUM);
+    if (!is_p_slice) {
+        memset(ref_list_1, 0, sizeof(AvcPicture) * AVC_MAX_REF_PICTURE_NUM);
+    }
+
+    if (is_p_slice) {
         if (curr_pic_.pic_structure == kFrame) { // 8.2.4.2.1 Initialisation process for the reference picture list for P and SP slices in frames
             // Group short term ref pictures
             int ref_index = 0;
             for (i = 0; i < dpb_buffer_.dpb_size; i++) {
                 AvcPicture *p_ref_pic = &dpb_buffer_.frame_buffer_list[i];
                 if (p_ref_pic->is_reference == kUsedForShortTerm) {
-                    p_slice_info->ref_list_0_[ref_index] = *p_ref_pic;
+                    ref_list_0[ref_index] = *p_ref_pic;
                     ref_index++;
                 }
             }
@@ -2142,17 +2318,17 @@ ParserResult AvcVideoParser::SetupReflist(AvcSliceInfo *p_slice_info) {
             for (i = 0; i < dpb_buffer_.dpb_size; i++) {
                 AvcPicture *p_ref_pic = &dpb_buffer_.frame_buffer_list[i];
                 if (p_ref_pic->is_reference == kUsedForLongTerm) {
-                    p_slice_info->ref_list_0_[ref_index] = *p_ref_pic;
+                    ref_list_0[ref_index] = *p_ref_pic;
                     ref_index++;
                 }
             }
             // Sort short term refs with descending order of pic_num
             if (dpb_buffer_.num_short_term > 1) {
-                qsort((void*)p_slice_info->ref_list_0_, dpb_buffer_.num_short_term, sizeof(AvcPicture), ComparePicNumDesc);
+                qsort((void*)ref_list_0, dpb_buffer_.num_short_term, sizeof(AvcPicture), ComparePicNumDesc);
             }
             // Sort long term refs with ascending order of long_term_pic_num
             if (dpb_buffer_.num_long_term > 1) {
-                qsort((void*)&p_slice_info->ref_list_0_[dpb_buffer_.num_short_term], dpb_buffer_.num_long_term, sizeof(AvcPicture), CompareLongTermPicNumAsc);
+                qsort((void*)&ref_list_0[dpb_buffer_.num_short_term], dpb_buffer_.num_long_term, sizeof(AvcPicture), CompareLongTermPicNumAsc);
             }
         } else { // 8.2.4.2.2 Initialisation process for the reference picture list for P and SP slices in fields
             // Construct and sort refFrameList0ShortTerm
@@ -2169,7 +2345,7 @@ ParserResult AvcVideoParser::SetupReflist(AvcSliceInfo *p_slice_info) {
                 qsort((void*)ref_frame_list0_short_term, index, sizeof(AvcPicture), CompareFrameNumWrapDesc);
             }
 
-            FillFieldRefList(ref_frame_list0_short_term, index, kUsedForShortTerm, curr_pic_.pic_structure, p_slice_info->ref_list_0_, &dpb_buffer_.num_short_term_ref_fields);
+            FillFieldRefList(ref_frame_list0_short_term, index, kUsedForShortTerm, curr_pic_.pic_structure, ref_list_0, &dpb_buffer_.num_short_term_ref_fields);
 
             // Construct and sort refFrameList0LongTerm
             AvcPicture ref_frame_list0_long_term[AVC_MAX_REF_FRAME_NUM] = {0};
@@ -2185,7 +2361,7 @@ ParserResult AvcVideoParser::SetupReflist(AvcSliceInfo *p_slice_info) {
                 qsort((void*)ref_frame_list0_long_term, index, sizeof(AvcPicture), CompareLongTermFrameIdxAsc);
             }
             if (index > 0) {
-                FillFieldRefList(ref_frame_list0_long_term, index, kUsedForLongTerm, curr_pic_.pic_structure, &p_slice_info->ref_list_0_[dpb_buffer_.num_short_term_ref_fields], &dpb_buffer_.num_long_term_ref_fields);
+                FillFieldRefList(ref_frame_list0_long_term, index, kUsedForLongTerm, curr_pic_.pic_structure, &ref_list_0[dpb_buffer_.num_short_term_ref_fields], &dpb_buffer_.num_long_term_ref_fields);
             }
         }
     } else {
@@ -2199,42 +2375,42 @@ ParserResult AvcVideoParser::SetupReflist(AvcSliceInfo *p_slice_info) {
             for (i = 0; i < dpb_buffer_.dpb_size; i++) {
                 AvcPicture *p_ref_pic = &dpb_buffer_.frame_buffer_list[i];
                 if (p_ref_pic->is_reference == kUsedForShortTerm && p_ref_pic->pic_order_cnt < curr_pic_.pic_order_cnt) {
-                    p_slice_info->ref_list_0_[ref_index] = *p_ref_pic;
+                    ref_list_0[ref_index] = *p_ref_pic;
                     num_short_term_smaller++;
                     ref_index++;
                 }
             }
             // Sort in descending order of POC
             if (num_short_term_smaller > 1) {
-                qsort((void*)p_slice_info->ref_list_0_, num_short_term_smaller, sizeof(AvcPicture), ComparePocDesc);
+                qsort((void*)ref_list_0, num_short_term_smaller, sizeof(AvcPicture), ComparePocDesc);
             }
 
             // Group short term ref pictures that have greater POC than the current picture
             for (i = 0; i < dpb_buffer_.dpb_size; i++) {
                 AvcPicture *p_ref_pic = &dpb_buffer_.frame_buffer_list[i];
                 if (p_ref_pic->is_reference == kUsedForShortTerm && p_ref_pic->pic_order_cnt > curr_pic_.pic_order_cnt) {
-                    p_slice_info->ref_list_0_[ref_index] = *p_ref_pic;
+                    ref_list_0[ref_index] = *p_ref_pic;
                     num_short_term_greater++;
                     ref_index++;
                 }
             }
             // Sort in ascending order of POC
             if (num_short_term_greater > 1) {
-                qsort((void*)&p_slice_info->ref_list_0_[num_short_term_smaller], num_short_term_greater, sizeof(AvcPicture), ComparePocAsc);
+                qsort((void*)&ref_list_0[num_short_term_smaller], num_short_term_greater, sizeof(AvcPicture), ComparePocAsc);
             }
 
             // Group long term ref pictures
             for (i = 0; i < dpb_buffer_.dpb_size; i++) {
                 AvcPicture *p_ref_pic = &dpb_buffer_.frame_buffer_list[i];
                 if (p_ref_pic->is_reference == kUsedForLongTerm) {
-                    p_slice_info->ref_list_0_[ref_index] = *p_ref_pic;
+                    ref_list_0[ref_index] = *p_ref_pic;
                     num_long_term++;
                     ref_index++;
                 }
             }
             // Sort long term refs with ascending order of long_term_pic_num
             if (num_long_term > 1) {
-                qsort((void*)&p_slice_info->ref_list_0_[num_short_term_smaller + num_short_term_greater], num_long_term, sizeof(AvcPicture), CompareLongTermPicNumAsc);
+                qsort((void*)&ref_list_0[num_short_term_smaller + num_short_term_greater], num_long_term, sizeof(AvcPicture), CompareLongTermPicNumAsc);
             }
 
             // RefPicList1
@@ -2247,42 +2423,42 @@ ParserResult AvcVideoParser::SetupReflist(AvcSliceInfo *p_slice_info) {
             for (i = 0; i < dpb_buffer_.dpb_size; i++) {
                 AvcPicture *p_ref_pic = &dpb_buffer_.frame_buffer_list[i];
                 if (p_ref_pic->is_reference == kUsedForShortTerm && p_ref_pic->pic_order_cnt > curr_pic_.pic_order_cnt) {
-                    p_slice_info->ref_list_1_[ref_index] = *p_ref_pic;
+                    ref_list_1[ref_index] = *p_ref_pic;
                     num_short_term_greater++;
                     ref_index++;
                 }
             }
             // Sort in ascending order of POC
             if (num_short_term_greater > 1) {
-                qsort((void*)p_slice_info->ref_list_1_, num_short_term_greater, sizeof(AvcPicture), ComparePocAsc);
+                qsort((void*)ref_list_1, num_short_term_greater, sizeof(AvcPicture), ComparePocAsc);
             }
 
             // Group short term ref pictures that have smaller POC than the current picture
             for (i = 0; i < dpb_buffer_.dpb_size; i++) {
                 AvcPicture *p_ref_pic = &dpb_buffer_.frame_buffer_list[i];
                 if (p_ref_pic->is_reference == kUsedForShortTerm && p_ref_pic->pic_order_cnt < curr_pic_.pic_order_cnt) {
-                    p_slice_info->ref_list_1_[ref_index] = *p_ref_pic;
+                    ref_list_1[ref_index] = *p_ref_pic;
                     num_short_term_smaller++;
                     ref_index++;
                 }
             }
             // Sort in descending order of POC
             if (num_short_term_smaller > 1) {
-                qsort((void*)&p_slice_info->ref_list_1_[num_short_term_greater], num_short_term_smaller, sizeof(AvcPicture), ComparePocDesc);
+                qsort((void*)&ref_list_1[num_short_term_greater], num_short_term_smaller, sizeof(AvcPicture), ComparePocDesc);
             }
  
             // Group long term ref pictures
             for (i = 0; i < dpb_buffer_.dpb_size; i++) {
                 AvcPicture *p_ref_pic = &dpb_buffer_.frame_buffer_list[i];
                 if (p_ref_pic->is_reference == kUsedForLongTerm) {
-                    p_slice_info->ref_list_1_[ref_index] = *p_ref_pic;
+                    ref_list_1[ref_index] = *p_ref_pic;
                     num_long_term++;
                     ref_index++;
                 }
             }
             // Sort long term refs with ascending order of long_term_pic_num
             if (num_long_term > 1) {
-                qsort((void*)&p_slice_info->ref_list_1_[num_short_term_smaller + num_short_term_greater], num_long_term, sizeof(AvcPicture), CompareLongTermPicNumAsc);
+                qsort((void*)&ref_list_1[num_short_term_smaller + num_short_term_greater], num_long_term, sizeof(AvcPicture), CompareLongTermPicNumAsc);
             }
         } else { // 8.2.4.2.4 Initialisation process for reference picture lists for B slices in fields
             // ===========
@@ -2318,7 +2494,7 @@ ParserResult AvcVideoParser::SetupReflist(AvcSliceInfo *p_slice_info) {
                 qsort((void*)&ref_frame_list0_short_term[num_short_term_smaller], num_short_term_greater, sizeof(AvcPicture), ComparePocAsc);
             }
 
-            FillFieldRefList(ref_frame_list0_short_term, num_short_term_smaller + num_short_term_greater, kUsedForShortTerm, curr_pic_.pic_structure, p_slice_info->ref_list_0_, &dpb_buffer_.num_short_term_ref_fields);
+            FillFieldRefList(ref_frame_list0_short_term, num_short_term_smaller + num_short_term_greater, kUsedForShortTerm, curr_pic_.pic_structure, ref_list_0, &dpb_buffer_.num_short_term_ref_fields);
 
             // Construct and sort refFrameListLongTerm
             AvcPicture ref_frame_list_long_term[AVC_MAX_REF_FRAME_NUM] = {0};
@@ -2336,7 +2512,7 @@ ParserResult AvcVideoParser::SetupReflist(AvcSliceInfo *p_slice_info) {
                 qsort((void*)ref_frame_list_long_term, num_long_term, sizeof(AvcPicture), CompareLongTermFrameIdxAsc);
             }
             if (num_long_term > 0) {
-                FillFieldRefList(ref_frame_list_long_term, num_long_term, kUsedForLongTerm, curr_pic_.pic_structure, &p_slice_info->ref_list_0_[dpb_buffer_.num_short_term_ref_fields], &dpb_buffer_.num_long_term_ref_fields);
+                FillFieldRefList(ref_frame_list_long_term, num_long_term, kUsedForLongTerm, curr_pic_.pic_structure, &ref_list_0[dpb_buffer_.num_short_term_ref_fields], &dpb_buffer_.num_long_term_ref_fields);
             }
 
             // ===========
@@ -2373,34 +2549,12 @@ ParserResult AvcVideoParser::SetupReflist(AvcSliceInfo *p_slice_info) {
             }
 
             uint32_t num_ref_fields;
-            FillFieldRefList(ref_frame_list1_short_term, num_short_term_smaller + num_short_term_greater, kUsedForShortTerm, curr_pic_.pic_structure, p_slice_info->ref_list_1_, &num_ref_fields);
+            FillFieldRefList(ref_frame_list1_short_term, num_short_term_smaller + num_short_term_greater, kUsedForShortTerm, curr_pic_.pic_structure, ref_list_1, &num_ref_fields);
             if (num_long_term > 0) {
-                FillFieldRefList(ref_frame_list_long_term, num_long_term, kUsedForLongTerm, curr_pic_.pic_structure, &p_slice_info->ref_list_1_[num_ref_fields], &num_ref_fields);
-            }
-        }
-    }
-
-    // 8.2.4.3 Modification process for reference picture lists
-    if (p_slice_header->ref_pic_list.ref_pic_list_modification_flag_l0 == 1) {
-        AvcPicture *ref_pic_list_x = p_slice_info->ref_list_0_; // RefPicListX
-        AvcListMod *p_list_mod = p_slice_header->ref_pic_list.modification_l0;
-        int num_ref_idx_lx_active = p_slice_header->num_ref_idx_l0_active_minus1 + 1;
-        if (ModifiyRefList(ref_pic_list_x, p_list_mod, num_ref_idx_lx_active, p_slice_header) != PARSER_OK) {
-            return PARSER_FAIL;
-        }
-    }
-
-    if (p_slice_header->slice_type == kAvcSliceTypeB || p_slice_header->slice_type == kAvcSliceTypeB_6) {
-        if (p_slice_header->ref_pic_list.ref_pic_list_modification_flag_l1 == 1) {
-            AvcPicture *ref_pic_list_x = p_slice_info->ref_list_1_; // RefPicListX
-            AvcListMod *p_list_mod = p_slice_header->ref_pic_list.modification_l1;
-            int num_ref_idx_lx_active = p_slice_header->num_ref_idx_l1_active_minus1 + 1;
-            if (ModifiyRefList(ref_pic_list_x, p_list_mod, num_ref_idx_lx_active, p_slice_header) != PARSER_OK) {
-                return PARSER_FAIL;
+                FillFieldRefList(ref_frame_list_long_term, num_long_term, kUsedForLongTerm, curr_pic_.pic_structure, &ref_list_1[num_ref_fields], &num_ref_fields);
             }
         }
     }
-    return PARSER_OK;
 }
 
 void AvcVideoParser::FillFieldRefList(AvcPicture *ref_frame_list_x, int num_ref_frames, int ref_type, int curr_field_parity, AvcPicture *ref_pic_list_x, uint32_t *num_fields_filled) {
@@ -2457,10 +2611,9 @@ ParserResult AvcVideoParser::ModifiyRefList(AvcPicture *ref_pic_list_x, AvcListM
     int pic_num_lx_pred = curr_pic_num; // picNumLXPred
     int max_frame_num = 1 << (p_sps->log2_max_frame_num_minus4 + 4); // MaxFrameNum
     int max_pic_num = p_slice_header->field_pic_flag ? 2 * max_frame_num : max_frame_num;
-    int num_short_term_pics = curr_pic_.pic_structure == kFrame ? dpb_buffer_.num_short_term : dpb_buffer_.num_short_term_ref_fields;
-    int num_long_term_pics = curr_pic_.pic_structure == kFrame ? dpb_buffer_.num_long_term : dpb_buffer_.num_long_term_ref_fields;
+    AvcPicture *p_ref_pics = curr_pic_.pic_structure == kFrame ? dpb_buffer_.frame_buffer_list : dpb_buffer_.field_pic_list;
     AvcPicture ref_pic_list_mod[AVC_MAX_REF_PICTURE_NUM + 1];
-    int i, c_idx, n_idx;
+    int ref_pic_idx, c_idx, n_idx;
 
     memcpy(ref_pic_list_mod, ref_pic_list_x, sizeof(AvcPicture) * num_ref_idx_lx_active);
 
@@ -2497,16 +2650,11 @@ ParserResult AvcVideoParser::ModifiyRefList(AvcPicture *ref_pic_list_x, AvcListM
             }
             // (8-37)
             // Find short-term reference picture with PicNum equal to pic_num_lx
-            for (i = 0; i < num_short_term_pics; i++) {
-                if (ref_pic_list_x[i].is_reference == kUsedForShortTerm && ref_pic_list_x[i].pic_num == pic_num_lx) {
-                    break;
-                }
-            }
-            if (i == num_short_term_pics) {
+            if ((ref_pic_idx = FindRefPicIndex(pic_num_lx, kUsedForShortTerm)) < 0) {
                 ERR("Could not find a short-term reference with the modified pic num.");
                 return PARSER_OUT_OF_RANGE;
             }
-            ref_pic_list_mod[ref_idx_lx] = ref_pic_list_x[i];
+            ref_pic_list_mod[ref_idx_lx] = p_ref_pics[ref_pic_idx];
             ref_idx_lx++;
             n_idx = ref_idx_lx;
             for (c_idx = ref_idx_lx; c_idx <= num_ref_idx_lx_active; c_idx++) {
@@ -2524,16 +2672,11 @@ ParserResult AvcVideoParser::ModifiyRefList(AvcPicture *ref_pic_list_x, AvcListM
             }
             // (8-38)
             // Find long-term reference picture with LongTermPicNum equal to long_term_pic_num
-            for (i = num_short_term_pics; i < num_short_term_pics + num_long_term_pics; i++) {
-                if (ref_pic_list_x[i].is_reference == kUsedForLongTerm && ref_pic_list_x[i].long_term_pic_num == p_list_mod->long_term_pic_num) {
-                    break;
-                }
-            }
-            if (i == num_short_term_pics + num_long_term_pics) {
+            if ((ref_pic_idx = FindRefPicIndex(p_list_mod->long_term_pic_num, kUsedForLongTerm)) < 0) {
                 ERR("Could not find long-term reference with the modified long term pic num.");
                 return PARSER_OUT_OF_RANGE;
             }
-            ref_pic_list_mod[ref_idx_lx] = ref_pic_list_x[i];
+            ref_pic_list_mod[ref_idx_lx] = p_ref_pics[ref_pic_idx];
             ref_idx_lx++;
             n_idx = ref_idx_lx;
             for (c_idx = ref_idx_lx; c_idx <= num_ref_idx_lx_active; c_idx++) {
@@ -2543,14 +2686,48 @@ ParserResult AvcVideoParser::ModifiyRefList(AvcPicture *ref_pic_list_x, AvcListM
                 }
             }
         }
-        p_list_mod = &p_slice_header->ref_pic_list.modification_l0[ref_idx_lx];
+        // Each operation inserts one entry, so the next one is at ref_idx_lx of the list (L0 or L1) being modified
+        p_list_mod++;
     }
 
     memcpy(ref_pic_list_x, ref_pic_list_mod, sizeof(AvcPicture) * num_ref_idx_lx_active);
     return PARSER_OK;
 }
 
+int AvcVideoParser::FindRefPicIndex(int pic_num, int ref_type) {
+    AvcPicture *p_ref_pics = curr_pic_.pic_structure == kFrame ? dpb_buffer_.frame_buffer_list : dpb_buffer_.field_pic_list;
+    int index = ref_type == kUsedForShortTerm ? short_term_pic_num_index_.Find(pic_num) : long_term_pic_num_index_.Find(pic_num);
+    // The indexes are set up before the marking process, so check the picture is still a reference of the requested type
+    if (index < 0 || p_ref_pics[index].is_reference != ref_type) {
+        return -1;
+    }
+    return index;
+}
+
 ParserResult AvcVideoParser::CheckDpbAndOutput() {
+    // Zero reorder fast path: output the current picture right after its decode submission instead of waiting for the DPB to be full.
+    // The previous pictures have been output the same way, so the output order is kept.
+    if (curr_pic_.pic_output_flag && IsNoReorderSequence(&sps_list_[active_sps_id_])) {
+        for (int i = 0; i < dpb_buffer_.dpb_size; i++) {
+            if (dpb_buffer_.frame_buffer_list[i].pic_idx == curr_pic_.pic_idx && dpb_buffer_.frame_buffer_list[i].pic_output_flag) {
+                dpb_buffer_.frame_buffer_list[i].pic_output_flag = 0;
+                if (dpb_buffer_.num_pics_needed_for_output > 0) {
+                    dpb_buffer_.num_pics_needed_for_output--;
+                }
+                // Insert into output/display picture list
+                if (pfn_display_picture_cb_) {
+                    if (num_output_pics_ >= dec_buf_pool_size_) {
+                        ERR("Error! Decode buffer pool overflow!");
+                        return PARSER_OUT_OF_RANGE;
+                    }
+                    output_pic_list_[num_output_pics_] = dpb_buffer_.frame_buffer_list[i].dec_buf_idx;
+                    num_output_pics_++;
+                }
+                break;
+            }
+        }
+    }
+
     // If DPB is full, bump one picture out
     if (dpb_buffer_.dpb_fullness == dpb_buffer_.dpb_size) {
         if (BumpPicFromDpb() != PARSER_OK) {
@@ -2566,6 +2743,19 @@ ParserResult AvcVideoParser::CheckDpbAndOutput() {
     return PARSER_OK;
 }
 
+bool AvcVideoParser::IsNoReorderSequence(AvcSeqParameterSet *p_sps) {
+    if (p_sps->vui_parameters_present_flag && p_sps->vui_seq_parameters.bitstream_restriction_flag) {
+        return p_sps->vui_seq_parameters.num_reorder_frames == 0;
+    }
+    // E.2.1: max_num_reorder_frames is inferred to be 0 for the intra profiles
+    if (p_sps->constraint_set3_flag && (p_sps->profile_idc == 44 || p_sps->profile_idc == 86 || p_sps->profile_idc == 100 ||
+        p_sps->profile_idc == 110 || p_sps->profile_idc == 122 || p_sps->profile_idc == 244)) {
+        return true;
+    }
+    // 8.2.1.3: pic_order_cnt_type 2 results in an output order that is the same as the decoding order
+    return p_sps->pic_order_cnt_type == 2;
+}
+
 ParserResult AvcVideoParser::FindFreeInDecBufPool() {
     int dec_buf_index;
 
@@ -2680,32 +2870,25 @@ ParserResult AvcVideoParser::MarkDecodedRefPics() {
                     case 1: { // 8.2.5.4.1 Marking process of a short-term reference picture as "unused for reference"
                         int curr_pic_num = p_slice_header->field_pic_flag ? 2 * p_slice_header->frame_num + 1 : p_slice_header->frame_num;
                         int pic_num_x = curr_pic_num - (p_mmco->difference_of_pic_nums_minus1 + 1);
-                        if (p_slice_header->field_pic_flag) {
-                            for (int j = 0; j < dpb_buffer_.dpb_size * 2; j++) {
-                                if (dpb_buffer_.field_pic_list[j].is_reference == kUsedForShortTerm && dpb_buffer_.field_pic_list[j].pic_num == pic_num_x) {
-                                    dpb_buffer_.field_pic_list[j].is_reference = kUnusedForReference;
+                        int j = FindRefPicIndex(pic_num_x, kUsedForShortTerm);
+                        if (j >= 0) {
+                            if (p_slice_header->field_pic_flag) {
+                                dpb_buffer_.field_pic_list[j].is_reference = kUnusedForReference;
+                                dpb_buffer_.num_short_term_ref_fields--;
+                                dpb_buffer_.frame_buffer_list[j / 2].is_reference = kUnusedForReference;
+                                if (dpb_buffer_.field_pic_list[(j / 2) * 2].is_reference == kUnusedForReference && dpb_buffer_.field_pic_list[(j / 2) * 2 + 1].is_reference == kUnusedForReference) {
+                                    dpb_buffer_.num_short_term--;
+                                }
+                            } else {
+                                dpb_buffer_.frame_buffer_list[j].is_reference = kUnusedForReference;
+                                dpb_buffer_.num_short_term--;
+                                if (dpb_buffer_.field_pic_list[j * 2].is_reference == kUsedForShortTerm) {
+                                    dpb_buffer_.field_pic_list[j * 2].is_reference = kUnusedForReference;
                                     dpb_buffer_.num_short_term_ref_fields--;
-                                    dpb_buffer_.frame_buffer_list[j / 2].is_reference = kUnusedForReference;
-                                    if (dpb_buffer_.field_pic_list[(j / 2) * 2].is_reference == kUnusedForReference && dpb_buffer_.field_pic_list[(j / 2) * 2 + 1].is_reference == kUnusedForReference) {
-                                        dpb_buffer_.num_short_term--;
-                                    }
-                                    break;
                                 }
-                            }
-                        } else {
-                            for (int j = 0; j < dpb_buffer_.dpb_size; j++) {
-                                if (dpb_buffer_.frame_buffer_list[j].is_reference == kUsedForShortTerm && dpb_buffer_.frame_buffer_list[j].pic_num == pic_num_x) {
-                                    dpb_buffer_.frame_buffer_list[j].is_reference = kUnusedForReference;
-                                    dpb_buffer_.num_short_term--;
-                                    if (dpb_buffer_.field_pic_list[j * 2].is_reference == kUsedForShortTerm) {
-                                        dpb_buffer_.field_pic_list[j * 2].is_reference = kUnusedForReference;
-                                        dpb_buffer_.num_short_term_ref_fields--;
-                                    }
-                                    if (dpb_buffer_.field_pic_list[j * 2 + 1].is_reference == kUsedForShortTerm) {
-                                        dpb_buffer_.field_pic_list[j * 2 + 1].is_reference = kUnusedForReference;
-                                        dpb_buffer_.num_short_term_ref_fields--;
-                                    }
-                                    break;
+                                if (dpb_buffer_.field_pic_list[j * 2 + 1].is_reference == kUsedForShortTerm) {
+                                    dpb_buffer_.field_pic_list[j * 2 + 1].is_reference = kUnusedForReference;
+                                    dpb_buffer_.num_short_term_ref_fields--;
                                 }
                             }
                         }
@@ -2713,32 +2896,25 @@ ParserResult AvcVideoParser::MarkDecodedRefPics() {
                     break;
 
                     case 2: { // 8.2.5.4.2 Marking process of a long-term reference picture as "unused for reference"
-                        if (p_slice_header->field_pic_flag) {
-                            for (int j = 0; j < dpb_buffer_.dpb_size * 2; j++) {
-                                if (dpb_buffer_.field_pic_list[j].is_reference == kUsedForLongTerm && dpb_buffer_.field_pic_list[j].long_term_pic_num == p_mmco->long_term_pic_num) {
-                                    dpb_buffer_.field_pic_list[j].is_reference = kUnusedForReference;
+                        int j = FindRefPicIndex(p_mmco->long_term_pic_num, kUsedForLongTerm);
+                        if (j >= 0) {
+                            if (p_slice_header->field_pic_flag) {
+                                dpb_buffer_.field_pic_list[j].is_reference = kUnusedForReference;
+                                dpb_buffer_.num_long_term_ref_fields--;
+                                dpb_buffer_.frame_buffer_list[j / 2].is_reference = kUnusedForReference;
+                                if (dpb_buffer_.field_pic_list[(j / 2) * 2].is_reference == kUnusedForReference && dpb_buffer_.field_pic_list[(j / 2) * 2 + 1].is_reference == kUnusedForReference) {
+                                    dpb_buffer_.num_long_term--;
+                                }
+                            } else {
+                                dpb_buffer_.frame_buffer_list[j].is_reference = kUnusedForReference;
+                                dpb_buffer_.num_long_term--;
+                                if (dpb_buffer_.field_pic_list[j * 2].is_reference == kUsedForLongTerm) {
+                                    dpb_buffer_.field_pic_list[j * 2].is_reference = kUnusedForReference;
                                     dpb_buffer_.num_long_term_ref_fields--;
-                                    dpb_buffer_.frame_buffer_list[j / 2].is_reference = kUnusedForReference;
-                                    if (dpb_buffer_.field_pic_list[(j / 2) * 2].is_reference == kUnusedForReference && dpb_buffer_.field_pic_list[(j / 2) * 2 + 1].is_reference == kUnusedForReference) {
-                                        dpb_buffer_.num_long_term--;
-                                    }
-                                    break;
                                 }
-                            }
-                        } else {
-                            for (int j = 0; j < dpb_buffer_.dpb_size; j++) {
-                                if (dpb_buffer_.frame_buffer_list[j].is_reference == kUsedForLongTerm && dpb_buffer_.frame_buffer_list[j].long_term_pic_num == p_mmco->long_term_pic_num) {
-                                    dpb_buffer_.frame_buffer_list[j].is_reference = kUnusedForReference;
-                                    dpb_buffer_.num_long_term--;
-                                    if (dpb_buffer_.field_pic_list[j * 2].is_reference == kUsedForLongTerm) {
-                                        dpb_buffer_.field_pic_list[j * 2].is_reference = kUnusedForReference;
-                                        dpb_buffer_.num_long_term_ref_fields--;
-                                    }
-                                    if (dpb_buffer_.field_pic_list[j * 2 + 1].is_reference == kUsedForLongTerm) {
-                                        dpb_buffer_.field_pic_list[j * 2 + 1].is_reference = kUnusedForReference;
-                                        dpb_buffer_.num_long_term_ref_fields--;
-                                    }
-                                    break;
+                                if (dpb_buffer_.field_pic_list[j * 2 + 1].is_reference == kUsedForLongTerm) {
+                                    dpb_buffer_.field_pic_list[j * 2 + 1].is_reference = kUnusedForReference;
+                                    dpb_buffer_.num_long_term_ref_fields--;
                                 }
                             }
                         }
@@ -2773,42 +2949,35 @@ ParserResult AvcVideoParser::MarkDecodedRefPics() {
                             }
                         }
 
-                        if (p_slice_header->field_pic_flag) {
-                            for (int j = 0; j < dpb_buffer_.dpb_size * 2; j++) {
-                                if (dpb_buffer_.field_pic_list[j].is_reference == kUsedForShortTerm && dpb_buffer_.field_pic_list[j].pic_num == pic_num_x) {
-                                    dpb_buffer_.field_pic_list[j].is_reference = kUsedForLongTerm;
-                                    dpb_buffer_.field_pic_list[j].long_term_frame_idx = p_mmco->long_term_frame_idx;
+                        int j = FindRefPicIndex(pic_num_x, kUsedForShortTerm);
+                        if (j >= 0) {
+                            if (p_slice_header->field_pic_flag) {
+                                dpb_buffer_.field_pic_list[j].is_reference = kUsedForLongTerm;
+                                dpb_buffer_.field_pic_list[j].long_term_frame_idx = p_mmco->long_term_frame_idx;
+                                dpb_buffer_.num_short_term_ref_fields--;
+                                dpb_buffer_.num_long_term_ref_fields++;
+                                if (dpb_buffer_.field_pic_list[(j / 2) * 2].is_reference == kUsedForLongTerm && dpb_buffer_.field_pic_list[(j / 2) * 2 + 1].is_reference == kUsedForLongTerm ) {
+                                    dpb_buffer_.frame_buffer_list[j / 2].is_reference = kUsedForLongTerm;
+                                    dpb_buffer_.frame_buffer_list[j / 2].long_term_frame_idx = p_mmco->long_term_frame_idx;
+                                    dpb_buffer_.num_short_term--;
+                                    dpb_buffer_.num_long_term++;
+                                }
+                            } else {
+                                dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForLongTerm;
+                                dpb_buffer_.frame_buffer_list[j].long_term_frame_idx = p_mmco->long_term_frame_idx;
+                                dpb_buffer_.num_short_term--;
+                                dpb_buffer_.num_long_term++;
+                                if (dpb_buffer_.field_pic_list[j * 2].is_reference == kUsedForShortTerm) {
+                                    dpb_buffer_.field_pic_list[j * 2].is_reference = kUsedForLongTerm;
+                                    dpb_buffer_.field_pic_list[j * 2].long_term_frame_idx = p_mmco->long_term_frame_idx;
                                     dpb_buffer_.num_short_term_ref_fields--;
                                     dpb_buffer_.num_long_term_ref_fields++;
-                                    if (dpb_buffer_.field_pic_list[(j / 2) * 2].is_reference == kUsedForLongTerm && dpb_buffer_.field_pic_list[(j / 2) * 2 + 1].is_reference == kUsedForLongTerm ) {
-                                        dpb_buffer_.frame_buffer_list[j / 2].is_reference = kUsedForLongTerm;
-                                        dpb_buffer_.frame_buffer_list[j / 2].long_term_frame_idx = p_mmco->long_term_frame_idx;
-                                        dpb_buffer_.num_short_term--;
-                                        dpb_buffer_.num_long_term++;
-                                    }
-                                    break;
                                 }
-                            }
-                        } else {
-                            for (int j = 0; j < dpb_buffer_.dpb_size; j++) {
-                                if (dpb_buffer_.frame_buffer_list[j].is_reference == kUsedForShortTerm && dpb_buffer_.frame_buffer_list[j].pic_num == pic_num_x) {
-                                    dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForLongTerm;
-                                    dpb_buffer_.frame_buffer_list[j].long_term_frame_idx = p_mmco->long_term_frame_idx;
-                                    dpb_buffer_.num_short_term--;
-                                    dpb_buffer_.num_long_term++;
-                                    if (dpb_buffer_.field_pic_list[j * 2].is_reference == kUsedForShortTerm) {
-                                        dpb_buffer_.field_pic_list[j * 2].is_reference = kUsedForLongTerm;
-                                        dpb_buffer_.field_pic_list[j * 2].long_term_frame_idx = p_mmco->long_term_frame_idx;
-                                        dpb_buffer_.num_short_term_ref_fields--;
-                                        dpb_buffer_.num_long_term_ref_fields++;
-                                    }
-                                    if (dpb_buffer_.field_pic_list[j * 2 + 1].is_reference == kUsedForShortTerm) {
-                                        dpb_buffer_.field_pic_list[j * 2 + 1].is_reference = kUsedForLongTerm;
-                                        dpb_buffer_.field_pic_list[j * 2 + 1].long_term_frame_idx = p_mmco->long_term_frame_idx;
-                                        dpb_buffer_.num_short_term_ref_fields--;
-                                        dpb_buffer_.num_long_term_ref_fields++;
-                                    }
-                                    break;
+                                if (dpb_buffer_.field_pic_list[j * 2 + 1].is_reference == kUsedForShortTerm) {
+                                    dpb_buffer_.field_pic_list[j * 2 + 1].is_reference = kUsedForLongTerm;
+                                    dpb_buffer_.field_pic_list[j * 2 + 1].long_term_frame_idx = p_mmco->long_term_frame_idx;
+                                    dpb_buffer_.num_short_term_ref_fields--;
+                                    dpb_buffer_.num_long_term_ref_fields++;
                                 }
                             }
                         }
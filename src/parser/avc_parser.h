@@ -140,6 +140,14 @@ protected:
     // DPB
     AvcPicture curr_pic_;
     DecodedPictureBuffer dpb_buffer_;
+    // PicNum and LongTermPicNum of the reference pictures, set up once per picture. The slots are frame_buffer_list indexes
+    // for frame pictures and field_pic_list indexes for field pictures.
+    DpbKeyIndex<AVC_MAX_DPB_FIELDS, 32> short_term_pic_num_index_;
+    DpbKeyIndex<AVC_MAX_DPB_FIELDS, 32> long_term_pic_num_index_;
+    // Initial reference picture lists of the current picture (8.2.4.2) for P ([0]) and B ([1]) slices, derived by the first slice of the type
+    bool init_ref_lists_valid_[2] = {false, false};
+    AvcPicture init_ref_list_0_[2][AVC_MAX_REF_PICTURE_NUM];
+    AvcPicture init_ref_list_1_[AVC_MAX_REF_PICTURE_NUM];
 
     /*! \brief Function to notify decoder about video format change (new SPS) through callback
      * \param [in] p_sps Pointer to the current active SPS
@@ -147,11 +155,27 @@ protected:
      */
     ParserResult NotifyNewSps(AvcSeqParameterSet *p_sps);
 
+    /*! \brief Function to fill the picture parameters and the scaling lists of the current picture
+     */
+    void FillPicParams();
+
+    /*! \brief Function to fill the slice parameters of a slice of the current picture
+     * \param [in] slice_index Index of the slice in slice_info_list_
+     */
+    void FillSliceParams(int slice_index);
+
     /*! \brief Function to fill the decode parameters and call back decoder to decode a picture
      * \return <tt>ParserResult</tt>
      */
     ParserResult SendPicForDecode();
 
+    /*! \brief Function to submit the parsed slices of the current picture which have not been submitted yet as one batch
+     *         (RocdecParserParams::slice_submission). The first batch starts the picture.
+     * \param [in] last_batch The batch ends the picture
+     * \return <tt>ParserResult</tt>
+     */
+    ParserResult SendSliceBatch(bool last_batch);
+
     /*! \brief Callback function to send parsed SEI playload to decoder.
      */
     void SendSeiMsgPayload();
@@ -163,6 +187,13 @@ protected:
      */
     ParserResult ParsePictureData(const uint8_t *p_stream, uint32_t pic_data_size);
 
+    /*! \brief Function to classify a NAL unit for access unit boundary detection in byte stream mode (7.4.1.2.3). The first slice of a
+     *         picture is detected with first_mb_in_slice equal to 0, so arbitrary slice order is not supported in this mode.
+     * \param [in] nal_unit Pointer to the NAL unit header, followed by at least the first byte of the slice header
+     * \return <tt>AuNalType</tt>
+     */
+    virtual AuNalType GetAuNalType(const uint8_t *nal_unit);
+
     /*! \brief Function to parse the NAL unit header
      * \param [in] header_byte The AVC NAL unit header byte
      * \return <tt>AvcNalUnitHeader</tt> Parsed nal header
@@ -235,6 +266,14 @@ protected:
      */
     ParserResult SetupReflist(AvcSliceInfo *p_slice_info);
 
+    /*! \brief Function to derive the initial reference picture lists of the current picture for P or B slices. 8.2.4.2.
+     * \param [in] is_p_slice True for P slices (RefPicList0 only), false for B slices
+     * \param [out] ref_list_0 Initial RefPicList0 of AVC_MAX_REF_PICTURE_NUM entries
+     * \param [out] ref_list_1 Initial RefPicList1 of AVC_MAX_REF_PICTURE_NUM entries, for B slices
+     * \return None
+     */
+    void InitRefPicLists(bool is_p_slice, AvcPicture *ref_list_0, AvcPicture *ref_list_1);
+
     /*! \brief Function to perform initialisation process for reference picture lists in fields. 8.2.4.2.5.
      * \param [in] ref_frame_list_x The reference frame lists refFrameListXShortTerm (with X may be 0 or 1) or refFrameListLongTerm
      * \param [in] num_ref_frames The number of sorted reference frames in the list
@@ -255,11 +294,25 @@ protected:
      */
     ParserResult ModifiyRefList(AvcPicture *ref_pic_list_x, AvcListMod *p_list_mod, int num_ref_idx_lx_active, AvcSliceHeader *p_slice_header);
 
+    /*! \brief Function to find a reference picture of the current picture by its picture number
+     * \param [in] pic_num PicNum of a short-term reference picture or LongTermPicNum of a long-term reference picture
+     * \param [in] ref_type kUsedForShortTerm or kUsedForLongTerm
+     * \return Index of the picture in frame_buffer_list for frame pictures or field_pic_list for field pictures, -1 if not found
+     */
+    int FindRefPicIndex(int pic_num, int ref_type);
+
     /*! \brief Function to check the fullness of DPB and output picture if needed.
      * \return <tt>ParserResult</tt>
      */
     ParserResult CheckDpbAndOutput();
 
+    /*! \brief Function to check if the output order of the sequence is the decoding order: num_reorder_frames is 0 in the VUI or inferred
+     *         to be 0 (intra profiles), or pic_order_cnt_type is 2
+     * \param [in] p_sps Pointer to the active SPS
+     * \return true if the pictures are never reordered
+     */
+    bool IsNoReorderSequence(AvcSeqParameterSet *p_sps);
+
     /*! \brief Function to find a free buffer in the decode buffer pool
      *  \return <tt>ParserResult</tt>
      */
@@ -21,6 +21,7 @@ THE SOFTWARE.
 */
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 #define MAX_VPS_COUNT 16    // 7.3.2.1
@@ -294,8 +295,8 @@ typedef struct {
     bool vui_poc_proportional_to_timing_flag;            //u(1)
     uint32_t vui_num_ticks_poc_diff_one_minus1;          //ue(v)
     bool vui_hrd_parameters_present_flag;                //u(1)
-    //hrd_parameters()
-    HevcHrdParameters hrd_parameters;
+    //hrd_parameters(), allocated on demand and kept for re-parsing; valid when vui_hrd_parameters_present_flag is set
+    HevcHrdParameters *hrd_parameters;
     bool bitstream_restriction_flag;                     //u(1)
     bool tiles_fixed_structure_flag;                     //u(1)
     bool motion_vectors_over_pic_boundaries_flag;        //u(1)
@@ -355,20 +356,22 @@ typedef struct {
     uint32_t vps_max_latency_increase_plus1[7];          //ue(v)
     uint32_t vps_max_layer_id;                           //u(6)
     uint32_t vps_num_layer_sets_minus1;                  //ue(v)
-    //vps_num_layer_sets_minus1 max is  1023  (dont +1 since starts from 1)
-    //vps_max_layer_id max is 62                   (+1 since starts from 0 and <= condition)
-    bool layer_id_included_flag[1023][63];               //u(1)
+    //vps_num_layer_sets_minus1 max is  1023, vps_max_layer_id max is 62 (+1 since starts from 0 and <= condition)
+    //allocated on demand for vps_num_layer_sets_minus1 + 1 layer sets, indexed from 1
+    bool (*layer_id_included_flag)[63];                  //u(1)
+    uint32_t num_layer_sets_allocated;
     bool vps_timing_info_present_flag;                   //u(1)
     uint32_t vps_num_units_in_tick;                      //u(32)
     uint32_t vps_time_scale;                             //u(32)
     bool vps_poc_proportional_to_timing_flag;            //u(1)
     uint32_t vps_num_ticks_poc_diff_one_minus1;          //ue(v)
     uint32_t vps_num_hrd_parameters;                     //ue(v)
-    //vps_num_hrd_parameters max is 1024
-    uint32_t hrd_layer_set_idx[1024];                    //ue(v)
-    bool cprms_present_flag[1024];                       //u(1)
+    //vps_num_hrd_parameters max is 1024, the arrays below are allocated on demand for vps_num_hrd_parameters entries
+    uint32_t *hrd_layer_set_idx;                         //ue(v)
+    bool *cprms_present_flag;                            //u(1)
     //hrd_parameters()
-    HevcHrdParameters hrd_parameters[1024];
+    HevcHrdParameters *hrd_parameters;
+    uint32_t num_hrd_parameters_allocated;
     bool vps_extension_flag;                             //u(1)
     bool vps_extension_data_flag;                        //u(1)
     //rbsp_trailing_bits()
@@ -412,8 +415,8 @@ typedef struct {
     uint32_t max_transform_hierarchy_depth_intra;        //ue(v)
     bool scaling_list_enabled_flag;                      //u(1)
     bool sps_scaling_list_data_present_flag;             //u(1)
-    //scaling_list_data()
-    HevcScalingListData scaling_list_data;
+    //scaling_list_data(), allocated on demand and kept for re-parsing; valid when scaling_list_enabled_flag is set
+    HevcScalingListData *scaling_list_data;
     bool amp_enabled_flag;                               //u(1)
     bool sample_adaptive_offset_enabled_flag;            //u(1)
     bool pcm_enabled_flag;                               //u(1)
@@ -485,8 +488,9 @@ typedef struct {
     int32_t pps_beta_offset_div2;                        //se(v)
     int32_t pps_tc_offset_div2;                          //se(v)
     bool pps_scaling_list_data_present_flag;             //u(1)
-    //scaling_list_data( )
-    HevcScalingListData scaling_list_data;
+    //scaling_list_data( ), allocated on demand and kept for re-parsing; valid when pps_scaling_list_data_present_flag is set.
+    //Otherwise the scaling lists of the active SPS apply.
+    HevcScalingListData *scaling_list_data;
     bool lists_modification_present_flag;                //u(1)
     uint32_t log2_parallel_merge_level_minus2;           //ue(v)
     bool slice_segment_header_extension_present_flag;    //u(1)
@@ -512,11 +516,13 @@ typedef struct {
 /*! \brief Structure for Slice Segment Header
  */
 typedef struct {
+    // Slice segment fields
     bool first_slice_segment_in_pic_flag;                //u(1)
     bool no_output_of_prior_pics_flag;                   //u(1)
     uint32_t slice_pic_parameter_set_id;                 //ue(v)
     bool dependent_slice_segment_flag;                   //u(1)
     uint32_t slice_segment_address;                      //u(v)
+    // Slice header fields, inferred from the preceding slice segment for a dependent slice segment (7.4.7.1)
     //num_extra_slice_header_bits is u(3), so max is 7
     bool slice_reserved_flag[7];                         //u(1)
     uint32_t slice_type;                                 //ue(v)
@@ -563,6 +569,7 @@ typedef struct {
     int32_t slice_beta_offset_div2;                      //se(v)
     int32_t slice_tc_offset_div2;                        //se(v)
     bool slice_loop_filter_across_slices_enabled_flag;   //u(1)
+    // Slice segment fields
     uint32_t num_entry_point_offsets;                    //ue(v)
     uint32_t offset_len_minus1;                          //ue(v)
     uint32_t entry_point_offset_minus1[MAX_ENTRY_POINT_OFFSETS]; //u(v)
@@ -571,3 +578,7 @@ typedef struct {
     uint8_t slice_segment_header_extension_data_byte[256];    //u(8)
 } HevcSliceSegHeader;
 
+// Byte ranges of HevcSliceSegHeader: the leading slice segment fields and the slice header fields a dependent slice segment inherits
+static constexpr size_t kSliceSegFieldsSize = offsetof(HevcSliceSegHeader, slice_reserved_flag);
+static constexpr size_t kInheritedSliceFieldsSize = offsetof(HevcSliceSegHeader, num_entry_point_offsets) - kSliceSegFieldsSize;
+
@@ -22,16 +22,15 @@ THE SOFTWARE.
 
 #include "hevc_parser.h"
 
+/*! \brief Function to get a zero initialized array of count structs, re-using the array p of allocated_cnt structs when it is large enough
+ * and allocating a new one from the arena otherwise
+ */
 template <typename T>
-inline T *AllocStruct(const int max_cnt) {
-    T *p = nullptr;
-    try {
-        p = (max_cnt == 1) ? new T : new T [max_cnt];
+inline T *ReuseOrAllocStruct(ParserArena &arena, T *p, uint32_t count, uint32_t allocated_cnt) {
+    if (p == nullptr || count > allocated_cnt) {
+        return arena.Alloc<T>(count);
     }
-    catch(const std::exception& e) {
-        ERR(STR("Failed to alloc HEVC header struct Data, ") + STR(e.what()))
-    }
-    memset(p, 0, sizeof(T) * max_cnt);
+    memset(p, 0, sizeof(T) * count);
     return p;
 }
 
@@ -40,11 +39,6 @@ HevcVideoParser::HevcVideoParser() {
     m_active_vps_id_ = -1; 
     m_active_sps_id_ = -1;
     m_active_pps_id_ = -1;
-    // allocate all fixed size structors here
-    m_vps_ = AllocStruct<HevcVideoParamSet>(MAX_VPS_COUNT);
-    m_sps_ = AllocStruct<HevcSeqParamSet>(MAX_SPS_COUNT);
-    m_pps_ = AllocStruct<HevcPicParamSet>(MAX_PPS_COUNT);
-    m_sh_copy_ = AllocStruct<HevcSliceSegHeader>(1);
     slice_info_list_.assign(INIT_SLICE_LIST_NUM, {0});
     slice_param_list_.assign(INIT_SLICE_LIST_NUM, {0});
 
@@ -53,18 +47,7 @@ HevcVideoParser::HevcVideoParser() {
 }
 
 HevcVideoParser::~HevcVideoParser() {
-    if (m_vps_) {
-        delete [] m_vps_;
-    }
-    if (m_sps_) {
-        delete [] m_sps_;
-    }
-    if (m_pps_) {
-        delete [] m_pps_;
-    }
-    if (m_sh_copy_) {
-        delete m_sh_copy_;
-    }
+    // The parameter sets are released with param_set_arena_
 }
 
 rocDecStatus HevcVideoParser::Initialize(RocdecParserParams *p_params) {
@@ -78,15 +61,30 @@ rocDecStatus HevcVideoParser::UnInitialize() {
 
 rocDecStatus HevcVideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) {
     if (p_data->payload && p_data->payload_size) {
-        curr_pts_ = p_data->pts;
+        if (!au_in_progress_) {
+            curr_pts_ = p_data->pts;
+        }
+        end_of_picture_ = (p_data->flags & ROCDEC_PKT_ENDOFPICTURE) != 0;
         if (ParsePictureData(p_data->payload, p_data->payload_size) != PARSER_OK) {
             ERR(STR("Parser failed!"));
+            au_in_progress_ = false;
             return ROCDEC_RUNTIME_ERROR;
         }
 
+        // The access unit continues in the next packet: submit the slices of this one, which are not the last ones of the picture
+        if (partial_au_) {
+            au_in_progress_ = true;
+            if (num_slices_ > num_submitted_slices_ && SendSliceBatch(false) != PARSER_OK) {
+                ERR(STR("Failed to decode!"));
+                return ROCDEC_RUNTIME_ERROR;
+            }
+            return ROCDEC_SUCCESS;
+        }
+        au_in_progress_ = false;
+
         // Init Roc decoder for the first time or reconfigure the existing decoder
         if (new_seq_activated_) {
-            if (FillSeqCallbackFn(&m_sps_[m_active_sps_id_]) != PARSER_OK) {
+            if (FillSeqCallbackFn(m_sps_[m_active_sps_id_]) != PARSER_OK) {
                 return ROCDEC_RUNTIME_ERROR;
             }
             new_seq_activated_ = false;
@@ -102,8 +100,8 @@ rocDecStatus HevcVideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) {
             return ROCDEC_SUCCESS;
         }
 
-        // Decode the picture
-        if (SendPicForDecode() != PARSER_OK) {
+        // Decode the picture, or submit its remaining slices and end it
+        if ((parser_params_.slice_submission ? SendSliceBatch(true) : SendPicForDecode()) != PARSER_OK) {
             ERR(STR("Failed to decode!"));
             return ROCDEC_RUNTIME_ERROR;
         }
@@ -130,6 +128,19 @@ rocDecStatus HevcVideoParser::ParseVideoData(RocdecSourceDataPacket *p_data) {
     return ROCDEC_SUCCESS;
 }
 
+RocVideoParser::AuNalType HevcVideoParser::GetAuNalType(const uint8_t *nal_unit) {
+    uint32_t nal_unit_type = (nal_unit[0] >> 1) & 63;
+    if (nal_unit_type <= NAL_UNIT_RESERVED_VCL31) {
+        return (nal_unit[2] & 0x80) ? kAuNalFirstVcl : kAuNalVcl; // first_slice_segment_in_pic_flag
+    }
+    if ((nal_unit_type >= NAL_UNIT_VPS && nal_unit_type <= NAL_UNIT_ACCESS_UNIT_DELIMITER) || nal_unit_type == NAL_UNIT_PREFIX_SEI ||
+        (nal_unit_type >= NAL_UNIT_RESERVED_NVCL41 && nal_unit_type <= NAL_UNIT_RESERVED_NVCL44) ||
+        (nal_unit_type >= NAL_UNIT_UNSPECIFIED_48 && nal_unit_type <= NAL_UNIT_UNSPECIFIED_55)) {
+        return kAuNalPrefix;
+    }
+    return kAuNalOther;
+}
+
 int HevcVideoParser::FillSeqCallbackFn(HevcSeqParamSet* sps_data) {
     video_format_params_.codec = rocDecVideoCodec_HEVC;
     video_format_params_.frame_rate.numerator = frame_rate_.numerator;
@@ -212,13 +223,21 @@ int HevcVideoParser::FillSeqCallbackFn(HevcSeqParamSet* sps_data) {
     video_format_params_.display_aspect_ratio.x = disp_width / gcd;
     video_format_params_.display_aspect_ratio.y = disp_height / gcd;
 
-    if (sps_data->vui_parameters_present_flag) {
+    // values inferred when not present: unspecified video format (5), limited range, unspecified colour description (2)
+    video_format_params_.video_signal_description.video_format = 5;
+    video_format_params_.video_signal_description.video_full_range_flag = 0;
+    video_format_params_.video_signal_description.color_primaries = 2;
+    video_format_params_.video_signal_description.transfer_characteristics = 2;
+    video_format_params_.video_signal_description.matrix_coefficients = 2;
+    video_format_params_.video_signal_description.reserved_zero_bits = 0;
+    if (sps_data->vui_parameters_present_flag && sps_data->vui_parameters.video_signal_type_present_flag) {
         video_format_params_.video_signal_description.video_format = sps_data->vui_parameters.video_format;
         video_format_params_.video_signal_description.video_full_range_flag = sps_data->vui_parameters.video_full_range_flag;
-        video_format_params_.video_signal_description.color_primaries = sps_data->vui_parameters.colour_primaries;
-        video_format_params_.video_signal_description.transfer_characteristics = sps_data->vui_parameters.transfer_characteristics;
-        video_format_params_.video_signal_description.matrix_coefficients = sps_data->vui_parameters.matrix_coeffs;
-        video_format_params_.video_signal_description.reserved_zero_bits = 0;
+        if (sps_data->vui_parameters.colour_description_present_flag) {
+            video_format_params_.video_signal_description.color_primaries = sps_data->vui_parameters.colour_primaries;
+            video_format_params_.video_signal_description.transfer_characteristics = sps_data->vui_parameters.transfer_characteristics;
+            video_format_params_.video_signal_description.matrix_coefficients = sps_data->vui_parameters.matrix_coeffs;
+        }
     }
     video_format_params_.seqhdr_data_length = 0;
 
@@ -241,10 +260,10 @@ void HevcVideoParser::SendSeiMsgPayload() {
     if (pfn_get_sei_message_cb_) pfn_get_sei_message_cb_(parser_params_.user_data, &sei_message_info_params_);
 }
 
-int HevcVideoParser::SendPicForDecode() {
+void HevcVideoParser::FillPicParams() {
     int i, j, ref_idx, buf_idx;
-    HevcSeqParamSet *sps_ptr = &m_sps_[m_active_sps_id_];
-    HevcPicParamSet *pps_ptr = &m_pps_[m_active_pps_id_];
+    HevcSeqParamSet *sps_ptr = m_sps_[m_active_sps_id_];
+    HevcPicParamSet *pps_ptr = m_pps_[m_active_pps_id_];
     dec_pic_params_ = {0};
 
     dec_pic_params_.pic_width = sps_ptr->pic_width_in_luma_samples;
@@ -319,6 +338,10 @@ int HevcVideoParser::SendPicForDecode() {
     for (i = ref_idx; i < 15; i++) {
         pic_param_ptr->ref_frames[i].pic_idx = 0xFF;
     }
+    // Keep the buffer indices for the slice reference lists: the decoder maps ref_frames to its surfaces when the picture is started
+    for (i = 0; i < 15; i++) {
+        ref_frame_dec_buf_idx_[i] = pic_param_ptr->ref_frames[i].pic_idx;
+    }
 
     pic_param_ptr->picture_width_in_luma_samples = sps_ptr->pic_width_in_luma_samples;
     pic_param_ptr->picture_height_in_luma_samples = sps_ptr->pic_height_in_luma_samples;
@@ -400,118 +423,10 @@ int HevcVideoParser::SendPicForDecode() {
 
     pic_param_ptr->st_rps_bits = slice_info_list_[0].slice_header.short_term_ref_pic_set_size;
 
-    /// Fill slice parameters
-    // Resize if needed
-    if (num_slices_ > slice_param_list_.size()) {
-        slice_param_list_.resize(num_slices_, {0});
-    }
-    for (int slice_index = 0; slice_index < num_slices_; slice_index++) {
-        RocdecHevcSliceParams *slice_params_ptr = &slice_param_list_[slice_index];
-        HevcSliceInfo *p_slice_info = &slice_info_list_[slice_index];
-        HevcSliceSegHeader *p_slice_header = &p_slice_info->slice_header;
-
-        // We put all slices into one slice data buffer.
-        slice_params_ptr->slice_data_size = p_slice_info->slice_data_size;
-        slice_params_ptr->slice_data_offset = p_slice_info->slice_data_offset; // point to the start code
-        slice_params_ptr->slice_data_flag = 0x00; // VA_SLICE_DATA_FLAG_ALL;
-        slice_params_ptr->slice_data_byte_offset = 0;  // VCN consumes from the start code
-        slice_params_ptr->slice_segment_address = p_slice_header->slice_segment_address;
-
-        // Ref lists
-        memset(slice_params_ptr->ref_pic_list, 0xFF, sizeof(slice_params_ptr->ref_pic_list));
-        if (p_slice_header->slice_type != HEVC_SLICE_TYPE_I) {
-            for (i = 0; i <= p_slice_header->num_ref_idx_l0_active_minus1; i++) {
-                int idx = p_slice_info->ref_pic_list_0_[i]; // pic_idx of the ref pic
-                int dec_buf_idx = dpb_buffer_.frame_buffer_list[idx].dec_buf_idx;
-                for (j = 0; j < 15; j++) {
-                    if (pic_param_ptr->ref_frames[j].pic_idx == dec_buf_idx) {
-                        break;
-                    }
-                }
-                if (j == 15) {
-                    ERR("Could not find matching pic in ref_frames list. The slice type is P/B, and the idx from the ref_pic_list_0_ is: " + TOSTR(idx));
-                    return PARSER_FAIL;
-                } else {
-                    slice_params_ptr->ref_pic_list[0][i] = j;
-                }
-            }
-
-            if (p_slice_header->slice_type == HEVC_SLICE_TYPE_B) {
-                for (i = 0; i <= p_slice_header->num_ref_idx_l1_active_minus1; i++) {
-                    int idx = p_slice_info->ref_pic_list_1_[i]; // pic_idx of the ref pic
-                    int dec_buf_idx = dpb_buffer_.frame_buffer_list[idx].dec_buf_idx;
-                    for (j = 0; j < 15; j++) {
-                        if (pic_param_ptr->ref_frames[j].pic_idx == dec_buf_idx) {
-                            break;
-                        }
-                    }
-                    if (j == 15) {
-                        ERR("Could not find matching pic in ref_frames list. The slice type is B, and the idx from the ref_pic_list_1_ is: " + TOSTR(idx));
-                        return PARSER_FAIL;
-                    } else {
-                        slice_params_ptr->ref_pic_list[1][i] = j;
-                    }
-                }
-            }
-        }
-
-        slice_params_ptr->long_slice_flags.fields.last_slice_of_pic = (slice_index == num_slices_ - 1) ? 1 : 0;
-        slice_params_ptr->long_slice_flags.fields.dependent_slice_segment_flag = p_slice_header->dependent_slice_segment_flag;
-        slice_params_ptr->long_slice_flags.fields.slice_type = p_slice_header->slice_type;
-        slice_params_ptr->long_slice_flags.fields.color_plane_id = p_slice_header->colour_plane_id;
-        slice_params_ptr->long_slice_flags.fields.slice_sao_luma_flag = p_slice_header->slice_sao_luma_flag;
-        slice_params_ptr->long_slice_flags.fields.slice_sao_chroma_flag = p_slice_header->slice_sao_chroma_flag;
-        slice_params_ptr->long_slice_flags.fields.mvd_l1_zero_flag = p_slice_header->mvd_l1_zero_flag;
-        slice_params_ptr->long_slice_flags.fields.cabac_init_flag = p_slice_header->cabac_init_flag;
-        slice_params_ptr->long_slice_flags.fields.slice_temporal_mvp_enabled_flag = p_slice_header->slice_temporal_mvp_enabled_flag;
-        slice_params_ptr->long_slice_flags.fields.slice_deblocking_filter_disabled_flag = p_slice_header->slice_deblocking_filter_disabled_flag;
-        slice_params_ptr->long_slice_flags.fields.collocated_from_l0_flag = p_slice_header->collocated_from_l0_flag;
-        slice_params_ptr->long_slice_flags.fields.slice_loop_filter_across_slices_enabled_flag = p_slice_header->slice_loop_filter_across_slices_enabled_flag;
-
-        slice_params_ptr->collocated_ref_idx = p_slice_header->collocated_ref_idx;
-        slice_params_ptr->num_ref_idx_l0_active_minus1 = p_slice_header->num_ref_idx_l0_active_minus1;
-        slice_params_ptr->num_ref_idx_l1_active_minus1 = p_slice_header->num_ref_idx_l1_active_minus1;
-        slice_params_ptr->slice_qp_delta = p_slice_header->slice_qp_delta;
-        slice_params_ptr->slice_cb_qp_offset = p_slice_header->slice_cb_qp_offset;
-        slice_params_ptr->slice_cr_qp_offset = p_slice_header->slice_cr_qp_offset;
-        slice_params_ptr->slice_beta_offset_div2 = p_slice_header->slice_beta_offset_div2;
-        slice_params_ptr->slice_tc_offset_div2 = p_slice_header->slice_tc_offset_div2;
-
-        if ((pps_ptr->weighted_pred_flag && p_slice_header->slice_type == HEVC_SLICE_TYPE_P) || (pps_ptr->weighted_bipred_flag && p_slice_header->slice_type == HEVC_SLICE_TYPE_B)) {
-            slice_params_ptr->luma_log2_weight_denom = p_slice_header->pred_weight_table.luma_log2_weight_denom;
-            slice_params_ptr->delta_chroma_log2_weight_denom = p_slice_header->pred_weight_table.delta_chroma_log2_weight_denom;
-            for (i = 0; i < p_slice_header->num_ref_idx_l0_active_minus1; i++) {
-                slice_params_ptr->delta_luma_weight_l0[i] = p_slice_header->pred_weight_table.delta_luma_weight_l0[i];
-                slice_params_ptr->luma_offset_l0[i] = p_slice_header->pred_weight_table.luma_offset_l0[i];
-                slice_params_ptr->delta_chroma_weight_l0[i][0] = p_slice_header->pred_weight_table.delta_chroma_weight_l0[i][0];
-                slice_params_ptr->delta_chroma_weight_l0[i][1] = p_slice_header->pred_weight_table.delta_chroma_weight_l0[i][1];
-                slice_params_ptr->chroma_offset_l0[i][0] = p_slice_header->pred_weight_table.chroma_offset_l0[i][0];
-                slice_params_ptr->chroma_offset_l0[i][1] = p_slice_header->pred_weight_table.chroma_offset_l0[i][1];
-            }
-
-            if (p_slice_header->slice_type == HEVC_SLICE_TYPE_B) {
-                for (i = 0; i < p_slice_header->num_ref_idx_l1_active_minus1; i++) {
-                    slice_params_ptr->delta_luma_weight_l1[i] = p_slice_header->pred_weight_table.delta_luma_weight_l1[i];
-                    slice_params_ptr->luma_offset_l1[i] = p_slice_header->pred_weight_table.luma_offset_l1[i];
-                    slice_params_ptr->delta_chroma_weight_l1[i][0] = p_slice_header->pred_weight_table.delta_chroma_weight_l1[i][0];
-                    slice_params_ptr->delta_chroma_weight_l1[i][1] = p_slice_header->pred_weight_table.delta_chroma_weight_l1[i][1];
-                    slice_params_ptr->chroma_offset_l1[i][0] = p_slice_header->pred_weight_table.chroma_offset_l1[i][0];
-                    slice_params_ptr->chroma_offset_l1[i][1] = p_slice_header->pred_weight_table.chroma_offset_l1[i][1];
-                }
-            }
-        }
-
-        slice_params_ptr->five_minus_max_num_merge_cand = p_slice_header->five_minus_max_num_merge_cand;
-        slice_params_ptr->num_entry_point_offsets = p_slice_header->num_entry_point_offsets;
-        slice_params_ptr->entry_offset_to_subset_array = 0; // don't care
-        slice_params_ptr->slice_data_num_emu_prevn_bytes = 0; // don't care
-    }
-    dec_pic_params_.slice_params.hevc = slice_param_list_.data();
-
     /// Fill scaling lists
     if (sps_ptr->scaling_list_enabled_flag) {
         RocdecHevcIQMatrix *iq_matrix_ptr = &dec_pic_params_.iq_matrix.hevc;
-        HevcScalingListData *scaling_list_data_ptr = &pps_ptr->scaling_list_data;
+        HevcScalingListData *scaling_list_data_ptr = pps_ptr->pps_scaling_list_data_present_flag ? pps_ptr->scaling_list_data : sps_ptr->scaling_list_data;
         for (i = 0; i < 6; i++) {
             for (j = 0; j < 16; j++) {
                     iq_matrix_ptr->scaling_list_4x4[i][j] = scaling_list_data_ptr->scaling_list[0][i][j];
@@ -531,6 +446,127 @@ int HevcVideoParser::SendPicForDecode() {
             }
         }
     }
+}
+
+ParserResult HevcVideoParser::FillSliceParams(int slice_index) {
+    int i, j;
+    HevcPicParamSet *pps_ptr = m_pps_[m_active_pps_id_];
+    RocdecHevcSliceParams *slice_params_ptr = &slice_param_list_[slice_index];
+    HevcSliceInfo *p_slice_info = &slice_info_list_[slice_index];
+    HevcSliceSegHeader *p_slice_header = &p_slice_info->slice_header;
+
+    // We put all slices of the picture (or of the slice batch) into one slice data buffer.
+    slice_params_ptr->slice_data_size = p_slice_info->slice_data_size;
+    slice_params_ptr->slice_data_offset = p_slice_info->slice_data_offset; // point to the start code
+    slice_params_ptr->slice_data_flag = 0x00; // VA_SLICE_DATA_FLAG_ALL;
+    slice_params_ptr->slice_data_byte_offset = 0;  // VCN consumes from the start code
+    slice_params_ptr->slice_segment_address = p_slice_header->slice_segment_address;
+
+    // Ref lists
+    memset(slice_params_ptr->ref_pic_list, 0xFF, sizeof(slice_params_ptr->ref_pic_list));
+    if (p_slice_header->slice_type != HEVC_SLICE_TYPE_I) {
+        for (i = 0; i <= p_slice_header->num_ref_idx_l0_active_minus1; i++) {
+            int idx = p_slice_info->ref_pic_list_0_[i]; // pic_idx of the ref pic
+            int dec_buf_idx = dpb_buffer_.frame_buffer_list[idx].dec_buf_idx;
+            for (j = 0; j < 15; j++) {
+                if (ref_frame_dec_buf_idx_[j] == dec_buf_idx) {
+                    break;
+                }
+            }
+            if (j == 15) {
+                ERR("Could not find matching pic in ref_frames list. The slice type is P/B, and the idx from the ref_pic_list_0_ is: " + TOSTR(idx));
+                return PARSER_FAIL;
+            } else {
+                slice_params_ptr->ref_pic_list[0][i] = j;
+            }
+        }
+
+        if (p_slice_header->slice_type == HEVC_SLICE_TYPE_B) {
+            for (i = 0; i <= p_slice_header->num_ref_idx_l1_active_minus1; i++) {
+                int idx = p_slice_info->ref_pic_list_1_[i]; // pic_idx of the ref pic
+                int dec_buf_idx = dpb_buffer_.frame_buffer_list[idx].dec_buf_idx;
+                for (j = 0; j < 15; j++) {
+                    if (ref_frame_dec_buf_idx_[j] == dec_buf_idx) {
+                        break;
+                    }
+                }
+                if (j == 15) {
+                    ERR("Could not find matching pic in ref_frames list. The slice type is B, and the idx from the ref_pic_list_1_ is: " + TOSTR(idx));
+                    return PARSER_FAIL;
+                } else {
+                    slice_params_ptr->ref_pic_list[1][i] = j;
+                }
+            }
+        }
+    }
+
+    slice_params_ptr->long_slice_flags.fields.last_slice_of_pic = (slice_index == num_slices_ - 1) ? 1 : 0;
+    slice_params_ptr->long_slice_flags.fields.dependent_slice_segment_flag = p_slice_header->dependent_slice_segment_flag;
+    slice_params_ptr->long_slice_flags.fields.slice_type = p_slice_header->slice_type;
+    slice_params_ptr->long_slice_flags.fields.color_plane_id = p_slice_header->colour_plane_id;
+    slice_params_ptr->long_slice_flags.fields.slice_sao_luma_flag = p_slice_header->slice_sao_luma_flag;
+    slice_params_ptr->long_slice_flags.fields.slice_sao_chroma_flag = p_slice_header->slice_sao_chroma_flag;
+    slice_params_ptr->long_slice_flags.fields.mvd_l1_zero_flag = p_slice_header->mvd_l1_zero_flag;
+    slice_params_ptr->long_slice_flags.fields.cabac_init_flag = p_slice_header->cabac_init_flag;
+    slice_params_ptr->long_slice_flags.fields.slice_temporal_mvp_enabled_flag = p_slice_header->slice_temporal_mvp_enabled_flag;
+    slice_params_ptr->long_slice_flags.fields.slice_deblocking_filter_disabled_flag = p_slice_header->slice_deblocking_filter_disabled_flag;
+    slice_params_ptr->long_slice_flags.fields.collocated_from_l0_flag = p_slice_header->collocated_from_l0_flag;
+    slice_params_ptr->long_slice_flags.fields.slice_loop_filter_across_slices_enabled_flag = p_slice_header->slice_loop_filter_across_slices_enabled_flag;
+
+    slice_params_ptr->collocated_ref_idx = p_slice_header->collocated_ref_idx;
+    slice_params_ptr->num_ref_idx_l0_active_minus1 = p_slice_header->num_ref_idx_l0_active_minus1;
+    slice_params_ptr->num_ref_idx_l1_active_minus1 = p_slice_header->num_ref_idx_l1_active_minus1;
+    slice_params_ptr->slice_qp_delta = p_slice_header->slice_qp_delta;
+    slice_params_ptr->slice_cb_qp_offset = p_slice_header->slice_cb_qp_offset;
+    slice_params_ptr->slice_cr_qp_offset = p_slice_header->slice_cr_qp_offset;
+    slice_params_ptr->slice_beta_offset_div2 = p_slice_header->slice_beta_offset_div2;
+    slice_params_ptr->slice_tc_offset_div2 = p_slice_header->slice_tc_offset_div2;
+
+    if ((pps_ptr->weighted_pred_flag && p_slice_header->slice_type == HEVC_SLICE_TYPE_P) || (pps_ptr->weighted_bipred_flag && p_slice_header->slice_type == HEVC_SLICE_TYPE_B)) {
+        slice_params_ptr->luma_log2_weight_denom = p_slice_header->pred_weight_table.luma_log2_weight_denom;
+        slice_params_ptr->delta_chroma_log2_weight_denom = p_slice_header->pred_weight_table.delta_chroma_log2_weight_denom;
+        for (i = 0; i < p_slice_header->num_ref_idx_l0_active_minus1; i++) {
+            slice_params_ptr->delta_luma_weight_l0[i] = p_slice_header->pred_weight_table.delta_luma_weight_l0[i];
+            slice_params_ptr->luma_offset_l0[i] = p_slice_header->pred_weight_table.luma_offset_l0[i];
+            slice_params_ptr->delta_chroma_weight_l0[i][0] = p_slice_header->pred_weight_table.delta_chroma_weight_l0[i][0];
+            slice_params_ptr->delta_chroma_weight_l0[i][1] = p_slice_header->pred_weight_table.delta_chroma_weight_l0[i][1];
+            slice_params_ptr->chroma_offset_l0[i][0] = p_slice_header->pred_weight_table.chroma_offset_l0[i][0];
+            slice_params_ptr->chroma_offset_l0[i][1] = p_slice_header->pred_weight_table.chroma_offset_l0[i][1];
+        }
+
+        if (p_slice_header->slice_type == HEVC_SLICE_TYPE_B) {
+            for (i = 0; i < p_slice_header->num_ref_idx_l1_active_minus1; i++) {
+                slice_params_ptr->delta_luma_weight_l1[i] = p_slice_header->pred_weight_table.delta_luma_weight_l1[i];
+                slice_params_ptr->luma_offset_l1[i] = p_slice_header->pred_weight_table.luma_offset_l1[i];
+                slice_params_ptr->delta_chroma_weight_l1[i][0] = p_slice_header->pred_weight_table.delta_chroma_weight_l1[i][0];
+                slice_params_ptr->delta_chroma_weight_l1[i][1] = p_slice_header->pred_weight_table.delta_chroma_weight_l1[i][1];
+                slice_params_ptr->chroma_offset_l1[i][0] = p_slice_header->pred_weight_table.chroma_offset_l1[i][0];
+                slice_params_ptr->chroma_offset_l1[i][1] = p_slice_header->pred_weight_table.chroma_offset_l1[i][1];
+            }
+        }
+    }
+
+    slice_params_ptr->five_minus_max_num_merge_cand = p_slice_header->five_minus_max_num_merge_cand;
+    slice_params_ptr->num_entry_point_offsets = p_slice_header->num_entry_point_offsets;
+    slice_params_ptr->entry_offset_to_subset_array = 0; // don't care
+    slice_params_ptr->slice_data_num_emu_prevn_bytes = 0; // don't care
+    return PARSER_OK;
+}
+
+int HevcVideoParser::SendPicForDecode() {
+    FillPicParams();
+
+    /// Fill slice parameters
+    // Resize if needed
+    if (num_slices_ > slice_param_list_.size()) {
+        slice_param_list_.resize(num_slices_, {0});
+    }
+    for (int slice_index = 0; slice_index < num_slices_; slice_index++) {
+        if (FillSliceParams(slice_index) != PARSER_OK) {
+            return PARSER_FAIL;
+        }
+    }
+    dec_pic_params_.slice_params.hevc = slice_param_list_.data();
 
 #if DBGINFO
     PrintVappiBufInfo();
@@ -544,6 +580,54 @@ int HevcVideoParser::SendPicForDecode() {
     }
 }
 
+ParserResult HevcVideoParser::SendSliceBatch(bool last_batch) {
+    if (num_submitted_slices_ == 0) {
+        // Init Roc decoder for the first time or reconfigure the existing decoder before starting the picture
+        if (new_seq_activated_) {
+            if (FillSeqCallbackFn(m_sps_[m_active_sps_id_]) != PARSER_OK) {
+                return PARSER_FAIL;
+            }
+            new_seq_activated_ = false;
+        }
+        FillPicParams();
+        dec_pic_params_.slice_batch_flags = ROCDEC_SLICE_BATCH | ROCDEC_SLICE_BATCH_FIRST;
+    } else {
+        dec_pic_params_.slice_batch_flags = ROCDEC_SLICE_BATCH;
+    }
+    if (last_batch) {
+        dec_pic_params_.slice_batch_flags |= ROCDEC_SLICE_BATCH_LAST;
+    }
+
+    // The batch data runs from the start code of its first slice to the end of its last slice
+    int first_slice = num_submitted_slices_;
+    int data_offset = slice_info_list_[first_slice].slice_data_offset;
+    HevcSliceInfo *p_last_slice_info = &slice_info_list_[num_slices_ - 1];
+    dec_pic_params_.bitstream_data = pic_data_buffer_ptr_ + data_offset;
+    dec_pic_params_.bitstream_data_len = p_last_slice_info->slice_data_offset + p_last_slice_info->slice_data_size - data_offset;
+    dec_pic_params_.num_slices = num_slices_ - first_slice;
+
+    // Resize if needed
+    if (num_slices_ > slice_param_list_.size()) {
+        slice_param_list_.resize(num_slices_, {0});
+    }
+    for (int slice_index = first_slice; slice_index < num_slices_; slice_index++) {
+        if (FillSliceParams(slice_index) != PARSER_OK) {
+            return PARSER_FAIL;
+        }
+        slice_param_list_[slice_index].slice_data_offset -= data_offset;
+        slice_param_list_[slice_index].long_slice_flags.fields.last_slice_of_pic = (last_batch && slice_index == num_slices_ - 1) ? 1 : 0;
+    }
+    dec_pic_params_.slice_params.hevc = &slice_param_list_[first_slice];
+    num_submitted_slices_ = num_slices_;
+
+    if (pfn_decode_picture_cb_(parser_params_.user_data, &dec_pic_params_) == 0) {
+        ERR("Decode error occurred.");
+        return PARSER_FAIL;
+    } else {
+        return PARSER_OK;
+    }
+}
+
 ParserResult HevcVideoParser::ParsePictureData(const uint8_t* p_stream, uint32_t pic_data_size) {
     ParserResult ret = PARSER_OK;
     ParserResult ret2;
@@ -555,9 +639,12 @@ ParserResult HevcVideoParser::ParsePictureData(const uint8_t* p_stream, uint32_t
     curr_start_code_offset_ = 0;
     next_start_code_offset_ = 0;
 
-    num_slices_ = 0;
-    sei_message_count_ = 0;
-    sei_payload_size_ = 0;
+    if (!au_in_progress_) {
+        num_slices_ = 0;
+        num_submitted_slices_ = 0;
+        sei_message_count_ = 0;
+        sei_payload_size_ = 0;
+    }
 
     do {
         ret = GetNalUnit();
@@ -610,6 +697,13 @@ ParserResult HevcVideoParser::ParsePictureData(const uint8_t* p_stream, uint32_t
                 case NAL_UNIT_CODED_SLICE_RADL_R:
                 case NAL_UNIT_CODED_SLICE_RASL_N:
                 case NAL_UNIT_CODED_SLICE_RASL_R: {
+                    // Slice submission: the slices parsed so far are not the last ones of the picture
+                    if (parser_params_.slice_submission && num_slices_ > num_submitted_slices_) {
+                        if ((ret2 = SendSliceBatch(false)) != PARSER_OK) {
+                            return ret2;
+                        }
+                    }
+
                     // Save slice NAL unit header
                     slice_nal_unit_header_ = nal_unit_header_;
 
@@ -624,7 +718,8 @@ ParserResult HevcVideoParser::ParsePictureData(const uint8_t* p_stream, uint32_t
                     memcpy(rbsp_buf_, (pic_data_buffer_ptr_ + curr_start_code_offset_ + 5), ebsp_size);
                     rbsp_size_ = EbspToRbsp(rbsp_buf_, 0, ebsp_size);
                     HevcSliceSegHeader *p_slice_header = &slice_info_list_[num_slices_].slice_header;
-                    if ((ret2 = ParseSliceHeader(rbsp_buf_, rbsp_size_, p_slice_header)) != PARSER_OK) {
+                    HevcSliceSegHeader *p_prev_slice_header = num_slices_ > 0 ? &slice_info_list_[num_slices_ - 1].slice_header : nullptr;
+                    if ((ret2 = ParseSliceHeader(rbsp_buf_, rbsp_size_, p_slice_header, p_prev_slice_header)) != PARSER_OK) {
                         return ret2;
                     }
 
@@ -664,6 +759,7 @@ ParserResult HevcVideoParser::ParsePictureData(const uint8_t* p_stream, uint32_t
 
                         // Decode RPS. 8.3.2.
                         DecodeRps();
+                        InitRefPicListTemp();
                     }
 
                     // Construct ref lists. 8.3.4.
@@ -970,7 +1066,7 @@ void HevcVideoParser::ParseScalingList(HevcScalingListData * sl_ptr, uint8_t *na
         }
     }
 
-    if (sps_ptr->chroma_format_idc == 3) {
+    if (sps_ptr && sps_ptr->chroma_format_idc == 3) {
         for (int i = 0; i < 64; i++) {
             sl_ptr->scaling_list[3][1][i] = sl_ptr->scaling_list[2][1][i];
             sl_ptr->scaling_list[3][2][i] = sl_ptr->scaling_list[2][2][i];
@@ -1204,7 +1300,8 @@ void HevcVideoParser::ParseVui(HevcVuiParameters *vui, uint32_t max_num_sub_laye
         }
         vui->vui_hrd_parameters_present_flag = Parser::GetBit(nalu, offset);
         if (vui->vui_hrd_parameters_present_flag) {
-            ParseHrdParameters(&vui->hrd_parameters, 1, max_num_sub_layers_minus1, nalu, size, offset);
+            vui->hrd_parameters = ReuseOrAllocStruct(param_set_arena_, vui->hrd_parameters, 1, 1);
+            ParseHrdParameters(vui->hrd_parameters, 1, max_num_sub_layers_minus1, nalu, size, offset);
         }
     }
     vui->bitstream_restriction_flag = Parser::GetBit(nalu, offset);
@@ -1223,8 +1320,24 @@ void HevcVideoParser::ParseVui(HevcVuiParameters *vui, uint32_t max_num_sub_laye
 void HevcVideoParser::ParseVps(uint8_t *nalu, size_t size) {
     size_t offset = 0; // current bit offset
     uint32_t vps_id = Parser::ReadBits(nalu, offset, 4);
-    HevcVideoParamSet *p_vps = &m_vps_[vps_id];
+    if (m_vps_[vps_id] == nullptr) {
+        m_vps_[vps_id] = param_set_arena_.Alloc<HevcVideoParamSet>();
+    }
+    HevcVideoParamSet *p_vps = m_vps_[vps_id];
+    // Keep the arrays allocated on demand by a previous VPS with this id for re-use
+    bool (*layer_id_included_flag)[63] = p_vps->layer_id_included_flag;
+    uint32_t num_layer_sets_allocated = p_vps->num_layer_sets_allocated;
+    uint32_t *hrd_layer_set_idx = p_vps->hrd_layer_set_idx;
+    bool *cprms_present_flag = p_vps->cprms_present_flag;
+    HevcHrdParameters *hrd_parameters = p_vps->hrd_parameters;
+    uint32_t num_hrd_parameters_allocated = p_vps->num_hrd_parameters_allocated;
     memset(p_vps, 0, sizeof(HevcVideoParamSet));
+    p_vps->layer_id_included_flag = layer_id_included_flag;
+    p_vps->num_layer_sets_allocated = num_layer_sets_allocated;
+    p_vps->hrd_layer_set_idx = hrd_layer_set_idx;
+    p_vps->cprms_present_flag = cprms_present_flag;
+    p_vps->hrd_parameters = hrd_parameters;
+    p_vps->num_hrd_parameters_allocated = num_hrd_parameters_allocated;
 
     p_vps->vps_video_parameter_set_id = vps_id;
     p_vps->vps_base_layer_internal_flag = Parser::GetBit(nalu, offset);
@@ -1249,6 +1362,14 @@ void HevcVideoParser::ParseVps(uint8_t *nalu, size_t size) {
     }
     p_vps->vps_max_layer_id = Parser::ReadBits(nalu, offset, 6);
     p_vps->vps_num_layer_sets_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
+    if (p_vps->vps_max_layer_id > 62 || p_vps->vps_num_layer_sets_minus1 > 1023) {
+        ERR(STR("Invalid VPS layer sets: vps_max_layer_id = ") + TOSTR(p_vps->vps_max_layer_id) + STR(", vps_num_layer_sets_minus1 = ") + TOSTR(p_vps->vps_num_layer_sets_minus1));
+        return;
+    }
+    if (p_vps->vps_num_layer_sets_minus1 > 0) {
+        p_vps->layer_id_included_flag = ReuseOrAllocStruct(param_set_arena_, p_vps->layer_id_included_flag, p_vps->vps_num_layer_sets_minus1 + 1, p_vps->num_layer_sets_allocated);
+        p_vps->num_layer_sets_allocated = std::max(p_vps->num_layer_sets_allocated, p_vps->vps_num_layer_sets_minus1 + 1);
+    }
     for (int i = 1; i <= p_vps->vps_num_layer_sets_minus1; i++) {
         for (int j = 0; j <= p_vps->vps_max_layer_id; j++) {
             p_vps->layer_id_included_flag[i][j] = Parser::GetBit(nalu, offset);
@@ -1263,6 +1384,17 @@ void HevcVideoParser::ParseVps(uint8_t *nalu, size_t size) {
             p_vps->vps_num_ticks_poc_diff_one_minus1 = Parser::ExpGolomb::ReadUe(nalu, offset);
         }
         p_vps->vps_num_hrd_parameters = Parser::ExpGolomb::ReadUe(nalu, offset);
+        if (p_vps->vps_num_hrd_parameters > p_vps->vps_num_layer_sets_minus1 + 1) {
+            ERR(STR("Invalid vps_num_hrd_parameters = ") + TOSTR(p_vps->vps_num_hrd_parameters));
+            return;
+        }
+        if (p_vps->vps_num_hrd_parameters > 0) {
+            p_vps->hrd_layer_set_idx = ReuseOrAllocStruct(param_set_arena_, p_vps->hrd_layer_set_idx, p_vps->vps_num_hrd_parameters, p_vps->num_hrd_parameters_allocated);
+            p_vps->cprms_present_flag = ReuseOrAllocStruct(param_set_arena_, p_vps->cprms_present_flag, p_vps->vps_num_hrd_parameters, p_vps->num_hrd_parameters_allocated);
+            p_vps->hrd_parameters = ReuseOrAllocStruct(param_set_arena_, p_vps->hrd_parameters, p_vps->vps_num_hrd_parameters, p_vps->num_hrd_parameters_allocated);
+            p_vps->num_hrd_parameters_allocated = std::max(p_vps->num_hrd_parameters_allocated, p_vps->vps_num_hrd_parameters);
+            p_vps->cprms_present_flag[0] = 1;  // inferred for the first hrd_parameters()
+        }
         for (int i = 0; i<p_vps->vps_num_hrd_parameters; i++) {
             p_vps->hrd_layer_set_idx[i] = Parser::ExpGolomb::ReadUe(nalu, offset);
             if (i > 0) {
@@ -1292,9 +1424,21 @@ void HevcVideoParser::ParseSps(uint8_t *nalu, size_t size) {
     ParsePtl(&ptl, true, max_sub_layer_minus1, nalu, size, offset);
 
     uint32_t sps_id = Parser::ExpGolomb::ReadUe(nalu, offset);
-    sps_ptr = &m_sps_[sps_id];
+    if (sps_id >= MAX_SPS_COUNT) {
+        ERR(STR("Invalid sps_seq_parameter_set_id = ") + TOSTR(sps_id));
+        return;
+    }
+    if (m_sps_[sps_id] == nullptr) {
+        m_sps_[sps_id] = param_set_arena_.Alloc<HevcSeqParamSet>();
+    }
+    sps_ptr = m_sps_[sps_id];
 
+    // Keep the structs allocated on demand by a previous SPS with this id for re-use
+    HevcScalingListData *scaling_list_data = sps_ptr->scaling_list_data;
+    HevcHrdParameters *vui_hrd_parameters = sps_ptr->vui_parameters.hrd_parameters;
     memset(sps_ptr, 0, sizeof(HevcSeqParamSet));
+    sps_ptr->scaling_list_data = scaling_list_data;
+    sps_ptr->vui_parameters.hrd_parameters = vui_hrd_parameters;
     sps_ptr->sps_video_parameter_set_id = vps_id;
     sps_ptr->sps_max_sub_layers_minus1 = max_sub_layer_minus1;
     sps_ptr->sps_temporal_id_nesting_flag = sps_temporal_id_nesting_flag;
@@ -1359,11 +1503,12 @@ void HevcVideoParser::ParseSps(uint8_t *nalu, size_t size) {
     sps_ptr->scaling_list_enabled_flag = Parser::GetBit(nalu, offset);
     if (sps_ptr->scaling_list_enabled_flag) {
         // Set up default values first
-        SetDefaultScalingList(&sps_ptr->scaling_list_data);
+        sps_ptr->scaling_list_data = ReuseOrAllocStruct(param_set_arena_, sps_ptr->scaling_list_data, 1, 1);
+        SetDefaultScalingList(sps_ptr->scaling_list_data);
 
         sps_ptr->sps_scaling_list_data_present_flag = Parser::GetBit(nalu, offset);
         if (sps_ptr->sps_scaling_list_data_present_flag) {
-            ParseScalingList(&sps_ptr->scaling_list_data, nalu, size, offset, sps_ptr);
+            ParseScalingList(sps_ptr->scaling_list_data, nalu, size, offset, sps_ptr);
         }
     }
     sps_ptr->amp_enabled_flag = Parser::GetBit(nalu, offset);
@@ -1412,11 +1557,22 @@ void HevcVideoParser::ParsePps(uint8_t *nalu, size_t size) {
     int i;
     size_t offset = 0;
     uint32_t pps_id = Parser::ExpGolomb::ReadUe(nalu, offset);
-    HevcPicParamSet *pps_ptr = &m_pps_[pps_id];
+    uint32_t sps_id = Parser::ExpGolomb::ReadUe(nalu, offset);
+    if (pps_id >= MAX_PPS_COUNT || sps_id >= MAX_SPS_COUNT) {
+        ERR(STR("Invalid PPS: pps_pic_parameter_set_id = ") + TOSTR(pps_id) + STR(", pps_seq_parameter_set_id = ") + TOSTR(sps_id));
+        return;
+    }
+    if (m_pps_[pps_id] == nullptr) {
+        m_pps_[pps_id] = param_set_arena_.Alloc<HevcPicParamSet>();
+    }
+    HevcPicParamSet *pps_ptr = m_pps_[pps_id];
+    // Keep the scaling lists allocated on demand by a previous PPS with this id for re-use
+    HevcScalingListData *scaling_list_data = pps_ptr->scaling_list_data;
     memset(pps_ptr, 0, sizeof(HevcPicParamSet));
+    pps_ptr->scaling_list_data = scaling_list_data;
 
     pps_ptr->pps_pic_parameter_set_id = pps_id;
-    pps_ptr->pps_seq_parameter_set_id = Parser::ExpGolomb::ReadUe(nalu, offset);
+    pps_ptr->pps_seq_parameter_set_id = sps_id;
     pps_ptr->dependent_slice_segments_enabled_flag = Parser::GetBit(nalu, offset);
     pps_ptr->output_flag_present_flag = Parser::GetBit(nalu, offset);
     pps_ptr->num_extra_slice_header_bits = Parser::ReadBits(nalu, offset, 3);
@@ -1485,11 +1641,10 @@ void HevcVideoParser::ParsePps(uint8_t *nalu, size_t size) {
     pps_ptr->pps_scaling_list_data_present_flag = Parser::GetBit(nalu, offset);
     if (pps_ptr->pps_scaling_list_data_present_flag) {
         // Set up default values first
-        SetDefaultScalingList(&pps_ptr->scaling_list_data);
+        pps_ptr->scaling_list_data = ReuseOrAllocStruct(param_set_arena_, pps_ptr->scaling_list_data, 1, 1);
+        SetDefaultScalingList(pps_ptr->scaling_list_data);
 
-        ParseScalingList(&pps_ptr->scaling_list_data, nalu, size, offset, &m_sps_[pps_ptr->pps_seq_parameter_set_id]);
-    } else {
-        pps_ptr->scaling_list_data = m_sps_[pps_ptr->pps_seq_parameter_set_id].scaling_list_data;
+        ParseScalingList(pps_ptr->scaling_list_data, nalu, size, offset, m_sps_[pps_ptr->pps_seq_parameter_set_id]);
     }
     pps_ptr->lists_modification_present_flag = Parser::GetBit(nalu, offset);
     pps_ptr->log2_parallel_merge_level_minus2 = Parser::ExpGolomb::ReadUe(nalu, offset);
@@ -1527,42 +1682,53 @@ void HevcVideoParser::ParsePps(uint8_t *nalu, size_t size) {
 #endif // DBGINFO
 }
 
-ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcSliceSegHeader *p_slice_header) {
+ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcSliceSegHeader *p_slice_header, const HevcSliceSegHeader *p_prev_slice_header) {
     HevcPicParamSet *pps_ptr = nullptr;
     HevcSeqParamSet *sps_ptr = nullptr;
     size_t offset = 0;
-    HevcSliceSegHeader temp_sh;
-    memset(p_slice_header, 0, sizeof(HevcSliceSegHeader));
-    memset(&temp_sh, 0, sizeof(temp_sh));
-
-    temp_sh.first_slice_segment_in_pic_flag = p_slice_header->first_slice_segment_in_pic_flag = Parser::GetBit(nalu, offset);
+    // Clear the slice segment fields here, the inherited fields when they are parsed or copied below. The entry point offsets and the
+    // extension data bytes are not parsed and are left alone.
+    memset(p_slice_header, 0, kSliceSegFieldsSize);
+    p_slice_header->num_entry_point_offsets = 0;
+    p_slice_header->offset_len_minus1 = 0;
+    p_slice_header->slice_segment_header_extension_length = 0;
+
+    p_slice_header->first_slice_segment_in_pic_flag = Parser::GetBit(nalu, offset);
     if (IsIrapPic(&slice_nal_unit_header_)) {
-        temp_sh.no_output_of_prior_pics_flag = p_slice_header->no_output_of_prior_pics_flag = Parser::GetBit(nalu, offset);
+        p_slice_header->no_output_of_prior_pics_flag = Parser::GetBit(nalu, offset);
     }
 
     // Set active VPS, SPS and PPS for the current slice
     m_active_pps_id_ = Parser::ExpGolomb::ReadUe(nalu, offset);
-    temp_sh.slice_pic_parameter_set_id = p_slice_header->slice_pic_parameter_set_id = m_active_pps_id_;
-    pps_ptr = &m_pps_[m_active_pps_id_];
+    p_slice_header->slice_pic_parameter_set_id = m_active_pps_id_;
+    if (m_active_pps_id_ < 0 || m_active_pps_id_ >= MAX_PPS_COUNT || m_pps_[m_active_pps_id_] == nullptr) {
+        ERR("Empty PPS is referred.");
+        return PARSER_WRONG_STATE;
+    }
+    pps_ptr = m_pps_[m_active_pps_id_];
     if ( pps_ptr->is_received == 0) {
         ERR("Empty PPS is referred.");
         return PARSER_WRONG_STATE;
     }
     if (m_active_sps_id_ != pps_ptr->pps_seq_parameter_set_id) {
         m_active_sps_id_ = pps_ptr->pps_seq_parameter_set_id;
-        sps_ptr = &m_sps_[m_active_sps_id_];
+        sps_ptr = m_sps_[m_active_sps_id_];
+        if (sps_ptr == nullptr) {
+            ERR("Empty SPS is referred.");
+            return PARSER_WRONG_STATE;
+        }
         // Re-set DPB size.
         dpb_buffer_.dpb_size = sps_ptr->sps_max_dec_pic_buffering_minus1[sps_ptr->sps_max_sub_layers_minus1] + 1;
         dpb_buffer_.dpb_size = dpb_buffer_.dpb_size > HEVC_MAX_DPB_FRAMES ? HEVC_MAX_DPB_FRAMES : dpb_buffer_.dpb_size;
         new_seq_activated_ = true;  // Note: clear this flag after the actions are taken.
     }
-    sps_ptr = &m_sps_[m_active_sps_id_];
-    if (sps_ptr->is_received == 0) {
+    sps_ptr = m_sps_[m_active_sps_id_];
+    if (sps_ptr == nullptr || sps_ptr->is_received == 0) {
         ERR("Empty SPS is referred.");
         return PARSER_WRONG_STATE;
     }
     m_active_vps_id_ = sps_ptr->sps_video_parameter_set_id;
-    if (m_vps_[m_active_vps_id_].is_received == 0) {
+    if (m_vps_[m_active_vps_id_] == nullptr || m_vps_[m_active_vps_id_]->is_received == 0) {
         ERR("Empty VPS is referred.");
         return PARSER_WRONG_STATE;
     }
@@ -1585,9 +1751,9 @@ ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcS
 
     // Set frame rate if available
     if (new_seq_activated_) {
-        if (m_vps_[m_active_vps_id_].vps_timing_info_present_flag) {
-            frame_rate_.numerator = m_vps_[m_active_vps_id_].vps_time_scale;
-            frame_rate_.denominator = m_vps_[m_active_vps_id_].vps_num_units_in_tick;
+        if (m_vps_[m_active_vps_id_]->vps_timing_info_present_flag) {
+            frame_rate_.numerator = m_vps_[m_active_vps_id_]->vps_time_scale;
+            frame_rate_.denominator = m_vps_[m_active_vps_id_]->vps_num_units_in_tick;
         } else if (sps_ptr->vui_parameters.vui_timing_info_present_flag) {
             frame_rate_.numerator = sps_ptr->vui_parameters.vui_time_scale;
             frame_rate_.denominator = sps_ptr->vui_parameters.vui_num_units_in_tick;
@@ -1599,13 +1765,14 @@ ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcS
 
     if (!p_slice_header->first_slice_segment_in_pic_flag) {
         if (pps_ptr->dependent_slice_segments_enabled_flag) {
-            temp_sh.dependent_slice_segment_flag = p_slice_header->dependent_slice_segment_flag = Parser::GetBit(nalu, offset);
+            p_slice_header->dependent_slice_segment_flag = Parser::GetBit(nalu, offset);
         }
         int bits_slice_segment_address = (int)ceilf(log2f((float)pic_size_in_ctbs_y_));
-        temp_sh.slice_segment_address = p_slice_header->slice_segment_address = Parser::ReadBits(nalu, offset, bits_slice_segment_address);
+        p_slice_header->slice_segment_address = Parser::ReadBits(nalu, offset, bits_slice_segment_address);
     }
 
     if (!p_slice_header->dependent_slice_segment_flag) {
+        memset(reinterpret_cast<uint8_t*>(p_slice_header) + kSliceSegFieldsSize, 0, kInheritedSliceFieldsSize);
         for (int i = 0; i < pps_ptr->num_extra_slice_header_bits; i++) {
             p_slice_header->slice_reserved_flag[i] = Parser::GetBit(nalu, offset);
         }
@@ -1805,15 +1972,13 @@ ParserResult HevcVideoParser::ParseSliceHeader(uint8_t *nalu, size_t size, HevcS
             p_slice_header->slice_loop_filter_across_slices_enabled_flag = Parser::GetBit(nalu, offset);
         }
 
-        memcpy(m_sh_copy_, p_slice_header, sizeof(HevcSliceSegHeader));
     } else {
-        //dependant slice
-        memcpy(p_slice_header, m_sh_copy_, sizeof(HevcSliceSegHeader));
-        p_slice_header->first_slice_segment_in_pic_flag = temp_sh.first_slice_segment_in_pic_flag;
-        p_slice_header->no_output_of_prior_pics_flag = temp_sh.no_output_of_prior_pics_flag;
-        p_slice_header->slice_pic_parameter_set_id = temp_sh.slice_pic_parameter_set_id;
-        p_slice_header->dependent_slice_segment_flag = temp_sh.dependent_slice_segment_flag;
-        p_slice_header->slice_segment_address = temp_sh.slice_segment_address;
+        //dependant slice: take the slice header fields of the preceding slice segment, which has the same values as the independent one
+        if (p_prev_slice_header == nullptr) {
+            ERR("Dependent slice segment without a preceding slice segment.");
+            return PARSER_WRONG_STATE;
+        }
+        memcpy(reinterpret_cast<uint8_t*>(p_slice_header) + kSliceSegFieldsSize, reinterpret_cast<const uint8_t*>(p_prev_slice_header) + kSliceSegFieldsSize, kInheritedSliceFieldsSize);
     }
     if (pps_ptr->tiles_enabled_flag || pps_ptr->entropy_coding_sync_enabled_flag) {
         int max_num_entry_point_offsets;  // 7.4.7.1
@@ -1898,7 +2063,7 @@ void HevcVideoParser::CalculateCurrPoc() {
         curr_pic_info_.prev_poc_msb = 0;
         curr_pic_info_.slice_pic_order_cnt_lsb = 0;
     } else {
-        int max_poc_lsb = 1 << (m_sps_[m_active_sps_id_].log2_max_pic_order_cnt_lsb_minus4 + 4);  // MaxPicOrderCntLsb
+        int max_poc_lsb = 1 << (m_sps_[m_active_sps_id_]->log2_max_pic_order_cnt_lsb_minus4 + 4);  // MaxPicOrderCntLsb
         int poc_msb;  // PicOrderCntMsb
         // If the current picture is an IRAP picture with NoRaslOutputFlag equal to 1, PicOrderCntMsb is set equal to 0.
         if (IsIrapPic(&slice_nal_unit_header_) && no_rasl_output_flag_ == 1) {
@@ -1926,7 +2091,7 @@ void HevcVideoParser::DecodeRps() {
     int i, j, k;
     int curr_delta_poc_msb_present_flag[HEVC_MAX_NUM_REF_PICS] = {0}; // CurrDeltaPocMsbPresentFlag
     int foll_delta_poc_msb_present_flag[HEVC_MAX_NUM_REF_PICS] = {0}; // FollDeltaPocMsbPresentFlag
-    int max_poc_lsb = 1 << (m_sps_[m_active_sps_id_].log2_max_pic_order_cnt_lsb_minus4 + 4);  // MaxPicOrderCntLsb
+    int max_poc_lsb = 1 << (m_sps_[m_active_sps_id_]->log2_max_pic_order_cnt_lsb_minus4 + 4);  // MaxPicOrderCntLsb
     HevcSliceSegHeader *p_slice_header = &slice_info_list_[0].slice_header;
 
     // When the current picture is an IRAP picture with NoRaslOutputFlag equal to 1, all reference pictures with
@@ -2006,124 +2171,106 @@ void HevcVideoParser::DecodeRps() {
 
         /// Short term reference pictures
         for (i = 0; i < num_poc_st_curr_before_; i++) {
-            for (j = 0; j < HEVC_MAX_DPB_FRAMES; j++) {
-                if (poc_st_curr_before_[i] == dpb_buffer_.frame_buffer_list[j].pic_order_cnt) {
-                    ref_pic_set_st_curr_before_[i] = j;  // RefPicSetStCurrBefore. Use DPB buffer index for now
-                    dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForShortTerm;
-                    break;
-                }
+            if ((j = dpb_poc_index_.Find(poc_st_curr_before_[i])) >= 0) {
+                ref_pic_set_st_curr_before_[i] = j;  // RefPicSetStCurrBefore. Use DPB buffer index for now
+                dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForShortTerm;
             }
         }
 
         for (i = 0; i < num_poc_st_curr_after_; i++) {
-            for (j = 0; j < HEVC_MAX_DPB_FRAMES; j++) {
-                if (poc_st_curr_after_[i] == dpb_buffer_.frame_buffer_list[j].pic_order_cnt) {
-                    ref_pic_set_st_curr_after_[i] = j;  // RefPicSetStCurrAfter
-                    dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForShortTerm;
-                    break;
-                }
+            if ((j = dpb_poc_index_.Find(poc_st_curr_after_[i])) >= 0) {
+                ref_pic_set_st_curr_after_[i] = j;  // RefPicSetStCurrAfter
+                dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForShortTerm;
             }
         }
 
-        for ( i = 0; i < num_poc_st_foll_; i++ ) {
-            for (j = 0; j < HEVC_MAX_DPB_FRAMES; j++) {
-                if (poc_st_foll_[i] == dpb_buffer_.frame_buffer_list[j].pic_order_cnt) {
-                    ref_pic_set_st_foll_[i] = j;  // RefPicSetStFoll
-                    dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForShortTerm;
-                    break;
-                }
+        for (i = 0; i < num_poc_st_foll_; i++) {
+            if ((j = dpb_poc_index_.Find(poc_st_foll_[i])) >= 0) {
+                ref_pic_set_st_foll_[i] = j;  // RefPicSetStFoll
+                dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForShortTerm;
             }
         }
 
         /// Long term reference pictures
         for (i = 0; i < num_poc_lt_curr_; i++) {
-            for (j = 0; j < HEVC_MAX_DPB_FRAMES; j++) {
-                if(!curr_delta_poc_msb_present_flag[i]) {
-                    if (poc_lt_curr_[i] == (dpb_buffer_.frame_buffer_list[j].pic_order_cnt & (max_poc_lsb - 1)) && dpb_buffer_.frame_buffer_list[j].use_status) {
-                        ref_pic_set_lt_curr_[i] = j;  // RefPicSetLtCurr
-                        dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForLongTerm;
-                        break;
-                    }
-                } else {
-                    if (poc_lt_curr_[i] == dpb_buffer_.frame_buffer_list[j].pic_order_cnt) {
-                        ref_pic_set_lt_curr_[i] = j;  // RefPicSetLtCurr
-                        dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForLongTerm;
-                        break;
-                    }
-                }
+            // Only the POC LSB is matched when the MSB is not present
+            j = curr_delta_poc_msb_present_flag[i] ? dpb_poc_index_.Find(poc_lt_curr_[i]) : dpb_poc_index_.FindMasked(poc_lt_curr_[i], max_poc_lsb - 1);
+            if (j >= 0) {
+                ref_pic_set_lt_curr_[i] = j;  // RefPicSetLtCurr
+                dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForLongTerm;
             }
         }
 
         for (i = 0; i < num_poc_lt_foll_; i++) {
-            for (j = 0; j < HEVC_MAX_DPB_FRAMES; j++) {
-                if(!foll_delta_poc_msb_present_flag[i]) {
-                    if (poc_lt_foll_[i] == (dpb_buffer_.frame_buffer_list[j].pic_order_cnt & (max_poc_lsb - 1)) && dpb_buffer_.frame_buffer_list[j].use_status) {
-                        ref_pic_set_lt_foll_[i] = j;  // RefPicSetLtFoll
-                        dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForLongTerm;
-                        break;
-                    }
-                } else {
-                    if (poc_lt_foll_[i] == dpb_buffer_.frame_buffer_list[j].pic_order_cnt) {
-                        ref_pic_set_lt_foll_[i] = j;  // RefPicSetLtFoll
-                        dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForLongTerm;
-                        break;
-                    }
-                }
+            // Only the POC LSB is matched when the MSB is not present
+            j = foll_delta_poc_msb_present_flag[i] ? dpb_poc_index_.Find(poc_lt_foll_[i]) : dpb_poc_index_.FindMasked(poc_lt_foll_[i], max_poc_lsb - 1);
+            if (j >= 0) {
+                ref_pic_set_lt_foll_[i] = j;  // RefPicSetLtFoll
+                dpb_buffer_.frame_buffer_list[j].is_reference = kUsedForLongTerm;
             }
         }
     }
 }
 
-void HevcVideoParser::ConstructRefPicLists(HevcSliceInfo *p_slice_info) {
-    HevcSliceSegHeader *p_slice_header = &p_slice_info->slice_header;
-    uint32_t num_rps_curr_temp_list; // NumRpsCurrTempList0 or NumRpsCurrTempList1;
-    int i, j;
+void HevcVideoParser::InitRefPicListTemp() {
+    uint32_t num_rps_curr = num_poc_st_curr_before_ + num_poc_st_curr_after_ + num_poc_lt_curr_;
+    uint32_t i;
     int rIdx;
-    uint32_t ref_pic_list_temp[HEVC_MAX_NUM_REF_PICS];  // RefPicListTemp0 or RefPicListTemp1
+
+    if (num_rps_curr == 0) {
+        // I picture. A P or B slice needs NumPicTotalCurr > 0 (7.4.7.1), so clear the lists of the previous picture in case a
+        // non-conforming slice reads them: the entries then point to DPB slot 0 instead of a picture of an earlier RPS.
+        memset(ref_pic_list_temp_0_, 0, sizeof(ref_pic_list_temp_0_));
+        memset(ref_pic_list_temp_1_, 0, sizeof(ref_pic_list_temp_1_));
+        return;
+    }
 
     /// List 0
     rIdx = 0;
-    num_rps_curr_temp_list = std::max(p_slice_header->num_ref_idx_l0_active_minus1 + 1, num_pic_total_curr_);
-
-    while (rIdx < num_rps_curr_temp_list) {
-        for (i = 0; i < num_poc_st_curr_before_ && rIdx < num_rps_curr_temp_list; rIdx++, i++) {
-            ref_pic_list_temp[rIdx] = ref_pic_set_st_curr_before_[i];
+    while (rIdx < HEVC_MAX_NUM_REF_PICS) {
+        for (i = 0; i < num_poc_st_curr_before_ && rIdx < HEVC_MAX_NUM_REF_PICS; rIdx++, i++) {
+            ref_pic_list_temp_0_[rIdx] = ref_pic_set_st_curr_before_[i];
         }
 
-        for (i = 0; i < num_poc_st_curr_after_ && rIdx < num_rps_curr_temp_list; rIdx++, i++) {
-            ref_pic_list_temp[rIdx] = ref_pic_set_st_curr_after_[i];
+        for (i = 0; i < num_poc_st_curr_after_ && rIdx < HEVC_MAX_NUM_REF_PICS; rIdx++, i++) {
+            ref_pic_list_temp_0_[rIdx] = ref_pic_set_st_curr_after_[i];
         }
 
-        for (i = 0; i < num_poc_lt_curr_ && rIdx < num_rps_curr_temp_list; rIdx++, i++) {
-            ref_pic_list_temp[rIdx] = ref_pic_set_lt_curr_[i];
+        for (i = 0; i < num_poc_lt_curr_ && rIdx < HEVC_MAX_NUM_REF_PICS; rIdx++, i++) {
+            ref_pic_list_temp_0_[rIdx] = ref_pic_set_lt_curr_[i];
         }
     }
 
-    for( rIdx = 0; rIdx <= p_slice_header->num_ref_idx_l0_active_minus1; rIdx++) {
-        p_slice_info->ref_pic_list_0_[rIdx] = p_slice_header->ref_pic_list_modification_flag_l0 ? ref_pic_list_temp[p_slice_header->list_entry_l0[rIdx]] : ref_pic_list_temp[rIdx];
-    }
-
     /// List 1
-    if (p_slice_header->slice_type == HEVC_SLICE_TYPE_B) {
-        rIdx = 0;
-        num_rps_curr_temp_list = std::max(p_slice_header->num_ref_idx_l1_active_minus1 + 1, num_pic_total_curr_);
-
-        while (rIdx < num_rps_curr_temp_list) {
-            for (i = 0; i < num_poc_st_curr_after_ && rIdx < num_rps_curr_temp_list; rIdx++, i++) {
-                ref_pic_list_temp[rIdx] = ref_pic_set_st_curr_after_[i];
-            }
+    rIdx = 0;
+    while (rIdx < HEVC_MAX_NUM_REF_PICS) {
+        for (i = 0; i < num_poc_st_curr_after_ && rIdx < HEVC_MAX_NUM_REF_PICS; rIdx++, i++) {
+            ref_pic_list_temp_1_[rIdx] = ref_pic_set_st_curr_after_[i];
+        }
 
-            for (i = 0; i < num_poc_st_curr_before_ && rIdx < num_rps_curr_temp_list; rIdx++, i++ ) {
-                ref_pic_list_temp[rIdx] = ref_pic_set_st_curr_before_[i];
-            }
+        for (i = 0; i < num_poc_st_curr_before_ && rIdx < HEVC_MAX_NUM_REF_PICS; rIdx++, i++) {
+            ref_pic_list_temp_1_[rIdx] = ref_pic_set_st_curr_before_[i];
+        }
 
-            for (i = 0; i < num_poc_lt_curr_ && rIdx < num_rps_curr_temp_list; rIdx++, i++ ) {
-                ref_pic_list_temp[rIdx] = ref_pic_set_lt_curr_[i];
-            }
+        for (i = 0; i < num_poc_lt_curr_ && rIdx < HEVC_MAX_NUM_REF_PICS; rIdx++, i++) {
+            ref_pic_list_temp_1_[rIdx] = ref_pic_set_lt_curr_[i];
         }
+    }
+}
+
+void HevcVideoParser::ConstructRefPicLists(HevcSliceInfo *p_slice_info) {
+    HevcSliceSegHeader *p_slice_header = &p_slice_info->slice_header;
+    uint32_t rIdx;
+
+    // RefPicListTemp0/1 are the same for all the slices of the picture, only their size (max(num_ref_idx_active, NumPicTotalCurr))
+    // differs, which does not change the selected entries.
+    for (rIdx = 0; rIdx <= p_slice_header->num_ref_idx_l0_active_minus1; rIdx++) {
+        p_slice_info->ref_pic_list_0_[rIdx] = p_slice_header->ref_pic_list_modification_flag_l0 ? ref_pic_list_temp_0_[p_slice_header->list_entry_l0[rIdx]] : ref_pic_list_temp_0_[rIdx];
+    }
 
-        for( rIdx = 0; rIdx <= p_slice_header->num_ref_idx_l1_active_minus1; rIdx++) {
-            p_slice_info->ref_pic_list_1_[rIdx] = p_slice_header->ref_pic_list_modification_flag_l1 ? ref_pic_list_temp[p_slice_header->list_entry_l1[rIdx]] : ref_pic_list_temp[rIdx];
+    if (p_slice_header->slice_type == HEVC_SLICE_TYPE_B) {
+        for (rIdx = 0; rIdx <= p_slice_header->num_ref_idx_l1_active_minus1; rIdx++) {
+            p_slice_info->ref_pic_list_1_[rIdx] = p_slice_header->ref_pic_list_modification_flag_l1 ? ref_pic_list_temp_1_[p_slice_header->list_entry_l1[rIdx]] : ref_pic_list_temp_1_[rIdx];
         }
     }
 }
@@ -2139,6 +2286,8 @@ void HevcVideoParser::InitDpb() {
     dpb_buffer_.dpb_size = 0;
     dpb_buffer_.dpb_fullness = 0;
     dpb_buffer_.num_pics_needed_for_output = 0;
+    dpb_poc_index_.Clear();
+    output_queue_size_ = 0;
 }
 
 void HevcVideoParser::EmptyDpb() {
@@ -2150,6 +2299,8 @@ void HevcVideoParser::EmptyDpb() {
     }
     dpb_buffer_.dpb_fullness = 0;
     dpb_buffer_.num_pics_needed_for_output = 0;
+    dpb_poc_index_.Clear();
+    output_queue_size_ = 0;
     num_output_pics_ = 0;
 }
 
@@ -2197,6 +2348,7 @@ int HevcVideoParser::MarkOutputPictures() {
         for (i = 0; i < HEVC_MAX_DPB_FRAMES; i++) {
             if (dpb_buffer_.frame_buffer_list[i].is_reference == kUnusedForReference && dpb_buffer_.frame_buffer_list[i].pic_output_flag == 0 && dpb_buffer_.frame_buffer_list[i].use_status) {
                 dpb_buffer_.frame_buffer_list[i].use_status = kNotUsed;
+                dpb_poc_index_.Remove(i);
                 decode_buffer_pool_[dpb_buffer_.frame_buffer_list[i].dec_buf_idx].use_status &= ~kFrameUsedForDecode;
                 if (dpb_buffer_.dpb_fullness > 0) {
                     dpb_buffer_.dpb_fullness--;
@@ -2207,18 +2359,19 @@ int HevcVideoParser::MarkOutputPictures() {
             }
         }
 
-        HevcSeqParamSet *sps_ptr = &m_sps_[m_active_sps_id_];
+        HevcSeqParamSet *sps_ptr = m_sps_[m_active_sps_id_];
         uint32_t highest_tid = sps_ptr->sps_max_sub_layers_minus1; // HighestTid
         uint32_t max_num_reorder_pics = sps_ptr->sps_max_num_reorder_pics[highest_tid];
         uint32_t max_dec_pic_buffering = sps_ptr->sps_max_dec_pic_buffering_minus1[highest_tid] + 1;
 
-        while (dpb_buffer_.dpb_fullness >= max_dec_pic_buffering) {
+        // A non-conforming RPS can keep more reference pictures than max_dec_pic_buffering, stop when no picture is left to bump
+        while (dpb_buffer_.dpb_fullness >= max_dec_pic_buffering && output_queue_size_ > 0) {
             if (BumpPicFromDpb() != PARSER_OK) {
                 return PARSER_FAIL;
             }
         }
 
-        while (dpb_buffer_.num_pics_needed_for_output > max_num_reorder_pics) {
+        while (dpb_buffer_.num_pics_needed_for_output > max_num_reorder_pics && output_queue_size_ > 0) {
             if (BumpPicFromDpb() != PARSER_OK) {
                 return PARSER_FAIL;
             }
@@ -2279,8 +2432,12 @@ ParserResult HevcVideoParser::FindFreeInDpbAndMark() {
     dpb_buffer_.frame_buffer_list[index].is_reference = kUsedForShortTerm;
     dpb_buffer_.frame_buffer_list[index].use_status = kFrameUsedForDecode;
 
+    dpb_poc_index_.Insert(index, curr_pic_info_.pic_order_cnt);
+
     if (dpb_buffer_.frame_buffer_list[index].pic_output_flag) {
         dpb_buffer_.num_pics_needed_for_output++;
+        output_queue_[output_queue_size_++] = std::make_pair(curr_pic_info_.pic_order_cnt, index);
+        std::push_heap(output_queue_, output_queue_ + output_queue_size_, std::greater<std::pair<int32_t, int>>());
     }
     dpb_buffer_.dpb_fullness++;
 
@@ -2292,11 +2449,11 @@ ParserResult HevcVideoParser::FindFreeInDpbAndMark() {
     decode_buffer_pool_[curr_pic_info_.dec_buf_idx].pic_order_cnt = curr_pic_info_.pic_order_cnt;
     decode_buffer_pool_[curr_pic_info_.dec_buf_idx].pts = curr_pts_;
 
-    HevcSeqParamSet *sps_ptr = &m_sps_[m_active_sps_id_];
+    HevcSeqParamSet *sps_ptr = m_sps_[m_active_sps_id_];
     uint32_t highest_tid = sps_ptr->sps_max_sub_layers_minus1; // HighestTid
     uint32_t max_num_reorder_pics = sps_ptr->sps_max_num_reorder_pics[highest_tid];
 
-    while ( dpb_buffer_.num_pics_needed_for_output > max_num_reorder_pics) {
+    while (dpb_buffer_.num_pics_needed_for_output > max_num_reorder_pics && output_queue_size_ > 0) {
         if (BumpPicFromDpb() != PARSER_OK) {
             return PARSER_FAIL;
         }
@@ -2308,22 +2465,13 @@ ParserResult HevcVideoParser::FindFreeInDpbAndMark() {
 }
 
 int HevcVideoParser::BumpPicFromDpb() {
-    int32_t min_poc = 0x7FFFFFFF;  // largest possible POC value 2^31 - 1
-    int min_poc_pic_idx = HEVC_MAX_DPB_FRAMES;
-    int i;
-
-    for (i = 0; i < HEVC_MAX_DPB_FRAMES; i++) {
-        if (dpb_buffer_.frame_buffer_list[i].pic_output_flag && dpb_buffer_.frame_buffer_list[i].use_status) {
-            if (dpb_buffer_.frame_buffer_list[i].pic_order_cnt < min_poc) {
-                min_poc = dpb_buffer_.frame_buffer_list[i].pic_order_cnt;
-                min_poc_pic_idx = i;
-            }
-        }
-    }
-    if (min_poc_pic_idx >= HEVC_MAX_DPB_FRAMES) {
+    if (output_queue_size_ == 0) {
         // No picture that is needed for ouput is found
         return PARSER_OK;
     }
+    // Take the picture with the smallest POC
+    std::pop_heap(output_queue_, output_queue_ + output_queue_size_, std::greater<std::pair<int32_t, int>>());
+    int min_poc_pic_idx = output_queue_[--output_queue_size_].second;
 
     // Mark as "not needed for output"
     dpb_buffer_.frame_buffer_list[min_poc_pic_idx].pic_output_flag = 0;
@@ -2334,6 +2482,7 @@ int HevcVideoParser::BumpPicFromDpb() {
     // If it is not used for reference, empty it.
     if (dpb_buffer_.frame_buffer_list[min_poc_pic_idx].is_reference == kUnusedForReference) {
         dpb_buffer_.frame_buffer_list[min_poc_pic_idx].use_status = kNotUsed;
+        dpb_poc_index_.Remove(min_poc_pic_idx);
         decode_buffer_pool_[dpb_buffer_.frame_buffer_list[min_poc_pic_idx].dec_buf_idx].use_status &= ~kFrameUsedForDecode;
         if (dpb_buffer_.dpb_fullness > 0 ) {
             dpb_buffer_.dpb_fullness--;
@@ -2470,7 +2619,7 @@ void HevcVideoParser::PrintSps(HevcSeqParamSet *sps_ptr) {
         for (int j = 0; j < HEVC_SCALING_LIST_NUM; j++) {
             MSG_NO_NEWLINE("scaling_list[" << i <<"][" << j << "][]:")
             for (int k = 0; k < HEVC_SCALING_LIST_MAX_INDEX; k++) {
-                MSG_NO_NEWLINE(" " << sps_ptr->scaling_list_data.scaling_list[i][j][k]);
+                MSG_NO_NEWLINE(" " << (sps_ptr->scaling_list_data ? sps_ptr->scaling_list_data->scaling_list[i][j][k] : 0));
             }
             MSG("");
         }
@@ -2570,7 +2719,7 @@ void HevcVideoParser::PrintPps(HevcPicParamSet *pps_ptr) {
         for (int j = 0; j < HEVC_SCALING_LIST_NUM; j++) {
             MSG_NO_NEWLINE("scaling_list[" << i <<"][" << j << "][]:")
             for (int k = 0; k < HEVC_SCALING_LIST_MAX_INDEX; k++) {
-                MSG_NO_NEWLINE(" " << pps_ptr->scaling_list_data.scaling_list[i][j][k]);
+                MSG_NO_NEWLINE(" " << (pps_ptr->scaling_list_data ? pps_ptr->scaling_list_data->scaling_list[i][j][k] : 0));
             }
             MSG("");
         }
@@ -27,6 +27,7 @@ THE SOFTWARE.
 
 #include <map>
 #include <algorithm>
+#include <functional>
 
 //size_id = 0
 extern int scaling_list_default_0[1][6][16];
@@ -126,12 +127,14 @@ protected:
     int32_t             m_active_vps_id_;
     int32_t             m_active_sps_id_;
     int32_t             m_active_pps_id_;
-    HevcVideoParamSet*  m_vps_ = nullptr;
-    HevcSeqParamSet*    m_sps_ = nullptr;
-    HevcPicParamSet*    m_pps_ = nullptr;
-    HevcSliceSegHeader* m_sh_copy_ = nullptr;
+    // Parameter sets are allocated from param_set_arena_ when an id is first received
+    ParserArena         param_set_arena_;
+    HevcVideoParamSet*  m_vps_[MAX_VPS_COUNT] = {nullptr};
+    HevcSeqParamSet*    m_sps_[MAX_SPS_COUNT] = {nullptr};
+    HevcPicParamSet*    m_pps_[MAX_PPS_COUNT] = {nullptr};
     std::vector<HevcSliceInfo> slice_info_list_;
     std::vector<RocdecHevcSliceParams> slice_param_list_;
+    int ref_frame_dec_buf_idx_[15]; // decode buffer indices of the ref_frames of the picture parameters
 
     HevcNalUnitHeader   slice_nal_unit_header_;
     HevcPicInfo         curr_pic_info_;
@@ -145,6 +148,9 @@ protected:
 
     // DPB
     DecodedPictureBuffer dpb_buffer_;
+    DpbKeyIndex<HEVC_MAX_DPB_FRAMES, 16> dpb_poc_index_;  // POC of the pictures in DPB. 16 buckets as MaxPicOrderCntLsb >= 16.
+    std::pair<int32_t, int> output_queue_[HEVC_MAX_DPB_FRAMES];  // min-heap of (POC, DPB index) of the pictures needed for output
+    int output_queue_size_ = 0;
     int no_output_of_prior_pics_flag;  // NoOutputOfPriorPicsFlag
 
     uint32_t num_pic_total_curr_;  // NumPicTotalCurr
@@ -166,6 +172,8 @@ protected:
     uint8_t ref_pic_set_st_foll_[HEVC_MAX_NUM_REF_PICS];  // RefPicSetStFoll
     uint8_t ref_pic_set_lt_curr_[HEVC_MAX_NUM_REF_PICS];  // RefPicSetLtCurr
     uint8_t ref_pic_set_lt_foll_[HEVC_MAX_NUM_REF_PICS];  // RefPicSetLtFoll
+    uint8_t ref_pic_list_temp_0_[HEVC_MAX_NUM_REF_PICS];  // RefPicListTemp0 of the maximum size, shared by the slices of the picture
+    uint8_t ref_pic_list_temp_1_[HEVC_MAX_NUM_REF_PICS];  // RefPicListTemp1 of the maximum size, shared by the slices of the picture
 
     /*! \brief Function to parse Video Parameter Set 
      * \param [in] nalu A pointer of <tt>uint8_t</tt> for the input stream to be parsed
@@ -271,9 +279,11 @@ protected:
      * \param [in] nalu A pointer of <tt>uint8_t</tt> for the input stream to be parsed
      * \param [in] size Size of the input stream
      * \param [out] p_slice_header Pointer to the slice header struct
+     * \param [in] p_prev_slice_header Pointer to the header of the preceding slice segment of the picture, from which a dependent slice
+     *             segment takes its slice header fields; nullptr for the first slice segment
      * \return <tt>ParserResult</tt>
      */
-    ParserResult ParseSliceHeader(uint8_t *nalu, size_t size, HevcSliceSegHeader *p_slice_header);
+    ParserResult ParseSliceHeader(uint8_t *nalu, size_t size, HevcSliceSegHeader *p_slice_header, const HevcSliceSegHeader *p_prev_slice_header);
 
     /*! \brief Function to calculate the picture order count of the current picture. Once per picutre. (8.3.1)
      */
@@ -283,7 +293,13 @@ protected:
      */
     void DecodeRps();
 
-    /*! \brief Function to perform decoding process for reference picture lists construction per slice. (8.3.4)
+    /*! \brief Function to derive the initial reference picture lists RefPicListTemp0/1 from the RPS. Once per picture. (8.3.4)
+     * The lists repeat the RPS entries up to the maximum list size, so that each slice only selects its first entries or applies its
+     * modifications, whatever its num_ref_idx_active.
+     */
+    void InitRefPicListTemp();
+
+    /*! \brief Function to perform decoding process for reference picture lists construction per slice from the initial lists of the picture. (8.3.4)
      * \param [in] p_slice_info Pointer to the slice info struct
      */
     void ConstructRefPicLists(HevcSliceInfo *p_slice_info);
@@ -329,6 +345,12 @@ protected:
      */
     ParserResult ParsePictureData(const uint8_t* p_stream, uint32_t pic_data_size);
 
+    /*! \brief Function to classify a NAL unit for access unit boundary detection in byte stream mode (7.4.2.4.4)
+     * \param [in] nal_unit Pointer to the NAL unit header, followed by at least the first byte of the slice segment header
+     * \return <tt>AuNalType</tt>
+     */
+    virtual AuNalType GetAuNalType(const uint8_t *nal_unit);
+
 #if DBGINFO
     void PrintVps(HevcVideoParamSet *vps_ptr);
     void PrintSps(HevcSeqParamSet *sps_ptr);
@@ -349,11 +371,28 @@ private:
      */
     void SendSeiMsgPayload();
 
+    /*! \brief Function to fill the picture parameters and the scaling lists of the current picture
+     */
+    void FillPicParams();
+
+    /*! \brief Function to fill the slice parameters of a slice of the current picture
+     * \param [in] slice_index Index of the slice in slice_info_list_
+     * \return Return code in ParserResult form
+     */
+    ParserResult FillSliceParams(int slice_index);
+
     /*! \brief Callback function to fill the decode parameters and call decoder to decode a picture
      * \return Return code in ParserResult form
      */
     int SendPicForDecode();
 
+    /*! \brief Callback function to submit the parsed slices of the current picture which have not been submitted yet as one
+     *         batch (RocdecParserParams::slice_submission). The first batch starts the picture.
+     * \param [in] last_batch The batch ends the picture
+     * \return Return code in ParserResult form
+     */
+    ParserResult SendSliceBatch(bool last_batch);
+
     bool IsIdrPic(HevcNalUnitHeader *nal_header_ptr);
     bool IsCraPic(HevcNalUnitHeader *nal_header_ptr);
     bool IsBlaPic(HevcNalUnitHeader *nal_header_ptr);
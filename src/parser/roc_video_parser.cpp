@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <algorithm>
 #include "roc_video_parser.h"
 
 RocVideoParser::RocVideoParser() {
@@ -30,12 +31,23 @@ RocVideoParser::RocVideoParser() {
     frame_rate_.numerator = 0;
     frame_rate_.denominator = 0;
     curr_pts_ = 0;
+    end_of_picture_ = false;
+    num_slices_ = 0;
+    num_submitted_slices_ = 0;
+    partial_au_ = false;
+    au_in_progress_ = false;
 
     sei_rbsp_buf_ = nullptr;
     sei_rbsp_buf_size_ = 0;
     sei_payload_buf_ = nullptr;
     sei_payload_buf_size_ = 0;
     sei_message_list_.assign(INIT_SEI_MESSAGE_COUNT, {0});
+
+    stream_read_offset_ = 0;
+    stream_write_offset_ = 0;
+    stream_scan_offset_ = 0;
+    stream_au_has_vcl_ = false;
+    stream_slice_cut_offset_ = 0;
 }
 
 RocVideoParser::~RocVideoParser() {
@@ -105,7 +117,7 @@ ParserResult RocVideoParser::OutputDecodedPictures(bool no_delay) {
     disp_info.progressive_frame = 1; // not used
     disp_info.top_field_first = 1; // not used
 
-    int disp_delay = no_delay ? 0 : parser_params_.max_display_delay;
+    int disp_delay = (no_delay || end_of_picture_) ? 0 : parser_params_.max_display_delay;
     if (num_output_pics_ > disp_delay) {
         int num_disp = num_output_pics_ - disp_delay;
         for (int i = 0; i < num_disp; i++) {
@@ -166,6 +178,135 @@ ParserResult RocVideoParser::GetNalUnit() {
     }        
 }
 
+rocDecStatus RocVideoParser::ParseByteStreamData(RocdecSourceDataPacket *pData) {
+    if (pData->payload && pData->payload_size) {
+        AppendStreamData(pData);
+    } else if (!(pData->flags & ROCDEC_PKT_ENDOFSTREAM)) {
+        // If no payload and EOS is not set, treated as invalid.
+        return ROCDEC_INVALID_PARAMETER;
+    }
+
+    // Parse every access unit completed by this chunk
+    rocDecStatus status;
+    ParserResult ret;
+    int au_end;
+    while ((ret = FindAccessUnitEnd(&au_end)) == PARSER_OK) {
+        if ((status = SendAccessUnit(au_end, 0, false)) != ROCDEC_SUCCESS) {
+            return status;
+        }
+    }
+    if (ret != PARSER_NOT_FOUND) {
+        ERR(STR("Invalid byte stream data."));
+        return ROCDEC_RUNTIME_ERROR;
+    }
+
+    // The remaining data is a complete access unit at the end of a picture or of the stream
+    if (pData->flags & (ROCDEC_PKT_ENDOFPICTURE | ROCDEC_PKT_ENDOFSTREAM)) {
+        return SendAccessUnit(stream_write_offset_, pData->flags & (ROCDEC_PKT_ENDOFPICTURE | ROCDEC_PKT_ENDOFSTREAM | ROCDEC_PKT_NOTIFY_EOS), false);
+    }
+    // Slice submission: parse the received slices of the current access unit without waiting for its end
+    if (parser_params_.slice_submission && stream_slice_cut_offset_ > stream_read_offset_) {
+        return SendAccessUnit(stream_slice_cut_offset_, 0, true);
+    }
+    return ROCDEC_SUCCESS;
+}
+
+void RocVideoParser::AppendStreamData(RocdecSourceDataPacket *p_data) {
+    int chunk_size = p_data->payload_size;
+    size_t required_size = stream_write_offset_ + chunk_size;
+    if (required_size > stream_buf_.size()) {
+        // Move the current access unit to the top of the buffer
+        if (stream_read_offset_ > 0) {
+            int shift = stream_read_offset_;
+            memmove(stream_buf_.data(), stream_buf_.data() + shift, stream_write_offset_ - shift);
+            stream_read_offset_ = 0;
+            stream_write_offset_ -= shift;
+            stream_scan_offset_ -= shift;
+            stream_slice_cut_offset_ -= shift;
+            for (auto &chunk : stream_chunk_list_) {
+                chunk.offset -= shift;
+            }
+        }
+        required_size = stream_write_offset_ + chunk_size;
+        if (required_size > stream_buf_.size()) {
+            stream_buf_.resize(std::max(stream_buf_.size() * 2, required_size));
+        }
+    }
+    memcpy(stream_buf_.data() + stream_write_offset_, p_data->payload, chunk_size);
+    stream_chunk_list_.push_back({stream_write_offset_, (p_data->flags & ROCDEC_PKT_TIMESTAMP) != 0, p_data->pts});
+    stream_write_offset_ += chunk_size;
+}
+
+ParserResult RocVideoParser::FindAccessUnitEnd(int *p_au_end) {
+    const uint8_t *p_buf = stream_buf_.data();
+    int pos = stream_scan_offset_;
+    while (pos + 2 < stream_write_offset_) {
+        if (p_buf[pos + 2] > 1) {
+            pos += 3;
+        } else if (p_buf[pos + 2] == 1 && p_buf[pos + 1] == 0 && p_buf[pos] == 0) {
+            // Start code: the NAL unit header and the first byte of the slice header are needed to classify the NAL unit
+            if (pos + 6 > stream_write_offset_) {
+                break;
+            }
+            AuNalType nal_type = GetAuNalType(p_buf + pos + 3);
+            if (stream_au_has_vcl_ && (nal_type == kAuNalPrefix || nal_type == kAuNalFirstVcl)) {
+                // keep the leading zero byte of a 4-byte start code with the next access unit
+                *p_au_end = (pos > stream_read_offset_ && p_buf[pos - 1] == 0) ? pos - 1 : pos;
+                stream_scan_offset_ = *p_au_end;
+                return PARSER_OK;
+            }
+            if (nal_type == kAuNalVcl && stream_au_has_vcl_) {
+                stream_slice_cut_offset_ = (pos > stream_read_offset_ && p_buf[pos - 1] == 0) ? pos - 1 : pos;
+            }
+            if (nal_type == kAuNalFirstVcl || nal_type == kAuNalVcl) {
+                stream_au_has_vcl_ = true;
+            }
+            pos += 3;
+        } else {
+            pos++;
+        }
+    }
+    stream_scan_offset_ = pos;
+    return PARSER_NOT_FOUND;
+}
+
+rocDecStatus RocVideoParser::SendAccessUnit(int au_end, uint32_t flags, bool partial) {
+    RocdecSourceDataPacket packet = {};
+    packet.flags = flags;
+    if (au_end > stream_read_offset_) {
+        packet.payload = stream_buf_.data() + stream_read_offset_;
+        packet.payload_size = au_end - stream_read_offset_;
+        // Drop the chunks ending before the access unit
+        size_t num_done = 0;
+        while (num_done + 1 < stream_chunk_list_.size() && stream_chunk_list_[num_done + 1].offset <= stream_read_offset_) {
+            num_done++;
+        }
+        stream_chunk_list_.erase(stream_chunk_list_.begin(), stream_chunk_list_.begin() + num_done);
+        if (!stream_chunk_list_.empty() && stream_chunk_list_[0].has_pts) {
+            packet.flags |= ROCDEC_PKT_TIMESTAMP;
+            packet.pts = stream_chunk_list_[0].pts;
+        }
+    } else if (!(flags & ROCDEC_PKT_ENDOFSTREAM)) {
+        return ROCDEC_SUCCESS;
+    }
+
+    stream_read_offset_ = au_end;
+    stream_scan_offset_ = std::max(stream_scan_offset_, au_end);
+    if (!partial) {
+        stream_au_has_vcl_ = false;
+    }
+    partial_au_ = partial;
+    if (flags & ROCDEC_PKT_ENDOFSTREAM) {
+        // The buffer is not touched by the parser anymore: restart from the top for the next stream
+        stream_read_offset_ = 0;
+        stream_write_offset_ = 0;
+        stream_scan_offset_ = 0;
+        stream_slice_cut_offset_ = 0;
+        stream_chunk_list_.clear();
+    }
+    return ParseVideoData(&packet);
+}
+
 size_t RocVideoParser::EbspToRbsp(uint8_t *streamBuffer,size_t begin_bytepos, size_t end_bytepos) {
     int count = 0;
     if (end_bytepos < begin_bytepos) {
@@ -255,4 +396,32 @@ void RocVideoParser::ParseSeiMessage(uint8_t *nalu, size_t size) {
 
         offset += payload_size;
     } while (offset < size && nalu[offset] != 0x80);
-}
\ No newline at end of file
+}
+
+ParserArena::~ParserArena() {
+    for (auto block : blocks_) {
+        delete [] block;
+    }
+}
+
+void *ParserArena::Alloc(size_t size) {
+    size = (size + 15) & ~static_cast<size_t>(15);
+    if (size > remaining_size_) {
+        // Large requests get a block of their own so the free space of the current block is not lost
+        size_t new_block_size = size > block_size_ / 2 ? size : block_size_;
+        uint8_t *block = new uint8_t [new_block_size];
+        blocks_.push_back(block);
+        reserved_size_ += new_block_size;
+        if (new_block_size != block_size_) {
+            memset(block, 0, size);
+            return block;
+        }
+        curr_ptr_ = block;
+        remaining_size_ = block_size_;
+    }
+    uint8_t *p = curr_ptr_;
+    curr_ptr_ += size;
+    remaining_size_ -= size;
+    memset(p, 0, size);
+    return p;
+}
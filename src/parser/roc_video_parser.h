@@ -88,6 +88,115 @@ enum {
     kFrameUsedForDisplay = 1 << 2
 } FrameBufUseStatus;
 
+/**
+ * @brief Bump allocator for data that lives as long as the parser, e.g. parameter sets. Memory is handed out zero
+ * initialized from blocks that are only requested when needed and released when the arena is destroyed.
+ * Only trivially destructible (C) structs may be allocated from it.
+ */
+class ParserArena {
+public:
+    ParserArena(size_t block_size = 64 * 1024) : block_size_(block_size) {};
+    ~ParserArena();
+    ParserArena(const ParserArena &) = delete;
+    ParserArena &operator=(const ParserArena &) = delete;
+
+    /*! \brief Function to allocate zero initialized memory
+     * \param [in] size Size in bytes
+     * \return Pointer to the memory, aligned to 16 bytes
+     */
+    void *Alloc(size_t size);
+
+    /*! \brief Function to allocate a zero initialized array of count structs
+     */
+    template <typename T>
+    T *Alloc(size_t count = 1) { return static_cast<T*>(Alloc(sizeof(T) * count)); }
+
+    /*! \brief Function to get the total size of the memory blocks requested by the arena
+     */
+    size_t GetReservedSize() const { return reserved_size_; }
+
+private:
+    std::vector<uint8_t*> blocks_;
+    size_t block_size_;
+    uint8_t *curr_ptr_ = nullptr;  // next free byte in the current block
+    size_t remaining_size_ = 0;  // free bytes left in the current block
+    size_t reserved_size_ = 0;
+};
+
+/**
+ * @brief Index from a picture key (e.g. POC or PicNum) to the slots of a DPB of up to kMaxSlots pictures. The slots are chained
+ * in kNumBuckets (power of 2) buckets selected by the low bits of the key, so a lookup only visits the pictures whose keys share
+ * these bits instead of the whole DPB.
+ */
+template <int kMaxSlots, int kNumBuckets>
+class DpbKeyIndex {
+public:
+    DpbKeyIndex() { Clear(); };
+
+    /*! \brief Function to remove all the slots from the index
+     */
+    void Clear() {
+        for (int i = 0; i < kNumBuckets; i++) {
+            bucket_head_[i] = -1;
+        }
+        for (int i = 0; i < kMaxSlots; i++) {
+            in_index_[i] = false;
+        }
+    }
+
+    /*! \brief Function to add a slot with its key. A slot that is already in the index is moved to the new key.
+     */
+    void Insert(int slot, int32_t key) {
+        Remove(slot);
+        int bucket = key & (kNumBuckets - 1);
+        keys_[slot] = key;
+        next_[slot] = bucket_head_[bucket];
+        bucket_head_[bucket] = slot;
+        in_index_[slot] = true;
+    }
+
+    /*! \brief Function to remove a slot. Slots that are not in the index are ignored.
+     */
+    void Remove(int slot) {
+        if (!in_index_[slot]) {
+            return;
+        }
+        int8_t *p_link = &bucket_head_[keys_[slot] & (kNumBuckets - 1)];
+        while (*p_link != slot) {
+            p_link = &next_[*p_link];
+        }
+        *p_link = next_[slot];
+        in_index_[slot] = false;
+    }
+
+    /*! \brief Function to find the slot of a key
+     * \return The slot, or -1 if the key is not in the index
+     */
+    int Find(int32_t key) const {
+        return FindMasked(key, -1);
+    }
+
+    /*! \brief Function to find the slot whose key has the given value in the bits of mask (e.g. the POC LSB)
+     * \param [in] key Masked key value
+     * \param [in] mask Bit mask, which has to include the bucket bits (kNumBuckets - 1)
+     * \return The slot, or -1 if there is no match
+     */
+    int FindMasked(int32_t key, int32_t mask) const {
+        for (int slot = bucket_head_[key & (kNumBuckets - 1)]; slot >= 0; slot = next_[slot]) {
+            if ((keys_[slot] & mask) == key) {
+                return slot;
+            }
+        }
+        return -1;
+    }
+
+private:
+    int8_t bucket_head_[kNumBuckets];  // first slot of each bucket, -1 if empty
+    int8_t next_[kMaxSlots];  // next slot in the same bucket, -1 at the end
+    int32_t keys_[kMaxSlots];
+    bool in_index_[kMaxSlots];
+};
+
 /**
  * @brief Base class for video parsing
  * 
@@ -101,6 +210,14 @@ public:
     RocdecParserParams *GetParserParams() {return &parser_params_;};
     virtual rocDecStatus Initialize(RocdecParserParams *pParams);
     virtual rocDecStatus ParseVideoData(RocdecSourceDataPacket *pData) = 0;     // pure virtual: implemented by derived class
+    /**
+     * @brief function to parse an arbitrary chunk of a byte stream (RocdecParserParams::byte_stream). The chunk is appended to the
+     * @brief stream buffer and every complete access unit found in it is passed to ParseVideoData
+     * \param [in] pData chunk of the byte stream; ROCDEC_PKT_ENDOFSTREAM parses the remaining data as the last access unit
+     * 
+     * @return rocDecStatus 
+     */
+    rocDecStatus ParseByteStreamData(RocdecSourceDataPacket *pData);
     virtual rocDecStatus UnInitialize() = 0;     // pure virtual: implemented by derived class
     /**
      * @brief function to to release surface with pic_idx and mark it for reuse, can be called from a different thread than decode thread
@@ -143,6 +260,7 @@ protected:
     std::vector<uint32_t> output_pic_list_; // sorted output frame index to decode_buffer_pool_
 
     RocdecTimeStamp curr_pts_;
+    bool end_of_picture_;   // the current packet has ROCDEC_PKT_ENDOFPICTURE: the ready pictures are output without display delay
     Rational frame_rate_;
 
     RocdecVideoFormat video_format_params_;
@@ -167,6 +285,11 @@ protected:
     uint8_t*            pic_stream_data_ptr_;
     int                 pic_stream_data_size_;
 
+    // Slice submission (RocdecParserParams::slice_submission)
+    int                 num_submitted_slices_;  // slices of the current picture already passed to pfn_decode_picture
+    bool                partial_au_;            // the packet ends inside the access unit: more slices of the current picture follow
+    bool                au_in_progress_;        // the previous packet was partial: the current packet continues its access unit
+
     uint8_t             *sei_rbsp_buf_; // buffer to store SEI RBSP. Allocated at run time.
     uint32_t            sei_rbsp_buf_size_;
     std::vector<RocdecSeiMessage> sei_message_list_;
@@ -175,13 +298,63 @@ protected:
     uint32_t            sei_payload_buf_size_;
     uint32_t            sei_payload_size_;  // total SEI payload size of the current frame
 
+    // Byte stream mode: the chunks are appended to a linear buffer which is compacted instead of reallocated once it holds the
+    // largest access unit plus one chunk, so the access units handed to ParseVideoData are contiguous without per chunk allocation
+    typedef struct {
+        int offset;             // start of the chunk in stream_buf_
+        bool has_pts;
+        RocdecTimeStamp pts;
+    } StreamChunkInfo;
+    std::vector<uint8_t> stream_buf_;
+    int stream_read_offset_;    // start of the current access unit
+    int stream_write_offset_;   // end of the buffered data
+    int stream_scan_offset_;    // next byte to examine for the end of the current access unit
+    bool stream_au_has_vcl_;    // the current access unit contains a VCL NAL unit
+    int stream_slice_cut_offset_;   // start of the last slice found after the first one of the current access unit: the data before it can be
+                                    // parsed early with slice submission, as its slices are not the last ones of the picture
+    std::vector<StreamChunkInfo> stream_chunk_list_;  // buffered chunks; an access unit takes the pts of the chunk holding its first byte
+
+    /*! \brief NAL unit classes for access unit boundary detection (H.264 7.4.1.2.3, HEVC 7.4.2.4.4)
+     */
+    enum AuNalType {
+        kAuNalOther = 0,    // does not start an access unit
+        kAuNalPrefix,       // AUD, parameter set, prefix SEI or reserved type: starts an access unit after a VCL NAL unit
+        kAuNalFirstVcl,     // first slice of a picture
+        kAuNalVcl           // other slices of a picture
+    };
+
+    /*! \brief Function to classify a NAL unit for access unit boundary detection of Annex-B byte streams
+     * \param [in] nal_unit Pointer to the NAL unit header, followed by at least the first byte of the slice header
+     * \return <tt>AuNalType</tt>
+     */
+    virtual AuNalType GetAuNalType(const uint8_t *nal_unit) { return kAuNalOther; };
+
+    /*! \brief Function to find the end of the current access unit in the stream buffer. The default implementation scans the start codes
+     *         of an Annex-B byte stream and classifies the NAL units with GetAuNalType.
+     * \param [out] p_au_end Offset of the first byte of the next access unit in stream_buf_
+     * \return <tt>ParserResult</tt> PARSER_OK if an access unit is complete, PARSER_NOT_FOUND if more data is needed, else error code
+     */
+    virtual ParserResult FindAccessUnitEnd(int *p_au_end);
+
+    /*! \brief Function to append a chunk to the stream buffer, compacting or growing it if needed
+     */
+    void AppendStreamData(RocdecSourceDataPacket *p_data);
+
+    /*! \brief Function to parse the buffered data up to au_end as one access unit
+     * \param [in] au_end End of the access unit in stream_buf_
+     * \param [in] flags Additional packet flags (ROCDEC_PKT_ENDOFSTREAM to flush the parser, ROCDEC_PKT_ENDOFPICTURE to output without delay)
+     * \param [in] partial The data ends inside the access unit (slice submission): the rest of it is sent with the next call
+     * \return <tt>rocDecStatus</tt>
+     */
+    rocDecStatus SendAccessUnit(int au_end, uint32_t flags, bool partial);
+
     /*! \brief Function to check the initially set (by decoder) decode buffer pool size and adjust if needed
      *  \param dpb_size The DPB buffer size of the current sequence
      */
     void CheckAndAdjustDecBufPoolSize(int dpb_size);
 
     /*! \brief Callback function to output decoded pictures from DPB for post-processing.
-     * \param [in] no_delay Indicator to override the display delay parameter wth no delay
+     * \param [in] no_delay Indicator to override the display delay parameter wth no delay (also done for ROCDEC_PKT_ENDOFPICTURE packets)
      * \return <tt>ParserResult</tt>
      */
     ParserResult OutputDecodedPictures(bool no_delay);
@@ -24,7 +24,7 @@ THE SOFTWARE.
 
 VaapiVideoDecoder::VaapiVideoDecoder(RocDecoderCreateInfo &decoder_create_info) : decoder_create_info_{decoder_create_info},
     drm_fd_{-1}, va_display_{0}, va_config_attrib_{{}}, va_config_id_{0}, va_profile_ {VAProfileNone}, va_context_id_{0}, va_surface_ids_{{}},
-    pic_params_buf_id_{0}, iq_matrix_buf_id_{0}, num_slices_{0}, slice_data_buf_id_{0} {
+    pic_params_buf_id_{0}, iq_matrix_buf_id_{0}, num_slices_{0}, slice_data_buf_id_{0}, pic_in_progress_{false} {
 };
 
 VaapiVideoDecoder::~VaapiVideoDecoder() {
@@ -241,6 +241,11 @@ rocDecStatus VaapiVideoDecoder::DestroyDataBuffers() {
         CHECK_VAAPI(vaDestroyBuffer(va_display_, slice_data_buf_id_));
         slice_data_buf_id_ = 0;
     }
+    for (auto &buf_id : slice_batch_data_buf_id_) {
+        CHECK_VAAPI(vaDestroyBuffer(va_display_, buf_id));
+    }
+    slice_batch_data_buf_id_.clear();
+    num_slices_ = 0;
     return ROCDEC_SUCCESS;
 }
 
@@ -249,6 +254,21 @@ rocDecStatus VaapiVideoDecoder::SubmitDecode(RocdecPicParams *pPicParams) {
     uint32_t pic_params_size, iq_matrix_size, slice_params_size;
     bool scaling_list_enabled = false;
     VASurfaceID curr_surface_id;
+    // A picture submitted in batches of slices is started by the first batch and ended by the last one
+    bool slice_batch = (pPicParams->slice_batch_flags & ROCDEC_SLICE_BATCH) != 0;
+    bool begin_pic = !slice_batch || (pPicParams->slice_batch_flags & ROCDEC_SLICE_BATCH_FIRST);
+    bool end_pic = !slice_batch || (pPicParams->slice_batch_flags & ROCDEC_SLICE_BATCH_LAST);
+    if (begin_pic && pic_in_progress_) {
+        ERR("The previous picture was not ended by a ROCDEC_SLICE_BATCH_LAST batch.");
+        // end the incomplete picture so that the VA context accepts the next vaBeginPicture; its surface is left partially decoded
+        pic_in_progress_ = false;
+        CHECK_VAAPI(vaEndPicture(va_display_, va_context_id_));
+        return ROCDEC_INVALID_PARAMETER;
+    }
+    if (!begin_pic && !pic_in_progress_) {
+        ERR("A slice batch was submitted without a ROCDEC_SLICE_BATCH_FIRST batch.");
+        return ROCDEC_INVALID_PARAMETER;
+    }
 
     // Get the surface id for the current picture, assuming 1:1 mapping between DPB and VAAPI decoded surfaces.
     if (pPicParams->curr_pic_idx >= va_surface_ids_.size() || pPicParams->curr_pic_idx < 0) {
@@ -260,14 +280,16 @@ rocDecStatus VaapiVideoDecoder::SubmitDecode(RocdecPicParams *pPicParams) {
     // Upload data buffers
     switch (decoder_create_info_.codec_type) {
         case rocDecVideoCodec_HEVC: {
-            pPicParams->pic_params.hevc.curr_pic.pic_idx = curr_surface_id;
-            for (int i = 0; i < 15; i++) {
-                if (pPicParams->pic_params.hevc.ref_frames[i].pic_idx != 0xFF) {
-                    if (pPicParams->pic_params.hevc.ref_frames[i].pic_idx >= va_surface_ids_.size() || pPicParams->pic_params.hevc.ref_frames[i].pic_idx < 0) {
-                        ERR("Reference frame index exceeded the VAAPI surface pool limit.");
-                        return ROCDEC_INVALID_PARAMETER;
+            if (begin_pic) {
+                pPicParams->pic_params.hevc.curr_pic.pic_idx = curr_surface_id;
+                for (int i = 0; i < 15; i++) {
+                    if (pPicParams->pic_params.hevc.ref_frames[i].pic_idx != 0xFF) {
+                        if (pPicParams->pic_params.hevc.ref_frames[i].pic_idx >= va_surface_ids_.size() || pPicParams->pic_params.hevc.ref_frames[i].pic_idx < 0) {
+                            ERR("Reference frame index exceeded the VAAPI surface pool limit.");
+                            return ROCDEC_INVALID_PARAMETER;
+                        }
+                        pPicParams->pic_params.hevc.ref_frames[i].pic_idx = va_surface_ids_[pPicParams->pic_params.hevc.ref_frames[i].pic_idx];
                     }
-                    pPicParams->pic_params.hevc.ref_frames[i].pic_idx = va_surface_ids_[pPicParams->pic_params.hevc.ref_frames[i].pic_idx];
                 }
             }
             pic_params_ptr = (void*)&pPicParams->pic_params.hevc;
@@ -291,14 +313,16 @@ rocDecStatus VaapiVideoDecoder::SubmitDecode(RocdecPicParams *pPicParams) {
         }
 
         case rocDecVideoCodec_AVC: {
-            pPicParams->pic_params.avc.curr_pic.pic_idx = curr_surface_id;
-            for (int i = 0; i < 16; i++) {
-                if (pPicParams->pic_params.avc.ref_frames[i].pic_idx != 0xFF) {
-                    if (pPicParams->pic_params.avc.ref_frames[i].pic_idx >= va_surface_ids_.size() || pPicParams->pic_params.avc.ref_frames[i].pic_idx < 0) {
-                        ERR("Reference frame index exceeded the VAAPI surface pool limit.");
-                        return ROCDEC_INVALID_PARAMETER;
+            if (begin_pic) {
+                pPicParams->pic_params.avc.curr_pic.pic_idx = curr_surface_id;
+                for (int i = 0; i < 16; i++) {
+                    if (pPicParams->pic_params.avc.ref_frames[i].pic_idx != 0xFF) {
+                        if (pPicParams->pic_params.avc.ref_frames[i].pic_idx >= va_surface_ids_.size() || pPicParams->pic_params.avc.ref_frames[i].pic_idx < 0) {
+                            ERR("Reference frame index exceeded the VAAPI surface pool limit.");
+                            return ROCDEC_INVALID_PARAMETER;
+                        }
+                        pPicParams->pic_params.avc.ref_frames[i].pic_idx = va_surface_ids_[pPicParams->pic_params.avc.ref_frames[i].pic_idx];
                     }
-                    pPicParams->pic_params.avc.ref_frames[i].pic_idx = va_surface_ids_[pPicParams->pic_params.avc.ref_frames[i].pic_idx];
                 }
             }
             pic_params_ptr = (void*)&pPicParams->pic_params.avc;
@@ -318,6 +342,10 @@ rocDecStatus VaapiVideoDecoder::SubmitDecode(RocdecPicParams *pPicParams) {
             break;
         }
         case rocDecVideoCodec_AV1: {
+            if (slice_batch) {
+                ERR("Slice batches are not supported for AV1.");
+                return ROCDEC_NOT_SUPPORTED;
+            }
             pPicParams->pic_params.av1.current_frame = curr_surface_id;
 
             if (pPicParams->pic_params.av1.current_display_picture != 0xFF) {
@@ -372,37 +400,51 @@ rocDecStatus VaapiVideoDecoder::SubmitDecode(RocdecPicParams *pPicParams) {
         }
     }
 
-    // Destroy the data buffers of the previous frame
-    rocDecStatus rocdec_status = DestroyDataBuffers();
-    if (rocdec_status != ROCDEC_SUCCESS) {
-        ERR("Failed to destroy VAAPI buffer.");
-        return rocdec_status;
-    }
+    if (begin_pic) {
+        // Destroy the data buffers of the previous frame
+        rocDecStatus rocdec_status = DestroyDataBuffers();
+        if (rocdec_status != ROCDEC_SUCCESS) {
+            ERR("Failed to destroy VAAPI buffer.");
+            return rocdec_status;
+        }
 
-    CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VAPictureParameterBufferType, pic_params_size, 1, pic_params_ptr, &pic_params_buf_id_));
-    if (scaling_list_enabled) {
-        CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VAIQMatrixBufferType, iq_matrix_size, 1, iq_matrix_ptr, &iq_matrix_buf_id_));
+        CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VAPictureParameterBufferType, pic_params_size, 1, pic_params_ptr, &pic_params_buf_id_));
+        if (scaling_list_enabled) {
+            CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VAIQMatrixBufferType, iq_matrix_size, 1, iq_matrix_ptr, &iq_matrix_buf_id_));
+        }
     }
-    // Resize if needed
-    num_slices_ = pPicParams->num_slices;
+    // The slice parameter buffers of all the batches are kept until the next picture. Resize if needed
+    uint32_t first_slice = num_slices_;
+    num_slices_ += pPicParams->num_slices;
     if (num_slices_ > slice_params_buf_id_.size()) {
         slice_params_buf_id_.resize(num_slices_, {0});
     }
-    for (int i = 0; i < num_slices_; i++) {
+    for (int i = first_slice; i < num_slices_; i++) {
         CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VASliceParameterBufferType, slice_params_size, 1, slice_params_ptr, &slice_params_buf_id_[i]));
         slice_params_ptr = (void*)((uint8_t*)slice_params_ptr + slice_params_size);
     }
-    CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VASliceDataBufferType, pPicParams->bitstream_data_len, 1, (void*)pPicParams->bitstream_data, &slice_data_buf_id_));
+    VABufferID *p_slice_data_buf_id = &slice_data_buf_id_;
+    if (slice_batch) {
+        slice_batch_data_buf_id_.push_back(0);
+        p_slice_data_buf_id = &slice_batch_data_buf_id_.back();
+    }
+    CHECK_VAAPI(vaCreateBuffer(va_display_, va_context_id_, VASliceDataBufferType, pPicParams->bitstream_data_len, 1, (void*)pPicParams->bitstream_data, p_slice_data_buf_id));
 
     // Sumbmit buffers to VAAPI driver
-    CHECK_VAAPI(vaBeginPicture(va_display_, va_context_id_, curr_surface_id));
-    CHECK_VAAPI(vaRenderPicture(va_display_, va_context_id_, &pic_params_buf_id_, 1));
-    if (scaling_list_enabled) {
-        CHECK_VAAPI(vaRenderPicture(va_display_, va_context_id_, &iq_matrix_buf_id_, 1));
-    }
-    CHECK_VAAPI(vaRenderPicture(va_display_, va_context_id_, slice_params_buf_id_.data(), num_slices_));
-    CHECK_VAAPI(vaRenderPicture(va_display_, va_context_id_, &slice_data_buf_id_, 1));
-    CHECK_VAAPI(vaEndPicture(va_display_, va_context_id_));
+    if (begin_pic) {
+        CHECK_VAAPI(vaBeginPicture(va_display_, va_context_id_, curr_surface_id));
+        pic_in_progress_ = !end_pic;
+        CHECK_VAAPI(vaRenderPicture(va_display_, va_context_id_, &pic_params_buf_id_, 1));
+        if (scaling_list_enabled) {
+            CHECK_VAAPI(vaRenderPicture(va_display_, va_context_id_, &iq_matrix_buf_id_, 1));
+        }
+    }
+    CHECK_VAAPI(vaRenderPicture(va_display_, va_context_id_, slice_params_buf_id_.data() + first_slice, num_slices_ - first_slice));
+    CHECK_VAAPI(vaRenderPicture(va_display_, va_context_id_, p_slice_data_buf_id, 1));
+    if (end_pic) {
+        pic_in_progress_ = false;
+        CHECK_VAAPI(vaEndPicture(va_display_, va_context_id_));
+    }
 
     return ROCDEC_SUCCESS;
 }
@@ -87,6 +87,8 @@ private:
     uint32_t num_slices_;
     VABufferID slice_data_buf_id_;
     uint32_t slice_data_buf_size_;
+    std::vector<VABufferID> slice_batch_data_buf_id_; // slice data buffers of the batches of the current picture
+    bool pic_in_progress_; // a picture submitted in slice batches has been started and not ended yet
 
     rocDecStatus InitVAAPI(std::string drm_node);
     rocDecStatus CreateDecoderConfig();
@@ -0,0 +1,179 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include "host_colorspace.h"
+#include "test_common.h"
+
+typedef void (*HostColorConvertFn)(const uint8_t *p_yuv, int yuv_pitch, uint8_t *p_rgb, int rgb_pitch, int width, int height, int v_pitch,
+                                   const ColorSpaceInfo &color_info, int num_threads);
+
+/*! \brief Host conversion of one source format and output format
+ */
+struct HostConversion {
+    const char *name;
+    HostColorConvertFn fn;
+    bool is_16bit;          // P016/YUV444P16 source
+    bool is_444;            // YUV444 source
+    int rgb_pixel_size;     // bytes per output pixel
+};
+
+static const HostConversion host_conversions[] = {
+    {"Nv12ToBgr24", HostNv12ToColor24<BGR24>, false, false, 3},
+    {"Nv12ToRgb24", HostNv12ToColor24<RGB24>, false, false, 3},
+    {"Nv12ToBgra32", HostNv12ToColor32<BGRA32>, false, false, 4},
+    {"Nv12ToRgba32", HostNv12ToColor32<RGBA32>, false, false, 4},
+    {"Nv12ToBgr48", HostNv12ToColor48<BGR48>, false, false, 6},
+    {"Nv12ToRgb48", HostNv12ToColor48<RGB48>, false, false, 6},
+    {"Nv12ToBgra64", HostNv12ToColor64<BGRA64>, false, false, 8},
+    {"Nv12ToRgba64", HostNv12ToColor64<RGBA64>, false, false, 8},
+    {"P016ToBgr24", HostP016ToColor24<BGR24>, true, false, 3},
+    {"P016ToRgb24", HostP016ToColor24<RGB24>, true, false, 3},
+    {"P016ToBgra32", HostP016ToColor32<BGRA32>, true, false, 4},
+    {"P016ToRgba32", HostP016ToColor32<RGBA32>, true, false, 4},
+    {"P016ToBgr48", HostP016ToColor48<BGR48>, true, false, 6},
+    {"P016ToRgb48", HostP016ToColor48<RGB48>, true, false, 6},
+    {"P016ToBgra64", HostP016ToColor64<BGRA64>, true, false, 8},
+    {"P016ToRgba64", HostP016ToColor64<RGBA64>, true, false, 8},
+    {"YUV444ToBgr24", HostYUV444ToColor24<BGR24>, false, true, 3},
+    {"YUV444ToRgb24", HostYUV444ToColor24<RGB24>, false, true, 3},
+    {"YUV444ToBgra32", HostYUV444ToColor32<BGRA32>, false, true, 4},
+    {"YUV444ToRgba32", HostYUV444ToColor32<RGBA32>, false, true, 4},
+    {"YUV444P16ToBgr24", HostYUV444P16ToColor24<BGR24>, true, true, 3},
+    {"YUV444P16ToRgb24", HostYUV444P16ToColor24<RGB24>, true, true, 3},
+    {"YUV444P16ToBgr48", HostYUV444P16ToColor48<BGR48>, true, true, 6},
+    {"YUV444P16ToRgb48", HostYUV444P16ToColor48<RGB48>, true, true, 6},
+    {"YUV444P16ToBgra64", HostYUV444P16ToColor64<BGRA64>, true, true, 8},
+    {"YUV444P16ToRgba64", HostYUV444P16ToColor64<RGBA64>, true, true, 8},
+};
+
+/*! \brief Source surface in the layout of the decoder output: padded rows and a luma plane taller than the picture (v_pitch > height)
+ */
+struct HostSurface {
+    std::vector<uint8_t> data;
+    int pitch;
+    int v_pitch;
+};
+
+static HostSurface RandomSurface(int width, int height, bool is_16bit, bool is_444, uint32_t seed) {
+    HostSurface surface;
+    surface.pitch = width * (is_16bit ? 2 : 1) + 32;
+    surface.v_pitch = (height + 15) & ~15;
+    int num_rows = is_444 ? 3 * surface.v_pitch : surface.v_pitch + (height + 1) / 2;
+    surface.data.resize(static_cast<size_t>(num_rows) * surface.pitch);
+    for (uint8_t &byte : surface.data) {
+        seed = seed * 1664525u + 1013904223u;
+        byte = static_cast<uint8_t>(seed >> 24);
+    }
+    return surface;
+}
+
+/*! \brief Converts the surface into an output buffer with padded rows prefilled with a guard value, so writes past the width show up
+ */
+static std::vector<uint8_t> Convert(const HostConversion &conversion, const HostSurface &surface, int width, int height,
+                                    const ColorSpaceInfo &color_info, int num_threads) {
+    int rgb_pitch = width * conversion.rgb_pixel_size + 24;
+    std::vector<uint8_t> rgb(static_cast<size_t>(rgb_pitch) * height, 0xcd);
+    conversion.fn(surface.data.data(), surface.pitch, rgb.data(), rgb_pitch, width, height, surface.v_pitch, color_info, num_threads);
+    return rgb;
+}
+
+/*! \brief The AVX2 rows (4:2:0 to 8-bit RGB) and the worker threads must give the same bytes as the per pixel code on one thread, for every
+ *         source and output format, sizes that are not a multiple of the 8 pixels of the AVX2 loop and the color descriptions of the streams
+ */
+static void TestAvx2MatchesScalar() {
+    const int sizes[][2] = {{64, 32}, {37, 18}, {130, 67}, {8, 2}, {7, 2}};
+    const ColorSpaceInfo color_infos[] = {
+        ColorSpaceInfo(ColorSpaceStandard_BT709),
+        ColorSpaceInfo(ColorSpaceStandard_BT601, true),
+        ColorSpaceInfo(ColorSpaceStandard_BT2020),
+        ColorSpaceInfo(ColorSpaceStandard_YCgCo, true),
+        ColorSpaceInfo(ColorSpaceStandard_BT2020, false, ColorTransfer_SMPTE2084, ColorPrimaries_BT2020, true),
+    };
+    if (!HostColorConvertUsesAvx2()) {
+        std::cout << "The CPU doesn't support AVX2: only the threaded per pixel conversions are compared" << std::endl;
+    }
+    uint32_t seed = 1;
+    for (const HostConversion &conversion : host_conversions) {
+        for (const auto &size : sizes) {
+            int width = size[0], height = size[1];
+            HostSurface surface = RandomSurface(width, height, conversion.is_16bit, conversion.is_444, seed++);
+            for (const ColorSpaceInfo &color_info : color_infos) {
+                std::string test_name = std::string(conversion.name) + " " + std::to_string(width) + "x" + std::to_string(height) +
+                                        " color standard " + std::to_string(color_info.col_standard) +
+                                        (color_info.full_range ? " full range" : "") + (color_info.hdr_to_sdr ? " tone mapped" : "");
+                SetHostColorConvertAvx2(false);
+                std::vector<uint8_t> scalar = Convert(conversion, surface, width, height, color_info, 1);
+                SetHostColorConvertAvx2(true);
+                Check(Convert(conversion, surface, width, height, color_info, 1) == scalar, test_name, "AVX2 differs from the per pixel code");
+                Check(Convert(conversion, surface, width, height, color_info, 3) == scalar, test_name, "3 threads differ from one thread");
+                Check(Convert(conversion, surface, width, height, color_info, 0) == scalar, test_name,
+                      "the hardware threads differ from one thread");
+            }
+        }
+    }
+}
+
+/*! \brief Known values of full range BT.601: Y 100, U 128, V 178 gives R 170.1, G 64.29 and B 100 (truncated like the kernels), on a row
+ *         long enough for the AVX2 loop and its tail
+ */
+static void TestKnownValues() {
+    const int width = 20, height = 2, v_pitch = 2;
+    const ColorSpaceInfo color_info(ColorSpaceStandard_BT601, true);
+    std::vector<uint8_t> nv12(width * (v_pitch + 1));
+    std::vector<uint16_t> p016(width * (v_pitch + 1));
+    for (int x = 0; x < width; x++) {
+        nv12[x] = nv12[width + x] = 100;
+        nv12[2 * width + x] = x & 1 ? 178 : 128;
+        p016[x] = p016[width + x] = 100 << 8;
+        p016[2 * width + x] = x & 1 ? 178 << 8 : 128 << 8;
+    }
+    for (bool avx2 : {false, true}) {
+        SetHostColorConvertAvx2(avx2);
+        std::string suffix = avx2 ? " (AVX2)" : "";
+        std::vector<uint8_t> bgr(width * 3 * height), rgba(width * 4 * height);
+        HostNv12ToColor24<BGR24>(nv12.data(), width, bgr.data(), width * 3, width, height, v_pitch, color_info);
+        HostNv12ToColor32<RGBA32>(nv12.data(), width, rgba.data(), width * 4, width, height, v_pitch, color_info);
+        std::vector<uint16_t> rgb48(width * 3 * height);
+        HostP016ToColor48<RGB48>(reinterpret_cast<const uint8_t *>(p016.data()), width * 2, reinterpret_cast<uint8_t *>(rgb48.data()), width * 6,
+                                 width, height, v_pitch, color_info);
+        bool bgr_ok = true, rgba_ok = true, rgb48_ok = true;
+        for (int i = 0; i < width * height; i++) {
+            bgr_ok = bgr_ok && bgr[3 * i] == 100 && bgr[3 * i + 1] == 64 && bgr[3 * i + 2] == 170;
+            rgba_ok = rgba_ok && rgba[4 * i] == 170 && rgba[4 * i + 1] == 64 && rgba[4 * i + 2] == 100 && rgba[4 * i + 3] == 0;
+            rgb48_ok = rgb48_ok && rgb48[3 * i] == 43545 && rgb48[3 * i + 1] == 16459 && rgb48[3 * i + 2] == 25600;
+        }
+        Check(bgr_ok, "known values" + suffix, "NV12 to BGR24 isn't 100, 64, 170");
+        Check(rgba_ok, "known values" + suffix, "NV12 to RGBA32 isn't 170, 64, 100, 0");
+        Check(rgb48_ok, "known values" + suffix, "P016 to RGB48 isn't 43545, 16459, 25600");
+    }
+}
+
+int main() {
+    TestKnownValues();
+    TestAvx2MatchesScalar();
+    return ReportTestResults("host color space");
+}
@@ -0,0 +1,979 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <iostream>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <string>
+#include <cstring>
+#include <cstdint>
+#include "rocparser.h"
+#include "test_common.h"
+
+/*! \brief Bit writer for the synthetic bitstreams of the tests
+ */
+class BitWriter {
+public:
+    void PutBits(uint64_t value, int num_bits) {
+        for (int i = num_bits - 1; i >= 0; i--) {
+            if ((num_bits_ & 7) == 0) {
+                data_.push_back(0);
+            }
+            if ((value >> i) & 1) {
+                data_.back() |= 0x80 >> (num_bits_ & 7);
+            }
+            num_bits_++;
+        }
+    }
+    void PutUe(uint32_t value) {
+        int len = 0;
+        while (((value + 1ULL) >> (len + 1)) != 0) {
+            len++;
+        }
+        PutBits(0, len);
+        PutBits(value + 1ULL, len + 1);
+    }
+    void PutSe(int32_t value) { PutUe(value > 0 ? 2 * value - 1 : -2 * value); }
+    void ByteAlign() { PutBits(0, (8 - (num_bits_ & 7)) & 7); }
+    void PutTrailingBits() { PutBits(1, 1); ByteAlign(); }
+    void PutBytes(const std::vector<uint8_t> &bytes) { ByteAlign(); data_.insert(data_.end(), bytes.begin(), bytes.end()); num_bits_ += bytes.size() * 8; }
+    const std::vector<uint8_t> &Data() const { return data_; }
+
+private:
+    std::vector<uint8_t> data_;
+    size_t num_bits_ = 0;
+};
+
+/*! \brief Parser instance recording what is passed to the callbacks
+ */
+class ParserTest {
+public:
+    ParserTest(rocDecVideoCodec codec, bool annex_b = false, bool byte_stream = false) : codec_(codec) {
+        RocdecParserParams params = {};
+        params.codec_type = codec;
+        params.max_num_decode_surfaces = 8;
+        params.annex_b = annex_b;
+        params.byte_stream = byte_stream;
+        params.user_data = this;
+        params.pfn_sequence_callback = HandleVideoSequence;
+        params.pfn_decode_picture = HandlePictureDecode;
+        params.pfn_display_picture = HandlePictureDisplay;
+        if (rocDecCreateVideoParser(&parser_, &params) != ROCDEC_SUCCESS) {
+            parser_ = nullptr;
+        }
+    }
+    ~ParserTest() {
+        if (parser_) {
+            rocDecDestroyVideoParser(parser_);
+        }
+    }
+
+    /*! \brief Parses a packet, or the packet in chunks of chunk_size bytes. The last packet or chunk carries flags.
+     */
+    rocDecStatus Parse(const std::vector<uint8_t> &data, uint32_t flags = 0, size_t chunk_size = 0) {
+        if (!parser_) {
+            return ROCDEC_NOT_INITIALIZED;
+        }
+        size_t step = chunk_size ? chunk_size : data.size();
+        size_t offset = 0;
+        do {
+            size_t size = std::min(step, data.size() - offset);
+            RocdecSourceDataPacket packet = {};
+            packet.payload = size ? data.data() + offset : nullptr;
+            packet.payload_size = size;
+            offset += size;
+            packet.flags = offset == data.size() ? flags : 0;
+            rocDecStatus status = rocDecParseVideoData(parser_, &packet);
+            if (status != ROCDEC_SUCCESS) {
+                return status;
+            }
+        } while (offset < data.size());
+        return ROCDEC_SUCCESS;
+    }
+
+    int num_sequences_ = 0;
+    int num_decoded_ = 0;
+    int num_displayed_ = 0;
+    int coded_width_ = 0;
+    int coded_height_ = 0;
+    std::vector<std::string> tiles_;  // AV1: "row,column: size" of every decoded tile
+    bool tile_data_ok_ = true;  // AV1: the data of every tile i is filled with 0x40 + i at its offset
+    std::vector<std::string> ref_lists_;  // H.264/HEVC: "POC: L0 ... | L1 ..." of every decoded slice, long-term references marked with L
+    std::vector<int> display_pocs_;  // H.264/HEVC: POC of the displayed pictures
+
+private:
+    static std::string RefPicName(int poc, bool long_term) { return " " + std::to_string(poc) + (long_term ? "L" : ""); }
+    static std::string AvcRefPicName(const RocdecAvcPicture &ref_pic) {
+        if (ref_pic.flags & RocdecAvcPicture_FLAGS_INVALID) {
+            return " -";
+        }
+        return RefPicName(ref_pic.top_field_order_cnt, ref_pic.flags & RocdecAvcPicture_FLAGS_LONG_TERM_REFERENCE);
+    }
+
+    void AddAvcRefLists(const RocdecPicParams *p_pic_params) {
+        const RocdecAvcPicParams &avc = p_pic_params->pic_params.avc;
+        int curr_poc = std::min(avc.curr_pic.top_field_order_cnt, avc.curr_pic.bottom_field_order_cnt);
+        pocs_[p_pic_params->curr_pic_idx] = curr_poc;
+        for (uint32_t i = 0; i < p_pic_params->num_slices; i++) {
+            const RocdecAvcSliceParams &slice = p_pic_params->slice_params.avc[i];
+            std::string lists = std::to_string(curr_poc) + ":";
+            if (slice.slice_type % 5 == 0 || slice.slice_type % 5 == 1) {
+                lists += " L0";
+                for (int j = 0; j <= slice.num_ref_idx_l0_active_minus1; j++) {
+                    lists += AvcRefPicName(slice.ref_pic_list_0[j]);
+                }
+            }
+            if (slice.slice_type % 5 == 1) {
+                lists += " | L1";
+                for (int j = 0; j <= slice.num_ref_idx_l1_active_minus1; j++) {
+                    lists += AvcRefPicName(slice.ref_pic_list_1[j]);
+                }
+            }
+            ref_lists_.push_back(lists);
+        }
+    }
+
+    void AddHevcRefLists(const RocdecPicParams *p_pic_params) {
+        const RocdecHevcPicParams &hevc = p_pic_params->pic_params.hevc;
+        pocs_[p_pic_params->curr_pic_idx] = hevc.curr_pic.poc;
+        for (uint32_t i = 0; i < p_pic_params->num_slices; i++) {
+            const RocdecHevcSliceParams &slice = p_pic_params->slice_params.hevc[i];
+            int slice_type = slice.long_slice_flags.fields.slice_type;
+            int num_lists = slice_type == 0 ? 2 : (slice_type == 1 ? 1 : 0);  // B, P, I
+            std::string lists = std::to_string(hevc.curr_pic.poc) + ":";
+            for (int list = 0; list < num_lists; list++) {
+                lists += list ? " | L1" : " L0";
+                for (int j = 0; j <= (list ? slice.num_ref_idx_l1_active_minus1 : slice.num_ref_idx_l0_active_minus1); j++) {
+                    const RocdecHevcPicture &ref_pic = hevc.ref_frames[slice.ref_pic_list[list][j] % 15];
+                    lists += RefPicName(ref_pic.poc, ref_pic.flags & RocdecHevcPicture_LONG_TERM_REFERENCE);
+                }
+            }
+            ref_lists_.push_back(lists);
+        }
+    }
+
+    static int ROCDECAPI HandleVideoSequence(void *p_user_data, RocdecVideoFormat *p_video_format) {
+        ParserTest *p_test = static_cast<ParserTest *>(p_user_data);
+        p_test->num_sequences_++;
+        p_test->coded_width_ = p_video_format->coded_width;
+        p_test->coded_height_ = p_video_format->coded_height;
+        return 1;
+    }
+    static int ROCDECAPI HandlePictureDecode(void *p_user_data, RocdecPicParams *p_pic_params) {
+        ParserTest *p_test = static_cast<ParserTest *>(p_user_data);
+        p_test->num_decoded_++;
+        if (p_test->codec_ == rocDecVideoCodec_AVC) {
+            p_test->AddAvcRefLists(p_pic_params);
+        } else if (p_test->codec_ == rocDecVideoCodec_HEVC) {
+            p_test->AddHevcRefLists(p_pic_params);
+        }
+        for (uint32_t i = 0; i < p_pic_params->num_slices && p_test->codec_ == rocDecVideoCodec_AV1; i++) {
+            const RocdecAv1SliceParams &tile = p_pic_params->slice_params.av1[i];
+            p_test->tiles_.push_back(std::to_string(tile.tile_row) + "," + std::to_string(tile.tile_column) + ": " + std::to_string(tile.slice_data_size));
+            if (tile.slice_data_offset + tile.slice_data_size > p_pic_params->bitstream_data_len) {
+                p_test->tile_data_ok_ = false;
+                continue;
+            }
+            for (uint32_t j = 0; j < tile.slice_data_size; j++) {
+                p_test->tile_data_ok_ &= p_pic_params->bitstream_data[tile.slice_data_offset + j] == 0x40 + i;
+            }
+        }
+        return 1;
+    }
+    static int ROCDECAPI HandlePictureDisplay(void *p_user_data, RocdecParserDispInfo *p_disp_info) {
+        ParserTest *p_test = static_cast<ParserTest *>(p_user_data);
+        p_test->num_displayed_++;
+        if (p_test->codec_ != rocDecVideoCodec_AV1) {
+            p_test->display_pocs_.push_back(p_test->pocs_[p_disp_info->picture_index]);
+        }
+        return 1;
+    }
+
+    RocdecVideoParser parser_ = nullptr;
+    rocDecVideoCodec codec_;
+    std::map<int, int> pocs_;  // POC of the picture decoded last to each picture index
+};
+
+/*! \brief NAL unit of the H.264/HEVC byte stream format: start code, NAL unit header and the RBSP with emulation prevention bytes
+ */
+static std::vector<uint8_t> NalUnit(const std::vector<uint8_t> &header, const std::vector<uint8_t> &rbsp) {
+    std::vector<uint8_t> nal = {0, 0, 0, 1};
+    nal.insert(nal.end(), header.begin(), header.end());
+    int num_zeros = 0;
+    for (uint8_t byte : rbsp) {
+        if (num_zeros == 2 && byte <= 3) {
+            nal.push_back(3);
+            num_zeros = 0;
+        }
+        nal.push_back(byte);
+        num_zeros = byte ? 0 : num_zeros + 1;
+    }
+    return nal;
+}
+
+static void Append(std::vector<uint8_t> &data, const std::vector<uint8_t> &bytes) { data.insert(data.end(), bytes.begin(), bytes.end()); }
+
+static void CheckLists(const std::vector<std::string> &lists, const std::vector<std::string> &expected, const std::string &test_name, const std::string &what) {
+    Check(lists == expected, test_name, what);
+    if (lists != expected) {
+        for (size_t i = 0; i < std::max(lists.size(), expected.size()); i++) {
+            std::cerr << "  " << (i < lists.size() ? lists[i] : "(none)") << (i < expected.size() && i < lists.size() && lists[i] == expected[i] ? "" : "  expected: " + (i < expected.size() ? expected[i] : "(none)")) << std::endl;
+        }
+    }
+}
+
+static std::vector<std::string> PocList(const std::vector<int> &pocs) {
+    std::vector<std::string> list;
+    for (int poc : pocs) {
+        list.push_back(std::to_string(poc));
+    }
+    return list;
+}
+
+/*! \brief HEVC bitstream pieces: Main profile 4:2:0 8-bit, 64x64 CTBs, no tools that add slice header syntax besides the explicit RPS,
+ *         the long-term pictures of the slice header and the reference list modification. The POC LSB is 8 bits.
+ */
+enum { kHevcTrailN = 0, kHevcTrailR = 1, kHevcIdrWRadl = 19, kHevcVps = 32, kHevcSps = 33, kHevcPps = 34 };
+enum { kHevcSliceB = 0, kHevcSliceP = 1, kHevcSliceI = 2 };
+
+static std::vector<uint8_t> HevcNalHeader(int nal_unit_type) { return {static_cast<uint8_t>(nal_unit_type << 1), 1}; }
+
+static void PutHevcProfileTierLevel(BitWriter &bw) {
+    bw.PutBits(0, 2);           // general_profile_space
+    bw.PutBits(0, 1);           // general_tier_flag
+    bw.PutBits(1, 5);           // general_profile_idc: Main
+    bw.PutBits(0x60000000, 32); // general_profile_compatibility_flag[1..2]
+    bw.PutBits(1, 1);           // general_progressive_source_flag
+    bw.PutBits(0, 1);           // general_interlaced_source_flag
+    bw.PutBits(0, 1);           // general_non_packed_constraint_flag
+    bw.PutBits(1, 1);           // general_frame_only_constraint_flag
+    bw.PutBits(0, 32);          // general_reserved_zero_43bits, general_inbld_flag
+    bw.PutBits(0, 12);
+    bw.PutBits(60, 8);          // general_level_idc: 2
+}
+
+static std::vector<uint8_t> HevcParameterSets(int width, int height) {
+    std::vector<uint8_t> data;
+    BitWriter vps;
+    vps.PutBits(0, 4);          // vps_video_parameter_set_id
+    vps.PutBits(3, 2);          // vps_base_layer_internal_flag, vps_base_layer_available_flag
+    vps.PutBits(0, 6);          // vps_max_layers_minus1
+    vps.PutBits(0, 3);          // vps_max_sub_layers_minus1
+    vps.PutBits(1, 1);          // vps_temporal_id_nesting_flag
+    vps.PutBits(0xFFFF, 16);    // vps_reserved_0xffff_16bits
+    PutHevcProfileTierLevel(vps);
+    vps.PutBits(1, 1);          // vps_sub_layer_ordering_info_present_flag
+    vps.PutUe(4);               // vps_max_dec_pic_buffering_minus1
+    vps.PutUe(2);               // vps_max_num_reorder_pics
+    vps.PutUe(0);               // vps_max_latency_increase_plus1
+    vps.PutBits(0, 6);          // vps_max_layer_id
+    vps.PutUe(0);               // vps_num_layer_sets_minus1
+    vps.PutBits(0, 1);          // vps_timing_info_present_flag
+    vps.PutBits(0, 1);          // vps_extension_flag
+    vps.PutTrailingBits();
+    Append(data, NalUnit(HevcNalHeader(kHevcVps), vps.Data()));
+
+    BitWriter sps;
+    sps.PutBits(0, 4);          // sps_video_parameter_set_id
+    sps.PutBits(0, 3);          // sps_max_sub_layers_minus1
+    sps.PutBits(1, 1);          // sps_temporal_id_nesting_flag
+    PutHevcProfileTierLevel(sps);
+    sps.PutUe(0);               // sps_seq_parameter_set_id
+    sps.PutUe(1);               // chroma_format_idc
+    sps.PutUe(width);           // pic_width_in_luma_samples
+    sps.PutUe(height);          // pic_height_in_luma_samples
+    sps.PutBits(0, 1);          // conformance_window_flag
+    sps.PutUe(0);               // bit_depth_luma_minus8
+    sps.PutUe(0);               // bit_depth_chroma_minus8
+    sps.PutUe(4);               // log2_max_pic_order_cnt_lsb_minus4
+    sps.PutBits(1, 1);          // sps_sub_layer_ordering_info_present_flag
+    sps.PutUe(4);               // sps_max_dec_pic_buffering_minus1
+    sps.PutUe(2);               // sps_max_num_reorder_pics
+    sps.PutUe(0);               // sps_max_latency_increase_plus1
+    sps.PutUe(0);               // log2_min_luma_coding_block_size_minus3
+    sps.PutUe(3);               // log2_diff_max_min_luma_coding_block_size
+    sps.PutUe(0);               // log2_min_luma_transform_block_size_minus2
+    sps.PutUe(3);               // log2_diff_max_min_luma_transform_block_size
+    sps.PutUe(0);               // max_transform_hierarchy_depth_inter
+    sps.PutUe(0);               // max_transform_hierarchy_depth_intra
+    sps.PutBits(0, 1);          // scaling_list_enabled_flag
+    sps.PutBits(0, 1);          // amp_enabled_flag
+    sps.PutBits(0, 1);          // sample_adaptive_offset_enabled_flag
+    sps.PutBits(0, 1);          // pcm_enabled_flag
+    sps.PutUe(0);               // num_short_term_ref_pic_sets
+    sps.PutBits(1, 1);          // long_term_ref_pics_present_flag
+    sps.PutUe(0);               // num_long_term_ref_pics_sps
+    sps.PutBits(0, 1);          // sps_temporal_mvp_enabled_flag
+    sps.PutBits(0, 1);          // strong_intra_smoothing_enabled_flag
+    sps.PutBits(0, 1);          // vui_parameters_present_flag
+    sps.PutBits(0, 1);          // sps_extension_present_flag
+    sps.PutTrailingBits();
+    Append(data, NalUnit(HevcNalHeader(kHevcSps), sps.Data()));
+
+    BitWriter pps;
+    pps.PutUe(0);               // pps_pic_parameter_set_id
+    pps.PutUe(0);               // pps_seq_parameter_set_id
+    pps.PutBits(0, 1);          // dependent_slice_segments_enabled_flag
+    pps.PutBits(0, 1);          // output_flag_present_flag
+    pps.PutBits(0, 3);          // num_extra_slice_header_bits
+    pps.PutBits(0, 1);          // sign_data_hiding_enabled_flag
+    pps.PutBits(0, 1);          // cabac_init_present_flag
+    pps.PutUe(0);               // num_ref_idx_l0_default_active_minus1
+    pps.PutUe(0);               // num_ref_idx_l1_default_active_minus1
+    pps.PutSe(0);               // init_qp_minus26
+    pps.PutBits(0, 1);          // constrained_intra_pred_flag
+    pps.PutBits(0, 1);          // transform_skip_enabled_flag
+    pps.PutBits(0, 1);          // cu_qp_delta_enabled_flag
+    pps.PutSe(0);               // pps_cb_qp_offset
+    pps.PutSe(0);               // pps_cr_qp_offset
+    pps.PutBits(0, 1);          // pps_slice_chroma_qp_offsets_present_flag
+    pps.PutBits(0, 1);          // weighted_pred_flag
+    pps.PutBits(0, 1);          // weighted_bipred_flag
+    pps.PutBits(0, 1);          // transquant_bypass_enabled_flag
+    pps.PutBits(0, 1);          // tiles_enabled_flag
+    pps.PutBits(0, 1);          // entropy_coding_sync_enabled_flag
+    pps.PutBits(0, 1);          // pps_loop_filter_across_slices_enabled_flag
+    pps.PutBits(0, 1);          // deblocking_filter_control_present_flag
+    pps.PutBits(0, 1);          // pps_scaling_list_data_present_flag
+    pps.PutBits(1, 1);          // lists_modification_present_flag
+    pps.PutUe(0);               // log2_parallel_merge_level_minus2
+    pps.PutBits(0, 1);          // slice_segment_header_extension_present_flag
+    pps.PutBits(0, 1);          // pps_extension_present_flag
+    pps.PutTrailingBits();
+    Append(data, NalUnit(HevcNalHeader(kHevcPps), pps.Data()));
+    return data;
+}
+
+/*! \brief HEVC slice segment. The short-term RPS is coded in the slice header as (delta POC, used by the current picture) pairs,
+ *         the long-term pictures by their POC LSB. An empty list_entry_lX leaves RefPicListX unmodified.
+ */
+struct HevcSlice {
+    int nal_unit_type;
+    int slice_type;
+    int poc;
+    std::vector<std::pair<int, bool>> st_rps;
+    std::vector<std::pair<int, bool>> lt_pocs;
+    int num_ref_idx_l0_active = 0;
+    int num_ref_idx_l1_active = 0;
+    std::vector<int> list_entry_l0 = {};
+    std::vector<int> list_entry_l1 = {};
+    int slice_segment_address = 0;
+    int slice_segment_address_bits = 0;
+};
+
+static std::vector<uint8_t> HevcSliceNal(const HevcSlice &slice) {
+    BitWriter bw;
+    bool idr = slice.nal_unit_type == kHevcIdrWRadl;
+    bw.PutBits(slice.slice_segment_address == 0, 1);  // first_slice_segment_in_pic_flag
+    if (slice.nal_unit_type >= 16 && slice.nal_unit_type <= 23) {
+        bw.PutBits(0, 1);                               // no_output_of_prior_pics_flag
+    }
+    bw.PutUe(0);                                        // slice_pic_parameter_set_id
+    if (slice.slice_segment_address) {
+        bw.PutBits(slice.slice_segment_address, slice.slice_segment_address_bits);
+    }
+    bw.PutUe(slice.slice_type);
+    int num_pic_total_curr = 0;
+    if (!idr) {
+        bw.PutBits(slice.poc & 0xFF, 8);                // slice_pic_order_cnt_lsb
+        bw.PutBits(0, 1);                               // short_term_ref_pic_set_sps_flag
+        std::vector<std::pair<int, bool>> negative_pics, positive_pics;
+        for (auto &pic : slice.st_rps) {
+            (pic.first < 0 ? negative_pics : positive_pics).push_back(pic);
+            num_pic_total_curr += pic.second;
+        }
+        std::sort(negative_pics.begin(), negative_pics.end(), [](auto &a, auto &b) { return a.first > b.first; });
+        std::sort(positive_pics.begin(), positive_pics.end());
+        bw.PutUe(negative_pics.size());                 // num_negative_pics
+        bw.PutUe(positive_pics.size());                 // num_positive_pics
+        int prev_delta_poc = 0;
+        for (auto &pic : negative_pics) {
+            bw.PutUe(prev_delta_poc - pic.first - 1);   // delta_poc_s0_minus1
+            bw.PutBits(pic.second, 1);                  // used_by_curr_pic_s0_flag
+            prev_delta_poc = pic.first;
+        }
+        prev_delta_poc = 0;
+        for (auto &pic : positive_pics) {
+            bw.PutUe(pic.first - prev_delta_poc - 1);   // delta_poc_s1_minus1
+            bw.PutBits(pic.second, 1);                  // used_by_curr_pic_s1_flag
+            prev_delta_poc = pic.first;
+        }
+        bw.PutUe(slice.lt_pocs.size());                 // num_long_term_pics
+        for (auto &pic : slice.lt_pocs) {
+            bw.PutBits(pic.first & 0xFF, 8);            // poc_lsb_lt
+            bw.PutBits(pic.second, 1);                  // used_by_curr_pic_lt_flag
+            bw.PutBits(0, 1);                           // delta_poc_msb_present_flag
+            num_pic_total_curr += pic.second;
+        }
+    }
+    if (slice.slice_type != kHevcSliceI) {
+        bw.PutBits(1, 1);                               // num_ref_idx_active_override_flag
+        bw.PutUe(slice.num_ref_idx_l0_active - 1);
+        if (slice.slice_type == kHevcSliceB) {
+            bw.PutUe(slice.num_ref_idx_l1_active - 1);
+        }
+        if (num_pic_total_curr > 1) {                   // ref_pic_lists_modification()
+            int list_entry_bits = 0;
+            while ((1 << list_entry_bits) < num_pic_total_curr) {
+                list_entry_bits++;
+            }
+            for (int list = 0; list < (slice.slice_type == kHevcSliceB ? 2 : 1); list++) {
+                const std::vector<int> &list_entry = list ? slice.list_entry_l1 : slice.list_entry_l0;
+                bw.PutBits(!list_entry.empty(), 1);     // ref_pic_list_modification_flag_lX
+                for (int entry : list_entry) {
+                    bw.PutBits(entry, list_entry_bits);
+                }
+            }
+        }
+        if (slice.slice_type == kHevcSliceB) {
+            bw.PutBits(0, 1);                           // mvd_l1_zero_flag
+        }
+        bw.PutUe(0);                                    // five_minus_max_num_merge_cand
+    }
+    bw.PutSe(0);                                        // slice_qp_delta
+    bw.PutTrailingBits();                               // byte_alignment()
+    bw.PutBytes({0xA5, 0x5A, 0xA5, 0x5A});              // slice data, not parsed
+    return NalUnit(HevcNalHeader(slice.nal_unit_type), bw.Data());
+}
+
+/*! \brief H.264 bitstream pieces: Main profile, 64x64 frames, CAVLC, pic_order_cnt_type 0 with a 6-bit POC LSB, 4-bit frame_num,
+ *         four reference frames.
+ */
+enum { kAvcSliceNonIdr = 1, kAvcSliceIdr = 5, kAvcSps = 7, kAvcPps = 8 };
+enum { kAvcSliceP = 0, kAvcSliceB = 1, kAvcSliceI = 2 };
+
+static std::vector<uint8_t> AvcNalHeader(int nal_ref_idc, int nal_unit_type) { return {static_cast<uint8_t>((nal_ref_idc << 5) | nal_unit_type)}; }
+
+static std::vector<uint8_t> AvcParameterSets() {
+    std::vector<uint8_t> data;
+    BitWriter sps;
+    sps.PutBits(77, 8);         // profile_idc: Main
+    sps.PutBits(0, 8);          // constraint_set0..5_flag, reserved_zero_2bits
+    sps.PutBits(30, 8);         // level_idc
+    sps.PutUe(0);               // seq_parameter_set_id
+    sps.PutUe(0);               // log2_max_frame_num_minus4
+    sps.PutUe(0);               // pic_order_cnt_type
+    sps.PutUe(2);               // log2_max_pic_order_cnt_lsb_minus4
+    sps.PutUe(4);               // max_num_ref_frames
+    sps.PutBits(0, 1);          // gaps_in_frame_num_value_allowed_flag
+    sps.PutUe(3);               // pic_width_in_mbs_minus1
+    sps.PutUe(3);               // pic_height_in_map_units_minus1
+    sps.PutBits(1, 1);          // frame_mbs_only_flag
+    sps.PutBits(1, 1);          // direct_8x8_inference_flag
+    sps.PutBits(0, 1);          // frame_cropping_flag
+    sps.PutBits(0, 1);          // vui_parameters_present_flag
+    sps.PutTrailingBits();
+    Append(data, NalUnit(AvcNalHeader(3, kAvcSps), sps.Data()));
+
+    BitWriter pps;
+    pps.PutUe(0);               // pic_parameter_set_id
+    pps.PutUe(0);               // seq_parameter_set_id
+    pps.PutBits(0, 1);          // entropy_coding_mode_flag
+    pps.PutBits(0, 1);          // bottom_field_pic_order_in_frame_present_flag
+    pps.PutUe(0);               // num_slice_groups_minus1
+    pps.PutUe(0);               // num_ref_idx_l0_default_active_minus1
+    pps.PutUe(0);               // num_ref_idx_l1_default_active_minus1
+    pps.PutBits(0, 1);          // weighted_pred_flag
+    pps.PutBits(0, 2);          // weighted_bipred_idc
+    pps.PutSe(0);               // pic_init_qp_minus26
+    pps.PutSe(0);               // pic_init_qs_minus26
+    pps.PutSe(0);               // chroma_qp_index_offset
+    pps.PutBits(0, 1);          // deblocking_filter_control_present_flag
+    pps.PutBits(0, 1);          // constrained_intra_pred_flag
+    pps.PutBits(0, 1);          // redundant_pic_cnt_present_flag
+    pps.PutTrailingBits();
+    Append(data, NalUnit(AvcNalHeader(3, kAvcPps), pps.Data()));
+    return data;
+}
+
+/*! \brief H.264 slice of a frame. The reference list modifications are (modification_of_pic_nums_idc, value) pairs, the memory
+ *         management control operations a memory_management_control_operation followed by its values, both without the
+ *         terminating operation.
+ */
+struct AvcSlice {
+    int nal_unit_type;
+    int nal_ref_idc;
+    int slice_type;
+    int frame_num;
+    int poc;
+    int num_ref_idx_l0_active = 0;
+    int num_ref_idx_l1_active = 0;
+    std::vector<std::pair<int, int>> modification_l0 = {};
+    std::vector<std::pair<int, int>> modification_l1 = {};
+    std::vector<std::vector<int>> mmco = {};
+    bool long_term_reference_flag = false;
+    int first_mb_in_slice = 0;
+};
+
+static std::vector<uint8_t> AvcSliceNal(const AvcSlice &slice) {
+    BitWriter bw;
+    bool idr = slice.nal_unit_type == kAvcSliceIdr;
+    bw.PutUe(slice.first_mb_in_slice);
+    bw.PutUe(slice.slice_type);
+    bw.PutUe(0);                                        // pic_parameter_set_id
+    bw.PutBits(slice.frame_num, 4);
+    if (idr) {
+        bw.PutUe(0);                                    // idr_pic_id
+    }
+    bw.PutBits(slice.poc & 0x3F, 6);                    // pic_order_cnt_lsb
+    if (slice.slice_type == kAvcSliceB) {
+        bw.PutBits(1, 1);                               // direct_spatial_mv_pred_flag
+    }
+    if (slice.slice_type != kAvcSliceI) {
+        bw.PutBits(1, 1);                               // num_ref_idx_active_override_flag
+        bw.PutUe(slice.num_ref_idx_l0_active - 1);
+        if (slice.slice_type == kAvcSliceB) {
+            bw.PutUe(slice.num_ref_idx_l1_active - 1);
+        }
+        for (int list = 0; list < (slice.slice_type == kAvcSliceB ? 2 : 1); list++) {
+            const std::vector<std::pair<int, int>> &modification = list ? slice.modification_l1 : slice.modification_l0;
+            bw.PutBits(!modification.empty(), 1);       // ref_pic_list_modification_flag_lX
+            if (!modification.empty()) {
+                for (auto &op : modification) {
+                    bw.PutUe(op.first);                 // modification_of_pic_nums_idc
+                    bw.PutUe(op.second);                // abs_diff_pic_num_minus1 or long_term_pic_num
+                }
+                bw.PutUe(3);
+            }
+        }
+    }
+    if (slice.nal_ref_idc) {                            // dec_ref_pic_marking()
+        if (idr) {
+            bw.PutBits(0, 1);                           // no_output_of_prior_pics_flag
+            bw.PutBits(slice.long_term_reference_flag, 1);
+        } else {
+            bw.PutBits(!slice.mmco.empty(), 1);         // adaptive_ref_pic_marking_mode_flag
+            if (!slice.mmco.empty()) {
+                for (auto &op : slice.mmco) {
+                    for (int value : op) {
+                        bw.PutUe(value);
+                    }
+                }
+                bw.PutUe(0);
+            }
+        }
+    }
+    bw.PutSe(0);                                        // slice_qp_delta
+    bw.PutBits(1, 1);                                   // slice data, not parsed
+    bw.ByteAlign();
+    bw.PutBytes({0xA5, 0x5A, 0xA5, 0x5A});
+    return NalUnit(AvcNalHeader(slice.nal_ref_idc, slice.nal_unit_type), bw.Data());
+}
+
+/*! \brief Parses one access unit per packet, the parameter sets in the first one, and returns the status of the first failing packet
+ */
+static rocDecStatus ParseAccessUnits(ParserTest &test, const std::vector<uint8_t> &parameter_sets, const std::vector<std::vector<uint8_t>> &access_units) {
+    for (size_t i = 0; i < access_units.size(); i++) {
+        std::vector<uint8_t> packet = i ? access_units[i] : parameter_sets;
+        if (i == 0) {
+            Append(packet, access_units[i]);
+        }
+        rocDecStatus status = test.Parse(packet, i == access_units.size() - 1 ? ROCDEC_PKT_ENDOFSTREAM : 0);
+        if (status != ROCDEC_SUCCESS) {
+            return status;
+        }
+    }
+    return ROCDEC_SUCCESS;
+}
+
+static void TestHevcDpb() {
+    const std::string name = "HEVC DPB";
+    // A hierarchical B group, then P pictures referencing POC 0 as a long-term picture, and a second IDR picture. POC 12 has
+    // more active references than pictures in the RPS, so its list repeats them.
+    std::vector<HevcSlice> slices = {
+        {kHevcIdrWRadl, kHevcSliceI, 0, {}, {}},
+        {kHevcTrailR, kHevcSliceP, 4, {{-4, true}}, {}, 1},
+        {kHevcTrailR, kHevcSliceB, 2, {{-2, true}, {2, true}}, {}, 2, 2},
+        {kHevcTrailN, kHevcSliceB, 1, {{-1, true}, {1, true}, {3, true}}, {}, 3, 3},
+        {kHevcTrailN, kHevcSliceB, 3, {{-1, true}, {-3, true}, {1, true}}, {}, 3, 3},
+        {kHevcTrailR, kHevcSliceP, 8, {{-4, true}}, {{0, true}}, 2},
+        {kHevcTrailR, kHevcSliceP, 12, {{-4, true}}, {{0, true}}, 3},
+        {kHevcIdrWRadl, kHevcSliceI, 0, {}, {}},
+        {kHevcTrailR, kHevcSliceP, 4, {{-4, true}}, {}, 1},
+    };
+    std::vector<std::vector<uint8_t>> access_units;
+    for (auto &slice : slices) {
+        access_units.push_back(HevcSliceNal(slice));
+    }
+    ParserTest test(rocDecVideoCodec_HEVC);
+    Check(ParseAccessUnits(test, HevcParameterSets(64, 64), access_units) == ROCDEC_SUCCESS, name, "stream not parsed");
+    Check(test.num_sequences_ == 1 && test.coded_width_ == 64 && test.coded_height_ == 64, name, "sequence");
+    CheckLists(test.ref_lists_, {"0:", "4: L0 0", "2: L0 0 4 | L1 4 0", "1: L0 0 2 4 | L1 2 4 0", "3: L0 2 0 4 | L1 4 2 0", "8: L0 4 0L",
+               "12: L0 8 0L 8", "0:", "4: L0 0"}, name, "reference lists");
+    CheckLists(PocList(test.display_pocs_), PocList({0, 1, 2, 3, 4, 8, 12, 0, 4}), name, "display order");
+
+    // POC 16 keeps five reference pictures with sps_max_dec_pic_buffering_minus1 = 4, all of them already output. The picture
+    // does not fit in the DPB and is rejected.
+    std::vector<HevcSlice> overflow_slices = {
+        {kHevcIdrWRadl, kHevcSliceI, 0, {}, {}},
+        {kHevcTrailR, kHevcSliceP, 4, {{-4, true}}, {}, 1},
+        {kHevcTrailR, kHevcSliceB, 2, {{-2, true}, {2, true}}, {}, 1, 1},
+        {kHevcTrailR, kHevcSliceP, 8, {{-4, true}, {-6, true}, {-8, true}}, {}, 1},
+        {kHevcTrailR, kHevcSliceP, 12, {{-4, true}, {-8, true}, {-10, true}, {-12, true}}, {}, 1},
+        {kHevcTrailR, kHevcSliceP, 16, {{-4, true}, {-8, true}, {-12, true}, {-14, true}, {-16, true}}, {}, 1},
+    };
+    access_units.clear();
+    for (auto &slice : overflow_slices) {
+        access_units.push_back(HevcSliceNal(slice));
+    }
+    ParserTest overflow_test(rocDecVideoCodec_HEVC);
+    Check(ParseAccessUnits(overflow_test, HevcParameterSets(64, 64), access_units) != ROCDEC_SUCCESS, name + " overflow", "DPB overflow accepted");
+    Check(overflow_test.num_decoded_ == 5, name + " overflow", "pictures before the overflow");
+}
+
+static void TestAvcDpb() {
+    const std::string name = "H.264 DPB";
+    // POC 6 marks POC 0 as long-term (MMCO 4, 3), POC 8 removes POC 2 (MMCO 1), the following pictures use the sliding window.
+    // POC 12 moves the long-term picture and POC 6 to the front of its list. The B pictures are not references.
+    std::vector<AvcSlice> slices = {
+        {kAvcSliceIdr, 3, kAvcSliceI, 0, 0},
+        {kAvcSliceNonIdr, 2, kAvcSliceP, 1, 2, 1},
+        {kAvcSliceNonIdr, 2, kAvcSliceP, 2, 4, 2},
+        {kAvcSliceNonIdr, 2, kAvcSliceP, 3, 6, 3, 0, {}, {}, {{4, 1}, {3, 2, 0}}},
+        {kAvcSliceNonIdr, 2, kAvcSliceP, 4, 8, 4, 0, {}, {}, {{1, 2}}},
+        {kAvcSliceNonIdr, 2, kAvcSliceP, 5, 10, 4},
+        {kAvcSliceNonIdr, 2, kAvcSliceP, 6, 12, 4, 0, {{2, 0}, {0, 2}}},
+        {kAvcSliceNonIdr, 2, kAvcSliceP, 7, 18, 1},
+        {kAvcSliceNonIdr, 0, kAvcSliceB, 8, 14, 2, 2},
+        {kAvcSliceNonIdr, 0, kAvcSliceB, 8, 16, 3, 3},
+    };
+    std::vector<std::vector<uint8_t>> access_units;
+    for (auto &slice : slices) {
+        access_units.push_back(AvcSliceNal(slice));
+    }
+    ParserTest test(rocDecVideoCodec_AVC);
+    Check(ParseAccessUnits(test, AvcParameterSets(), access_units) == ROCDEC_SUCCESS, name, "stream not parsed");
+    Check(test.num_sequences_ == 1 && test.coded_width_ == 64 && test.coded_height_ == 64, name, "sequence");
+    CheckLists(test.ref_lists_, {"0:", "2: L0 0", "4: L0 2 0", "6: L0 4 2 0", "8: L0 6 4 2 0L", "10: L0 8 6 4 0L", "12: L0 0L 6 10 8",
+               "18: L0 12", "14: L0 12 10 | L1 18 12", "16: L0 12 10 18 | L1 18 12 10"}, name, "reference lists");
+    CheckLists(PocList(test.display_pocs_), PocList({0, 2, 4, 6, 8, 10, 12, 14, 16, 18}), name, "display order");
+}
+
+static void TestHevcRefListModification() {
+    const std::string name = "HEVC reference list modification";
+    // 128x64 pictures of two CTBs. POC 2 has two slices with different list sizes and list_entry_lX, POC 5 has pictures in its
+    // RPS that are not used by the current picture, POC 7 only one current reference and no list modification syntax.
+    std::vector<std::vector<HevcSlice>> pictures = {
+        {{kHevcIdrWRadl, kHevcSliceI, 0, {}, {}}},
+        {{kHevcTrailR, kHevcSliceP, 8, {{-8, true}}, {}, 1}},
+        {{kHevcTrailR, kHevcSliceB, 4, {{-4, true}, {4, true}}, {}, 2, 2}},
+        {{kHevcTrailR, kHevcSliceB, 2, {{-2, true}, {2, true}, {6, true}}, {}, 3, 2, {2, 0, 1}, {}},
+         {kHevcTrailR, kHevcSliceB, 2, {{-2, true}, {2, true}, {6, true}}, {}, 1, 4, {}, {2, 2, 1, 0}, 1, 1}},
+        {{kHevcTrailR, kHevcSliceP, 6, {{-2, true}, {-4, true}, {-6, true}, {2, true}}, {}, 2, 0, {3, 1}}},
+        {{kHevcTrailN, kHevcSliceB, 5, {{-1, true}, {-3, false}, {1, true}, {3, true}}, {}, 2, 2, {}, {2, 1}}},
+        {{kHevcTrailN, kHevcSliceP, 7, {{-1, true}, {-3, false}, {-5, false}, {1, false}}, {}, 2}},
+    };
+    std::vector<std::vector<uint8_t>> access_units;
+    for (auto &picture : pictures) {
+        access_units.emplace_back();
+        for (auto &slice : picture) {
+            Append(access_units.back(), HevcSliceNal(slice));
+        }
+    }
+    ParserTest test(rocDecVideoCodec_HEVC);
+    Check(ParseAccessUnits(test, HevcParameterSets(128, 64), access_units) == ROCDEC_SUCCESS, name, "stream not parsed");
+    CheckLists(test.ref_lists_, {"0:", "8: L0 0", "4: L0 0 8 | L1 8 0", "2: L0 8 0 4 | L1 4 8", "2: L0 0 | L1 0 0 8 4", "6: L0 8 2",
+               "5: L0 4 6 | L1 4 8", "7: L0 6 6"}, name, "reference lists");
+    CheckLists(PocList(test.display_pocs_), PocList({0, 2, 4, 5, 6, 7, 8}), name, "display order");
+}
+
+static void TestAvcRefListModification() {
+    const std::string name = "H.264 reference list modification";
+    // POC 4 has a B, a P and a B slice: the second B slice reuses the initial lists of the first one after the P slice, and
+    // only modifies RefPicList1. The second slice of POC 2 adds to the picture number prediction past MaxPicNum.
+    std::vector<std::vector<AvcSlice>> pictures = {
+        {{kAvcSliceIdr, 3, kAvcSliceI, 0, 0}},
+        {{kAvcSliceNonIdr, 2, kAvcSliceP, 1, 8, 1}},
+        {{kAvcSliceNonIdr, 2, kAvcSliceB, 2, 4, 2, 2},
+         {kAvcSliceNonIdr, 2, kAvcSliceP, 2, 4, 2, 0, {{0, 1}}, {}, {}, false, 4},
+         {kAvcSliceNonIdr, 2, kAvcSliceB, 2, 4, 1, 2, {}, {{0, 1}}, {}, false, 8}},
+        {{kAvcSliceNonIdr, 0, kAvcSliceB, 3, 2, 3, 3},
+         {kAvcSliceNonIdr, 0, kAvcSliceB, 3, 2, 3, 3, {{0, 0}, {1, 14}}, {}, {}, false, 8}},
+    };
+    std::vector<std::vector<uint8_t>> access_units;
+    for (auto &picture : pictures) {
+        access_units.emplace_back();
+        for (auto &slice : picture) {
+            Append(access_units.back(), AvcSliceNal(slice));
+        }
+    }
+    ParserTest test(rocDecVideoCodec_AVC);
+    Check(ParseAccessUnits(test, AvcParameterSets(), access_units) == ROCDEC_SUCCESS, name, "stream not parsed");
+    CheckLists(test.ref_lists_, {"0:", "8: L0 0", "4: L0 0 8 | L1 8 0", "4: L0 0 8", "4: L0 0 | L1 0 8", "2: L0 0 4 8 | L1 4 8 0",
+               "2: L0 4 8 0 | L1 4 8 0"}, name, "reference lists");
+    CheckLists(PocList(test.display_pocs_), PocList({0, 2, 4, 8}), name, "display order");
+}
+
+/*! \brief AV1 bitstream pieces. The streams are still pictures of one key frame (reduced_still_picture_header), 64x64 8-bit 4:2:0,
+ *         with one tile per 64x64 superblock column.
+ */
+enum { kAv1ObuSequenceHeader = 1, kAv1ObuTemporalDelimiter = 2, kAv1ObuFrameHeader = 3, kAv1ObuTileGroup = 4, kAv1ObuFrame = 6 };
+
+static void PutLeb128(std::vector<uint8_t> &data, uint64_t value) {
+    do {
+        uint8_t byte = value & 0x7F;
+        value >>= 7;
+        data.push_back(value ? byte | 0x80 : byte);
+    } while (value);
+}
+
+static std::vector<uint8_t> Av1SequenceHeaderPayload(int width, int height) {
+    BitWriter bw;
+    bw.PutBits(0, 3);           // seq_profile
+    bw.PutBits(1, 1);           // still_picture
+    bw.PutBits(1, 1);           // reduced_still_picture_header
+    bw.PutBits(0, 5);           // seq_level_idx[0]
+    bw.PutBits(15, 4);          // frame_width_bits_minus_1
+    bw.PutBits(15, 4);          // frame_height_bits_minus_1
+    bw.PutBits(width - 1, 16);  // max_frame_width_minus_1
+    bw.PutBits(height - 1, 16); // max_frame_height_minus_1
+    bw.PutBits(0, 1);           // use_128x128_superblock
+    bw.PutBits(0, 1);           // enable_filter_intra
+    bw.PutBits(0, 1);           // enable_intra_edge_filter
+    bw.PutBits(0, 1);           // enable_superres
+    bw.PutBits(0, 1);           // enable_cdef
+    bw.PutBits(0, 1);           // enable_restoration
+    bw.PutBits(0, 1);           // color_config(): high_bitdepth
+    bw.PutBits(0, 1);           // mono_chrome
+    bw.PutBits(0, 1);           // color_description_present_flag
+    bw.PutBits(0, 1);           // color_range
+    bw.PutBits(0, 2);           // chroma_sample_position
+    bw.PutBits(0, 1);           // separate_uv_delta_q
+    bw.PutBits(0, 1);           // film_grain_params_present
+    bw.PutTrailingBits();
+    return bw.Data();
+}
+
+/*! \brief Uncompressed header of a key frame of tile_cols_log2 uniformly spaced tile columns whose sizes are coded on tile_size_bytes,
+ *         ended by byte_alignment() in a frame OBU or by trailing_bits() in a frame header OBU
+ */
+static std::vector<uint8_t> Av1FrameHeaderPayload(int tile_cols_log2, int max_tile_cols_log2, bool trailing_bits, int tile_size_bytes = 2) {
+    BitWriter bw;
+    bw.PutBits(0, 1);           // disable_cdf_update
+    bw.PutBits(0, 1);           // allow_screen_content_tools
+    bw.PutBits(0, 1);           // render_and_frame_size_different
+    bw.PutBits(1, 1);           // uniform_tile_spacing_flag
+    for (int i = 0; i < max_tile_cols_log2; i++) {
+        bw.PutBits(i < tile_cols_log2, 1);  // increment_tile_cols_log2
+        if (i >= tile_cols_log2) {
+            break;
+        }
+    }
+    if (tile_cols_log2) {
+        bw.PutBits(0, tile_cols_log2);  // context_update_tile_id
+        bw.PutBits(tile_size_bytes - 1, 2);  // tile_size_bytes_minus_1
+    }
+    bw.PutBits(100, 8);         // base_q_idx
+    bw.PutBits(0, 1);           // DeltaQYDc delta_coded
+    bw.PutBits(0, 1);           // DeltaQUDc delta_coded
+    bw.PutBits(0, 1);           // DeltaQUAc delta_coded
+    bw.PutBits(0, 1);           // using_qmatrix
+    bw.PutBits(0, 1);           // segmentation_enabled
+    bw.PutBits(0, 1);           // delta_q_present
+    bw.PutBits(0, 6);           // loop_filter_level[0]
+    bw.PutBits(0, 6);           // loop_filter_level[1]
+    bw.PutBits(0, 3);           // loop_filter_sharpness
+    bw.PutBits(0, 1);           // loop_filter_delta_enabled
+    bw.PutBits(0, 1);           // tx_mode_select
+    bw.PutBits(0, 1);           // reduced_tx_set
+    if (trailing_bits) {
+        bw.PutTrailingBits();
+    } else {
+        bw.ByteAlign();
+    }
+    return bw.Data();
+}
+
+/*! \brief Tile group of the tiles tg_start to tg_end, with tile_size bytes of tile data filled with 0x40 + the tile number per tile and
+ *         the tile sizes coded on tile_size_bytes
+ */
+static std::vector<uint8_t> Av1TileGroupPayload(int tile_cols_log2, int tg_start, int tg_end, int tile_size, int tile_size_bytes = 2) {
+    BitWriter bw;
+    int num_tiles = 1 << tile_cols_log2;
+    bool tile_start_and_end_present_flag = tg_start != 0 || tg_end != num_tiles - 1;
+    if (num_tiles > 1) {
+        bw.PutBits(tile_start_and_end_present_flag, 1);
+        if (tile_start_and_end_present_flag) {
+            bw.PutBits(tg_start, tile_cols_log2);
+            bw.PutBits(tg_end, tile_cols_log2);
+        }
+    }
+    bw.ByteAlign();
+    for (int i = tg_start; i <= tg_end; i++) {
+        if (i < tg_end) {
+            for (int byte = 0; byte < tile_size_bytes; byte++) {
+                bw.PutBits((tile_size - 1) >> (8 * byte), 8);  // tile_size_minus_1, le(TileSizeBytes)
+            }
+        }
+        bw.PutBytes(std::vector<uint8_t>(tile_size, static_cast<uint8_t>(0x40 + i)));
+    }
+    return bw.Data();
+}
+
+/*! \brief Frame OBU payload of a key frame with all its tiles in one tile group
+ */
+static std::vector<uint8_t> Av1FramePayload(int tile_cols_log2, int max_tile_cols_log2, int tile_size) {
+    std::vector<uint8_t> payload = Av1FrameHeaderPayload(tile_cols_log2, max_tile_cols_log2, false);
+    Append(payload, Av1TileGroupPayload(tile_cols_log2, 0, (1 << tile_cols_log2) - 1, tile_size));
+    return payload;
+}
+
+/*! \brief OBU of the low overhead bitstream format: OBU header with obu_has_size_field, obu_size, payload
+ */
+static std::vector<uint8_t> Av1Obu(int obu_type, const std::vector<uint8_t> &payload) {
+    std::vector<uint8_t> obu = {static_cast<uint8_t>((obu_type << 3) | 0x02)};
+    PutLeb128(obu, payload.size());
+    Append(obu, payload);
+    return obu;
+}
+
+/*! \brief OBU of the length delimited format (Annex B): obu_length, then the OBU header without obu_size
+ */
+static std::vector<uint8_t> Av1AnnexBObu(int obu_type, const std::vector<uint8_t> &payload) {
+    std::vector<uint8_t> obu;
+    PutLeb128(obu, 1 + payload.size());
+    obu.push_back(obu_type << 3);
+    obu.insert(obu.end(), payload.begin(), payload.end());
+    return obu;
+}
+
+/*! \brief Length delimited temporal unit of one frame unit holding a temporal delimiter, a sequence header and a frame
+ */
+static std::vector<uint8_t> Av1AnnexBTemporalUnit(int width, int height, int tile_size) {
+    std::vector<uint8_t> frame_unit;
+    for (auto &obu : {Av1AnnexBObu(kAv1ObuTemporalDelimiter, {}), Av1AnnexBObu(kAv1ObuSequenceHeader, Av1SequenceHeaderPayload(width, height)),
+                      Av1AnnexBObu(kAv1ObuFrame, Av1FramePayload(0, 0, tile_size))}) {
+        frame_unit.insert(frame_unit.end(), obu.begin(), obu.end());
+    }
+    std::vector<uint8_t> temporal_unit_data;
+    PutLeb128(temporal_unit_data, frame_unit.size());
+    temporal_unit_data.insert(temporal_unit_data.end(), frame_unit.begin(), frame_unit.end());
+    std::vector<uint8_t> temporal_unit;
+    PutLeb128(temporal_unit, temporal_unit_data.size());
+    temporal_unit.insert(temporal_unit.end(), temporal_unit_data.begin(), temporal_unit_data.end());
+    return temporal_unit;
+}
+
+static void TestAv1AnnexB() {
+    const std::string name = "AV1 Annex B";
+    std::vector<uint8_t> temporal_unit = Av1AnnexBTemporalUnit(64, 64, 20);
+
+    // A complete temporal unit: one key frame of one 20-byte tile
+    for (size_t chunk_size : {0, 3}) {
+        std::string test_name = name + (chunk_size ? " byte stream" : "");
+        ParserTest test(rocDecVideoCodec_AV1, true, chunk_size != 0);
+        Check(test.Parse(temporal_unit, ROCDEC_PKT_ENDOFSTREAM, chunk_size) == ROCDEC_SUCCESS, test_name, "temporal unit not parsed");
+        Check(test.num_sequences_ == 1 && test.coded_width_ == 64 && test.coded_height_ == 64, test_name, "sequence");
+        Check(test.num_decoded_ == 1 && test.tiles_ == std::vector<std::string>{"0,0: 20"} && test.tile_data_ok_, test_name, "decoded frame");
+        Check(test.num_displayed_ == 1, test_name, "displayed frame");
+    }
+
+    // The same temporal unit cut before its last byte: temporal_unit_size is larger than the data
+    {
+        std::vector<uint8_t> truncated(temporal_unit.begin(), temporal_unit.end() - 1);
+        ParserTest test(rocDecVideoCodec_AV1, true);
+        Check(test.Parse(truncated, ROCDEC_PKT_ENDOFSTREAM) != ROCDEC_SUCCESS, name + " truncated", "truncated temporal unit accepted");
+        Check(test.num_decoded_ == 0, name + " truncated", "frame of a truncated temporal unit decoded");
+    }
+
+    // frame_unit_size larger than the enclosing temporal unit, in both input modes
+    for (size_t chunk_size : {0, 3}) {
+        std::string test_name = name + " frame unit size" + (chunk_size ? " byte stream" : "");
+        std::vector<uint8_t> invalid = temporal_unit;
+        invalid[1]++;
+        ParserTest test(rocDecVideoCodec_AV1, true, chunk_size != 0);
+        Check(test.Parse(invalid, ROCDEC_PKT_ENDOFSTREAM, chunk_size) != ROCDEC_SUCCESS, test_name, "frame unit larger than the temporal unit accepted");
+        Check(test.num_decoded_ == 0, test_name, "frame of an invalid temporal unit decoded");
+    }
+}
+
+static void TestAv1Tiles() {
+    const std::string name = "AV1 tiles";
+    // 256x64 frames have four superblock columns, so up to four tile columns. Each temporal unit is one access unit.
+    std::vector<uint8_t> sequence = Av1Obu(kAv1ObuTemporalDelimiter, {});
+    Append(sequence, Av1Obu(kAv1ObuSequenceHeader, Av1SequenceHeaderPayload(256, 64)));
+    struct {
+        std::string test_name;
+        std::vector<std::vector<uint8_t>> obus;
+        std::vector<std::string> tiles;
+    } cases[] = {
+        {"two tiles in a frame OBU", {Av1Obu(kAv1ObuFrame, Av1FramePayload(1, 2, 30))}, {"0,0: 30", "0,1: 30"}},
+        {"four tiles in a frame OBU", {Av1Obu(kAv1ObuFrame, Av1FramePayload(2, 2, 20))}, {"0,0: 20", "0,1: 20", "0,2: 20", "0,3: 20"}},
+        {"four tiles in three tile group OBUs", {Av1Obu(kAv1ObuFrameHeader, Av1FrameHeaderPayload(2, 2, true)), Av1Obu(kAv1ObuTileGroup, Av1TileGroupPayload(2, 0, 0, 17)),
+         Av1Obu(kAv1ObuTileGroup, Av1TileGroupPayload(2, 1, 2, 300)), Av1Obu(kAv1ObuTileGroup, Av1TileGroupPayload(2, 3, 3, 5))}, {"0,0: 17", "0,1: 300", "0,2: 300", "0,3: 5"}},
+        {"four tiles with 4-byte tile sizes", {Av1Obu(kAv1ObuFrameHeader, Av1FrameHeaderPayload(2, 2, true, 4)), Av1Obu(kAv1ObuTileGroup, Av1TileGroupPayload(2, 0, 3, 20, 4))},
+         {"0,0: 20", "0,1: 20", "0,2: 20", "0,3: 20"}},
+    };
+    for (auto &test_case : cases) {
+        std::string test_name = name + ": " + test_case.test_name;
+        std::vector<uint8_t> temporal_unit = sequence;
+        for (auto &obu : test_case.obus) {
+            Append(temporal_unit, obu);
+        }
+        ParserTest test(rocDecVideoCodec_AV1);
+        Check(test.Parse(temporal_unit, ROCDEC_PKT_ENDOFSTREAM) == ROCDEC_SUCCESS, test_name, "temporal unit not parsed");
+        Check(test.num_sequences_ == 1 && test.coded_width_ == 256 && test.coded_height_ == 64, test_name, "sequence");
+        Check(test.num_decoded_ == 1 && test.num_displayed_ == 1, test_name, "decoded frame");
+        CheckLists(test.tiles_, test_case.tiles, test_name, "tiles");
+        Check(test.tile_data_ok_, test_name, "tile data offsets");
+    }
+
+    // Tile groups out of order, overlapping tile groups, and a tile size beyond its OBU
+    std::vector<uint8_t> frame_header = Av1Obu(kAv1ObuFrameHeader, Av1FrameHeaderPayload(2, 2, true));
+    std::vector<uint8_t> oversized_tile = Av1TileGroupPayload(2, 0, 3, 20);
+    oversized_tile[1] += 200;  // low byte of tile_size_minus_1 of the first tile, after the byte of tile_start_and_end_present_flag
+    // The first tile replaced by a tile_size_minus_1 of 0xFFFFFFFF (TileSizeBytes 4): tile_size_minus_1 + 1 wraps to 0 in 32 bits, which
+    // would make the first tile empty and the three others valid
+    std::vector<uint8_t> wrapping_tile = Av1TileGroupPayload(2, 0, 3, 20, 4);
+    wrapping_tile.erase(wrapping_tile.begin() + 1, wrapping_tile.begin() + 1 + 4 + 20);
+    wrapping_tile.insert(wrapping_tile.begin() + 1, 4, 0xff);
+    struct {
+        std::string test_name;
+        std::vector<std::vector<uint8_t>> obus;
+    } invalid_cases[] = {
+        {"tile groups out of order", {frame_header, Av1Obu(kAv1ObuTileGroup, Av1TileGroupPayload(2, 2, 3, 20)), Av1Obu(kAv1ObuTileGroup, Av1TileGroupPayload(2, 0, 1, 20))}},
+        {"overlapping tile groups", {frame_header, Av1Obu(kAv1ObuTileGroup, Av1TileGroupPayload(2, 0, 1, 20)), Av1Obu(kAv1ObuTileGroup, Av1TileGroupPayload(2, 1, 3, 20))}},
+        {"tile size beyond the OBU", {frame_header, Av1Obu(kAv1ObuTileGroup, oversized_tile)}},
+        {"tile size wrapping in 32 bits", {Av1Obu(kAv1ObuFrameHeader, Av1FrameHeaderPayload(2, 2, true, 4)), Av1Obu(kAv1ObuTileGroup, wrapping_tile)}},
+    };
+    for (auto &test_case : invalid_cases) {
+        std::string test_name = name + ": " + test_case.test_name;
+        std::vector<uint8_t> temporal_unit = sequence;
+        for (auto &obu : test_case.obus) {
+            Append(temporal_unit, obu);
+        }
+        ParserTest test(rocDecVideoCodec_AV1);
+        Check(test.Parse(temporal_unit, ROCDEC_PKT_ENDOFSTREAM) != ROCDEC_SUCCESS, test_name, "invalid tile group accepted");
+        Check(test.num_decoded_ == 0, test_name, "frame of an invalid tile group decoded");
+    }
+}
+
+int main() {
+    TestAvcDpb();
+    TestHevcDpb();
+    TestAvcRefListModification();
+    TestHevcRefListModification();
+    TestAv1Tiles();
+    TestAv1AnnexB();
+    return ReportTestResults("parser");
+}
@@ -0,0 +1,237 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include "resample_filter.h"
+#include "test_common.h"
+
+static const ResampleFilter filters[] = {ResampleFilter_Area, ResampleFilter_Bilinear, ResampleFilter_Bicubic, ResampleFilter_Lanczos3};
+static const char *filter_names[] = {"area", "bilinear", "bicubic", "lanczos3"};
+
+/*! \brief Runs ResampleYuv420Ref into a destination with a padded pitch and compares both planes with the expected values within tolerance;
+ *         the expected value function gets (plane, component, x, y) and returns a negative value for the pixels that are not checked
+ */
+template<class ExpectedFn>
+static void CheckResample(const std::string &test_name, ResampleFilter filter, const Yuv420Surface &src, int dst_width, int dst_height, double tolerance,
+                          ExpectedFn expected) {
+    Yuv420Surface dst(dst_width, dst_height, src.is_16bit);
+    dst.v_pitch = dst_height;   // the destination UV plane follows the Y plane
+    ResampleYuv420Ref(filter, src.data.data(), src.pitch, src.width, src.height, src.v_pitch, src.is_16bit, dst.data.data(), dst.pitch, dst_width,
+                      dst_height);
+    int num_errors = 0;
+    for (int plane = 0; plane < 2; plane++) {
+        for (int y = 0; y < (plane ? dst_height / 2 : dst_height); y++) {
+            for (int x = 0; x < (plane ? dst_width / 2 : dst_width); x++) {
+                for (int comp = 0; comp <= plane; comp++) {
+                    double expected_value = expected(plane, comp, x, y);
+                    int value = dst.Get(plane, comp, x, y);
+                    if (expected_value >= 0 && !(std::fabs(value - expected_value) <= tolerance) && num_errors++ < 4) {
+                        std::cerr << test_name << ": plane " << plane << " component " << comp << " (" << x << ", " << y << ") is " << value
+                                  << ", expected " << expected_value << std::endl;
+                    }
+                }
+            }
+        }
+    }
+    Check(num_errors == 0, test_name, std::to_string(num_errors) + " value(s) differ");
+}
+
+/*! \brief Properties of the coefficient tables of every filter, from identity to the 60x downscale of 3840 to 64: the weights of every
+ *         destination index sum to 1 and stay in the source, area and bilinear weights are not negative, the area weights of a source pixel add up
+ *         to dst_size / src_size (every source pixel contributes the same), and the footprint grows with the downscale ratio
+ */
+static void TestTables() {
+    const int geometries[][2] = {{3840, 64}, {3840, 224}, {1920, 224}, {1080, 360}, {960, 480}, {225, 224}, {224, 224}, {100, 300}, {7, 3}, {3, 2}};
+    for (int f = 0; f < 4; f++) {
+        for (auto &geometry : geometries) {
+            int src_size = geometry[0], dst_size = geometry[1];
+            std::string name = std::string(filter_names[f]) + " table " + std::to_string(src_size) + " to " + std::to_string(dst_size);
+            std::vector<int> start;
+            std::vector<float> weights;
+            int num_taps = BuildResampleTable(filters[f], src_size, dst_size, start, weights);
+            Check(static_cast<int>(start.size()) == dst_size && weights.size() == static_cast<size_t>(dst_size) * num_taps, name, "table size");
+            double scale = static_cast<double>(src_size) / dst_size;
+            // the footprint covers the filter support widened by the downscale ratio, plus the partially covered edge pixels
+            double max_taps = 2.0 * ResampleFilterRadius(filters[f]) * std::max(scale, 1.0) + 3.0;
+            Check(num_taps >= std::min(static_cast<int>(scale), src_size) && num_taps <= max_taps, name, "number of taps " + std::to_string(num_taps));
+            std::vector<double> contribution(src_size, 0.0);
+            int num_errors = 0;
+            for (int i = 0; i < dst_size; i++) {
+                double sum = 0.0;
+                bool in_range = start[i] >= 0 && start[i] < src_size;
+                for (int k = 0; k < num_taps; k++) {
+                    float w = weights[static_cast<size_t>(i) * num_taps + k];
+                    sum += w;
+                    if (w != 0.0f) {
+                        in_range = in_range && start[i] + k < src_size;
+                        contribution[std::min(start[i] + k, src_size - 1)] += w;
+                    }
+                    if (w < 0.0f && (filters[f] == ResampleFilter_Area || filters[f] == ResampleFilter_Bilinear)) {
+                        in_range = false;
+                    }
+                }
+                if ((!in_range || std::fabs(sum - 1.0) > 1e-5) && num_errors++ < 4) {
+                    std::cerr << name << ": destination " << i << " starts at " << start[i] << " with a weight sum of " << sum << std::endl;
+                }
+            }
+            Check(num_errors == 0, name, std::to_string(num_errors) + " destination index(es) with invalid weights");
+            if (filters[f] == ResampleFilter_Area && scale > 1.0) {
+                double max_error = 0.0;
+                for (double c : contribution) {
+                    max_error = std::max(max_error, std::fabs(c - 1.0 / scale));
+                }
+                Check(max_error < 1e-5, name, "source contribution differs from dst_size / src_size by " + std::to_string(max_error));
+            }
+        }
+    }
+    // exact area weights: a 4x integer ratio averages 4 pixels, 3 to 2 splits the middle pixel
+    std::vector<int> start;
+    std::vector<float> weights;
+    int num_taps = BuildResampleTable(ResampleFilter_Area, 16, 4, start, weights);
+    Check(num_taps == 4 && start[1] == 4 && weights[4] == 0.25f && weights[7] == 0.25f, "area table 16 to 4", "weights are not 4 x 0.25");
+    num_taps = BuildResampleTable(ResampleFilter_Area, 3, 2, start, weights);
+    Check(num_taps == 2 && start[0] == 0 && start[1] == 1 && std::fabs(weights[0] - 2.0f / 3) < 1e-6f && std::fabs(weights[1] - 1.0f / 3) < 1e-6f &&
+          std::fabs(weights[2] - 1.0f / 3) < 1e-6f && std::fabs(weights[3] - 2.0f / 3) < 1e-6f, "area table 3 to 2", "weights are not 2/3, 1/3");
+    // area averaging of an upscale is bilinear, and every filter is the identity at the same size
+    std::vector<int> bilinear_start;
+    std::vector<float> bilinear_weights;
+    BuildResampleTable(ResampleFilter_Area, 100, 300, start, weights);
+    BuildResampleTable(ResampleFilter_Bilinear, 100, 300, bilinear_start, bilinear_weights);
+    Check(start == bilinear_start && weights == bilinear_weights, "area table 100 to 300", "differs from bilinear");
+    for (int f = 0; f < 4; f++) {
+        num_taps = BuildResampleTable(filters[f], 224, 224, start, weights);
+        int num_errors = 0;
+        for (int i = 0; i < 224; i++) {
+            for (int k = 0; k < num_taps; k++) {
+                double expected = start[i] + k == i ? 1.0 : 0.0;
+                num_errors += std::fabs(weights[static_cast<size_t>(i) * num_taps + k] - expected) > 1e-6 ? 1 : 0;
+            }
+        }
+        Check(num_errors == 0, std::string(filter_names[f]) + " table 224 to 224", "is not the identity");
+    }
+}
+
+/*! \brief A uniform surface stays uniform with every filter, downscaled (including 3840x2160 to 224x224 and 64x36) and upscaled
+ */
+static void TestUniform() {
+    const int geometries[][4] = {{3840, 2160, 224, 224}, {3840, 2160, 64, 36}, {1920, 1080, 640, 360}, {1920, 1080, 320, 180}, {64, 48, 200, 150}};
+    for (bool is_16bit : {false, true}) {
+        const int yuv[3] = {is_16bit ? 0x5a3c : 90, is_16bit ? 0x8010 : 128, is_16bit ? 0xc3f0 : 196};
+        for (auto &geometry : geometries) {
+            Yuv420Surface src(geometry[0], geometry[1], is_16bit);
+            src.Fill([&](int plane, int comp, int, int) { return yuv[plane + comp]; });
+            for (int f = 0; f < 4; f++) {
+                std::string name = std::string(is_16bit ? "P016 " : "NV12 ") + filter_names[f] + " uniform " + std::to_string(geometry[0]) + "x" +
+                                   std::to_string(geometry[1]) + " to " + std::to_string(geometry[2]) + "x" + std::to_string(geometry[3]);
+                CheckResample(name, filters[f], src, geometry[2], geometry[3], 0.0, [&](int plane, int comp, int, int) { return yuv[plane + comp]; });
+            }
+        }
+    }
+}
+
+/*! \brief The area filter of an integer ratio is the rounded block average: a pseudo random 64x32 surface downscaled 4x gives
+ *         (sum of the 4x4 block + 8) / 16, for the luma and for both chroma components
+ */
+static void TestAreaBlockAverage() {
+    for (bool is_16bit : {false, true}) {
+        Yuv420Surface src(64, 32, is_16bit);
+        auto value = [&](int plane, int comp, int x, int y) {
+            uint32_t hash = (static_cast<uint32_t>(x) * 73856093u) ^ (static_cast<uint32_t>(y) * 19349663u) ^ (static_cast<uint32_t>(2 * plane + comp) * 83492791u);
+            hash = (hash ^ (hash >> 13)) * 0x5bd1e995u;
+            return static_cast<int>((hash ^ (hash >> 15)) & (is_16bit ? 0xffff : 0xff));
+        };
+        src.Fill(value);
+        CheckResample(std::string(is_16bit ? "P016" : "NV12") + " area 64x32 to 16x8 block average", ResampleFilter_Area, src, 16, 8, 0.0,
+                      [&](int plane, int comp, int x, int y) {
+                          int64_t sum = 0;
+                          for (int j = 0; j < 4; j++) {
+                              for (int i = 0; i < 4; i++) {
+                                  sum += value(plane, comp, 4 * x + i, 4 * y + j);
+                              }
+                          }
+                          return static_cast<double>((sum + 8) / 16);
+                      });
+    }
+}
+
+/*! \brief Anti-aliasing of large downscales: a one pixel checkerboard of 0 and max (the luma and both chroma components) averages to the mid value
+ *         with every filter when 3840x2160 is downscaled to 224x224, where a fixed footprint would alias to the source values
+ */
+static void TestLargeDownscale() {
+    for (bool is_16bit : {false, true}) {
+        const int max_value = is_16bit ? 0xffff : 0xff;
+        Yuv420Surface src(3840, 2160, is_16bit);
+        src.Fill([&](int, int comp, int x, int y) { return ((x + y + comp) & 1) ? max_value : 0; });
+        for (int f = 0; f < 4; f++) {
+            // one destination pixel averages about 17x10 source pixels: the partial edge pixels leave a residual of a few percent
+            CheckResample(std::string(is_16bit ? "P016 " : "NV12 ") + filter_names[f] + " checkerboard 3840x2160 to 224x224", filters[f], src, 224, 224,
+                          0.05 * max_value, [&](int, int, int, int) { return max_value / 2.0; });
+        }
+    }
+}
+
+/*! \brief Pixel center alignment of the ladder renditions: the luma is a horizontal ramp and the chroma planes are vertical (U) and horizontal (V)
+ *         ramps of 1920x1080, which every filter preserves away from the edges, so destination pixel x of a rendition is the ramp at the source
+ *         position (x + 0.5) * scale - 0.5; the renditions are the 640x360 and 320x180 ladder of the videoDecodeRGB test and a 224x224 thumbnail
+ */
+static void TestLadderRamps() {
+    const int renditions[][2] = {{640, 360}, {320, 180}, {224, 224}};
+    for (bool is_16bit : {false, true}) {
+        const double unit = is_16bit ? 16.0 : 1.0 / 16;     // ramp slope per source pixel
+        Yuv420Surface src(1920, 1080, is_16bit);
+        src.Fill([&](int plane, int comp, int x, int y) { return static_cast<int>(std::lround(unit * (plane && comp == 0 ? y : x))); });
+        for (auto &rendition : renditions) {
+            int dst_width = rendition[0], dst_height = rendition[1];
+            for (int f = 0; f < 4; f++) {
+                std::string name = std::string(is_16bit ? "P016 " : "NV12 ") + filter_names[f] + " ramps 1920x1080 to " + std::to_string(dst_width) + "x" +
+                                   std::to_string(dst_height);
+                CheckResample(name, filters[f], src, dst_width, dst_height, is_16bit ? 16.0 : 1.0, [&](int plane, int comp, int x, int y) {
+                    bool vertical = plane && comp == 0;
+                    int src_size = vertical ? (plane ? 540 : 1080) : (plane ? 960 : 1920);
+                    int dst_size = vertical ? (plane ? dst_height / 2 : dst_height) : (plane ? dst_width / 2 : dst_width);
+                    int index = vertical ? y : x;
+                    double scale = static_cast<double>(src_size) / dst_size;
+                    double position = (index + 0.5) * scale - 0.5;
+                    // the footprint of the pixels near the edges is folded into the edge pixels
+                    double support = (ResampleFilterRadius(filters[f]) + 1.0) * scale + 1.0;
+                    if (position < support || position > src_size - 1 - support) {
+                        return -1.0;
+                    }
+                    return unit * position;
+                });
+            }
+        }
+    }
+}
+
+int main() {
+    TestTables();
+    TestUniform();
+    TestAreaBlockAverage();
+    TestLargeDownscale();
+    TestLadderRamps();
+    return ReportTestResults("resample reference");
+}
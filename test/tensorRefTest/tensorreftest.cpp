@@ -0,0 +1,218 @@
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdint>
+#include "tensor_convert.h"
+#include "test_common.h"
+
+/*! \brief Runs ResizeYuv420ToTensorRef and compares the 3 planes with the expected values of each channel and pixel
+ */
+template<class ExpectedFn>
+static void CheckTensor(const std::string &test_name, const Yuv420Surface &surface, int src_width, int src_height, int dst_width, int dst_height,
+                        bool bgr, const TensorNormParams &norm_params, const ColorSpaceInfo &color_info, ExpectedFn expected) {
+    std::vector<float> tensor(3 * dst_width * dst_height, NAN);
+    ResizeYuv420ToTensorRef(surface.data.data(), surface.pitch, src_width, src_height, surface.v_pitch, surface.is_16bit, tensor.data(),
+                            dst_width, dst_height, bgr, norm_params, color_info);
+    int num_errors = 0;
+    for (int c = 0; c < 3; c++) {
+        for (int y = 0; y < dst_height; y++) {
+            for (int x = 0; x < dst_width; x++) {
+                float value = tensor[(c * dst_height + y) * dst_width + x];
+                double expected_value = expected(c, x, y);
+                if (!(std::fabs(value - expected_value) <= 1e-4) && num_errors++ < 4) {
+                    std::cerr << test_name << ": channel " << c << " (" << x << ", " << y << ") is " << value << ", expected " << expected_value
+                              << std::endl;
+                }
+            }
+        }
+    }
+    Check(num_errors == 0, test_name, std::to_string(num_errors) + " value(s) differ");
+}
+
+/*! \brief Full range BT.601 Y 100, U 128, V 178 gives R 170.1, G 64.293 and B 100 at any scale; with BGR order and the ImageNet mean and
+ *         standard deviation, which apply in output channel order, the channels are (100 / 255 - 0.485) / 0.229, (64.293 / 255 - 0.456) / 0.224
+ *         and (170.1 / 255 - 0.406) / 0.225
+ */
+static void TestUniformColor() {
+    const ColorSpaceInfo color_info(ColorSpaceStandard_BT601, true);
+    TensorNormParams imagenet;
+    const float mean[3] = {0.485f, 0.456f, 0.406f}, std_dev[3] = {0.229f, 0.224f, 0.225f};
+    for (int c = 0; c < 3; c++) {
+        imagenet.mean[c] = mean[c];
+        imagenet.std_dev[c] = std_dev[c];
+    }
+    for (bool is_16bit : {false, true}) {
+        const int width = 32, height = 16;
+        Yuv420Surface surface(width, height, is_16bit);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                surface.SetLuma(x, y, 100);
+                surface.SetChroma(x / 2, y / 2, 128, 178);
+            }
+        }
+        std::string name = is_16bit ? "P016" : "NV12";
+        // 16-bit: R = 25600 + 1.402 * 12800, G = 25600 - 0.714136 * 12800 on a 65535 scale
+        const double rgb[2][3] = {{0.6670588, 0.2521301, 0.3921569}, {0.6644633, 0.2511491, 0.3906310}};
+        const double *p_rgb = rgb[is_16bit];
+        CheckTensor(name + " uniform color 32x16 to 8x4", surface, width, height, 8, 4, false, TensorNormParams(), color_info,
+                    [&](int c, int, int) { return p_rgb[c]; });
+        CheckTensor(name + " uniform color 32x16 to 45x23", surface, width, height, 45, 23, false, TensorNormParams(), color_info,
+                    [&](int c, int, int) { return p_rgb[c]; });
+        CheckTensor(name + " uniform color BGR normalized", surface, width, height, 8, 4, true, imagenet, color_info,
+                    [&](int c, int, int) { return (p_rgb[2 - c] - mean[c]) / std_dev[c]; });
+    }
+}
+
+/*! \brief Luma ramp Y = 16 x with neutral chroma in full range (R = G = B = Y): halving the width averages the source columns 2 x and 2 x + 1,
+ *         giving 32 x + 8; doubling the height of rows 0, 64, 128, 192 interpolates at 0.5 y - 0.25 clamped to the edge rows,
+ *         giving 0, 16, 48, 80, 112, 144, 176, 192
+ */
+static void TestLumaResize() {
+    const ColorSpaceInfo color_info(ColorSpaceStandard_BT709, true);
+    for (bool is_16bit : {false, true}) {
+        std::string name = is_16bit ? "P016" : "NV12";
+        // the 16-bit samples are the 8-bit values shifted by 8, on a 65535 scale
+        const double unit_scale = is_16bit ? 256.0 / 65535.0 : 1.0 / 255.0;
+        {
+            const int width = 16, height = 4;
+            Yuv420Surface surface(width, height, is_16bit);
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    surface.SetLuma(x, y, 16 * x);
+                    surface.SetChroma(x / 2, y / 2, 128, 128);
+                }
+            }
+            CheckTensor(name + " horizontal ramp 16x4 to 8x4", surface, width, height, 8, 4, false, TensorNormParams(), color_info,
+                        [&](int, int x, int) { return (32 * x + 8) * unit_scale; });
+        }
+        {
+            const int width = 4, height = 4;
+            Yuv420Surface surface(width, height, is_16bit);
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    surface.SetLuma(x, y, 64 * y);
+                    surface.SetChroma(x / 2, y / 2, 128, 128);
+                }
+            }
+            const int expected[8] = {0, 16, 48, 80, 112, 144, 176, 192};
+            CheckTensor(name + " vertical ramp 4x4 to 4x8", surface, width, height, 4, 8, false, TensorNormParams(), color_info,
+                        [&](int, int, int y) { return expected[y] * unit_scale; });
+        }
+    }
+}
+
+/*! \brief Chroma siting: at the source size the chroma of pixel x is interpolated at x / 2 - 0.25 (clamped) between the 2x1 chroma samples,
+ *         so with Y 100 and V = 128 + 8 k on chroma column k, full range BT.601 gives R = 100 + 1.402 * 8 * clamp(x / 2 - 0.25, 0, 7):
+ *         100, 102.804, 108.412, 114.02, ... and 178.512 at the last column
+ */
+static void TestChromaSiting() {
+    const ColorSpaceInfo color_info(ColorSpaceStandard_BT601, true);
+    const int width = 16, height = 4;
+    Yuv420Surface surface(width, height, false);
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            surface.SetLuma(x, y, 100);
+            surface.SetChroma(x / 2, y / 2, 128, 128 + 8 * (x / 2));
+        }
+    }
+    const double expected_r[width] = {100.0, 102.804, 108.412, 114.02, 119.628, 125.236, 130.844, 136.452,
+                                      142.06, 147.668, 153.276, 158.884, 164.492, 170.1, 175.708, 178.512};
+    CheckTensor("NV12 chroma siting", surface, width, height, width, height, false, TensorNormParams(), color_info,
+                [&](int c, int x, int) { return c == 0 ? expected_r[x] / 255.0 : c == 2 ? 100.0 / 255.0
+                                                : (100.0 - 0.714136 * 8 * std::min(std::max(x / 2.0 - 0.25, 0.0), 7.0)) / 255.0; });
+}
+
+/*! \brief Planar FP32 reference at the source size with Y 100, neutral U and a V that changes per chroma sample: full range BT.601 gives
+ *         R = Y + 1.402 (V - 128), G = Y - 0.714136 (V - 128) and B = Y on the 255 (8-bit) or 65535 (16-bit) scale, then the scale and bias
+ *         apply in output channel order. For 4:2:0 every 2x2 block shares its chroma sample; for 4:4:4 the U and V planes follow the Y plane
+ *         v_pitch rows apart.
+ */
+static void TestPlanar() {
+    const ColorSpaceInfo color_info(ColorSpaceStandard_BT601, true);
+    TensorScaleBias scale_bias;
+    const float scale[3] = {2.0f, 3.0f, 4.0f}, bias[3] = {-1.0f, 0.0f, 0.5f};
+    for (int c = 0; c < 3; c++) {
+        scale_bias.scale[c] = scale[c];
+        scale_bias.bias[c] = bias[c];
+    }
+    auto check_planar = [&](const std::string &test_name, const std::vector<uint8_t> &surface, int pitch, int width, int height, int v_pitch,
+                            bool is_16bit, bool is_444, bool bgr, const TensorScaleBias &params, auto v_value) {
+        std::vector<float> tensor(3 * width * height, NAN);
+        YuvToPlanarTensorRef(surface.data(), pitch, width, height, v_pitch, is_16bit, is_444, tensor.data(), bgr, params, color_info);
+        const double unit = is_16bit ? 256.0 / 65535.0 : 1.0 / 255.0;
+        int num_errors = 0;
+        for (int c = 0; c < 3; c++) {
+            for (int y = 0; y < height; y++) {
+                for (int x = 0; x < width; x++) {
+                    double dv = v_value(x, y) - 128.0;
+                    double rgb[3] = {(100.0 + 1.402 * dv) * unit, (100.0 - 0.714136 * dv) * unit, 100.0 * unit};
+                    double expected = rgb[bgr ? 2 - c : c] * params.scale[c] + params.bias[c];
+                    float value = tensor[(c * height + y) * width + x];
+                    if (!(std::fabs(value - expected) <= 1e-4) && num_errors++ < 4) {
+                        std::cerr << test_name << ": channel " << c << " (" << x << ", " << y << ") is " << value << ", expected " << expected << std::endl;
+                    }
+                }
+            }
+        }
+        Check(num_errors == 0, test_name, std::to_string(num_errors) + " value(s) differ");
+    };
+    for (bool is_16bit : {false, true}) {
+        const int width = 8, height = 4;
+        Yuv420Surface surface(width, height, is_16bit);
+        auto v_420 = [](int x, int y) { return 128 + 8 * (x / 2) + 16 * (y / 2); };
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                surface.SetLuma(x, y, 100);
+                surface.SetChroma(x / 2, y / 2, 128, v_420(x, y));
+            }
+        }
+        std::string name = is_16bit ? "P016" : "NV12";
+        check_planar(name + " planar RGB", surface.data, surface.pitch, width, height, surface.v_pitch, is_16bit, false, false, TensorScaleBias(), v_420);
+        check_planar(name + " planar BGR with scale and bias", surface.data, surface.pitch, width, height, surface.v_pitch, is_16bit, false, true,
+                     scale_bias, v_420);
+    }
+    {
+        const int width = 4, height = 2, pitch = 12, v_pitch = 3;
+        auto v_444 = [](int x, int y) { return 128 + 10 * x + 20 * y; };
+        std::vector<uint8_t> surface(3 * v_pitch * pitch, 0xff);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                surface[y * pitch + x] = 100;
+                surface[(v_pitch + y) * pitch + x] = 128;
+                surface[(2 * v_pitch + y) * pitch + x] = static_cast<uint8_t>(v_444(x, y));
+            }
+        }
+        check_planar("YUV444 planar BGR with scale and bias", surface, pitch, width, height, v_pitch, false, true, true, scale_bias, v_444);
+    }
+}
+
+int main() {
+    TestUniformColor();
+    TestLumaResize();
+    TestChromaSiting();
+    TestPlanar();
+    return ReportTestResults("tensor reference");
+}
@@ -0,0 +1,107 @@
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/*! \brief Common helpers of the host test programs (test/<name>Test): each program is a single translation unit that calls Check for every
+ *         verified property and returns ReportTestResults from main
+ */
+
+inline int num_failures = 0;
+
+inline void Check(bool condition, const std::string &test_name, const std::string &what) {
+    if (!condition) {
+        std::cerr << "FAILED: " << test_name << ": " << what << std::endl;
+        num_failures++;
+    }
+}
+
+/*! \brief Prints the summary of the test program
+ *
+ * \param [in] suite_name - name of the tests in the summary, e.g. "parser" for "All parser tests passed"
+ * \return 0 when all the checks passed, 1 otherwise
+ */
+inline int ReportTestResults(const std::string &suite_name) {
+    if (num_failures) {
+        std::cerr << num_failures << " " << suite_name << " test(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All " << suite_name << " tests passed" << std::endl;
+    return 0;
+}
+
+/*! \brief NV12 (8-bit) or P016 (MSB aligned 16-bit) surface of width x height pixels with a padded pitch and a luma plane taller than the
+ *         picture; the padding is filled with 0xff. The UV plane is 2 components wide. Get, Set and Fill access the stored sample values,
+ *         SetLuma and SetChroma take 8-bit values that are shifted left by 8 for P016.
+ */
+struct Yuv420Surface {
+    std::vector<uint8_t> data;
+    int width;
+    int height;
+    int pitch;
+    int v_pitch;
+    bool is_16bit;
+
+    Yuv420Surface(int width, int height, bool is_16bit) : width(width), height(height), pitch(width * (is_16bit ? 2 : 1) + 16), v_pitch(height + 4),
+                                                          is_16bit(is_16bit) {
+        data.resize(static_cast<size_t>(v_pitch + (height + 1) / 2) * pitch, 0xff);
+    }
+    int Get(int plane, int comp, int x, int y) const {
+        const uint8_t *p_row = data.data() + static_cast<size_t>(plane ? v_pitch + y : y) * pitch;
+        int index = plane ? 2 * x + comp : x;
+        return is_16bit ? reinterpret_cast<const uint16_t *>(p_row)[index] : p_row[index];
+    }
+    void Set(int plane, int comp, int x, int y, int value) {
+        uint8_t *p_row = data.data() + static_cast<size_t>(plane ? v_pitch + y : y) * pitch;
+        int index = plane ? 2 * x + comp : x;
+        if (is_16bit) {
+            reinterpret_cast<uint16_t *>(p_row)[index] = static_cast<uint16_t>(value);
+        } else {
+            p_row[index] = static_cast<uint8_t>(value);
+        }
+    }
+    /*! \brief Sets every sample of both planes to value(plane, component, x, y)
+     */
+    template<class ValueFn>
+    void Fill(ValueFn value) {
+        for (int plane = 0; plane < 2; plane++) {
+            int plane_width = plane ? (width + 1) / 2 : width, plane_height = plane ? (height + 1) / 2 : height;
+            for (int y = 0; y < plane_height; y++) {
+                for (int x = 0; x < plane_width; x++) {
+                    for (int comp = 0; comp <= plane; comp++) {
+                        Set(plane, comp, x, y, value(plane, comp, x, y));
+                    }
+                }
+            }
+        }
+    }
+    void SetLuma(int x, int y, int value) { Set(0, 0, x, y, is_16bit ? value << 8 : value); }
+    void SetChroma(int x, int y, int u, int v) {
+        Set(1, 0, x, y, is_16bit ? u << 8 : u);
+        Set(1, 1, x, y, is_16bit ? v << 8 : v);
+    }
+};
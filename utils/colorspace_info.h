@@ -0,0 +1,245 @@
+
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+/*!
+ * \file
+ * \brief Color description of decoded streams and the YUV to RGB conversion shared by the device kernels and the host code.
+ *
+ * The header doesn't depend on HIP, so host only consumers (e.g. host_colorspace.h) can be built with any C++ compiler. The packed RGB
+ * formats are only declared here; colorspace_kernels.h defines them with the HIP vector types.
+ */
+
+#if defined(__HIP__)
+#define COLORSPACE_HOST_DEVICE __host__ __device__
+#else
+#define COLORSPACE_HOST_DEVICE
+#endif
+
+typedef enum ColorSpaceStandard_ {
+    ColorSpaceStandard_BT709 = 1,
+    ColorSpaceStandard_Unspecified = 2,
+    ColorSpaceStandard_Reserved = 3,
+    ColorSpaceStandard_FCC = 4,
+    ColorSpaceStandard_BT470 = 5,
+    ColorSpaceStandard_BT601 = 6,
+    ColorSpaceStandard_SMPTE240M = 7,
+    ColorSpaceStandard_YCgCo = 8,
+    ColorSpaceStandard_BT2020 = 9,
+    ColorSpaceStandard_BT2020C = 10
+} ColorSpaceStandard;
+
+// packed RGB formats, defined in colorspace_kernels.h; the host functions only use them to select the layout
+union BGR24;
+union RGB24;
+union BGR48;
+union RGB48;
+union BGRA32;
+union RGBA32;
+union BGRA64;
+union RGBA64;
+
+/**
+ * @brief Transfer characteristics (ITU-T H.273 code points, as signaled in the VUI/sequence header)
+ */
+typedef enum ColorTransfer_ {
+    ColorTransfer_BT709 = 1,
+    ColorTransfer_Unspecified = 2,
+    ColorTransfer_SMPTE2084 = 16,   // PQ
+    ColorTransfer_HLG = 18,
+} ColorTransfer;
+
+/**
+ * @brief Color primaries (ITU-T H.273 code points, as signaled in the VUI/sequence header)
+ */
+typedef enum ColorPrimaries_ {
+    ColorPrimaries_BT709 = 1,
+    ColorPrimaries_Unspecified = 2,
+    ColorPrimaries_BT2020 = 9,
+} ColorPrimaries;
+
+/**
+ * @brief Color description of a decoded stream selecting the YUV to RGB conversion.
+ *        It converts implicitly from a ColorSpaceStandard value for limited range SDR content.
+ */
+struct ColorSpaceInfo {
+    int col_standard;       // matrix coefficients (ColorSpaceStandard)
+    bool full_range;        // video_full_range_flag: Y and UV use the full sample range
+    int transfer;           // transfer characteristics (ColorTransfer)
+    int primaries;          // color primaries (ColorPrimaries)
+    bool hdr_to_sdr;        // tone map PQ/HLG content to SDR BT.709 RGB instead of keeping the HDR encoded values
+    ColorSpaceInfo(int col_standard = ColorSpaceStandard_BT709, bool full_range = false, int transfer = ColorTransfer_Unspecified,
+                   int primaries = ColorPrimaries_Unspecified, bool hdr_to_sdr = false)
+        : col_standard(col_standard), full_range(full_range), transfer(transfer), primaries(primaries), hdr_to_sdr(hdr_to_sdr) {}
+};
+
+/**
+ * @brief YUV to RGB conversion parameters passed by value to the kernels, so streams with different color descriptions can be converted
+ *        concurrently without any constant memory upload
+ */
+struct YuvToRgbParams {
+    float mat[3][3];        // rows: R, G, B; applied on (Y - y_offset, U - uv_offset, V - uv_offset)
+    float y_offset;         // black level
+    float uv_offset;        // chroma zero level
+    float max_value;        // maximum sample value of the unit (255 or 65535)
+    int hdr_transfer;       // ColorTransfer_SMPTE2084/ColorTransfer_HLG when tone mapping to SDR, 0 otherwise
+    int bt2020_to_bt709;    // converts the linear light BT.2020 primaries to BT.709 when tone mapping
+};
+
+inline void GetColMatCoefficients(int col_standard, float &wr, float &wb, int &black, int &white, int &max) {
+    black = 16; white = 235;
+    max = 255;
+
+    switch (col_standard)
+    {
+    case ColorSpaceStandard_BT709:
+    default:
+        wr = 0.2126f; wb = 0.0722f;
+        break;
+
+    case ColorSpaceStandard_FCC:
+        wr = 0.30f; wb = 0.11f;
+        break;
+
+    case ColorSpaceStandard_BT470:
+    case ColorSpaceStandard_BT601:
+        wr = 0.2990f; wb = 0.1140f;
+        break;
+
+    case ColorSpaceStandard_SMPTE240M:
+        wr = 0.212f; wb = 0.087f;
+        break;
+
+    case ColorSpaceStandard_BT2020:
+    case ColorSpaceStandard_BT2020C:
+        wr = 0.2627f; wb = 0.0593f;
+        // 10-bit only
+        black = 64 << 6; white = 940 << 6;
+        max = (1 << 16) - 1;
+        break;
+    }
+}
+
+/**
+ * @brief Computes the conversion parameters of a stream for 8-bit (NV12/YUV444) or 16-bit (P016/YUV444_16Bit, MSB aligned) samples
+ *
+ * @param color_info - color description of the stream
+ * @param unit_bits - 8 or 16
+ */
+inline YuvToRgbParams GetYuvToRgbParams(const ColorSpaceInfo &color_info, int unit_bits) {
+    YuvToRgbParams params = {};
+    // 10/12-bit samples are MSB aligned in 16-bit units, so the ranges scale with the unit size
+    float scale = static_cast<float>(1 << (unit_bits - 8));
+    float max = static_cast<float>((1 << unit_bits) - 1);
+    float y_range, uv_range;
+    if (color_info.full_range) {
+        params.y_offset = 0.0f;
+        y_range = uv_range = max;
+    } else {
+        params.y_offset = 16.0f * scale;
+        y_range = 219.0f * scale;
+        uv_range = 224.0f * scale;
+    }
+    params.uv_offset = 128.0f * scale;
+    params.max_value = max;
+    float coef[3][3];
+    if (color_info.col_standard == ColorSpaceStandard_YCgCo) {
+        // U carries Cg and V carries Co
+        float ycgco[3][3] = {
+            1.0f, -1.0f, 1.0f,
+            1.0f, 1.0f, 0.0f,
+            1.0f, -1.0f, -1.0f,
+        };
+        memcpy(coef, ycgco, sizeof(coef));
+    } else {
+        // only Kr/Kb are used, the sample ranges are set above
+        float wr, wb;
+        int black, white, max_unused;
+        GetColMatCoefficients(color_info.col_standard, wr, wb, black, white, max_unused);
+        float ypbpr[3][3] = {
+            1.0f, 0.0f, (1.0f - wr) / 0.5f,
+            1.0f, -wb * (1.0f - wb) / 0.5f / (1 - wb - wr), -wr * (1 - wr) / 0.5f / (1 - wb - wr),
+            1.0f, (1.0f - wb) / 0.5f, 0.0f,
+        };
+        memcpy(coef, ypbpr, sizeof(coef));
+    }
+    for (int i = 0; i < 3; i++) {
+        params.mat[i][0] = coef[i][0] * max / y_range;
+        params.mat[i][1] = coef[i][1] * max / uv_range;
+        params.mat[i][2] = coef[i][2] * max / uv_range;
+    }
+    if (color_info.hdr_to_sdr && (color_info.transfer == ColorTransfer_SMPTE2084 || color_info.transfer == ColorTransfer_HLG)) {
+        params.hdr_transfer = color_info.transfer;
+        params.bt2020_to_bt709 = color_info.primaries == ColorPrimaries_BT2020;
+    }
+    return params;
+}
+
+/**
+ * @brief Converts one pixel to R, G, B values in [0, max_value]. Shared by the color conversion kernels, the tensor kernels and their CPU references.
+ */
+COLORSPACE_HOST_DEVICE inline void YuvToRgbFloat(const YuvToRgbParams &params, float y, float u, float v, float rgb[3]) {
+    float fy = y - params.y_offset, fu = u - params.uv_offset, fv = v - params.uv_offset;
+    for (int c = 0; c < 3; c++) {
+        rgb[c] = fminf(fmaxf(params.mat[c][0] * fy + params.mat[c][1] * fu + params.mat[c][2] * fv, 0.0f), params.max_value);
+    }
+    if (!params.hdr_transfer) {
+        return;
+    }
+    // HDR to SDR: linearize to display light in cd/m2, convert the primaries, tone map above the reference white and encode for a BT.1886 display
+    const float ref_white = 203.0f, peak = 1000.0f;
+    float lin[3];
+    for (int c = 0; c < 3; c++) {
+        float e = rgb[c] / params.max_value;
+        if (params.hdr_transfer == ColorTransfer_SMPTE2084) {
+            const float m1 = 0.1593017578125f, m2 = 78.84375f, c1 = 0.8359375f, c2 = 18.8515625f, c3 = 18.6875f;
+            float ep = powf(e, 1.0f / m2);
+            lin[c] = 10000.0f * powf(fmaxf(ep - c1, 0.0f) / (c2 - c3 * ep), 1.0f / m1);
+        } else {
+            const float a = 0.17883277f, b = 0.28466892f, cc = 0.55991073f;
+            lin[c] = e <= 0.5f ? e * e / 3.0f : (expf((e - cc) / a) + b) / 12.0f;
+        }
+    }
+    if (params.hdr_transfer == ColorTransfer_HLG) {
+        // OOTF of a 1000 cd/m2 display: system gamma 1.2 on the scene luminance
+        float ys = 0.2627f * lin[0] + 0.6780f * lin[1] + 0.0593f * lin[2];
+        float gain = peak * powf(fmaxf(ys, 1e-6f), 0.2f);
+        lin[0] *= gain; lin[1] *= gain; lin[2] *= gain;
+    }
+    if (params.bt2020_to_bt709) {
+        float r = lin[0], g = lin[1], b = lin[2];
+        lin[0] = 1.6605f * r - 0.5876f * g - 0.0728f * b;
+        lin[1] = -0.1246f * r + 1.1329f * g - 0.0083f * b;
+        lin[2] = -0.0182f * r - 0.1006f * g + 1.1187f * b;
+    }
+    const float max_rel = peak / ref_white;
+    for (int c = 0; c < 3; c++) {
+        float x = fmaxf(lin[c], 0.0f) / ref_white;
+        x = x * (1.0f + x / (max_rel * max_rel)) / (1.0f + x);     // extended Reinhard: reference white stays below 1, the peak maps to 1
+        rgb[c] = powf(fminf(x, 1.0f), 1.0f / 2.4f) * params.max_value;
+    }
+}
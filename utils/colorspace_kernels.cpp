@@ -20,64 +20,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
 
+#include <atomic>
+#include <type_traits>
 #include "colorspace_kernels.h"
 #include "roc_video_dec.h"
  
-__constant__ float yuv_to_rgb_mat[3][3];
 __constant__ float rgb_to_yuv_mat[3][3];
 
 
-void inline GetColMatCoefficients(int col_standard, float &wr, float &wb, int &black, int &white, int &max) {
-    black = 16; white = 235;
-    max = 255;
-
-    switch (col_standard)
-    {
-    case ColorSpaceStandard_BT709:
-    default:
-        wr = 0.2126f; wb = 0.0722f;
-        break;
-
-    case ColorSpaceStandard_FCC:
-        wr = 0.30f; wb = 0.11f;
-        break;
-
-    case ColorSpaceStandard_BT470:
-    case ColorSpaceStandard_BT601:
-        wr = 0.2990f; wb = 0.1140f;
-        break;
-
-    case ColorSpaceStandard_SMPTE240M:
-        wr = 0.212f; wb = 0.087f;
-        break;
-
-    case ColorSpaceStandard_BT2020:
-    case ColorSpaceStandard_BT2020C:
-        wr = 0.2627f; wb = 0.0593f;
-        // 10-bit only
-        black = 64 << 6; white = 940 << 6;
-        max = (1 << 16) - 1;
-        break;
-    }
-}
-
-void SetMatYuv2Rgb(int col_standard) {
-    float wr, wb;
-    int black, white, max;
-    GetColMatCoefficients(col_standard, wr, wb, black, white, max);
-    float mat[3][3] = {
-        1.0f, 0.0f, (1.0f - wr) / 0.5f,
-        1.0f, -wb * (1.0f - wb) / 0.5f / (1 - wb - wr), -wr * (1 - wr) / 0.5f / (1 - wb - wr),
-        1.0f, (1.0f - wb) / 0.5f, 0.0f,
-    };
-    for (int i = 0; i < 3; i++) {
-        for (int j = 0; j < 3; j++) {
-            mat[i][j] = (float)(1.0 * max / (white - black) * mat[i][j]);
-        }
-    }
-    HIP_API_CALL(hipMemcpyToSymbol(yuv_to_rgb_mat, mat, sizeof(mat)));
-}
-
 void SetMatRgb2Yuv(int col_standard) {
     float wr, wb;
     int black, white, max;
@@ -101,16 +51,13 @@ __device__ static T Clamp(T x, T lower, T upper) {
 }
 
 template<class Rgb, class YuvUnit>
-__device__ inline Rgb YuvToRgbForPixel(YuvUnit y, YuvUnit u, YuvUnit v) {
-    const int 
-        low = 1 << (sizeof(YuvUnit) * 8 - 4),
-        mid = 1 << (sizeof(YuvUnit) * 8 - 1);
-    float fy = (int)y - low, fu = (int)u - mid, fv = (int)v - mid;
-    const float maxf = (1 << sizeof(YuvUnit) * 8) - 1.0f;
+__device__ inline Rgb YuvToRgbForPixel(const YuvToRgbParams &params, YuvUnit y, YuvUnit u, YuvUnit v) {
+    float frgb[3];
+    YuvToRgbFloat(params, y, u, v, frgb);
     YuvUnit 
-        r = (YuvUnit)Clamp(yuv_to_rgb_mat[0][0] * fy + yuv_to_rgb_mat[0][1] * fu + yuv_to_rgb_mat[0][2] * fv, 0.0f, maxf),
-        g = (YuvUnit)Clamp(yuv_to_rgb_mat[1][0] * fy + yuv_to_rgb_mat[1][1] * fu + yuv_to_rgb_mat[1][2] * fv, 0.0f, maxf),
-        b = (YuvUnit)Clamp(yuv_to_rgb_mat[2][0] * fy + yuv_to_rgb_mat[2][1] * fu + yuv_to_rgb_mat[2][2] * fv, 0.0f, maxf);
+        r = (YuvUnit)frgb[0],
+        g = (YuvUnit)frgb[1],
+        b = (YuvUnit)frgb[2];
     
     Rgb rgb{};
     const int nShift = abs((int)sizeof(YuvUnit) - (int)sizeof(rgb.c.r)) * 8;
@@ -128,7 +75,7 @@ __device__ inline Rgb YuvToRgbForPixel(YuvUnit y, YuvUnit u, YuvUnit v) {
 
 // yuv to RGBA (32/64 bit)
 template<class YuvUnitx2, class Rgb, class RgbIntx2>
-__global__ static void YuvToRgbaKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgb, int rgb_pitch, int width, int height, int v_pitch) {
+__global__ static void YuvToRgbaKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgb, int rgb_pitch, int width, int height, int v_pitch, YuvToRgbParams params) {
     int x = (threadIdx.x + blockIdx.x * blockDim.x) * 2;
     int y = (threadIdx.y + blockIdx.y * blockDim.y) * 2;
     if (x + 1 >= width || y + 1 >= height) {
@@ -143,18 +90,18 @@ __global__ static void YuvToRgbaKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *
     YuvUnitx2 ch = *(YuvUnitx2 *)(p_src + (v_pitch - y / 2) * yuv_pitch);
 
     *(RgbIntx2 *)p_dst = RgbIntx2 {
-        YuvToRgbForPixel<Rgb>(l0.x, ch.x, ch.y).d,
-        YuvToRgbForPixel<Rgb>(l0.y, ch.x, ch.y).d,
+        YuvToRgbForPixel<Rgb>(params, l0.x, ch.x, ch.y).d,
+        YuvToRgbForPixel<Rgb>(params, l0.y, ch.x, ch.y).d,
     };
     *(RgbIntx2 *)(p_dst + rgb_pitch) = RgbIntx2 {
-        YuvToRgbForPixel<Rgb>(l1.x, ch.x, ch.y).d, 
-        YuvToRgbForPixel<Rgb>(l1.y, ch.x, ch.y).d,
+        YuvToRgbForPixel<Rgb>(params, l1.x, ch.x, ch.y).d, 
+        YuvToRgbForPixel<Rgb>(params, l1.y, ch.x, ch.y).d,
     };
 }
 
 // yuv to RGB (24/48 bit)
 template<class YuvUnitx2, class Rgb, class RgbInt1, class RgbInt2>
-__global__ static void YuvToRgbKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgb, int rgb_pitch, int width, int height, int v_pitch) {
+__global__ static void YuvToRgbKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgb, int rgb_pitch, int width, int height, int v_pitch, YuvToRgbParams params) {
     int x = (threadIdx.x + blockIdx.x * blockDim.x) * 2;
     int y = (threadIdx.y + blockIdx.y * blockDim.y) * 2;
     if (x + 1 >= width || y + 1 >= height) {
@@ -168,10 +115,10 @@ __global__ static void YuvToRgbKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *d
     YuvUnitx2 l0 = *(YuvUnitx2 *)p_src;
     YuvUnitx2 l1 = *(YuvUnitx2 *)(p_src + yuv_pitch);
     YuvUnitx2 ch = *(YuvUnitx2 *)(p_src + (v_pitch - y / 2) * yuv_pitch);
-    Rgb rgb0 = YuvToRgbForPixel<Rgb>(l0.x, ch.x, ch.y),
-        rgb1 = YuvToRgbForPixel<Rgb>(l0.y, ch.x, ch.y),
-        rgb2 = YuvToRgbForPixel<Rgb>(l1.x, ch.x, ch.y),
-        rgb3 = YuvToRgbForPixel<Rgb>(l1.y, ch.x, ch.y);
+    Rgb rgb0 = YuvToRgbForPixel<Rgb>(params, l0.x, ch.x, ch.y),
+        rgb1 = YuvToRgbForPixel<Rgb>(params, l0.y, ch.x, ch.y),
+        rgb2 = YuvToRgbForPixel<Rgb>(params, l1.x, ch.x, ch.y),
+        rgb3 = YuvToRgbForPixel<Rgb>(params, l1.y, ch.x, ch.y);
 
     *(RgbInt1 *)p_dst = RgbInt1 { rgb0.v.x, rgb0.v.y, rgb0.v.z, rgb1.v.x };
     *(RgbInt2 *)(p_dst + sizeof(RgbInt1)) = RgbInt2 { rgb1.v.y, rgb1.v.z };
@@ -181,7 +128,7 @@ __global__ static void YuvToRgbKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *d
 
 // yuv444 to RGBA (32/64 bit)
 template<class YuvUnitx2, class Rgb, class RgbIntx2>
-__global__ static void Yuv444ToRgbaKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgb, int rgb_pitch, int width, int height, int v_pitch) {
+__global__ static void Yuv444ToRgbaKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgb, int rgb_pitch, int width, int height, int v_pitch, YuvToRgbParams params) {
     int x = (threadIdx.x + blockIdx.x * blockDim.x) * 2;
     int y = (threadIdx.y + blockIdx.y * blockDim.y);
     if (x + 1 >= width || y  >= height) {
@@ -196,14 +143,14 @@ __global__ static void Yuv444ToRgbaKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_
     YuvUnitx2 ch2 = *(YuvUnitx2 *)(p_src + (2 * v_pitch * yuv_pitch));
 
     *(RgbIntx2 *)p_dst = RgbIntx2{
-        YuvToRgbForPixel<Rgb>(l0.x, ch1.x, ch2.x).d,
-        YuvToRgbForPixel<Rgb>(l0.y, ch1.y, ch2.y).d,
+        YuvToRgbForPixel<Rgb>(params, l0.x, ch1.x, ch2.x).d,
+        YuvToRgbForPixel<Rgb>(params, l0.y, ch1.y, ch2.y).d,
     };
 }
 
 // yuv444 to RGB (24/48 bit)
 template<class YuvUnitx2, class Rgb, class RgbInt1, class RgbInt2>
-__global__ static void Yuv444ToRgbKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgb, int rgb_pitch, int width, int height, int v_pitch) {
+__global__ static void Yuv444ToRgbKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgb, int rgb_pitch, int width, int height, int v_pitch, YuvToRgbParams params) {
     int x = (threadIdx.x + blockIdx.x * blockDim.x) * 2;
     int y = (threadIdx.y + blockIdx.y * blockDim.y);
     if (x + 1 >= width || y  >= height) {
@@ -216,8 +163,8 @@ __global__ static void Yuv444ToRgbKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t
     YuvUnitx2 l0 = *(YuvUnitx2 *)p_src;
     YuvUnitx2 ch1 = *(YuvUnitx2 *)(p_src + (v_pitch * yuv_pitch));
     YuvUnitx2 ch2 = *(YuvUnitx2 *)(p_src + (2 * v_pitch * yuv_pitch));
-    Rgb rgb0 = YuvToRgbForPixel<Rgb>(l0.x, ch1.x, ch2.x),
-        rgb1 = YuvToRgbForPixel<Rgb>(l0.y, ch1.y, ch2.y);
+    Rgb rgb0 = YuvToRgbForPixel<Rgb>(params, l0.x, ch1.x, ch2.x),
+        rgb1 = YuvToRgbForPixel<Rgb>(params, l0.y, ch1.y, ch2.y);
 
     *(RgbInt1 *)p_dst = RgbInt1 { rgb0.v.x, rgb0.v.y, rgb0.v.z, rgb1.v.x };
     *(RgbInt2 *)(p_dst + sizeof(RgbInt1)) = RgbInt2 { rgb1.v.y, rgb1.v.z };
@@ -225,7 +172,7 @@ __global__ static void Yuv444ToRgbKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t
 
 
 template<class YuvUnitx2, class Rgb, class RgbUnitx2>
-__global__ static void YuvToRgbPlanarKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgbp, int nRgbpPitch, int width, int height, int v_pitch) {
+__global__ static void YuvToRgbPlanarKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgbp, int nRgbpPitch, int width, int height, int v_pitch, YuvToRgbParams params) {
     int x = (threadIdx.x + blockIdx.x * blockDim.x) * 2;
     int y = (threadIdx.y + blockIdx.y * blockDim.y) * 2;
     if (x + 1 >= width || y + 1 >= height) {
@@ -238,10 +185,10 @@ __global__ static void YuvToRgbPlanarKernel(uint8_t *dp_yuv, int yuv_pitch, uint
     YuvUnitx2 l1 = *(YuvUnitx2 *)(p_src + yuv_pitch);
     YuvUnitx2 ch = *(YuvUnitx2 *)(p_src + (v_pitch - y / 2) * yuv_pitch);
 
-    Rgb rgb0 = YuvToRgbForPixel<Rgb>(l0.x, ch.x, ch.y),
-        rgb1 = YuvToRgbForPixel<Rgb>(l0.y, ch.x, ch.y),
-        rgb2 = YuvToRgbForPixel<Rgb>(l1.x, ch.x, ch.y),
-        rgb3 = YuvToRgbForPixel<Rgb>(l1.y, ch.x, ch.y);
+    Rgb rgb0 = YuvToRgbForPixel<Rgb>(params, l0.x, ch.x, ch.y),
+        rgb1 = YuvToRgbForPixel<Rgb>(params, l0.y, ch.x, ch.y),
+        rgb2 = YuvToRgbForPixel<Rgb>(params, l1.x, ch.x, ch.y),
+        rgb3 = YuvToRgbForPixel<Rgb>(params, l1.y, ch.x, ch.y);
 
     uint8_t *p_dst = dp_rgbp + x * sizeof(RgbUnitx2) / 2 + y * nRgbpPitch;
     *(RgbUnitx2 *)p_dst = RgbUnitx2 {rgb0.v.x, rgb1.v.x};
@@ -255,7 +202,7 @@ __global__ static void YuvToRgbPlanarKernel(uint8_t *dp_yuv, int yuv_pitch, uint
 }
 
 template<class YuvUnitx2, class Rgb, class RgbUnitx2>
-__global__ static void Yuv444ToRgbPlanarKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgbp, int nRgbpPitch, int width, int height, int v_pitch) {
+__global__ static void Yuv444ToRgbPlanarKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgbp, int nRgbpPitch, int width, int height, int v_pitch, YuvToRgbParams params) {
     int x = (threadIdx.x + blockIdx.x * blockDim.x) * 2;
     int y = (threadIdx.y + blockIdx.y * blockDim.y);
     if (x + 1 >= width || y >= height) {
@@ -268,8 +215,8 @@ __global__ static void Yuv444ToRgbPlanarKernel(uint8_t *dp_yuv, int yuv_pitch, u
     YuvUnitx2 ch1 = *(YuvUnitx2 *)(p_src + (v_pitch * yuv_pitch));
     YuvUnitx2 ch2 = *(YuvUnitx2 *)(p_src + (2 * v_pitch * yuv_pitch));
 
-    Rgb rgb0 = YuvToRgbForPixel<Rgb>(l0.x, ch1.x, ch2.x),
-        rgb1 = YuvToRgbForPixel<Rgb>(l0.y, ch1.y, ch2.y);
+    Rgb rgb0 = YuvToRgbForPixel<Rgb>(params, l0.x, ch1.x, ch2.x),
+        rgb1 = YuvToRgbForPixel<Rgb>(params, l0.y, ch1.y, ch2.y);
 
 
     uint8_t *p_dst = dp_rgbp + x * sizeof(RgbUnitx2) / 2 + y * nRgbpPitch;
@@ -282,210 +229,356 @@ __global__ static void Yuv444ToRgbPlanarKernel(uint8_t *dp_yuv, int yuv_pitch, u
     *(RgbUnitx2 *)p_dst = RgbUnitx2{ rgb0.v.z, rgb1.v.z };
 }
 
+static std::atomic<int> color_convert_kernel(ColorConvertKernel_Tiled);
+
+void SetColorConvertKernel(ColorConvertKernel kernel) {
+    color_convert_kernel = kernel;
+}
+
+// pixels of a row converted by one thread of the tiled kernels
+#define TILE_WIDTH 8
+
+/**
+ * @brief Tiled 4:2:0 to packed RGB conversion: each thread converts TILE_WIDTH x 2 pixels with one 64/128-bit load per luma row and one for
+ *        the chroma row. The 32/64-bit outputs are written with 128-bit stores. The rows of 24/48-bit pixels of the block are staged in shared
+ *        memory and written with 128-bit stores by the whole block, instead of 3/6-byte stores that don't coalesce. The same pixels as
+ *        YuvToRgbKernel/YuvToRgbaKernel are written (even width and height) with the same values.
+ */
+template<class YuvUnit, class Rgb>
+__global__ static void YuvToRgbTileKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgb, int rgb_pitch, int width, int height, int v_pitch, YuvToRgbParams params) {
+    typedef typename std::conditional<sizeof(YuvUnit) == 1, uint2, uint4>::type YuvVector;   // TILE_WIDTH units
+    typedef decltype(Rgb::c.r) RgbUnit;
+    const bool staged = sizeof(Rgb) == 3 * sizeof(RgbUnit);
+    const int tile_bytes = TILE_WIDTH * sizeof(Rgb);
+    const int valid_width = width & ~1, valid_height = height & ~1;
+    int x = (threadIdx.x + blockIdx.x * blockDim.x) * TILE_WIDTH;
+    int y = (threadIdx.y + blockIdx.y * blockDim.y) * 2;
+    extern __shared__ uint4 rgb_rows[];     // 2 * blockDim.y rows of blockDim.x tiles of the 24/48-bit outputs
+
+    if (x < valid_width && y < valid_height) {
+        union {
+            YuvVector v;
+            YuvUnit u[TILE_WIDTH];
+        } l0, l1, ch;
+        uint8_t *p_src = dp_yuv + x * sizeof(YuvUnit) + y * yuv_pitch;
+        l0.v = *(YuvVector *)p_src;
+        l1.v = *(YuvVector *)(p_src + yuv_pitch);
+        ch.v = *(YuvVector *)(p_src + (v_pitch - y / 2) * yuv_pitch);
+        for (int row = 0; row < 2; row++) {
+            uint4 tile[(tile_bytes + sizeof(uint4) - 1) / sizeof(uint4)];
+            for (int i = 0; i < TILE_WIDTH; i++) {
+                YuvUnit luma = row ? l1.u[i] : l0.u[i];
+                reinterpret_cast<Rgb *>(tile)[i] = YuvToRgbForPixel<Rgb>(params, luma, ch.u[i & ~1], ch.u[i | 1]);
+            }
+            if (staged) {
+                uint8_t *p_stage = reinterpret_cast<uint8_t *>(rgb_rows) + (threadIdx.y * 2 + row) * blockDim.x * tile_bytes + threadIdx.x * tile_bytes;
+                // the tiles of 24/48 bytes are only 8-byte aligned
+                for (int k = 0; k < tile_bytes / (int)sizeof(uint2); k++) {
+                    reinterpret_cast<uint2 *>(p_stage)[k] = reinterpret_cast<uint2 *>(tile)[k];
+                }
+            } else if (x + TILE_WIDTH <= valid_width) {
+                uint4 *p_dst = reinterpret_cast<uint4 *>(dp_rgb + x * sizeof(Rgb) + (y + row) * rgb_pitch);
+                for (int k = 0; k < tile_bytes / (int)sizeof(uint4); k++) {
+                    p_dst[k] = tile[k];
+                }
+            } else {
+                Rgb *p_dst = reinterpret_cast<Rgb *>(dp_rgb + x * sizeof(Rgb) + (y + row) * rgb_pitch);
+                for (int i = 0; i < valid_width - x; i++) {
+                    p_dst[i] = reinterpret_cast<Rgb *>(tile)[i];
+                }
+            }
+        }
+    }
+    if (!staged) {
+        return;
+    }
+    // the block writes its staged rows with consecutive 128-bit stores
+    __syncthreads();
+    const int row_vectors = blockDim.x * tile_bytes / sizeof(uint4);
+    const int valid_row_bytes = valid_width * sizeof(Rgb);
+    for (int i = threadIdx.y * blockDim.x + threadIdx.x; i < row_vectors * 2 * (int)blockDim.y; i += blockDim.x * blockDim.y) {
+        int row = i / row_vectors, offset = (i % row_vectors) * sizeof(uint4) + blockIdx.x * blockDim.x * tile_bytes;
+        int dst_y = blockIdx.y * blockDim.y * 2 + row;
+        if (dst_y >= valid_height || offset >= valid_row_bytes) {
+            continue;
+        }
+        uint8_t *p_dst = dp_rgb + offset + dst_y * rgb_pitch;
+        if (offset + (int)sizeof(uint4) <= valid_row_bytes) {
+            *reinterpret_cast<uint4 *>(p_dst) = rgb_rows[i];
+        } else {
+            const uint8_t *p_stage = reinterpret_cast<const uint8_t *>(&rgb_rows[i]);
+            for (int k = 0; k < valid_row_bytes - offset; k++) {
+                p_dst[k] = p_stage[k];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Block shape of the tiled kernels for the current device: two rows of a 64-wide wavefront on gfx9 (GCN/CDNA), four rows of a
+ *        32-wide wavefront on the RDNA architectures
+ */
+static dim3 GetTileKernelBlock() {
+    static std::mutex mutex;
+    static std::unordered_map<int, dim3> device_blocks;
+    int device_id = 0;
+    HIP_API_CALL(hipGetDevice(&device_id));
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = device_blocks.find(device_id);
+    if (it != device_blocks.end()) {
+        return it->second;
+    }
+    hipDeviceProp_t hip_dev_prop;
+    HIP_API_CALL(hipGetDeviceProperties(&hip_dev_prop, device_id));
+    dim3 block = !strncmp(hip_dev_prop.gcnArchName, "gfx9", 4) ? dim3(64, 2) : dim3(32, 4);
+    device_blocks[device_id] = block;
+    return block;
+}
+
+/**
+ * @brief Launches YuvToRgbTileKernel if it is selected and the surfaces allow the vector accesses (16-byte aligned rows, and luma rows
+ *        readable up to a multiple of TILE_WIDTH pixels); returns false otherwise so the caller launches the 2x2 kernel
+ */
+template<class YuvUnit, class Rgb>
+static bool LaunchYuvToRgbTileKernel(uint8_t *dp_yuv, int yuv_pitch, uint8_t *dp_rgb, int rgb_pitch, int width, int height, int v_pitch,
+                                     const YuvToRgbParams &params, hipStream_t hip_stream) {
+    if (color_convert_kernel != ColorConvertKernel_Tiled || ((reinterpret_cast<uintptr_t>(dp_yuv) | reinterpret_cast<uintptr_t>(dp_rgb) |
+        static_cast<uintptr_t>(yuv_pitch) | static_cast<uintptr_t>(rgb_pitch)) & 15) ||
+        yuv_pitch < static_cast<int>(((width + TILE_WIDTH - 1) & ~(TILE_WIDTH - 1)) * sizeof(YuvUnit))) {
+        return false;
+    }
+    int tiles_x = ((width & ~1) + TILE_WIDTH - 1) / TILE_WIDTH, tiles_y = height / 2;
+    if (!tiles_x || !tiles_y) {
+        return true;
+    }
+    dim3 block = GetTileKernelBlock();
+    size_t stage_size = sizeof(Rgb) == 3 * sizeof(decltype(Rgb::c.r)) ? block.x * TILE_WIDTH * sizeof(Rgb) * block.y * 2 : 0;
+    YuvToRgbTileKernel<YuvUnit, Rgb>
+        <<<dim3((tiles_x + block.x - 1) / block.x, (tiles_y + block.y - 1) / block.y), block, stage_size, hip_stream>>>
+        (dp_yuv, yuv_pitch, dp_rgb, rgb_pitch, width, height, v_pitch, params);
+    return true;
+}
+
 template <class COLOR32>
-void Nv12ToColor32(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
-    YuvToRgbaKernel<uchar2, COLOR32, uint2>
-        <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_nv12, nv12_pitch, dp_bgra, bgra_pitch, width, height, v_pitch);
+void Nv12ToColor32(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 8);
+    if (!LaunchYuvToRgbTileKernel<uint8_t, COLOR32>(dp_nv12, nv12_pitch, dp_bgra, bgra_pitch, width, height, v_pitch, params, hip_stream)) {
+        YuvToRgbaKernel<uchar2, COLOR32, uint2>
+            <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
+            (dp_nv12, nv12_pitch, dp_bgra, bgra_pitch, width, height, v_pitch, params);
+    }
 }
 
 template <class COLOR64>
-void Nv12ToColor64(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
-    YuvToRgbaKernel<uchar2, COLOR64, ulonglong2>
-        <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_nv12, nv12_pitch, dp_bgra, bgra_pitch, width, height, v_pitch);
+void Nv12ToColor64(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 8);
+    if (!LaunchYuvToRgbTileKernel<uint8_t, COLOR64>(dp_nv12, nv12_pitch, dp_bgra, bgra_pitch, width, height, v_pitch, params, hip_stream)) {
+        YuvToRgbaKernel<uchar2, COLOR64, ulonglong2>
+            <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
+            (dp_nv12, nv12_pitch, dp_bgra, bgra_pitch, width, height, v_pitch, params);
+    }
 }
 
 template <class COLOR32>
-void YUV444ToColor32(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
+void YUV444ToColor32(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 8);
     Yuv444ToRgbaKernel<uchar2, COLOR32, uint2>
         <<<dim3((width + 63) / 32 / 2, (height + 3) / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_yuv_444, pitch, dp_bgra, bgra_pitch, width, height, v_pitch);
+        (dp_yuv_444, pitch, dp_bgra, bgra_pitch, width, height, v_pitch, params);
 }
 
 template <class COLOR64>
-void YUV444ToColor64(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
+void YUV444ToColor64(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 8);
     Yuv444ToRgbaKernel<uchar2, COLOR64, ulonglong2>
         <<<dim3((width + 63) / 32 / 2, (height + 3) / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_yuv_444, pitch, dp_bgra, bgra_pitch, width, height, v_pitch);
+        (dp_yuv_444, pitch, dp_bgra, bgra_pitch, width, height, v_pitch, params);
 }
 
 template <class COLOR32>
-void P016ToColor32(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
-    YuvToRgbaKernel<ushort2, COLOR32, uint2>
-        <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_p016, p016_pitch, dp_bgra, bgra_pitch, width, height, v_pitch);
+void P016ToColor32(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 16);
+    if (!LaunchYuvToRgbTileKernel<uint16_t, COLOR32>(dp_p016, p016_pitch, dp_bgra, bgra_pitch, width, height, v_pitch, params, hip_stream)) {
+        YuvToRgbaKernel<ushort2, COLOR32, uint2>
+            <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
+            (dp_p016, p016_pitch, dp_bgra, bgra_pitch, width, height, v_pitch, params);
+    }
 }
 
 template <class COLOR64>
-void P016ToColor64(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
-    YuvToRgbaKernel<ushort2, COLOR64, ulonglong2>
-        <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_p016, p016_pitch, dp_bgra, bgra_pitch, width, height, v_pitch);
+void P016ToColor64(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 16);
+    if (!LaunchYuvToRgbTileKernel<uint16_t, COLOR64>(dp_p016, p016_pitch, dp_bgra, bgra_pitch, width, height, v_pitch, params, hip_stream)) {
+        YuvToRgbaKernel<ushort2, COLOR64, ulonglong2>
+            <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
+            (dp_p016, p016_pitch, dp_bgra, bgra_pitch, width, height, v_pitch, params);
+    }
 }
 
 template <class COLOR32>
-void YUV444P16ToColor32(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
+void YUV444P16ToColor32(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 16);
     Yuv444ToRgbaKernel<ushort2, COLOR32, uint2>
         <<<dim3((width + 63) / 32 / 2, (height + 3) / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_yuv_444, pitch, dp_bgra, bgra_pitch, width, height, v_pitch);
+        (dp_yuv_444, pitch, dp_bgra, bgra_pitch, width, height, v_pitch, params);
 }
 
 template <class COLOR64>
-void YUV444P16ToColor64(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
+void YUV444P16ToColor64(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 16);
     Yuv444ToRgbaKernel<ushort2, COLOR64, ulonglong2>
         <<<dim3((width + 63) / 32 / 2, (height + 3) / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_yuv_444, pitch, dp_bgra, bgra_pitch, width, height, v_pitch);
+        (dp_yuv_444, pitch, dp_bgra, bgra_pitch, width, height, v_pitch, params);
 }
 
 template <class COLOR32>
-void Nv12ToColorPlanar(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
+void Nv12ToColorPlanar(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 8);
     YuvToRgbPlanarKernel<uchar2, COLOR32, uchar2>
         <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_nv12, nv12_pitch, dp_bgrp, nBgrpPitch, width, height, v_pitch);
+        (dp_nv12, nv12_pitch, dp_bgrp, nBgrpPitch, width, height, v_pitch, params);
 }
 
 template <class COLOR32>
-void P016ToColorPlanar(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
+void P016ToColorPlanar(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 16);
     YuvToRgbPlanarKernel<ushort2, COLOR32, uchar2>
         <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_p016, p016_pitch, dp_bgrp, nBgrpPitch, width, height, v_pitch);
+        (dp_p016, p016_pitch, dp_bgrp, nBgrpPitch, width, height, v_pitch, params);
 }
 
 template <class COLOR32>
-void YUV444ToColorPlanar(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
+void YUV444ToColorPlanar(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 8);
     Yuv444ToRgbPlanarKernel<uchar2, COLOR32, uchar2>
         <<<dim3((width + 63) / 32 / 2, (height + 3) / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_yuv_444, pitch, dp_bgrp, nBgrpPitch, width, height, v_pitch);
+        (dp_yuv_444, pitch, dp_bgrp, nBgrpPitch, width, height, v_pitch, params);
 }
 
 template <class COLOR32>
-void YUV444P16ToColorPlanar(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
+void YUV444P16ToColorPlanar(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 16);
     Yuv444ToRgbPlanarKernel<ushort2, COLOR32, uchar2>
         <<<dim3((width + 63) / 32 / 2, (height + 3) / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_yuv_444, pitch, dp_bgrp, nBgrpPitch, width, height, v_pitch);
+        (dp_yuv_444, pitch, dp_bgrp, nBgrpPitch, width, height, v_pitch, params);
 }
 
 // Explicit Instantiation: for RGB32/BGR32 and RGB64/BGR64 formats
-template void Nv12ToColor32<BGRA32>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void Nv12ToColor32<RGBA32>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void Nv12ToColor64<BGRA64>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void Nv12ToColor64<RGBA64>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444ToColor32<BGRA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444ToColor32<RGBA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444ToColor64<BGRA64>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444ToColor64<RGBA64>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void P016ToColor32<BGRA32>(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void P016ToColor32<RGBA32>(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void P016ToColor64<BGRA64>(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void P016ToColor64<RGBA64>(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444P16ToColor32<BGRA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444P16ToColor32<RGBA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444P16ToColor64<BGRA64>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444P16ToColor64<RGBA64>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void Nv12ToColorPlanar<BGRA32>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void Nv12ToColorPlanar<RGBA32>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void P016ToColorPlanar<BGRA32>(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void P016ToColorPlanar<RGBA32>(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444ToColorPlanar<BGRA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444ToColorPlanar<RGBA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444P16ToColorPlanar<BGRA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444P16ToColorPlanar<RGBA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+template void Nv12ToColor32<BGRA32>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void Nv12ToColor32<RGBA32>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void Nv12ToColor64<BGRA64>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void Nv12ToColor64<RGBA64>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444ToColor32<BGRA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444ToColor32<RGBA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444ToColor64<BGRA64>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444ToColor64<RGBA64>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void P016ToColor32<BGRA32>(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void P016ToColor32<RGBA32>(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void P016ToColor64<BGRA64>(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void P016ToColor64<RGBA64>(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444P16ToColor32<BGRA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444P16ToColor32<RGBA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444P16ToColor64<BGRA64>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444P16ToColor64<RGBA64>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void Nv12ToColorPlanar<BGRA32>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void Nv12ToColorPlanar<RGBA32>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void P016ToColorPlanar<BGRA32>(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void P016ToColorPlanar<RGBA32>(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444ToColorPlanar<BGRA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444ToColorPlanar<RGBA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444P16ToColorPlanar<BGRA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444P16ToColorPlanar<RGBA32>(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int nBgrpPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 
 template <class COLOR24>
-void Nv12ToColor24(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
-    YuvToRgbKernel<uchar2, COLOR24, uchar4, uchar2>
-        <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_nv12, nv12_pitch, dp_bgr, bgr_pitch, width, height, v_pitch);
+void Nv12ToColor24(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 8);
+    if (!LaunchYuvToRgbTileKernel<uint8_t, COLOR24>(dp_nv12, nv12_pitch, dp_bgr, bgr_pitch, width, height, v_pitch, params, hip_stream)) {
+        YuvToRgbKernel<uchar2, COLOR24, uchar4, uchar2>
+            <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
+            (dp_nv12, nv12_pitch, dp_bgr, bgr_pitch, width, height, v_pitch, params);
+    }
 }
 
 template <class COLOR48>
-void Nv12ToColor48(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
-    YuvToRgbKernel<uchar2, COLOR48, ushort4, ushort2>
-        <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_nv12, nv12_pitch, dp_bgr, bgr_pitch, width, height, v_pitch);
+void Nv12ToColor48(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 8);
+    if (!LaunchYuvToRgbTileKernel<uint8_t, COLOR48>(dp_nv12, nv12_pitch, dp_bgr, bgr_pitch, width, height, v_pitch, params, hip_stream)) {
+        YuvToRgbKernel<uchar2, COLOR48, ushort4, ushort2>
+            <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
+            (dp_nv12, nv12_pitch, dp_bgr, bgr_pitch, width, height, v_pitch, params);
+    }
 }
 
 template <class COLOR24>
-void YUV444ToColor24(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
+void YUV444ToColor24(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 8);
     Yuv444ToRgbKernel<uchar2, COLOR24, uchar4, uchar2>
         <<<dim3((width + 63) / 32 / 2, (height + 3) / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_yuv_444, pitch, dp_bgr, bgr_pitch, width, height, v_pitch);
+        (dp_yuv_444, pitch, dp_bgr, bgr_pitch, width, height, v_pitch, params);
 }
 
 template <class COLOR48>
-void YUV444ToColor48(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
+void YUV444ToColor48(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 8);
     Yuv444ToRgbKernel<uchar2, COLOR48, ushort4, ushort2>
         <<<dim3((width + 63) / 32 / 2, (height + 3) / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_yuv_444, pitch, dp_bgr, bgr_pitch, width, height, v_pitch);
+        (dp_yuv_444, pitch, dp_bgr, bgr_pitch, width, height, v_pitch, params);
 }
 
 template <class COLOR24>
-void P016ToColor24(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
-    YuvToRgbKernel<ushort2, COLOR24, uchar4, uchar2>
-        <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_p016, p016_pitch, dp_bgr, bgr_pitch, width, height, v_pitch);
+void P016ToColor24(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 16);
+    if (!LaunchYuvToRgbTileKernel<uint16_t, COLOR24>(dp_p016, p016_pitch, dp_bgr, bgr_pitch, width, height, v_pitch, params, hip_stream)) {
+        YuvToRgbKernel<ushort2, COLOR24, uchar4, uchar2>
+            <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
+            (dp_p016, p016_pitch, dp_bgr, bgr_pitch, width, height, v_pitch, params);
+    }
 }
 
 template <class COLOR48>
-void P016ToColor48(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
-    YuvToRgbKernel<ushort2, COLOR48, ushort4, ushort2>
-        <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_p016, p016_pitch, dp_bgr, bgr_pitch, width, height, v_pitch);
+void P016ToColor48(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 16);
+    if (!LaunchYuvToRgbTileKernel<uint16_t, COLOR48>(dp_p016, p016_pitch, dp_bgr, bgr_pitch, width, height, v_pitch, params, hip_stream)) {
+        YuvToRgbKernel<ushort2, COLOR48, ushort4, ushort2>
+            <<<dim3((width + 63) / 32 / 2, (height + 3) / 2 / 2), dim3(32, 2), 0, hip_stream>>>
+            (dp_p016, p016_pitch, dp_bgr, bgr_pitch, width, height, v_pitch, params);
+    }
 }
 
 template <class COLOR24>
-void YUV444P16ToColor24(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
+void YUV444P16ToColor24(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 16);
     Yuv444ToRgbKernel<ushort2, COLOR24, uchar4, uchar2>
         <<<dim3((width + 63) / 32 / 2, (height + 3) / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_yuv_444, pitch, dp_bgra, bgra_pitch, width, height, v_pitch);
+        (dp_yuv_444, pitch, dp_bgra, bgra_pitch, width, height, v_pitch, params);
 }
 
 template <class COLOR48>
-void YUV444P16ToColor48(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream) {
-    SetMatYuv2Rgb(col_standard);
+void YUV444P16ToColor48(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    YuvToRgbParams params = GetYuvToRgbParams(color_info, 16);
     Yuv444ToRgbKernel<ushort2, COLOR48, ushort4, ushort2>
         <<<dim3((width + 63) / 32 / 2, (height + 3) / 2), dim3(32, 2), 0, hip_stream>>>
-        (dp_yuv_444, pitch, dp_bgr, bgr_pitch, width, height, v_pitch);
+        (dp_yuv_444, pitch, dp_bgr, bgr_pitch, width, height, v_pitch, params);
 }
 
 
 // Explicit Instantiation: for RGB24/BGR24 and RGB48/BGR48 formats
-template void Nv12ToColor24<BGR24>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void Nv12ToColor24<RGB24>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void Nv12ToColor48<BGR48>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void Nv12ToColor48<RGB48>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444ToColor24<BGR24>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444ToColor24<RGB24>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444ToColor48<BGR48>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444ToColor48<RGB48>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void P016ToColor24<BGR24>(uint8_t *dp_p016, int p016_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void P016ToColor24<RGB24>(uint8_t *dp_p016, int p016_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void P016ToColor48<BGR48>(uint8_t *dp_p016, int p016_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void P016ToColor48<RGB48>(uint8_t *dp_p016, int p016_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444P16ToColor24<BGR24>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444P16ToColor24<RGB24>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444P16ToColor48<BGR48>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
-template void YUV444P16ToColor48<RGB48>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+template void Nv12ToColor24<BGR24>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void Nv12ToColor24<RGB24>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void Nv12ToColor48<BGR48>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void Nv12ToColor48<RGB48>(uint8_t *dp_nv12, int nv12_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444ToColor24<BGR24>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444ToColor24<RGB24>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444ToColor48<BGR48>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444ToColor48<RGB48>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void P016ToColor24<BGR24>(uint8_t *dp_p016, int p016_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void P016ToColor24<RGB24>(uint8_t *dp_p016, int p016_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void P016ToColor48<BGR48>(uint8_t *dp_p016, int p016_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void P016ToColor48<RGB48>(uint8_t *dp_p016, int p016_pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444P16ToColor24<BGR24>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444P16ToColor24<RGB24>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444P16ToColor48<BGR48>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template void YUV444P16ToColor48<RGB48>(uint8_t *dp_yuv_444, int pitch, uint8_t *p_bgr, int p_bgrPitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 
 
 template<class YuvUnit, class RgbUnit>
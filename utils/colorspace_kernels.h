@@ -24,6 +24,7 @@ THE SOFTWARE.
 #pragma once
 #include <stdint.h>
 #include <hip/hip_runtime.h>
+#include "colorspace_info.h"
 
 /*!
  * \file
@@ -33,19 +34,6 @@ THE SOFTWARE.
  * \brief AMD The vcnDECODE Color Space API.
  */
 
-typedef enum ColorSpaceStandard_ {
-    ColorSpaceStandard_BT709 = 1,
-    ColorSpaceStandard_Unspecified = 2,
-    ColorSpaceStandard_Reserved = 3,
-    ColorSpaceStandard_FCC = 4,
-    ColorSpaceStandard_BT470 = 5,
-    ColorSpaceStandard_BT601 = 6,
-    ColorSpaceStandard_SMPTE240M = 7,
-    ColorSpaceStandard_YCgCo = 8,
-    ColorSpaceStandard_BT2020 = 9,
-    ColorSpaceStandard_BT2020C = 10
-} ColorSpaceStandard;
-
 union BGR24 {
     uchar3 v;
     struct {
@@ -106,38 +94,58 @@ union RGBA64 {
     } c;
 };
 
+typedef enum ColorConvertKernel_ {
+    ColorConvertKernel_Tiled = 0,       // 8x2 pixels per thread with 128-bit accesses (default); the 2x2 kernels are used for unaligned surfaces
+    ColorConvertKernel_Pixel2x2 = 1,    // one 2x2 pixel block per thread
+} ColorConvertKernel;
+
+/**
+ * @brief Selects the kernels of the NV12/P016 to packed RGB conversions (Nv12ToColor* and P016ToColor*) of the process, e.g. for benchmarking
+ */
+void SetColorConvertKernel(ColorConvertKernel kernel);
+
 // color-convert hip kernel function definitions
 template <class COLOR32>
-void YUV444ToColor32(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void YUV444ToColor32(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR64>
-void YUV444ToColor64(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void YUV444ToColor64(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR24>
-void YUV444ToColor24(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void YUV444ToColor24(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR48>
-void YUV444ToColor48(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void YUV444ToColor48(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 
 template <class COLOR24>
-void Nv12ToColor24(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void Nv12ToColor24(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR32>
-void Nv12ToColor32(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void Nv12ToColor32(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR48>
-void Nv12ToColor48(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void Nv12ToColor48(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR64>
-void Nv12ToColor64(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void Nv12ToColor64(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR24>
-void YUV444P16ToColor24(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void YUV444P16ToColor24(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR48>
-void YUV444P16ToColor48(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void YUV444P16ToColor48(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR32>
-void YUV444P16ToColor32(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void YUV444P16ToColor32(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR64>
-void YUV444P16ToColor64(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void YUV444P16ToColor64(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR32>
-void P016ToColor32(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void P016ToColor32(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR64>
-void P016ToColor64(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void P016ToColor64(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR24>
-void P016ToColor24(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void P016ToColor24(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 template <class COLOR48>
-void P016ToColor48(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, int col_standard, hipStream_t hip_stream);
+void P016ToColor48(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+
+// planar 8-bit outputs: the three color planes of bgrp_pitch x height bytes follow each other (B, G, R for BGRA32; R, G, B for RGBA32)
+template <class COLOR32>
+void Nv12ToColorPlanar(uint8_t *dp_nv12, int nv12_pitch, uint8_t *dp_bgrp, int bgrp_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template <class COLOR32>
+void P016ToColorPlanar(uint8_t *dp_p016, int p016_pitch, uint8_t *dp_bgrp, int bgrp_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template <class COLOR32>
+void YUV444ToColorPlanar(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int bgrp_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+template <class COLOR32>
+void YUV444P16ToColorPlanar(uint8_t *dp_yuv_444, int pitch, uint8_t *dp_bgrp, int bgrp_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
 
@@ -0,0 +1,720 @@
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <algorithm>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "rocdecode.h"
+
+/*!
+ * \file
+ * \brief Native elementary stream demuxer for rocDecode samples.
+ *
+ * Splits raw Annex-B H.264/HEVC streams, IVF files and AV1 low overhead bitstream format (Section 5) and length delimited
+ * (Annex B) OBU streams into access units / temporal units without libavformat. The input is memory mapped (or provided by the user) and the returned
+ * packets point directly into it, so no memory is allocated or copied per packet.
+ */
+
+/**
+ * @brief Enum for the elementary stream type
+ *
+ */
+typedef enum ElementaryStreamTypeEnum {
+    ES_TYPE_UNKNOWN = 0,
+    ES_TYPE_ANNEXB_AVC = 1,         /**< H.264 byte stream (Annex B) */
+    ES_TYPE_ANNEXB_HEVC = 2,        /**< HEVC byte stream (Annex B) */
+    ES_TYPE_IVF = 3,                /**< IVF container (AV1) */
+    ES_TYPE_OBU = 4,                /**< AV1 low overhead bitstream format (Section 5) */
+    ES_TYPE_OBU_ANNEXB = 5,         /**< AV1 length delimited bitstream format (Annex B); the parser needs RocdecParserParams::annex_b */
+} ElementaryStreamType;
+
+class ElementaryStreamDemuxer {
+    public:
+        /**
+         * @brief Construct a demuxer on a memory mapped elementary stream file. The stream type is detected from the
+         *        file extension and the content.
+         */
+        ElementaryStreamDemuxer(const char *input_file_path) {
+            int fd = open(input_file_path, O_RDONLY);
+            if (fd < 0) {
+                std::cerr << "ERROR: failed to open " << input_file_path << std::endl;
+                return;
+            }
+            struct stat file_stat;
+            if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+                std::cerr << "ERROR: failed to get the size of " << input_file_path << std::endl;
+                close(fd);
+                return;
+            }
+            void *addr = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            close(fd);
+            if (addr == MAP_FAILED) {
+                std::cerr << "ERROR: mmap failed for " << input_file_path << std::endl;
+                return;
+            }
+            madvise(addr, file_stat.st_size, MADV_SEQUENTIAL);
+            data_ = static_cast<const uint8_t *>(addr);
+            data_size_ = file_stat.st_size;
+            is_mapped_ = true;
+            Init(DetectStreamType(input_file_path));
+        }
+
+        /**
+         * @brief Construct a demuxer on a user buffer holding the whole elementary stream; the buffer has to stay valid for the lifetime of the demuxer
+         */
+        ElementaryStreamDemuxer(const uint8_t *data, size_t data_size, ElementaryStreamType stream_type = ES_TYPE_UNKNOWN) : data_(data), data_size_(data_size) {
+            Init(stream_type != ES_TYPE_UNKNOWN ? stream_type : DetectStreamType(nullptr));
+        }
+
+        ~ElementaryStreamDemuxer() {
+            if (is_mapped_ && data_) {
+                munmap(const_cast<uint8_t *>(data_), data_size_);
+            }
+        }
+
+        /**
+         * @brief Returns the next access unit (H.264/HEVC) or temporal unit (AV1). The returned pointer points into the input and stays valid for the lifetime of the demuxer.
+         *
+         * @param video - pointer to the packet data
+         * @param video_size - packet size in bytes; 0 at the end of the stream
+         * @param pts - presentation timestamp in milliseconds (derived from the frame index when the stream doesn't carry timestamps)
+         * @return true - a packet is returned
+         * @return false - end of stream or error
+         */
+        bool Demux(uint8_t **video, int *video_size, int64_t *pts = nullptr) {
+            *video_size = 0;
+            if (!data_ || offset_ >= data_size_) {
+                return false;
+            }
+            size_t unit_start = offset_, unit_end = 0;
+            int64_t unit_pts = frame_count_ * 1000 / frame_rate_;
+            switch (stream_type_) {
+                case ES_TYPE_ANNEXB_AVC:
+                case ES_TYPE_ANNEXB_HEVC:
+                    unit_end = FindAccessUnitEnd(offset_);
+                    break;
+                case ES_TYPE_IVF: {
+                    if (data_size_ - offset_ < kIvfFrameHeaderSize) {
+                        return false;
+                    }
+                    uint32_t frame_size = ReadLe32(data_ + offset_);
+                    unit_pts = static_cast<int64_t>(ReadLe64(data_ + offset_ + 4)) * ivf_timebase_num_ * 1000 / ivf_timebase_den_;
+                    unit_start = offset_ + kIvfFrameHeaderSize;
+                    unit_end = unit_start + frame_size;
+                    if (unit_end > data_size_) {
+                        std::cerr << "ERROR: truncated IVF frame" << std::endl;
+                        unit_end = data_size_;
+                    }
+                    break;
+                }
+                case ES_TYPE_OBU:
+                    unit_end = FindTemporalUnitEnd(offset_);
+                    break;
+                case ES_TYPE_OBU_ANNEXB: {
+                    // The packet is the whole temporal_unit(), including temporal_unit_size
+                    uint64_t temporal_unit_size;
+                    size_t num_bytes;
+                    if (!ReadLeb128(offset_, temporal_unit_size, num_bytes)) {
+                        return false;
+                    }
+                    unit_end = offset_ + num_bytes + temporal_unit_size;
+                    if (unit_end > data_size_) {
+                        std::cerr << "ERROR: truncated temporal unit" << std::endl;
+                        unit_end = data_size_;
+                    }
+                    break;
+                }
+                default:
+                    return false;
+            }
+            if (unit_end <= unit_start) {
+                offset_ = data_size_;
+                return false;
+            }
+            *video = const_cast<uint8_t *>(data_ + unit_start);
+            *video_size = static_cast<int>(unit_end - unit_start);
+            if (pts) {
+                *pts = unit_pts;
+            }
+            offset_ = unit_end;
+            frame_count_++;
+            return true;
+        }
+
+        /**
+         * @brief Returns the elementary stream data without the access unit splitting (Annex-B and OBU streams only), e.g. to feed a
+         *        byte stream mode parser with arbitrary chunks
+         *
+         * @param size - size of the stream data in bytes
+         * @return pointer to the first byte of the stream; nullptr for IVF files
+         */
+        const uint8_t *GetStreamData(size_t *size) const {
+            if (!data_ || stream_type_ == ES_TYPE_IVF) {
+                *size = 0;
+                return nullptr;
+            }
+            *size = data_size_ - first_unit_offset_;
+            return data_ + first_unit_offset_;
+        }
+
+        bool IsValid() const { return data_ != nullptr && stream_type_ != ES_TYPE_UNKNOWN; }
+        ElementaryStreamType GetStreamType() const { return stream_type_; }
+        rocDecVideoCodec GetCodecID() const { return codec_id_; }
+        const uint32_t GetWidth() const { return width_; }
+        const uint32_t GetHeight() const { return height_; }
+        const uint32_t GetBitDepth() const { return bit_depth_; }
+        const double GetFrameRate() const { return frame_rate_; }
+        void Rewind() { offset_ = first_unit_offset_; frame_count_ = 0; }
+
+    private:
+        static const size_t kMaxHeaderSize = 256;
+        static const size_t kIvfFileHeaderSize = 32;
+        static const size_t kIvfFrameHeaderSize = 12;
+        static const uint8_t kObuSequenceHeader = 1;
+        static const uint8_t kObuTemporalDelimiter = 2;
+        static const uint32_t kDefaultFrameRate = 25;   // same default as the FFmpeg raw demuxers
+
+        void Init(ElementaryStreamType stream_type) {
+            stream_type_ = stream_type;
+            switch (stream_type_) {
+                case ES_TYPE_ANNEXB_AVC:
+                    codec_id_ = rocDecVideoCodec_AVC;
+                    break;
+                case ES_TYPE_ANNEXB_HEVC:
+                    codec_id_ = rocDecVideoCodec_HEVC;
+                    break;
+                case ES_TYPE_IVF: {
+                    if (data_size_ < kIvfFileHeaderSize) {
+                        std::cerr << "ERROR: invalid IVF file header" << std::endl;
+                        stream_type_ = ES_TYPE_UNKNOWN;
+                        return;
+                    }
+                    uint32_t fourcc = ReadLe32(data_ + 8);
+                    if (fourcc == ReadLe32(reinterpret_cast<const uint8_t *>("AV01"))) {
+                        codec_id_ = rocDecVideoCodec_AV1;
+                    } else if (fourcc == ReadLe32(reinterpret_cast<const uint8_t *>("VP90"))) {
+                        codec_id_ = rocDecVideoCodec_VP9;
+                    } else if (fourcc == ReadLe32(reinterpret_cast<const uint8_t *>("VP80"))) {
+                        codec_id_ = rocDecVideoCodec_VP8;
+                    }
+                    width_ = data_[12] | (data_[13] << 8);
+                    height_ = data_[14] | (data_[15] << 8);
+                    ivf_timebase_den_ = ReadLe32(data_ + 16);
+                    ivf_timebase_num_ = ReadLe32(data_ + 20);
+                    if (!ivf_timebase_den_ || !ivf_timebase_num_) {
+                        ivf_timebase_den_ = kDefaultFrameRate;
+                        ivf_timebase_num_ = 1;
+                    }
+                    frame_rate_ = static_cast<double>(ivf_timebase_den_) / ivf_timebase_num_;
+                    offset_ = std::min(static_cast<size_t>(data_[6] | (data_[7] << 8)), data_size_);
+                    break;
+                }
+                case ES_TYPE_OBU:
+                case ES_TYPE_OBU_ANNEXB:
+                    codec_id_ = rocDecVideoCodec_AV1;
+                    break;
+                default:
+                    std::cerr << "ERROR: unsupported elementary stream" << std::endl;
+                    return;
+            }
+            first_unit_offset_ = offset_;
+            ParseSequenceInfo();
+        }
+
+        /**
+         * @brief Detects the stream type from the file extension, then from the content
+         */
+        ElementaryStreamType DetectStreamType(const char *input_file_path) {
+            if (data_size_ >= 4 && !memcmp(data_, "DKIF", 4)) {
+                return ES_TYPE_IVF;
+            }
+            if (input_file_path) {
+                std::string ext(input_file_path);
+                size_t pos = ext.find_last_of('.');
+                ext = (pos != std::string::npos) ? ext.substr(pos + 1) : "";
+                std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+                if (ext == "264" || ext == "h264" || ext == "avc" || ext == "26l" || ext == "jsv") {
+                    return ES_TYPE_ANNEXB_AVC;
+                }
+                if (ext == "265" || ext == "h265" || ext == "hevc" || ext == "bit" || ext == "bin") {
+                    return ES_TYPE_ANNEXB_HEVC;
+                }
+                if (ext == "obu" || ext == "av1") {
+                    return IsAv1AnnexB() ? ES_TYPE_OBU_ANNEXB : ES_TYPE_OBU;
+                }
+            }
+            // AV1 Section 5 streams start with a temporal delimiter OBU (0x12 0x00)
+            if (data_size_ >= 2 && data_[0] == 0x12 && data_[1] == 0x00) {
+                return ES_TYPE_OBU;
+            }
+            if (IsAv1AnnexB()) {
+                return ES_TYPE_OBU_ANNEXB;
+            }
+            size_t sc = FindStartCode(0);
+            if (sc + 4 < data_size_) {
+                const uint8_t *nal = data_ + sc + 3;
+                uint8_t hevc_nal_type = (nal[0] >> 1) & 0x3F;
+                if ((nal[0] & 0x81) == 0 && (nal[1] & 0x07) != 0 && hevc_nal_type >= 32 && hevc_nal_type <= 40) {
+                    return ES_TYPE_ANNEXB_HEVC;
+                }
+                return ES_TYPE_ANNEXB_AVC;
+            }
+            return ES_TYPE_UNKNOWN;
+        }
+
+        /**
+         * @brief Returns the offset of the next 0x000001 start code at or after pos, or data_size_ if none
+         */
+        size_t FindStartCode(size_t pos) const {
+            while (pos + 2 < data_size_) {
+                if (data_[pos + 2] > 1) {
+                    pos += 3;
+                } else if (data_[pos + 2] == 1 && data_[pos + 1] == 0 && data_[pos] == 0) {
+                    return pos;
+                } else {
+                    pos++;
+                }
+            }
+            return data_size_;
+        }
+
+        /**
+         * @brief Returns true if the NAL unit starts a new access unit when the current one already contains a VCL NAL unit
+         *        (H.264 7.4.1.2.3, HEVC 7.4.2.4.4)
+         */
+        bool IsFirstNalOfAccessUnit(const uint8_t *nal, size_t nal_size, bool &is_vcl) const {
+            is_vcl = false;
+            if (stream_type_ == ES_TYPE_ANNEXB_HEVC) {
+                if (nal_size < 3) {
+                    return false;
+                }
+                uint8_t nal_type = (nal[0] >> 1) & 0x3F;
+                if (nal_type < 32) {
+                    is_vcl = true;
+                    return (nal[2] & 0x80) != 0;     // first_slice_segment_in_pic_flag
+                }
+                return (nal_type >= 32 && nal_type <= 35) || nal_type == 39 || (nal_type >= 41 && nal_type <= 44) || (nal_type >= 48 && nal_type <= 55);
+            } else {
+                if (nal_size < 2) {
+                    return false;
+                }
+                uint8_t nal_type = nal[0] & 0x1F;
+                if (nal_type >= 1 && nal_type <= 5) {
+                    is_vcl = true;
+                    return (nal[1] & 0x80) != 0;     // first_mb_in_slice == 0
+                }
+                return (nal_type >= 6 && nal_type <= 9) || (nal_type >= 14 && nal_type <= 18);
+            }
+        }
+
+        size_t FindAccessUnitEnd(size_t pos) const {
+            bool has_vcl = false;
+            size_t sc = FindStartCode(pos);
+            while (sc < data_size_) {
+                size_t next_sc = FindStartCode(sc + 3);
+                bool is_vcl = false;
+                bool is_first = IsFirstNalOfAccessUnit(data_ + sc + 3, next_sc - sc - 3, is_vcl);
+                if (has_vcl && is_first) {
+                    // keep the leading zero byte of a 4-byte start code with the next access unit
+                    return (sc > pos && data_[sc - 1] == 0) ? sc - 1 : sc;
+                }
+                has_vcl |= is_vcl;
+                sc = next_sc;
+            }
+            return data_size_;
+        }
+
+        /**
+         * @brief Reads the leb128 value at pos; returns false if it is truncated or longer than 8 bytes
+         */
+        bool ReadLeb128(size_t pos, uint64_t &value, size_t &num_bytes) const {
+            value = 0;
+            for (size_t i = 0; i < 8 && pos + i < data_size_; i++) {
+                value |= static_cast<uint64_t>(data_[pos + i] & 0x7F) << (i * 7);
+                if (!(data_[pos + i] & 0x80)) {
+                    num_bytes = i + 1;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Returns true if the stream starts with a length delimited (Annex B) temporal unit: a frame unit of the temporal
+         *        unit size holding a temporal delimiter OBU of its obu_length
+         */
+        bool IsAv1AnnexB() const {
+            uint64_t temporal_unit_size, frame_unit_size, obu_length;
+            size_t n0, n1, n2;
+            if (!ReadLeb128(0, temporal_unit_size, n0) || !ReadLeb128(n0, frame_unit_size, n1) || !ReadLeb128(n0 + n1, obu_length, n2)) {
+                return false;
+            }
+            size_t obu_pos = n0 + n1 + n2;
+            if (temporal_unit_size > data_size_ - n0 || n1 > temporal_unit_size || frame_unit_size > temporal_unit_size - n1 ||
+                n2 > frame_unit_size || obu_length == 0 || obu_length > frame_unit_size - n2 || obu_pos >= data_size_) {
+                return false;
+            }
+            // obu_forbidden_bit is 0 and the first OBU is a temporal delimiter
+            return (data_[obu_pos] & 0x80) == 0 && ((data_[obu_pos] >> 3) & 0x0F) == kObuTemporalDelimiter;
+        }
+
+        /**
+         * @brief Reads the OBU header at pos; returns false if the OBU is truncated
+         */
+        bool ReadObuHeader(size_t pos, uint8_t &obu_type, size_t &header_size, size_t &obu_size) const {
+            if (pos >= data_size_) {
+                return false;
+            }
+            obu_type = (data_[pos] >> 3) & 0x0F;
+            bool extension_flag = (data_[pos] >> 2) & 1;
+            bool has_size_field = (data_[pos] >> 1) & 1;
+            header_size = 1 + (extension_flag ? 1 : 0);
+            if (has_size_field) {
+                uint64_t value = 0;
+                int i = 0;
+                for (; i < 8; i++) {
+                    if (pos + header_size + i >= data_size_) {
+                        return false;
+                    }
+                    uint8_t byte = data_[pos + header_size + i];
+                    value |= static_cast<uint64_t>(byte & 0x7F) << (i * 7);
+                    if (!(byte & 0x80)) {
+                        break;
+                    }
+                }
+                header_size += i + 1;
+                obu_size = value;
+            } else {
+                obu_size = data_size_ - pos - header_size;
+            }
+            return pos + header_size + obu_size <= data_size_;
+        }
+
+        size_t FindTemporalUnitEnd(size_t pos) const {
+            uint8_t obu_type;
+            size_t header_size, obu_size;
+            bool first = true;
+            while (ReadObuHeader(pos, obu_type, header_size, obu_size)) {
+                if (obu_type == kObuTemporalDelimiter && !first) {
+                    return pos;
+                }
+                first = false;
+                pos += header_size + obu_size;
+            }
+            return data_size_;
+        }
+
+        /**
+         * @brief Finds the first sequence level header of the stream and extracts the bit depth (and the size for H.264/HEVC/AV1)
+         */
+        void ParseSequenceInfo() {
+            if (stream_type_ == ES_TYPE_ANNEXB_AVC || stream_type_ == ES_TYPE_ANNEXB_HEVC) {
+                size_t sc = FindStartCode(offset_);
+                while (sc < data_size_) {
+                    size_t next_sc = FindStartCode(sc + 3);
+                    const uint8_t *nal = data_ + sc + 3;
+                    size_t nal_size = next_sc - sc - 3;
+                    if (stream_type_ == ES_TYPE_ANNEXB_HEVC && nal_size > 2 && ((nal[0] >> 1) & 0x3F) == 33) {
+                        ParseHevcSps(nal, nal_size);
+                        return;
+                    }
+                    if (stream_type_ == ES_TYPE_ANNEXB_AVC && nal_size > 1 && (nal[0] & 0x1F) == 7) {
+                        ParseAvcSps(nal, nal_size);
+                        return;
+                    }
+                    sc = next_sc;
+                }
+            } else if (stream_type_ == ES_TYPE_OBU_ANNEXB) {
+                // temporal_unit_size, frame_unit_size, then the OBUs of the frame unit, each preceded by obu_length
+                uint64_t temporal_unit_size, frame_unit_size, obu_length;
+                size_t num_bytes, pos = offset_;
+                if (!ReadLeb128(pos, temporal_unit_size, num_bytes)) {
+                    return;
+                }
+                pos += num_bytes;
+                size_t temporal_unit_end = std::min(data_size_, pos + temporal_unit_size);
+                while (pos < temporal_unit_end && ReadLeb128(pos, frame_unit_size, num_bytes)) {
+                    pos += num_bytes;
+                    size_t frame_unit_end = std::min(temporal_unit_end, pos + frame_unit_size);
+                    while (pos < frame_unit_end && ReadLeb128(pos, obu_length, num_bytes)) {
+                        pos += num_bytes;
+                        if (obu_length == 0 || obu_length > frame_unit_end - pos) {
+                            return;
+                        }
+                        if (((data_[pos] >> 3) & 0x0F) == kObuSequenceHeader) {
+                            // obu_size is optional in Annex B
+                            size_t header_size = 1 + ((data_[pos] >> 2) & 1);
+                            uint64_t obu_size = 0;
+                            if (((data_[pos] >> 1) & 1) && ReadLeb128(pos + header_size, obu_size, num_bytes)) {
+                                header_size += num_bytes;
+                            }
+                            if (header_size < obu_length) {
+                                uint64_t payload_size = obu_length - header_size;
+                                ParseAv1SequenceHeader(data_ + pos + header_size, obu_size ? std::min(obu_size, payload_size) : payload_size);
+                            }
+                            return;
+                        }
+                        pos += obu_length;
+                    }
+                    pos = frame_unit_end;
+                }
+            } else if (codec_id_ == rocDecVideoCodec_AV1) {
+                size_t pos = offset_;
+                uint8_t obu_type;
+                size_t header_size, obu_size;
+                if (stream_type_ == ES_TYPE_IVF) {
+                    pos += kIvfFrameHeaderSize;
+                }
+                while (ReadObuHeader(pos, obu_type, header_size, obu_size)) {
+                    if (obu_type == kObuSequenceHeader) {
+                        ParseAv1SequenceHeader(data_ + pos + header_size, obu_size);
+                        return;
+                    }
+                    pos += header_size + obu_size;
+                }
+            }
+        }
+
+        // Bit reader on a RBSP copy of the header (emulation prevention bytes removed)
+        struct BitReader {
+            uint8_t buf[kMaxHeaderSize] = {0};
+            size_t size = 0;
+            size_t bit_idx = 0;
+            uint32_t ReadBits(int num_bits) {
+                uint32_t value = 0;
+                for (int i = 0; i < num_bits; i++) {
+                    value <<= 1;
+                    if (bit_idx < size * 8) {
+                        value |= (buf[bit_idx >> 3] >> (7 - (bit_idx & 7))) & 1;
+                    }
+                    bit_idx++;
+                }
+                return value;
+            }
+            void SkipBits(size_t num_bits) { bit_idx += num_bits; }
+            uint32_t ReadUe() {
+                int leading_zeros = 0;
+                while (!ReadBits(1) && leading_zeros < 32 && bit_idx < size * 8) {
+                    leading_zeros++;
+                }
+                return leading_zeros ? ((1u << leading_zeros) - 1) + ReadBits(leading_zeros) : 0;
+            }
+            uint32_t ReadUvlc() { return ReadUe(); }
+        };
+
+        static void CopyRbsp(BitReader &reader, const uint8_t *src, size_t src_size, bool remove_emulation_prevention) {
+            int zero_count = 0;
+            for (size_t i = 0; i < src_size && reader.size < kMaxHeaderSize; i++) {
+                if (remove_emulation_prevention && zero_count == 2 && src[i] == 0x03) {
+                    zero_count = 0;
+                    continue;
+                }
+                zero_count = src[i] ? 0 : zero_count + 1;
+                reader.buf[reader.size++] = src[i];
+            }
+        }
+
+        void ParseAvcSps(const uint8_t *nal, size_t nal_size) {
+            BitReader reader;
+            CopyRbsp(reader, nal + 1, nal_size - 1, true);
+            uint32_t profile_idc = reader.ReadBits(8);
+            reader.SkipBits(16);        // constraint flags, level_idc
+            reader.ReadUe();            // seq_parameter_set_id
+            uint32_t chroma_format_idc = 1;
+            if (profile_idc == 100 || profile_idc == 110 || profile_idc == 122 || profile_idc == 244 || profile_idc == 44 || profile_idc == 83 ||
+                profile_idc == 86 || profile_idc == 118 || profile_idc == 128 || profile_idc == 138 || profile_idc == 139 || profile_idc == 134 || profile_idc == 135) {
+                chroma_format_idc = reader.ReadUe();
+                if (chroma_format_idc == 3) {
+                    reader.SkipBits(1);     // separate_colour_plane_flag
+                }
+                bit_depth_ = reader.ReadUe() + 8;
+                reader.ReadUe();        // bit_depth_chroma_minus8
+                reader.SkipBits(1);     // qpprime_y_zero_transform_bypass_flag
+                if (reader.ReadBits(1)) {
+                    // seq_scaling_matrix_present_flag: skip the scaling lists
+                    for (int i = 0; i < ((chroma_format_idc != 3) ? 8 : 12); i++) {
+                        if (reader.ReadBits(1)) {
+                            int size = (i < 6) ? 16 : 64;
+                            int last_scale = 8, next_scale = 8;
+                            for (int j = 0; j < size && next_scale; j++) {
+                                int32_t delta_scale = static_cast<int32_t>(reader.ReadUe());
+                                delta_scale = (delta_scale & 1) ? (delta_scale + 1) / 2 : -(delta_scale / 2);
+                                next_scale = (last_scale + delta_scale + 256) % 256;
+                                last_scale = next_scale ? next_scale : last_scale;
+                            }
+                        }
+                    }
+                }
+            }
+            reader.ReadUe();            // log2_max_frame_num_minus4
+            uint32_t pic_order_cnt_type = reader.ReadUe();
+            if (pic_order_cnt_type == 0) {
+                reader.ReadUe();
+            } else if (pic_order_cnt_type == 1) {
+                reader.SkipBits(1);
+                reader.ReadUe();
+                reader.ReadUe();
+                uint32_t num_ref_frames_in_pic_order_cnt_cycle = reader.ReadUe();
+                for (uint32_t i = 0; i < num_ref_frames_in_pic_order_cnt_cycle && i < 256; i++) {
+                    reader.ReadUe();
+                }
+            }
+            reader.ReadUe();            // max_num_ref_frames
+            reader.SkipBits(1);         // gaps_in_frame_num_value_allowed_flag
+            uint32_t pic_width_in_mbs = reader.ReadUe() + 1;
+            uint32_t pic_height_in_map_units = reader.ReadUe() + 1;
+            uint32_t frame_mbs_only_flag = reader.ReadBits(1);
+            width_ = pic_width_in_mbs * 16;
+            height_ = pic_height_in_map_units * 16 * (2 - frame_mbs_only_flag);
+        }
+
+        void ParseHevcSps(const uint8_t *nal, size_t nal_size) {
+            BitReader reader;
+            CopyRbsp(reader, nal + 2, nal_size - 2, true);
+            reader.SkipBits(4);         // sps_video_parameter_set_id
+            uint32_t max_sub_layers_minus1 = reader.ReadBits(3);
+            reader.SkipBits(1);         // sps_temporal_id_nesting_flag
+            // profile_tier_level()
+            reader.SkipBits(88 + 8);    // general profile and level
+            uint32_t sub_layer_profile_present[8] = {0}, sub_layer_level_present[8] = {0};
+            for (uint32_t i = 0; i < max_sub_layers_minus1; i++) {
+                sub_layer_profile_present[i] = reader.ReadBits(1);
+                sub_layer_level_present[i] = reader.ReadBits(1);
+            }
+            if (max_sub_layers_minus1 > 0) {
+                reader.SkipBits(2 * (8 - max_sub_layers_minus1));
+            }
+            for (uint32_t i = 0; i < max_sub_layers_minus1; i++) {
+                reader.SkipBits((sub_layer_profile_present[i] ? 88 : 0) + (sub_layer_level_present[i] ? 8 : 0));
+            }
+            reader.ReadUe();            // sps_seq_parameter_set_id
+            if (reader.ReadUe() == 3) { // chroma_format_idc
+                reader.SkipBits(1);     // separate_colour_plane_flag
+            }
+            width_ = reader.ReadUe();
+            height_ = reader.ReadUe();
+            if (reader.ReadBits(1)) {   // conformance_window_flag
+                reader.ReadUe();
+                reader.ReadUe();
+                reader.ReadUe();
+                reader.ReadUe();
+            }
+            bit_depth_ = reader.ReadUe() + 8;
+        }
+
+        void ParseAv1SequenceHeader(const uint8_t *obu, size_t obu_size) {
+            BitReader reader;
+            CopyRbsp(reader, obu, obu_size, false);
+            uint32_t seq_profile = reader.ReadBits(3);
+            reader.SkipBits(1);         // still_picture
+            uint32_t reduced_still_picture_header = reader.ReadBits(1);
+            if (reduced_still_picture_header) {
+                reader.SkipBits(5);     // seq_level_idx[0]
+            } else {
+                uint32_t decoder_model_info_present_flag = 0, buffer_delay_length_minus_1 = 0;
+                if (reader.ReadBits(1)) {   // timing_info_present_flag
+                    reader.SkipBits(64);    // num_units_in_display_tick, time_scale
+                    if (reader.ReadBits(1)) {   // equal_picture_interval
+                        reader.ReadUvlc();
+                    }
+                    decoder_model_info_present_flag = reader.ReadBits(1);
+                    if (decoder_model_info_present_flag) {
+                        buffer_delay_length_minus_1 = reader.ReadBits(5);
+                        reader.SkipBits(32 + 5 + 5);
+                    }
+                }
+                uint32_t initial_display_delay_present_flag = reader.ReadBits(1);
+                uint32_t operating_points_cnt_minus_1 = reader.ReadBits(5);
+                for (uint32_t i = 0; i <= operating_points_cnt_minus_1; i++) {
+                    reader.SkipBits(12);    // operating_point_idc
+                    uint32_t seq_level_idx = reader.ReadBits(5);
+                    if (seq_level_idx > 7) {
+                        reader.SkipBits(1); // seq_tier
+                    }
+                    if (decoder_model_info_present_flag && reader.ReadBits(1)) {
+                        reader.SkipBits(2 * (buffer_delay_length_minus_1 + 1) + 1);
+                    }
+                    if (initial_display_delay_present_flag && reader.ReadBits(1)) {
+                        reader.SkipBits(4);
+                    }
+                }
+            }
+            uint32_t frame_width_bits_minus_1 = reader.ReadBits(4);
+            uint32_t frame_height_bits_minus_1 = reader.ReadBits(4);
+            width_ = reader.ReadBits(frame_width_bits_minus_1 + 1) + 1;
+            height_ = reader.ReadBits(frame_height_bits_minus_1 + 1) + 1;
+            if (!reduced_still_picture_header && reader.ReadBits(1)) {  // frame_id_numbers_present_flag
+                reader.SkipBits(4 + 3);
+            }
+            reader.SkipBits(3);         // use_128x128_superblock, enable_filter_intra, enable_intra_edge_filter
+            if (!reduced_still_picture_header) {
+                reader.SkipBits(4);     // enable_interintra_compound, enable_masked_compound, enable_warped_motion, enable_dual_filter
+                uint32_t enable_order_hint = reader.ReadBits(1);
+                if (enable_order_hint) {
+                    reader.SkipBits(2); // enable_jnt_comp, enable_ref_frame_mvs
+                }
+                uint32_t seq_force_screen_content_tools = 2;
+                if (!reader.ReadBits(1)) {  // seq_choose_screen_content_tools
+                    seq_force_screen_content_tools = reader.ReadBits(1);
+                }
+                if (seq_force_screen_content_tools > 0 && !reader.ReadBits(1)) {    // seq_choose_integer_mv
+                    reader.SkipBits(1); // seq_force_integer_mv
+                }
+                if (enable_order_hint) {
+                    reader.SkipBits(3); // order_hint_bits_minus_1
+                }
+            }
+            reader.SkipBits(3);         // enable_superres, enable_cdef, enable_restoration
+            // color_config()
+            uint32_t high_bitdepth = reader.ReadBits(1);
+            if (seq_profile == 2 && high_bitdepth) {
+                bit_depth_ = reader.ReadBits(1) ? 12 : 10;
+            } else {
+                bit_depth_ = high_bitdepth ? 10 : 8;
+            }
+        }
+
+        static uint32_t ReadLe32(const uint8_t *p) { return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24); }
+        static uint64_t ReadLe64(const uint8_t *p) { return ReadLe32(p) | (static_cast<uint64_t>(ReadLe32(p + 4)) << 32); }
+
+        const uint8_t *data_ = nullptr;
+        size_t data_size_ = 0;
+        bool is_mapped_ = false;
+        size_t offset_ = 0;
+        size_t first_unit_offset_ = 0;
+        ElementaryStreamType stream_type_ = ES_TYPE_UNKNOWN;
+        rocDecVideoCodec codec_id_ = rocDecVideoCodec_NumCodecs;
+        uint32_t width_ = 0;
+        uint32_t height_ = 0;
+        uint32_t bit_depth_ = 8;
+        double frame_rate_ = kDefaultFrameRate;
+        uint32_t ivf_timebase_num_ = 1;
+        uint32_t ivf_timebase_den_ = kDefaultFrameRate;
+        int64_t frame_count_ = 0;
+};
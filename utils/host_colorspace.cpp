@@ -0,0 +1,469 @@
+
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "host_colorspace.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && !defined(__HIP_DEVICE_COMPILE__)
+#include <immintrin.h>
+#define HOST_COLORSPACE_X86 1
+#endif
+
+// element type, number of channels and channel order of the packed RGB formats
+template<class Rgb> struct HostRgbLayout;
+template<> struct HostRgbLayout<BGR24> { typedef uint8_t Unit; static const int num_channels = 3; static const bool bgr = true; };
+template<> struct HostRgbLayout<RGB24> { typedef uint8_t Unit; static const int num_channels = 3; static const bool bgr = false; };
+template<> struct HostRgbLayout<BGRA32> { typedef uint8_t Unit; static const int num_channels = 4; static const bool bgr = true; };
+template<> struct HostRgbLayout<RGBA32> { typedef uint8_t Unit; static const int num_channels = 4; static const bool bgr = false; };
+template<> struct HostRgbLayout<BGR48> { typedef uint16_t Unit; static const int num_channels = 3; static const bool bgr = true; };
+template<> struct HostRgbLayout<RGB48> { typedef uint16_t Unit; static const int num_channels = 3; static const bool bgr = false; };
+template<> struct HostRgbLayout<BGRA64> { typedef uint16_t Unit; static const int num_channels = 4; static const bool bgr = true; };
+template<> struct HostRgbLayout<RGBA64> { typedef uint16_t Unit; static const int num_channels = 4; static const bool bgr = false; };
+
+/**
+ * @brief Worker threads shared by all the host conversions of the process. They are started on the first call and kept until the process
+ *        exits, so a conversion doesn't pay the thread creation for every surface. Several callers can submit bands concurrently.
+ */
+class HostRowBandPool {
+public:
+    static HostRowBandPool &Instance() {
+        static HostRowBandPool pool;
+        return pool;
+    }
+
+    /**
+     * @brief Runs rows_fn(y, min(height, y + band_height)) on the bands of [0, height) with the workers and the calling thread, and returns
+     *        when all the bands are done
+     */
+    void Run(int height, int band_height, const std::function<void(int, int)> &rows_fn) {
+        auto call = std::make_shared<Call>();
+        call->rows_fn = &rows_fn;
+        call->height = height;
+        call->band_height = band_height;
+        call->num_bands = (height + band_height - 1) / band_height;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // a helper that starts after the caller took the last band returns without touching rows_fn
+            for (int i = 1; i < call->num_bands; i++) {
+                tasks_.push_back(call);
+            }
+        }
+        work_cv_.notify_all();
+        RunBands(*call);
+        std::unique_lock<std::mutex> lock(call->mutex);
+        call->done_cv.wait(lock, [&] { return call->num_done == call->num_bands; });
+    }
+
+private:
+    struct Call {
+        const std::function<void(int, int)> *rows_fn;
+        int height;
+        int band_height;
+        int num_bands;
+        std::atomic<int> next_band{0};
+        std::mutex mutex;
+        std::condition_variable done_cv;
+        int num_done = 0;
+    };
+
+    HostRowBandPool() {
+        int num_workers = static_cast<int>(std::thread::hardware_concurrency()) - 1;
+        for (int i = 0; i < num_workers; i++) {
+            workers_.emplace_back(&HostRowBandPool::WorkerLoop, this);
+        }
+    }
+
+    ~HostRowBandPool() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        work_cv_.notify_all();
+        for (auto &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    static void RunBands(Call &call) {
+        for (int band = call.next_band++; band < call.num_bands; band = call.next_band++) {
+            int y = band * call.band_height;
+            (*call.rows_fn)(y, std::min(call.height, y + call.band_height));
+            std::lock_guard<std::mutex> lock(call.mutex);
+            if (++call.num_done == call.num_bands) {
+                call.done_cv.notify_one();
+            }
+        }
+    }
+
+    void WorkerLoop() {
+        for (;;) {
+            std::shared_ptr<Call> call;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_cv_.wait(lock, [&] { return stop_ || !tasks_.empty(); });
+                if (tasks_.empty()) {
+                    return;
+                }
+                call = std::move(tasks_.front());
+                tasks_.pop_front();
+            }
+            RunBands(*call);
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::deque<std::shared_ptr<Call>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    bool stop_ = false;
+};
+
+/**
+ * @brief Splits the rows [0, height) into num_threads bands of a multiple of row_align rows and runs rows_fn(y_begin, y_end) on each band
+ *        with the calling thread and the workers of HostRowBandPool
+ */
+static void ForEachRowBand(int height, int row_align, int num_threads, const std::function<void(int, int)> &rows_fn) {
+    const int min_rows_per_thread = 16;     // below this the hand-off to the workers costs more than the rows
+    if (num_threads <= 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    num_threads = std::max(1, std::min(num_threads, height / min_rows_per_thread));
+    int num_units = (height + row_align - 1) / row_align;
+    int band_height = (num_units + num_threads - 1) / num_threads * row_align;
+    if (num_threads == 1 || band_height >= height) {
+        rows_fn(0, height);
+        return;
+    }
+    HostRowBandPool::Instance().Run(height, band_height, rows_fn);
+}
+
+static std::atomic<bool> host_avx2_enabled{true};
+
+void SetHostColorConvertAvx2(bool enable) {
+    host_avx2_enabled = enable;
+}
+
+bool HostColorConvertUsesAvx2() {
+#ifdef HOST_COLORSPACE_X86
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2 && host_avx2_enabled;
+#else
+    return false;
+#endif
+}
+
+// same truncation and bit depth adjustment as YuvToRgbForPixel of the kernels
+template<class YuvUnit, class RgbUnit>
+static inline RgbUnit HostToRgbUnit(float value) {
+    YuvUnit unit = static_cast<YuvUnit>(value);
+    const int shift = abs(static_cast<int>(sizeof(YuvUnit)) - static_cast<int>(sizeof(RgbUnit))) * 8;
+    if (sizeof(YuvUnit) >= sizeof(RgbUnit)) {
+        return static_cast<RgbUnit>(unit >> shift);
+    }
+    return static_cast<RgbUnit>(unit << shift);
+}
+
+/**
+ * @brief Converts the pixels [x_begin, width) of row y; 4:2:0 surfaces use the chroma sample of the 2x2 block like the kernels
+ */
+template<class YuvUnit, class Rgb, bool chroma_420>
+static void YuvToRgbRow(const uint8_t *p_yuv, int yuv_pitch, uint8_t *p_rgb, int rgb_pitch, int v_pitch, int y, int x_begin, int width,
+                        const YuvToRgbParams &params) {
+    typedef HostRgbLayout<Rgb> Layout;
+    typedef typename Layout::Unit RgbUnit;
+    const int r_index = Layout::bgr ? 2 : 0, b_index = 2 - r_index;
+    const YuvUnit *p_luma = reinterpret_cast<const YuvUnit *>(p_yuv + static_cast<size_t>(y) * yuv_pitch);
+    const YuvUnit *p_u, *p_v;
+    if (chroma_420) {
+        p_u = reinterpret_cast<const YuvUnit *>(p_yuv + static_cast<size_t>(v_pitch + y / 2) * yuv_pitch);
+        p_v = p_u + 1;
+    } else {
+        p_u = reinterpret_cast<const YuvUnit *>(p_yuv + static_cast<size_t>(v_pitch + y) * yuv_pitch);
+        p_v = reinterpret_cast<const YuvUnit *>(p_yuv + static_cast<size_t>(2 * v_pitch + y) * yuv_pitch);
+    }
+    RgbUnit *p_dst = reinterpret_cast<RgbUnit *>(p_rgb + static_cast<size_t>(y) * rgb_pitch);
+    for (int x = x_begin; x < width; x++) {
+        int c = chroma_420 ? (x & ~1) : x;
+        float frgb[3];
+        YuvToRgbFloat(params, p_luma[x], p_u[c], p_v[c], frgb);
+        RgbUnit *p_pixel = p_dst + x * Layout::num_channels;
+        p_pixel[r_index] = HostToRgbUnit<YuvUnit, RgbUnit>(frgb[0]);
+        p_pixel[1] = HostToRgbUnit<YuvUnit, RgbUnit>(frgb[1]);
+        p_pixel[b_index] = HostToRgbUnit<YuvUnit, RgbUnit>(frgb[2]);
+        if (Layout::num_channels == 4) {
+            p_pixel[3] = 0;
+        }
+    }
+}
+
+#ifdef HOST_COLORSPACE_X86
+/**
+ * @brief AVX2 conversion of 8 pixels per iteration of a 4:2:0 row into packed 8-bit RGB. It evaluates the matrix in the same order as
+ *        YuvToRgbFloat without fused multiply-adds, so the results are identical to YuvToRgbRow. Returns the number of pixels converted;
+ *        the caller converts the remaining ones.
+ */
+template<class YuvUnit, bool bgr, int num_channels>
+__attribute__((target("avx2")))
+static int Yuv420ToRgb8RowAvx2(const YuvUnit *p_luma, const YuvUnit *p_uv, uint8_t *p_dst, int width, const YuvToRgbParams &params) {
+    __m256 mat[3][3];
+    for (int c = 0; c < 3; c++) {
+        for (int k = 0; k < 3; k++) {
+            mat[c][k] = _mm256_set1_ps(params.mat[c][k]);
+        }
+    }
+    const __m256 y_offset = _mm256_set1_ps(params.y_offset), uv_offset = _mm256_set1_ps(params.uv_offset);
+    const __m256 zero = _mm256_setzero_ps(), max_value = _mm256_set1_ps(params.max_value);
+    // the interleaved UV pairs of 4 chroma samples are spread over the 8 pixels
+    const __m256i u_index = _mm256_setr_epi32(0, 0, 2, 2, 4, 4, 6, 6), v_index = _mm256_setr_epi32(1, 1, 3, 3, 5, 5, 7, 7);
+    const __m128i pack_24bit = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const int unit_shift = (sizeof(YuvUnit) - 1) * 8;
+    const int r_shift = bgr ? 16 : 0, b_shift = 16 - r_shift;
+    int x = 0;
+    for (; x + 8 <= width; x += 8) {
+        __m256i luma, chroma;
+        if (sizeof(YuvUnit) == 1) {
+            luma = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p_luma + x)));
+            chroma = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p_uv + x)));
+        } else {
+            luma = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_luma + x)));
+            chroma = _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p_uv + x)));
+        }
+        __m256 fy = _mm256_sub_ps(_mm256_cvtepi32_ps(luma), y_offset);
+        __m256 fu = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_permutevar8x32_epi32(chroma, u_index)), uv_offset);
+        __m256 fv = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_permutevar8x32_epi32(chroma, v_index)), uv_offset);
+        __m256i rgb[3];
+        for (int c = 0; c < 3; c++) {
+            __m256 value = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(mat[c][0], fy), _mm256_mul_ps(mat[c][1], fu)), _mm256_mul_ps(mat[c][2], fv));
+            value = _mm256_min_ps(_mm256_max_ps(value, zero), max_value);
+            rgb[c] = _mm256_srli_epi32(_mm256_cvttps_epi32(value), unit_shift);
+        }
+        // one 32-bit word per pixel; the alpha byte stays 0 like the kernels
+        __m256i pixels = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(rgb[0], r_shift), _mm256_slli_epi32(rgb[1], 8)),
+                                         _mm256_slli_epi32(rgb[2], b_shift));
+        if (num_channels == 4) {
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(p_dst + x * 4), pixels);
+        } else {
+            // drop the alpha bytes of each 128-bit half and store exactly 24 bytes
+            __m128i lo = _mm_shuffle_epi8(_mm256_castsi256_si128(pixels), pack_24bit);
+            __m128i hi = _mm_shuffle_epi8(_mm256_extracti128_si256(pixels, 1), pack_24bit);
+            uint8_t *p = p_dst + x * 3;
+            uint32_t tail;
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(p), lo);
+            tail = _mm_extract_epi32(lo, 2);
+            memcpy(p + 8, &tail, sizeof(tail));
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(p + 12), hi);
+            tail = _mm_extract_epi32(hi, 2);
+            memcpy(p + 20, &tail, sizeof(tail));
+        }
+    }
+    return x;
+}
+#endif
+
+template<class YuvUnit, class Rgb, bool chroma_420>
+static void HostYuvToColor(const uint8_t *p_yuv, int yuv_pitch, uint8_t *p_rgb, int rgb_pitch, int width, int height, int v_pitch,
+                           const ColorSpaceInfo &color_info, int num_threads) {
+    typedef HostRgbLayout<Rgb> Layout;
+    const YuvToRgbParams params = GetYuvToRgbParams(color_info, sizeof(YuvUnit) * 8);
+    // the tone mapping of HDR streams and the 16-bit outputs use the per pixel code
+    const bool use_avx2 = chroma_420 && sizeof(typename Layout::Unit) == 1 && !params.hdr_transfer && HostColorConvertUsesAvx2();
+    ForEachRowBand(height, chroma_420 ? 2 : 1, num_threads, [&](int y_begin, int y_end) {
+        for (int y = y_begin; y < y_end; y++) {
+            int x = 0;
+#ifdef HOST_COLORSPACE_X86
+            if (use_avx2) {
+                x = Yuv420ToRgb8RowAvx2<YuvUnit, Layout::bgr, Layout::num_channels>(
+                        reinterpret_cast<const YuvUnit *>(p_yuv + static_cast<size_t>(y) * yuv_pitch),
+                        reinterpret_cast<const YuvUnit *>(p_yuv + static_cast<size_t>(v_pitch + y / 2) * yuv_pitch),
+                        p_rgb + static_cast<size_t>(y) * rgb_pitch, width, params);
+            }
+#endif
+            YuvToRgbRow<YuvUnit, Rgb, chroma_420>(p_yuv, yuv_pitch, p_rgb, rgb_pitch, v_pitch, y, x, width, params);
+        }
+    });
+}
+
+template <class COLOR24>
+void HostNv12ToColor24(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads) {
+    HostYuvToColor<uint8_t, COLOR24, true>(p_nv12, nv12_pitch, p_bgr, bgr_pitch, width, height, v_pitch, color_info, num_threads);
+}
+
+template <class COLOR32>
+void HostNv12ToColor32(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads) {
+    HostYuvToColor<uint8_t, COLOR32, true>(p_nv12, nv12_pitch, p_bgra, bgra_pitch, width, height, v_pitch, color_info, num_threads);
+}
+
+template <class COLOR48>
+void HostNv12ToColor48(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads) {
+    HostYuvToColor<uint8_t, COLOR48, true>(p_nv12, nv12_pitch, p_bgr, bgr_pitch, width, height, v_pitch, color_info, num_threads);
+}
+
+template <class COLOR64>
+void HostNv12ToColor64(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads) {
+    HostYuvToColor<uint8_t, COLOR64, true>(p_nv12, nv12_pitch, p_bgra, bgra_pitch, width, height, v_pitch, color_info, num_threads);
+}
+
+template <class COLOR24>
+void HostP016ToColor24(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads) {
+    HostYuvToColor<uint16_t, COLOR24, true>(p_p016, p016_pitch, p_bgr, bgr_pitch, width, height, v_pitch, color_info, num_threads);
+}
+
+template <class COLOR32>
+void HostP016ToColor32(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads) {
+    HostYuvToColor<uint16_t, COLOR32, true>(p_p016, p016_pitch, p_bgra, bgra_pitch, width, height, v_pitch, color_info, num_threads);
+}
+
+template <class COLOR48>
+void HostP016ToColor48(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads) {
+    HostYuvToColor<uint16_t, COLOR48, true>(p_p016, p016_pitch, p_bgr, bgr_pitch, width, height, v_pitch, color_info, num_threads);
+}
+
+template <class COLOR64>
+void HostP016ToColor64(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads) {
+    HostYuvToColor<uint16_t, COLOR64, true>(p_p016, p016_pitch, p_bgra, bgra_pitch, width, height, v_pitch, color_info, num_threads);
+}
+
+template <class COLOR24>
+void HostYUV444ToColor24(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads) {
+    HostYuvToColor<uint8_t, COLOR24, false>(p_yuv_444, pitch, p_bgr, bgr_pitch, width, height, v_pitch, color_info, num_threads);
+}
+
+template <class COLOR32>
+void HostYUV444ToColor32(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads) {
+    HostYuvToColor<uint8_t, COLOR32, false>(p_yuv_444, pitch, p_bgra, bgra_pitch, width, height, v_pitch, color_info, num_threads);
+}
+
+template <class COLOR24>
+void HostYUV444P16ToColor24(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads) {
+    HostYuvToColor<uint16_t, COLOR24, false>(p_yuv_444, pitch, p_bgr, bgr_pitch, width, height, v_pitch, color_info, num_threads);
+}
+
+template <class COLOR48>
+void HostYUV444P16ToColor48(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads) {
+    HostYuvToColor<uint16_t, COLOR48, false>(p_yuv_444, pitch, p_bgr, bgr_pitch, width, height, v_pitch, color_info, num_threads);
+}
+
+template <class COLOR64>
+void HostYUV444P16ToColor64(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads) {
+    HostYuvToColor<uint16_t, COLOR64, false>(p_yuv_444, pitch, p_bgra, bgra_pitch, width, height, v_pitch, color_info, num_threads);
+}
+
+// source positions and weight of the second tap of a bilinear resize along one axis
+struct HostBilinearTap {
+    int index0;
+    int index1;
+    float weight1;
+};
+
+static std::vector<HostBilinearTap> GetBilinearTaps(int src_size, int dst_size) {
+    std::vector<HostBilinearTap> taps(dst_size);
+    float scale = static_cast<float>(src_size) / dst_size;
+    for (int i = 0; i < dst_size; i++) {
+        float pos = std::min(std::max((i + 0.5f) * scale - 0.5f, 0.0f), static_cast<float>(src_size - 1));
+        taps[i].index0 = static_cast<int>(pos);
+        taps[i].index1 = std::min(taps[i].index0 + 1, src_size - 1);
+        taps[i].weight1 = pos - taps[i].index0;
+    }
+    return taps;
+}
+
+/**
+ * @brief Bilinear resize of a plane of num_components interleaved samples per pixel (1 for luma, 2 for the UV plane)
+ */
+template<class YuvUnit, int num_components>
+static void HostResizePlane(const uint8_t *p_src, int src_pitch, int src_width, int src_height, uint8_t *p_dst, int dst_pitch, int dst_width,
+                            int dst_height, int num_threads) {
+    if (src_width <= 0 || src_height <= 0 || dst_width <= 0 || dst_height <= 0) {
+        return;
+    }
+    const std::vector<HostBilinearTap> x_taps = GetBilinearTaps(src_width, dst_width), y_taps = GetBilinearTaps(src_height, dst_height);
+    ForEachRowBand(dst_height, 1, num_threads, [&](int y_begin, int y_end) {
+        for (int y = y_begin; y < y_end; y++) {
+            const YuvUnit *p_row0 = reinterpret_cast<const YuvUnit *>(p_src + static_cast<size_t>(y_taps[y].index0) * src_pitch);
+            const YuvUnit *p_row1 = reinterpret_cast<const YuvUnit *>(p_src + static_cast<size_t>(y_taps[y].index1) * src_pitch);
+            const float wy = y_taps[y].weight1;
+            YuvUnit *p_out = reinterpret_cast<YuvUnit *>(p_dst + static_cast<size_t>(y) * dst_pitch);
+            for (int x = 0; x < dst_width; x++) {
+                const int i0 = x_taps[x].index0 * num_components, i1 = x_taps[x].index1 * num_components;
+                const float wx = x_taps[x].weight1;
+                for (int k = 0; k < num_components; k++) {
+                    float top = p_row0[i0 + k] + (p_row0[i1 + k] - p_row0[i0 + k]) * wx;
+                    float bottom = p_row1[i0 + k] + (p_row1[i1 + k] - p_row1[i0 + k]) * wx;
+                    p_out[x * num_components + k] = static_cast<YuvUnit>(top + (bottom - top) * wy + 0.5f);
+                }
+            }
+        }
+    });
+}
+
+void HostResizeNv12(uint8_t *p_dst_nv12, int dst_pitch, int dst_width, int dst_height, const uint8_t *p_src_nv12, int src_pitch, int src_width,
+                    int src_height, const uint8_t *p_src_nv12_uv, uint8_t *p_dst_nv12_uv, int num_threads) {
+    HostResizePlane<uint8_t, 1>(p_src_nv12, src_pitch, src_width, src_height, p_dst_nv12, dst_pitch, dst_width, dst_height, num_threads);
+    HostResizePlane<uint8_t, 2>(p_src_nv12_uv, src_pitch, src_width / 2, src_height / 2, p_dst_nv12_uv, dst_pitch, dst_width / 2, dst_height / 2,
+                                num_threads);
+}
+
+void HostResizeP016(uint8_t *p_dst_p016, int dst_pitch, int dst_width, int dst_height, const uint8_t *p_src_p016, int src_pitch, int src_width,
+                    int src_height, const uint8_t *p_src_p016_uv, uint8_t *p_dst_p016_uv, int num_threads) {
+    HostResizePlane<uint16_t, 1>(p_src_p016, src_pitch, src_width, src_height, p_dst_p016, dst_pitch, dst_width, dst_height, num_threads);
+    HostResizePlane<uint16_t, 2>(p_src_p016_uv, src_pitch, src_width / 2, src_height / 2, p_dst_p016_uv, dst_pitch, dst_width / 2, dst_height / 2,
+                                 num_threads);
+}
+
+// Explicit Instantiation
+template void HostNv12ToColor24<BGR24>(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostNv12ToColor24<RGB24>(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostNv12ToColor32<BGRA32>(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostNv12ToColor32<RGBA32>(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostNv12ToColor48<BGR48>(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostNv12ToColor48<RGB48>(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostNv12ToColor64<BGRA64>(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostNv12ToColor64<RGBA64>(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostP016ToColor24<BGR24>(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostP016ToColor24<RGB24>(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostP016ToColor32<BGRA32>(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostP016ToColor32<RGBA32>(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostP016ToColor48<BGR48>(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostP016ToColor48<RGB48>(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostP016ToColor64<BGRA64>(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostP016ToColor64<RGBA64>(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostYUV444ToColor24<BGR24>(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostYUV444ToColor24<RGB24>(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostYUV444ToColor32<BGRA32>(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostYUV444ToColor32<RGBA32>(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostYUV444P16ToColor24<BGR24>(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostYUV444P16ToColor24<RGB24>(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostYUV444P16ToColor48<BGR48>(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostYUV444P16ToColor48<RGB48>(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostYUV444P16ToColor64<BGRA64>(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
+template void HostYUV444P16ToColor64<RGBA64>(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads);
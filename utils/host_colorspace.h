@@ -0,0 +1,111 @@
+
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <stdint.h>
+#include "colorspace_info.h"
+
+/*!
+ * \file
+ * \brief Host (CPU) color conversion and resize of decoded surfaces copied to host memory.
+ *
+ * These are the counterparts of the Nv12ToColor*, P016ToColor*, YUV444*ToColor* and ResizeNv12/ResizeP016 kernels for surfaces returned with
+ * OUT_SURFACE_MEM_HOST_COPIED, so that host side consumers don't need a round trip to the device for the conversion. The rows are split
+ * into num_threads bands (0 selects the number of hardware threads), run by the calling thread and a pool of worker threads started on the
+ * first call. The color conversion of 4:2:0 surfaces to 8-bit packed RGB uses AVX2 when the CPU supports it; the other cases use the portable
+ * per pixel code. The results are the same as the kernels up to the floating point contraction of the device compiler.
+ */
+
+/**
+ * @brief Converts an NV12 surface (host memory) into packed 24-bit BGR/RGB
+ *
+ * @param p_nv12 - source NV12 surface (host memory)
+ * @param nv12_pitch - source pitch in bytes
+ * @param p_bgr - destination (host memory)
+ * @param bgr_pitch - destination pitch in bytes
+ * @param width - width
+ * @param height - height
+ * @param v_pitch - row of the UV plane relative to p_nv12 (vertical stride of the luma plane)
+ * @param color_info - color description of the source stream
+ * @param num_threads - number of threads; 0 selects the number of hardware threads
+ */
+template <class COLOR24>
+void HostNv12ToColor24(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads = 0);
+template <class COLOR32>
+void HostNv12ToColor32(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads = 0);
+template <class COLOR48>
+void HostNv12ToColor48(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads = 0);
+template <class COLOR64>
+void HostNv12ToColor64(const uint8_t *p_nv12, int nv12_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads = 0);
+template <class COLOR24>
+void HostP016ToColor24(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads = 0);
+template <class COLOR32>
+void HostP016ToColor32(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads = 0);
+template <class COLOR48>
+void HostP016ToColor48(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads = 0);
+template <class COLOR64>
+void HostP016ToColor64(const uint8_t *p_p016, int p016_pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads = 0);
+template <class COLOR24>
+void HostYUV444ToColor24(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads = 0);
+template <class COLOR32>
+void HostYUV444ToColor32(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads = 0);
+template <class COLOR24>
+void HostYUV444P16ToColor24(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads = 0);
+template <class COLOR48>
+void HostYUV444P16ToColor48(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgr, int bgr_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads = 0);
+template <class COLOR64>
+void HostYUV444P16ToColor64(const uint8_t *p_yuv_444, int pitch, uint8_t *p_bgra, int bgra_pitch, int width, int height, int v_pitch, const ColorSpaceInfo &color_info, int num_threads = 0);
+
+/**
+ * @brief Resizes (bilinear, pixel centers aligned) both planes of an NV12 surface in host memory
+ *
+ * @param p_dst_nv12 - destination Y plane (host memory)
+ * @param dst_pitch - destination pitch in bytes
+ * @param dst_width - destination width
+ * @param dst_height - destination height
+ * @param p_src_nv12 - source Y plane (host memory)
+ * @param src_pitch - source pitch in bytes
+ * @param src_width - source width
+ * @param src_height - source height
+ * @param p_src_nv12_uv - source UV plane
+ * @param p_dst_nv12_uv - destination UV plane
+ * @param num_threads - number of threads; 0 selects the number of hardware threads
+ */
+void HostResizeNv12(uint8_t *p_dst_nv12, int dst_pitch, int dst_width, int dst_height, const uint8_t *p_src_nv12, int src_pitch, int src_width,
+                    int src_height, const uint8_t *p_src_nv12_uv, uint8_t *p_dst_nv12_uv, int num_threads = 0);
+
+/**
+ * @brief Resizes both planes of a P016 surface in host memory. The parameters are the same as HostResizeNv12.
+ */
+void HostResizeP016(uint8_t *p_dst_p016, int dst_pitch, int dst_width, int dst_height, const uint8_t *p_src_p016, int src_pitch, int src_width,
+                    int src_height, const uint8_t *p_src_p016_uv, uint8_t *p_dst_p016_uv, int num_threads = 0);
+
+/**
+ * @brief Returns true if the host color conversion uses the AVX2 code path on this CPU
+ */
+bool HostColorConvertUsesAvx2();
+
+/**
+ * @brief Enables (default) or disables the AVX2 code path of the process, e.g. to compare it with the per pixel code
+ */
+void SetHostColorConvertAvx2(bool enable);
@@ -0,0 +1,230 @@
+
+/*
+Copyright (c) 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "colorspace_info.h"
+
+/*!
+ * \file
+ * \brief Filter coefficients and per pixel code of the separable resampler of resample_kernels.h, shared by the kernels and their CPU reference.
+ *
+ * Like tensor_convert.h, the header doesn't depend on HIP (colorspace_info.h only provides COLORSPACE_HOST_DEVICE), so the reference builds and
+ * runs without a GPU.
+ */
+
+typedef enum ResampleFilter_ {
+    ResampleFilter_Area = 0,        // pixel area averaging (box); bilinear when upscaling
+    ResampleFilter_Bilinear = 1,    // triangle filter
+    ResampleFilter_Bicubic = 2,     // Keys cubic, a = -0.5
+    ResampleFilter_Lanczos3 = 3,    // 3 lobes Lanczos
+} ResampleFilter;
+
+inline double ResampleFilterRadius(ResampleFilter filter) {
+    switch (filter) {
+        case ResampleFilter_Bicubic:
+            return 2.0;
+        case ResampleFilter_Lanczos3:
+            return 3.0;
+        default:
+            return 1.0;
+    }
+}
+
+inline double ResampleFilterWeight(ResampleFilter filter, double x) {
+    x = std::fabs(x);
+    switch (filter) {
+        case ResampleFilter_Bicubic: {
+            const double a = -0.5;
+            if (x < 1.0) {
+                return ((a + 2.0) * x - (a + 3.0)) * x * x + 1.0;
+            } else if (x < 2.0) {
+                return ((a * x - 5.0 * a) * x + 8.0 * a) * x - 4.0 * a;
+            }
+            return 0.0;
+        }
+        case ResampleFilter_Lanczos3: {
+            if (x < 1e-6) {
+                return 1.0;
+            } else if (x >= 3.0) {
+                return 0.0;
+            }
+            double pi_x = M_PI * x;
+            return 3.0 * std::sin(pi_x) * std::sin(pi_x / 3.0) / (pi_x * pi_x);
+        }
+        default:
+            return x < 1.0 ? 1.0 - x : 0.0;
+    }
+}
+
+/**
+ * @brief Computes the filter coefficients of one axis: destination index i is the sum over k < num_taps of
+ *        weights[i * num_taps + k] * src[start[i] + k]; the source indices are clamped to [0, src_size - 1] by the caller
+ *
+ * @param filter - resampling filter
+ * @param src_size - source size of the axis
+ * @param dst_size - destination size of the axis
+ * @param start - receives the first source index of each destination index (dst_size entries)
+ * @param weights - receives the normalized weights (dst_size * num_taps entries)
+ * @return number of taps per destination index
+ */
+inline int BuildResampleTable(ResampleFilter filter, int src_size, int dst_size, std::vector<int> &start, std::vector<float> &weights) {
+    double scale = static_cast<double>(src_size) / dst_size;
+    // widen the filter by the downscale ratio so every source pixel contributes (anti-aliasing); area averaging of an upscale is bilinear
+    double filter_scale = std::max(scale, 1.0);
+    bool area = filter == ResampleFilter_Area && scale > 1.0;
+    std::vector<std::vector<double>> dst_weights(dst_size);
+    start.resize(dst_size);
+    int num_taps = 1;
+    for (int i = 0; i < dst_size; i++) {
+        int first, last;
+        double lo = i * scale, hi = lo + scale, center = lo + 0.5 * scale, support = ResampleFilterRadius(filter) * filter_scale;
+        if (area) {
+            first = static_cast<int>(std::floor(lo));
+            last = static_cast<int>(std::ceil(hi)) - 1;
+        } else {
+            first = static_cast<int>(std::floor(center - support));
+            last = static_cast<int>(std::ceil(center + support));
+        }
+        // fold the taps outside of the source into the edge pixels
+        int clamped_first = std::min(std::max(first, 0), src_size - 1), clamped_last = std::min(std::max(last, 0), src_size - 1);
+        std::vector<double> &w = dst_weights[i];
+        w.assign(clamped_last - clamped_first + 1, 0.0);
+        double sum = 0.0;
+        for (int s = first; s <= last; s++) {
+            double ws = area ? std::min(hi, s + 1.0) - std::max(lo, static_cast<double>(s))
+                             : ResampleFilterWeight(filter, (s + 0.5 - center) / filter_scale);
+            w[std::min(std::max(s, 0), src_size - 1) - clamped_first] += ws;
+            sum += ws;
+        }
+        // trim the zero taps at both ends
+        size_t head = 0, tail = w.size();
+        while (head + 1 < tail && w[head] == 0.0) {
+            head++;
+        }
+        while (tail > head + 1 && w[tail - 1] == 0.0) {
+            tail--;
+        }
+        w = std::vector<double>(w.begin() + head, w.begin() + tail);
+        for (double &ws : w) {
+            ws /= sum;
+        }
+        start[i] = clamped_first + static_cast<int>(head);
+        num_taps = std::max(num_taps, static_cast<int>(w.size()));
+    }
+    weights.assign(static_cast<size_t>(dst_size) * num_taps, 0.0f);
+    for (int i = 0; i < dst_size; i++) {
+        for (size_t k = 0; k < dst_weights[i].size(); k++) {
+            weights[static_cast<size_t>(i) * num_taps + k] = static_cast<float>(dst_weights[i][k]);
+        }
+    }
+    return num_taps;
+}
+
+/**
+ * @brief Horizontal pass of one destination pixel: filters num_comp (1 for Y, 2 for interleaved UV) components of a source row into p_out
+ */
+template<typename YuvUnit>
+COLORSPACE_HOST_DEVICE inline void ResampleRowPixel(const YuvUnit *p_row, int src_width, int num_comp, int start, const float *p_weights, int num_taps,
+                                                    float *p_out) {
+    float sum[2] = {0.0f, 0.0f};
+    for (int k = 0; k < num_taps; k++) {
+        int sx = (start + k < src_width - 1 ? start + k : src_width - 1) * num_comp;
+        for (int c = 0; c < num_comp; c++) {
+            sum[c] += p_weights[k] * static_cast<float>(p_row[sx + c]);
+        }
+    }
+    for (int c = 0; c < num_comp; c++) {
+        p_out[c] = sum[c];
+    }
+}
+
+/**
+ * @brief Vertical pass of one destination pixel: filters num_comp components of a column of the horizontally filtered rows (col_pitch floats apart)
+ *        and rounds them to the destination
+ */
+template<typename YuvUnit>
+COLORSPACE_HOST_DEVICE inline void ResampleColumnPixel(const float *p_col, size_t col_pitch, int src_height, int num_comp, int start, const float *p_weights,
+                                                       int num_taps, YuvUnit *p_dst) {
+    const float max_value = static_cast<float>((1 << (sizeof(YuvUnit) * 8)) - 1);
+    float sum[2] = {0.0f, 0.0f};
+    for (int k = 0; k < num_taps; k++) {
+        const float *p_tmp = p_col + (start + k < src_height - 1 ? start + k : src_height - 1) * col_pitch;
+        for (int c = 0; c < num_comp; c++) {
+            sum[c] += p_weights[k] * p_tmp[c];
+        }
+    }
+    for (int c = 0; c < num_comp; c++) {
+        p_dst[c] = static_cast<YuvUnit>(fminf(fmaxf(sum[c] + 0.5f, 0.0f), max_value));
+    }
+}
+
+template<typename YuvUnit>
+void ResamplePlaneRef(ResampleFilter filter, const uint8_t *p_src, int src_pitch, int src_width, int src_height, int num_comp, uint8_t *p_dst,
+                      int dst_pitch, int dst_width, int dst_height) {
+    std::vector<int> x_start, y_start;
+    std::vector<float> x_weights, y_weights;
+    int x_taps = BuildResampleTable(filter, src_width, dst_width, x_start, x_weights);
+    int y_taps = BuildResampleTable(filter, src_height, dst_height, y_start, y_weights);
+    size_t tmp_pitch = static_cast<size_t>(dst_width) * num_comp;
+    std::vector<float> tmp(tmp_pitch * src_height);
+    for (int y = 0; y < src_height; y++) {
+        const YuvUnit *p_row = reinterpret_cast<const YuvUnit *>(p_src + static_cast<size_t>(y) * src_pitch);
+        for (int x = 0; x < dst_width; x++) {
+            ResampleRowPixel(p_row, src_width, num_comp, x_start[x], &x_weights[static_cast<size_t>(x) * x_taps], x_taps, &tmp[y * tmp_pitch + x * num_comp]);
+        }
+    }
+    for (int y = 0; y < dst_height; y++) {
+        YuvUnit *p_row = reinterpret_cast<YuvUnit *>(p_dst + static_cast<size_t>(y) * dst_pitch);
+        for (int x = 0; x < dst_width; x++) {
+            ResampleColumnPixel(&tmp[x * num_comp], tmp_pitch, src_height, num_comp, y_start[y], &y_weights[static_cast<size_t>(y) * y_taps], y_taps,
+                                p_row + x * num_comp);
+        }
+    }
+}
+
+/**
+ * @brief CPU reference of YuvResampler::Resize on host memory. It uses the same tables and per pixel code as the kernels, so the results only
+ *        differ by the floating point contraction of the device compiler (at most 1 at the rounding boundaries).
+ *
+ * @param p_src - source NV12/P016 surface (host memory); the UV plane starts src_v_pitch rows after the Y plane
+ * @param is_16bit - true for P016, false for NV12
+ * @param p_dst - destination NV12/P016 surface (host memory); the UV plane follows the Y plane at p_dst + dst_pitch * dst_height
+ */
+inline void ResampleYuv420Ref(ResampleFilter filter, const uint8_t *p_src, int src_pitch, int src_width, int src_height, int src_v_pitch, bool is_16bit,
+                              uint8_t *p_dst, int dst_pitch, int dst_width, int dst_height) {
+    const uint8_t *p_src_uv = p_src + static_cast<size_t>(src_v_pitch) * src_pitch;
+    uint8_t *p_dst_uv = p_dst + static_cast<size_t>(dst_height) * dst_pitch;
+    int src_uv_width = (src_width + 1) >> 1, src_uv_height = (src_height + 1) >> 1;
+    if (is_16bit) {
+        ResamplePlaneRef<uint16_t>(filter, p_src, src_pitch, src_width, src_height, 1, p_dst, dst_pitch, dst_width, dst_height);
+        ResamplePlaneRef<uint16_t>(filter, p_src_uv, src_pitch, src_uv_width, src_uv_height, 2, p_dst_uv, dst_pitch, dst_width >> 1, dst_height >> 1);
+    } else {
+        ResamplePlaneRef<uint8_t>(filter, p_src, src_pitch, src_width, src_height, 1, p_dst, dst_pitch, dst_width, dst_height);
+        ResamplePlaneRef<uint8_t>(filter, p_src_uv, src_pitch, src_uv_width, src_uv_height, 2, p_dst_uv, dst_pitch, dst_width >> 1, dst_height >> 1);
+    }
+}
@@ -0,0 +1,206 @@
+
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include "resample_kernels.h"
+#include "roc_video_dec.h"
+
+/**
+ * @brief One plane (Y or interleaved UV) of one rendition; the horizontal pass filters the source rows into dp_tmp
+ *        (src_height rows of dst_width * num_comp floats), the vertical pass filters dp_tmp into the destination
+ */
+struct ResamplePlaneDesc {
+    const uint8_t *dp_src;
+    int src_pitch;
+    int src_width;
+    int src_height;
+    float *dp_tmp;
+    uint8_t *dp_dst;
+    int dst_pitch;
+    int dst_width;
+    int dst_height;
+    int num_comp;
+    const int *dp_x_start;
+    const float *dp_x_weights;
+    int x_taps;
+    const int *dp_y_start;
+    const float *dp_y_weights;
+    int y_taps;
+};
+
+template<typename YuvUnit>
+static __global__ void ResampleHorizontalKernel(const ResamplePlaneDesc *p_descs) {
+    const ResamplePlaneDesc &desc = p_descs[blockIdx.z];
+    int x = blockIdx.x * blockDim.x + threadIdx.x,
+        y = blockIdx.y * blockDim.y + threadIdx.y;
+    if (x >= desc.dst_width || y >= desc.src_height) {
+        return;
+    }
+    const YuvUnit *p_row = reinterpret_cast<const YuvUnit *>(desc.dp_src + static_cast<size_t>(y) * desc.src_pitch);
+    ResampleRowPixel(p_row, desc.src_width, desc.num_comp, desc.dp_x_start[x], desc.dp_x_weights + x * desc.x_taps, desc.x_taps,
+                     desc.dp_tmp + (static_cast<size_t>(y) * desc.dst_width + x) * desc.num_comp);
+}
+
+template<typename YuvUnit>
+static __global__ void ResampleVerticalKernel(const ResamplePlaneDesc *p_descs) {
+    const ResamplePlaneDesc &desc = p_descs[blockIdx.z];
+    int x = blockIdx.x * blockDim.x + threadIdx.x,
+        y = blockIdx.y * blockDim.y + threadIdx.y;
+    if (x >= desc.dst_width || y >= desc.dst_height) {
+        return;
+    }
+    size_t tmp_pitch = static_cast<size_t>(desc.dst_width) * desc.num_comp;
+    YuvUnit *p_dst = reinterpret_cast<YuvUnit *>(desc.dp_dst + static_cast<size_t>(y) * desc.dst_pitch) + x * desc.num_comp;
+    ResampleColumnPixel(desc.dp_tmp + x * desc.num_comp, tmp_pitch, desc.src_height, desc.num_comp, desc.dp_y_start[y], desc.dp_y_weights + y * desc.y_taps,
+                        desc.y_taps, p_dst);
+}
+
+YuvResampler::~YuvResampler() {
+    for (auto &table : tables_) {
+        hipFree(table.second.dp_start);
+        hipFree(table.second.dp_weights);
+    }
+    if (dp_tmp_) {
+        hipFree(dp_tmp_);
+    }
+    if (dp_desc_) {
+        hipFree(dp_desc_);
+    }
+}
+
+const YuvResampler::FilterTable *YuvResampler::GetTable(int src_size, int dst_size) {
+    auto key = std::make_tuple(static_cast<int>(filter_), src_size, dst_size);
+    auto it = tables_.find(key);
+    if (it != tables_.end()) {
+        return &it->second;
+    }
+    std::vector<int> start;
+    std::vector<float> weights;
+    FilterTable table = {};
+    table.num_taps = BuildResampleTable(filter_, src_size, dst_size, start, weights);
+    if (hipMalloc(&table.dp_start, start.size() * sizeof(int)) != hipSuccess ||
+        hipMalloc(&table.dp_weights, weights.size() * sizeof(float)) != hipSuccess) {
+        std::cerr << "ERROR: hipMalloc failed to allocate the resample coefficient table!" << std::endl;
+        hipFree(table.dp_start);
+        return nullptr;
+    }
+    // built once per geometry, so a synchronous upload keeps the host vectors simple
+    HIP_API_CALL(hipMemcpyHtoD(table.dp_start, start.data(), start.size() * sizeof(int)));
+    HIP_API_CALL(hipMemcpyHtoD(table.dp_weights, weights.data(), weights.size() * sizeof(float)));
+    return &tables_.emplace(key, table).first->second;
+}
+
+bool YuvResampler::ResizeLadder(const uint8_t *dp_src, int src_pitch, int src_width, int src_height, int src_v_pitch, bool is_16bit,
+                                const ResampleOutput *p_outputs, int num_outputs, hipStream_t hip_stream) {
+    if (num_outputs <= 0) {
+        return true;
+    }
+    std::vector<ResamplePlaneDesc> descs(2 * num_outputs);
+    std::vector<size_t> tmp_offsets(descs.size());
+    size_t tmp_size = 0;
+    int max_dst_width = 0, max_dst_height = 0;
+    for (int i = 0; i < num_outputs; i++) {
+        const ResampleOutput &output = p_outputs[i];
+        if (output.dst_width <= 0 || output.dst_height <= 0 || (output.dst_width | output.dst_height) & 1) {
+            std::cerr << "ERROR: resample output " << i << " must have an even width and height!" << std::endl;
+            return false;
+        }
+        for (int plane = 0; plane < 2; plane++) {
+            ResamplePlaneDesc &desc = descs[2 * i + plane];
+            desc.num_comp = plane + 1;
+            desc.src_pitch = src_pitch;
+            desc.src_width = plane ? (src_width + 1) >> 1 : src_width;
+            desc.src_height = plane ? (src_height + 1) >> 1 : src_height;
+            desc.dp_src = dp_src + (plane ? static_cast<size_t>(src_v_pitch) * src_pitch : 0);
+            desc.dst_pitch = output.dst_pitch;
+            desc.dst_width = plane ? output.dst_width >> 1 : output.dst_width;
+            desc.dst_height = plane ? output.dst_height >> 1 : output.dst_height;
+            desc.dp_dst = output.dp_dst + (plane ? static_cast<size_t>(output.dst_height) * output.dst_pitch : 0);
+            const FilterTable *p_x_table = GetTable(desc.src_width, desc.dst_width);
+            const FilterTable *p_y_table = GetTable(desc.src_height, desc.dst_height);
+            if (!p_x_table || !p_y_table) {
+                return false;
+            }
+            desc.dp_x_start = p_x_table->dp_start;
+            desc.dp_x_weights = p_x_table->dp_weights;
+            desc.x_taps = p_x_table->num_taps;
+            desc.dp_y_start = p_y_table->dp_start;
+            desc.dp_y_weights = p_y_table->dp_weights;
+            desc.y_taps = p_y_table->num_taps;
+            tmp_offsets[2 * i + plane] = tmp_size;
+            tmp_size += static_cast<size_t>(desc.src_height) * desc.dst_width * desc.num_comp;
+        }
+        max_dst_width = std::max(max_dst_width, output.dst_width);
+        max_dst_height = std::max(max_dst_height, output.dst_height);
+    }
+
+    tmp_size *= sizeof(float);
+    if (tmp_size > tmp_size_) {
+        if (dp_tmp_) {
+            HIP_API_CALL(hipStreamSynchronize(hip_stream));
+            hipFree(dp_tmp_);
+            dp_tmp_ = nullptr;
+        }
+        if (hipMalloc(&dp_tmp_, tmp_size) != hipSuccess) {
+            std::cerr << "ERROR: hipMalloc failed to allocate the resample intermediate buffer!" << std::endl;
+            tmp_size_ = 0;
+            return false;
+        }
+        tmp_size_ = tmp_size;
+    }
+    size_t desc_size = descs.size() * sizeof(ResamplePlaneDesc);
+    if (desc_size > desc_size_) {
+        if (dp_desc_) {
+            HIP_API_CALL(hipStreamSynchronize(hip_stream));
+            hipFree(dp_desc_);
+            dp_desc_ = nullptr;
+        }
+        if (hipMalloc(&dp_desc_, desc_size) != hipSuccess) {
+            std::cerr << "ERROR: hipMalloc failed to allocate the resample descriptors!" << std::endl;
+            desc_size_ = 0;
+            return false;
+        }
+        desc_size_ = desc_size;
+    }
+    for (size_t i = 0; i < descs.size(); i++) {
+        descs[i].dp_tmp = dp_tmp_ + tmp_offsets[i];
+    }
+    // the pageable source is staged by the runtime before the call returns, so the local vector can go out of scope
+    HIP_API_CALL(hipMemcpyHtoDAsync(dp_desc_, descs.data(), desc_size, hip_stream));
+
+    // one launch per pass for every plane of every rendition: blockIdx.z selects the plane, the blocks outside of a plane return at once
+    const ResamplePlaneDesc *p_descs = static_cast<const ResamplePlaneDesc *>(dp_desc_);
+    dim3 block(16, 16);
+    dim3 grid_h((max_dst_width + block.x - 1) / block.x, (src_height + block.y - 1) / block.y, descs.size());
+    dim3 grid_v((max_dst_width + block.x - 1) / block.x, (max_dst_height + block.y - 1) / block.y, descs.size());
+    if (is_16bit) {
+        ResampleHorizontalKernel<uint16_t><<<grid_h, block, 0, hip_stream>>>(p_descs);
+        ResampleVerticalKernel<uint16_t><<<grid_v, block, 0, hip_stream>>>(p_descs);
+    } else {
+        ResampleHorizontalKernel<uint8_t><<<grid_h, block, 0, hip_stream>>>(p_descs);
+        ResampleVerticalKernel<uint8_t><<<grid_v, block, 0, hip_stream>>>(p_descs);
+    }
+    return true;
+}
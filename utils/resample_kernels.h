@@ -0,0 +1,112 @@
+
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <stdint.h>
+#include <map>
+#include <tuple>
+#include <vector>
+#include <hip/hip_runtime.h>
+#include "resample_filter.h"
+
+/*!
+ * \file
+ * \brief Separable high quality resampler for NV12/P016 surfaces.
+ *
+ * Each output pixel is a weighted sum over a filter footprint that widens with the downscale ratio, so large downscales (e.g. 4K to 224x224)
+ * do not alias like the texture (bilinear) or nearest neighbour paths of ResizeNv12/ResizeP016. The per row and per column filter coefficients
+ * only depend on the (source size, destination size, filter) of an axis: they are computed once on the host (BuildResampleTable of
+ * resample_filter.h) and cached in device memory.
+ * Several renditions of a source (a thumbnail ladder) are produced with one horizontal and one vertical launch.
+ */
+
+/**
+ * @brief One destination rendition of YuvResampler::ResizeLadder
+ */
+struct ResampleOutput {
+    uint8_t *dp_dst;    // NV12 or P016 destination (device memory); the UV plane follows the Y plane at dp_dst + dst_pitch * dst_height
+    int dst_pitch;      // pitch in bytes
+    int dst_width;      // even width
+    int dst_height;     // even height
+};
+
+/**
+ * @brief Separable resampler with a device cache of the coefficient tables of every geometry it has seen.
+ *        An instance is meant to be used from one thread; calls on different streams must be serialized by the caller as the
+ *        intermediate buffer is shared.
+ */
+class YuvResampler {
+    public:
+        YuvResampler(ResampleFilter filter = ResampleFilter_Area) : filter_(filter) {};
+        ~YuvResampler();
+        /**
+         * @brief Selects the filter of the next calls; the tables of the previous filter stay cached
+         */
+        void SetFilter(ResampleFilter filter) { filter_ = filter; };
+        ResampleFilter GetFilter() const { return filter_; };
+
+        /**
+         * @brief Resizes an NV12/P016 surface
+         *
+         * @param dp_src - source surface (device memory)
+         * @param src_pitch - source pitch in bytes
+         * @param src_width - source width
+         * @param src_height - source height
+         * @param src_v_pitch - row of the UV plane relative to dp_src (vertical stride of the luma plane)
+         * @param is_16bit - true for P016, false for NV12
+         * @param output - destination
+         * @param hip_stream - stream for launching the kernels
+         * @return true on success
+         */
+        bool Resize(const uint8_t *dp_src, int src_pitch, int src_width, int src_height, int src_v_pitch, bool is_16bit, const ResampleOutput &output,
+                    hipStream_t hip_stream) {
+            return ResizeLadder(dp_src, src_pitch, src_width, src_height, src_v_pitch, is_16bit, &output, 1, hip_stream);
+        };
+
+        /**
+         * @brief Resizes an NV12/P016 surface into num_outputs renditions of different sizes with one launch per pass for all of them.
+         *        The parameters are the same as Resize.
+         */
+        bool ResizeLadder(const uint8_t *dp_src, int src_pitch, int src_width, int src_height, int src_v_pitch, bool is_16bit,
+                          const ResampleOutput *p_outputs, int num_outputs, hipStream_t hip_stream);
+
+        /**
+         * @brief Returns the number of coefficient tables in the device cache
+         */
+        size_t GetCachedTableCount() const { return tables_.size(); };
+
+    private:
+        struct FilterTable {
+            int *dp_start;
+            float *dp_weights;
+            int num_taps;
+        };
+        const FilterTable *GetTable(int src_size, int dst_size);
+
+        ResampleFilter filter_;
+        std::map<std::tuple<int, int, int>, FilterTable> tables_;   // keyed by (filter, src_size, dst_size)
+        float *dp_tmp_ = nullptr;       // horizontally filtered planes
+        size_t tmp_size_ = 0;
+        void *dp_desc_ = nullptr;       // per plane descriptors of the launches
+        size_t desc_size_ = 0;
+};
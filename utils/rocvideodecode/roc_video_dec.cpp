@@ -23,7 +23,7 @@ THE SOFTWARE.
 #include "roc_video_dec.h"
 
 RocVideoDecoder::RocVideoDecoder(int device_id, OutputSurfaceMemoryType out_mem_type, rocDecVideoCodec codec, bool force_zero_latency,
-              const Rect *p_crop_rect, bool extract_user_sei_Message, uint32_t disp_delay, int max_width, int max_height, uint32_t clk_rate) :
+              const Rect *p_crop_rect, bool extract_user_sei_Message, uint32_t disp_delay, int max_width, int max_height, uint32_t clk_rate, bool byte_stream, bool slice_submission, bool annex_b) :
               device_id_{device_id}, out_mem_type_(out_mem_type), codec_id_(codec), b_force_zero_latency_(force_zero_latency), 
               b_extract_sei_message_(extract_user_sei_Message), disp_delay_(disp_delay), max_width_ (max_width), max_height_(max_height) {
 
@@ -42,11 +42,15 @@ RocVideoDecoder::RocVideoDecoder(int device_id, OutputSurfaceMemoryType out_mem_
     parser_params.max_num_decode_surfaces = 1; // let the parser to determine the decode buffer pool size
     parser_params.clock_rate = clk_rate;
     parser_params.max_display_delay = disp_delay_;
+    parser_params.byte_stream = byte_stream;
+    parser_params.slice_submission = slice_submission;
+    parser_params.annex_b = annex_b;
     parser_params.user_data = this;
     parser_params.pfn_sequence_callback = HandleVideoSequenceProc;
     parser_params.pfn_decode_picture = HandlePictureDecodeProc;
     parser_params.pfn_display_picture = b_force_zero_latency_ ? NULL : HandlePictureDisplayProc;
     parser_params.pfn_get_sei_msg = b_extract_sei_message_ ? HandleSEIMessagesProc : NULL;
+    parser_params.pfn_get_operating_point = HandleOperatingPointProc;
     ROCDEC_API_CALL(rocDecCreateVideoParser(&rocdec_parser_, &parser_params));
 }
 
@@ -260,6 +264,10 @@ int RocVideoDecoder::HandleVideoSequence(RocdecVideoFormat *p_video_format) {
         ROCDEC_THROW("Rocdec:: Invalid video format in HandleVideoSequence: ", ROCDEC_INVALID_PARAMETER);
         return 0;
     }
+    if (out_mem_type_ == OUT_SURFACE_MEM_DEV_POST_PROCESSED && !post_process_callback_) {
+        ROCDEC_THROW("Rocdec:: OUT_SURFACE_MEM_DEV_POST_PROCESSED needs a post-process callback set with SetPostProcessCallback() before decoding ", ROCDEC_INVALID_PARAMETER);
+        return 0;
+    }
     auto start_time = StartTimer();
     input_video_info_str_.str("");
     input_video_info_str_.clear();
@@ -305,6 +313,11 @@ int RocVideoDecoder::HandleVideoSequence(RocdecVideoFormat *p_video_format) {
     }
     // store current video format: this is required to call reconfigure from application in case of random seek
     if (curr_video_format_ptr_) memcpy(curr_video_format_ptr_, p_video_format, sizeof(RocdecVideoFormat));
+    // the color description can change with a new sequence without a decoder reconfiguration
+    output_surface_info_.color_primaries = p_video_format->video_signal_description.color_primaries;
+    output_surface_info_.transfer_characteristics = p_video_format->video_signal_description.transfer_characteristics;
+    output_surface_info_.matrix_coefficients = p_video_format->video_signal_description.matrix_coefficients;
+    output_surface_info_.full_range = p_video_format->video_signal_description.video_full_range_flag;
 
     if (coded_width_ && coded_height_) {
         // rocdecCreateDecoder() has been called before, and now there's possible config change
@@ -393,7 +406,7 @@ int RocVideoDecoder::HandleVideoSequence(RocdecVideoFormat *p_video_format) {
     chroma_height_ = (int)(ceil(target_height_ * GetChromaHeightFactor(video_surface_format_)));
     num_chroma_planes_ = GetChromaPlaneCount(video_surface_format_);
     if (video_chroma_format_ == rocDecVideoChromaFormat_Monochrome) num_chroma_planes_ = 0;
-    if (out_mem_type_ == OUT_SURFACE_MEM_DEV_INTERNAL || out_mem_type_ == OUT_SURFACE_MEM_NOT_MAPPED)
+    if (out_mem_type_ == OUT_SURFACE_MEM_DEV_INTERNAL || out_mem_type_ == OUT_SURFACE_MEM_NOT_MAPPED || out_mem_type_ == OUT_SURFACE_MEM_DEV_POST_PROCESSED)
         GetSurfaceStrideInternal(video_surface_format_, p_video_format->coded_width, p_video_format->coded_height, &surface_stride_, &surface_vstride_);
     else {
         surface_stride_ = videoDecodeCreateInfo.target_width * byte_per_pixel_;    // todo:: check if we need pitched memory for faster copy
@@ -403,7 +416,7 @@ int RocVideoDecoder::HandleVideoSequence(RocdecVideoFormat *p_video_format) {
     output_surface_info_.output_width = target_width_;
     output_surface_info_.output_height = target_height_;
     output_surface_info_.output_pitch  = surface_stride_;
-    output_surface_info_.output_vstride = (out_mem_type_ == OUT_SURFACE_MEM_DEV_INTERNAL) ? surface_vstride_ : videoDecodeCreateInfo.target_height;
+    output_surface_info_.output_vstride = (out_mem_type_ == OUT_SURFACE_MEM_DEV_INTERNAL || out_mem_type_ == OUT_SURFACE_MEM_DEV_POST_PROCESSED) ? surface_vstride_ : videoDecodeCreateInfo.target_height;
     output_surface_info_.bit_depth = bitdepth_minus_8_ + 8;
     output_surface_info_.bytes_per_pixel = byte_per_pixel_;
     output_surface_info_.surface_format = video_surface_format_;
@@ -417,6 +430,10 @@ int RocVideoDecoder::HandleVideoSequence(RocdecVideoFormat *p_video_format) {
     } else if (out_mem_type_ == OUT_SURFACE_MEM_HOST_COPIED){
         output_surface_info_.output_surface_size_in_bytes = GetFrameSize();
         output_surface_info_.mem_type = OUT_SURFACE_MEM_HOST_COPIED;
+    } else if (out_mem_type_ == OUT_SURFACE_MEM_DEV_POST_PROCESSED) {
+        // the post-process callback sees the mapped decoded surface
+        output_surface_info_.output_surface_size_in_bytes = surface_stride_ * (surface_vstride_ + (chroma_vstride_ * num_chroma_planes_));
+        output_surface_info_.mem_type = OUT_SURFACE_MEM_DEV_POST_PROCESSED;
     } else {
         output_surface_info_.output_surface_size_in_bytes = surface_stride_ * (surface_vstride_ + (chroma_vstride_ * num_chroma_planes_));
         output_surface_info_.mem_type = OUT_SURFACE_MEM_NOT_MAPPED;
@@ -510,7 +527,7 @@ int RocVideoDecoder::ReconfigureDecoder(RocdecVideoFormat *p_video_format) {
         num_frames_flushed_during_reconfig_ += p_reconfig_params_->p_fn_reconfigure_flush(this, p_reconfig_params_->reconfig_flush_mode, static_cast<void *>(p_reconfig_params_->p_reconfig_user_struct));
     // clear the existing output buffers of different size
     // note that app lose the remaining frames in the vp_frames/vp_frames_q in case application didn't set p_fn_reconfigure_flush_ callback
-    if (out_mem_type_ == OUT_SURFACE_MEM_DEV_INTERNAL) {
+    if (out_mem_type_ == OUT_SURFACE_MEM_DEV_INTERNAL || out_mem_type_ == OUT_SURFACE_MEM_DEV_POST_PROCESSED) {
         ReleaseInternalFrames();
     } else {
         std::lock_guard<std::mutex> lock(mtx_vp_frame_);
@@ -550,7 +567,7 @@ int RocVideoDecoder::ReconfigureDecoder(RocdecVideoFormat *p_video_format) {
         }
     }
 
-    if (out_mem_type_ == OUT_SURFACE_MEM_DEV_INTERNAL || out_mem_type_ == OUT_SURFACE_MEM_NOT_MAPPED) {
+    if (out_mem_type_ == OUT_SURFACE_MEM_DEV_INTERNAL || out_mem_type_ == OUT_SURFACE_MEM_NOT_MAPPED || out_mem_type_ == OUT_SURFACE_MEM_DEV_POST_PROCESSED) {
         GetSurfaceStrideInternal(video_surface_format_, coded_width_, coded_height_, &surface_stride_, &surface_vstride_);
     } else {
         surface_stride_ = target_width_ * byte_per_pixel_;
@@ -563,7 +580,7 @@ int RocVideoDecoder::ReconfigureDecoder(RocdecVideoFormat *p_video_format) {
     output_surface_info_.output_width = target_width_;
     output_surface_info_.output_height = target_height_;
     output_surface_info_.output_pitch  = surface_stride_;
-    output_surface_info_.output_vstride = (out_mem_type_ == OUT_SURFACE_MEM_DEV_INTERNAL) ? surface_vstride_ : target_height_;
+    output_surface_info_.output_vstride = (out_mem_type_ == OUT_SURFACE_MEM_DEV_INTERNAL || out_mem_type_ == OUT_SURFACE_MEM_DEV_POST_PROCESSED) ? surface_vstride_ : target_height_;
     output_surface_info_.bit_depth = bitdepth_minus_8_ + 8;
     output_surface_info_.bytes_per_pixel = byte_per_pixel_;
     output_surface_info_.surface_format = video_surface_format_;
@@ -577,6 +594,10 @@ int RocVideoDecoder::ReconfigureDecoder(RocdecVideoFormat *p_video_format) {
     } else if (out_mem_type_ == OUT_SURFACE_MEM_HOST_COPIED) {
         output_surface_info_.output_surface_size_in_bytes = GetFrameSize();
         output_surface_info_.mem_type = OUT_SURFACE_MEM_HOST_COPIED;
+    } else if (out_mem_type_ == OUT_SURFACE_MEM_DEV_POST_PROCESSED) {
+        // the post-process callback sees the mapped decoded surface
+        output_surface_info_.output_surface_size_in_bytes = surface_stride_ * (surface_vstride_ + (chroma_vstride_ * num_chroma_planes_));
+        output_surface_info_.mem_type = OUT_SURFACE_MEM_DEV_POST_PROCESSED;
     } else {
         output_surface_info_.output_surface_size_in_bytes = surface_stride_ * (surface_vstride_ + (chroma_vstride_ * num_chroma_planes_));
         output_surface_info_.mem_type = OUT_SURFACE_MEM_NOT_MAPPED;
@@ -641,8 +662,15 @@ int RocVideoDecoder::HandlePictureDecode(RocdecPicParams *pPicParams) {
     if (!roc_decoder_) {
         THROW("RocDecoder not initialized: failed with ErrCode: " +  TOSTR(ROCDEC_NOT_INITIALIZED));
     }
-    pic_num_in_dec_order_[pPicParams->curr_pic_idx] = decode_poc_++;
+    // A picture submitted in slice batches is counted with its first batch and decoded with its last one
+    bool slice_batch = (pPicParams->slice_batch_flags & ROCDEC_SLICE_BATCH) != 0;
+    if (!slice_batch || (pPicParams->slice_batch_flags & ROCDEC_SLICE_BATCH_FIRST)) {
+        pic_num_in_dec_order_[pPicParams->curr_pic_idx] = decode_poc_++;
+    }
     ROCDEC_API_CALL(rocDecDecodeFrame(roc_decoder_, pPicParams));
+    if (slice_batch && !(pPicParams->slice_batch_flags & ROCDEC_SLICE_BATCH_LAST)) {
+        return 1;
+    }
     last_decode_surf_idx_ = pPicParams->curr_pic_idx;
     decoded_pic_cnt_++;
     if (b_force_zero_latency_ && ((!pPicParams->field_pic_flag) || (pPicParams->second_field))) {
@@ -717,6 +745,20 @@ int RocVideoDecoder::HandlePictureDisplay(RocdecParserDispInfo *pDispInfo) {
             std::lock_guard<std::mutex> lock(mtx_vp_frame_);
             vp_frames_q_.push(dec_frame);
             output_frame_cnt_++;
+        } else if (out_mem_type_ == OUT_SURFACE_MEM_DEV_POST_PROCESSED) {
+            // run the user post-processing on the mapped surface instead of copying the decoded surface first
+            DecFrameBuffer dec_frame = { 0 };
+            dec_frame.frame_ptr = post_process_callback_(static_cast<uint8_t *>(src_dev_ptr[0]), &output_surface_info_, pDispInfo->pts, hip_stream_);
+            if (!dec_frame.frame_ptr) {
+                ROCDEC_THROW("Rocdec:: the post-process callback returned no output for picture " + TOSTR(pic_num_in_dec_order_[pDispInfo->picture_index]), ROCDEC_INVALID_PARAMETER);
+            }
+            dec_frame.pts = pDispInfo->pts;
+            dec_frame.picture_index = pDispInfo->picture_index;
+            // the decoder can reuse the surface once the post-processing kernels have read it
+            HIP_API_CALL(hipStreamSynchronize(hip_stream_));
+            std::lock_guard<std::mutex> lock(mtx_vp_frame_);
+            vp_frames_q_.push(dec_frame);
+            output_frame_cnt_++;
         } else {
             // copy the decoded surface info device or host
             uint8_t *p_dec_frame = nullptr;
@@ -798,6 +840,22 @@ int RocVideoDecoder::HandlePictureDisplay(RocdecParserDispInfo *pDispInfo) {
     return 1;
 }
 
+void RocVideoDecoder::SetOperatingPoint(int operating_point, bool output_all_layers) {
+    // operating_points_cnt_minus_1 is coded with 5 bits
+    if (operating_point < 0 || operating_point > 31) {
+        THROW("Invalid AV1 operating point: " + std::to_string(operating_point));
+    }
+    operating_point_ = operating_point;
+    output_all_layers_ = output_all_layers;
+}
+
+int RocVideoDecoder::GetOperatingPoint(RocdecOperatingPointInfo *p_op_info) {
+    if (p_op_info->codec == rocDecVideoCodec_AV1 && operating_point_ >= 0 && operating_point_ < p_op_info->av1.operating_points_cnt) {
+        return operating_point_ | (output_all_layers_ << 10);
+    }
+    return -1;
+}
+
 int RocVideoDecoder::GetSEIMessage(RocdecSeiMessageInfo *pSEIMessageInfo) {
     uint32_t sei_num_mesages = pSEIMessageInfo->sei_message_count;
     if (sei_num_mesages) {
@@ -856,7 +914,7 @@ uint8_t* RocVideoDecoder::GetFrame(int64_t *pts) {
     if (output_frame_cnt_ > 0) {
         std::lock_guard<std::mutex> lock(mtx_vp_frame_);
         output_frame_cnt_--;
-        if (out_mem_type_ == OUT_SURFACE_MEM_DEV_INTERNAL && !vp_frames_q_.empty()) {
+        if ((out_mem_type_ == OUT_SURFACE_MEM_DEV_INTERNAL || out_mem_type_ == OUT_SURFACE_MEM_DEV_POST_PROCESSED) && !vp_frames_q_.empty()) {
             DecFrameBuffer *fb = &vp_frames_q_.front();
             if (pts) *pts = fb->pts;
             return fb->frame_ptr;
@@ -871,7 +929,7 @@ uint8_t* RocVideoDecoder::GetFrame(int64_t *pts) {
 
 
 /**
- * @brief function to release frame after use by the application: Only used with "OUT_SURFACE_MEM_DEV_INTERNAL"
+ * @brief function to release frame after use by the application: Only used with "OUT_SURFACE_MEM_DEV_INTERNAL" and "OUT_SURFACE_MEM_DEV_POST_PROCESSED"
  * 
  * @param pTimestamp - timestamp of the frame to be released (unmapped)
  * @return true      - success
@@ -881,7 +939,7 @@ uint8_t* RocVideoDecoder::GetFrame(int64_t *pts) {
 bool RocVideoDecoder::ReleaseFrame(int64_t pTimestamp, bool b_flushing) {
     if (out_mem_type_ == OUT_SURFACE_MEM_NOT_MAPPED)
         return true;    // nothing to do
-    if (out_mem_type_ != OUT_SURFACE_MEM_DEV_INTERNAL) {
+    if (out_mem_type_ != OUT_SURFACE_MEM_DEV_INTERNAL && out_mem_type_ != OUT_SURFACE_MEM_DEV_POST_PROCESSED) {
         if (!b_flushing)  // if not flushing the buffers are re-used, so keep them
             return true;            // nothing to do
         else {
@@ -917,7 +975,7 @@ bool RocVideoDecoder::ReleaseFrame(int64_t pTimestamp, bool b_flushing) {
  * @return false     - falied
  */
 bool RocVideoDecoder::ReleaseInternalFrames() {
-    if (out_mem_type_ != OUT_SURFACE_MEM_DEV_INTERNAL || out_mem_type_ == OUT_SURFACE_MEM_NOT_MAPPED)
+    if (out_mem_type_ != OUT_SURFACE_MEM_DEV_INTERNAL && out_mem_type_ != OUT_SURFACE_MEM_DEV_POST_PROCESSED)
         return true;            // nothing to do
     // only needed when using internal mapped buffer
     while (!vp_frames_q_.empty()) {
@@ -933,7 +991,8 @@ void RocVideoDecoder::SaveFrameToFile(std::string output_file_name, void *surf_m
     uint8_t *hst_ptr = nullptr;
     bool is_rgb = (rgb_image_size != 0);
     uint64_t output_image_size = is_rgb ? rgb_image_size : surf_info->output_surface_size_in_bytes;
-    if (surf_info->mem_type == OUT_SURFACE_MEM_DEV_INTERNAL || surf_info->mem_type == OUT_SURFACE_MEM_DEV_COPIED) {
+    if (surf_info->mem_type == OUT_SURFACE_MEM_DEV_INTERNAL || surf_info->mem_type == OUT_SURFACE_MEM_DEV_COPIED ||
+        surf_info->mem_type == OUT_SURFACE_MEM_DEV_POST_PROCESSED) {
         if (hst_ptr == nullptr) {
             hst_ptr = new uint8_t [output_image_size];
         }
@@ -1043,9 +1102,10 @@ void RocVideoDecoder::UpdateMd5ForDataBuffer(void *pDevMem, int rgb_image_size){
     uint8_t *hstPtr = nullptr;
     hstPtr = new uint8_t [rgb_image_size];
     hipError_t hip_status = hipSuccess;
-    hip_status = hipMemcpyDtoH((void *)hstPtr, pDevMem, rgb_image_size);
+    // hipMemcpyDefault: the buffer can also be in host memory (e.g. converted on the CPU from a host copied frame)
+    hip_status = hipMemcpy((void *)hstPtr, pDevMem, rgb_image_size, hipMemcpyDefault);
     if (hip_status != hipSuccess) {
-        std::cout << "ERROR: hipMemcpyDtoH failed! (" << hip_status << ")" << std::endl;
+        std::cout << "ERROR: hipMemcpy failed! (" << hip_status << ")" << std::endl;
         delete [] hstPtr;
         return;
     }
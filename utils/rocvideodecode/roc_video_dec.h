@@ -31,6 +31,7 @@ THE SOFTWARE.
 #include <sstream>
 #include <string.h>
 #include <queue>
+#include <functional>
 #include <stdexcept>
 #include <exception>
 #include <cstring>
@@ -65,7 +66,9 @@ typedef enum OutputSurfaceMemoryType_enum {
     OUT_SURFACE_MEM_DEV_INTERNAL = 0,      /**<  Internal interopped decoded surface memory(original mapped decoded surface) */
     OUT_SURFACE_MEM_DEV_COPIED = 1,        /**<  decoded output will be copied to a separate device memory (the user doesn't need to call release) **/
     OUT_SURFACE_MEM_HOST_COPIED = 2,        /**<  decoded output will be copied to a separate host memory (the user doesn't need to call release) **/
-    OUT_SURFACE_MEM_NOT_MAPPED  = 3         /**< <  decoded output is not available (interop won't be used): useful for decode only performance app*/
+    OUT_SURFACE_MEM_NOT_MAPPED  = 3,        /**< <  decoded output is not available (interop won't be used): useful for decode only performance app*/
+    OUT_SURFACE_MEM_DEV_POST_PROCESSED = 4  /**<  the post-process callback set with SetPostProcessCallback() runs on the mapped decoded surface and writes into user device memory;
+                                                  GetFrame() returns the pointer returned by the callback (the user must call release) */
 } OutputSurfaceMemoryType;
 
 #define TOSTR(X) std::to_string(static_cast<int>(X))
@@ -152,8 +155,18 @@ typedef struct OutputSurfaceInfoType {
     uint64_t output_surface_size_in_bytes; /**< Output Image Size in Bytes; including both luma and chroma planes*/ 
     rocDecVideoSurfaceFormat surface_format;      /**< Chroma format of the decoded image*/
     OutputSurfaceMemoryType mem_type;             /**< Output mem_type of the surface*/    
+    uint8_t color_primaries;             /**< Color primaries of the stream (ITU-T H.273); 2: unspecified*/
+    uint8_t transfer_characteristics;    /**< Transfer characteristics of the stream (ITU-T H.273); 2: unspecified*/
+    uint8_t matrix_coefficients;         /**< Matrix coefficients of the stream (ITU-T H.273); 2: unspecified*/
+    uint8_t full_range;                  /**< 1 if the samples use the full range (video_full_range_flag)*/
 } OutputSurfaceInfo;
 
+/**
+ * @brief Post-process functor of OUT_SURFACE_MEM_DEV_POST_PROCESSED: enqueues the post-processing (e.g. color conversion or resize) of the
+ *        mapped decoded surface p_surface on hip_stream and returns the output buffer of the frame, which GetFrame() returns
+ */
+typedef std::function<uint8_t *(uint8_t *p_surface, OutputSurfaceInfo *surf_info, int64_t pts, hipStream_t hip_stream)> PostProcessCallback;
+
 typedef struct ReconfigParams_t {
     PFNRECONFIGUEFLUSHCALLBACK p_fn_reconfigure_flush;
     void *p_reconfig_user_struct;
@@ -177,10 +190,13 @@ class RocVideoDecoder {
        * @param max_height 
        * @param clk_rate 
        * @param force_zero_latency 
+       * @param byte_stream - DecodeFrame takes arbitrary chunks of the elementary stream instead of access units
+       * @param slice_submission - H.264/HEVC: the slices are submitted to the decoder in batches as soon as they are parsed
+       * @param annex_b - AV1: the stream is in the length delimited bitstream format (Annex B) instead of the low overhead bitstream format
        */
         RocVideoDecoder(int device_id,  OutputSurfaceMemoryType out_mem_type, rocDecVideoCodec codec, bool force_zero_latency = false,
                           const Rect *p_crop_rect = nullptr, bool extract_user_SEI_Message = false, uint32_t disp_delay = 0, int max_width = 0, int max_height = 0,
-                          uint32_t clk_rate = 1000);
+                          uint32_t clk_rate = 1000, bool byte_stream = false, bool slice_submission = false, bool annex_b = false);
         ~RocVideoDecoder();
         
         rocDecVideoCodec GetCodecId() { return codec_id_; }
@@ -269,6 +285,25 @@ class RocVideoDecoder {
          */
         bool SetReconfigParams(ReconfigParams *p_reconfig_params, bool b_force_reconfig_flush = false);
         
+        /**
+         * @brief Sets the post-process functor of OUT_SURFACE_MEM_DEV_POST_PROCESSED. It runs in the display callback of the parser on the
+         *        mapped decoded surface, so the decoded surface is not copied and is handed back to the decoder as soon as the enqueued
+         *        kernels have completed.
+         *
+         * @param post_process_callback - functor; it must be set before the first DecodeFrame call and return the output of the frame:
+         *                                the sequence header throws without it, and the display of a picture throws if it returns nullptr
+         */
+        void SetPostProcessCallback(PostProcessCallback post_process_callback) { post_process_callback_ = post_process_callback; };
+
+        /**
+         * @brief AV1: selects the operating point of a scalable stream when the next sequence header is parsed. The OBUs of the layers that
+         *        are not in the operating point are not decoded.
+         *
+         * @param operating_point - operating point index (0 to 31); operating point 0 is used if the stream has fewer operating points
+         * @param output_all_layers - output the frames of all the spatial layers instead of only the highest spatial layer of each temporal unit
+         */
+        void SetOperatingPoint(int operating_point, bool output_all_layers);
+
         /**
          * @brief Function to force Reconfigure Flush: needed for random seeking to key frames
          * 
@@ -293,7 +328,7 @@ class RocVideoDecoder {
         uint8_t* GetFrame(int64_t *pts);
 
         /**
-         * @brief function to release frame after use by the application: Only used with "OUT_SURFACE_MEM_DEV_INTERNAL"
+         * @brief function to release frame after use by the application: Only used with "OUT_SURFACE_MEM_DEV_INTERNAL" and "OUT_SURFACE_MEM_DEV_POST_PROCESSED"
          * 
          * @param pTimestamp - timestamp of the frame to be released (unmapped)
          * @param b_flushing - true when flushing
@@ -343,6 +378,9 @@ class RocVideoDecoder {
          */
         void InitMd5();
 
+        /**
+         * @brief Helper function to add a buffer in device or host memory to the MD5 calculation
+         */
         void UpdateMd5ForDataBuffer(void *pDevMem, int rgb_image_size);
 
         /**
@@ -408,6 +446,11 @@ class RocVideoDecoder {
          */
         static int ROCDECAPI HandleSEIMessagesProc(void *p_user_data, RocdecSeiMessageInfo *p_sei_message_info) { return ((RocVideoDecoder *)p_user_data)->GetSEIMessage(p_sei_message_info); } 
 
+        /**
+         *   @brief  Callback function to be registered for getting a callback when the operating point of an AV1 sequence is selected
+         */
+        static int ROCDECAPI HandleOperatingPointProc(void *p_user_data, RocdecOperatingPointInfo *p_op_info) { return ((RocVideoDecoder *)p_user_data)->GetOperatingPoint(p_op_info); }
+
         /**
          *   @brief  This function gets called when a sequence is ready to be decoded. The function also gets called
              when there is format change
@@ -430,6 +473,11 @@ class RocVideoDecoder {
          */
         int GetSEIMessage(RocdecSeiMessageInfo *p_sei_message_info);
 
+        /**
+         *   @brief  This function gets called when an AV1 sequence header is parsed. It returns the operating point set by SetOperatingPoint
+         */
+        int GetOperatingPoint(RocdecOperatingPointInfo *p_op_info);
+
         /**
          *   @brief  This function reconfigure decoder if there is a change in sequence params.
          */
@@ -468,8 +516,11 @@ class RocVideoDecoder {
         OutputSurfaceMemoryType out_mem_type_ = OUT_SURFACE_MEM_DEV_INTERNAL;
         bool b_extract_sei_message_ = false;
         bool b_force_zero_latency_ = false;
+        int operating_point_ = 0;
+        bool output_all_layers_ = false;
         uint32_t disp_delay_;
         ReconfigParams *p_reconfig_params_ = nullptr;
+        PostProcessCallback post_process_callback_;
         bool b_force_recofig_flush_ = false;
         int32_t num_frames_flushed_during_reconfig_ = 0;
         hipDeviceProp_t hip_dev_prop_;
@@ -0,0 +1,224 @@
+
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <stdint.h>
+#include <stddef.h>
+#include "colorspace_info.h"
+
+/*!
+ * \file
+ * \brief Per pixel code of the tensor conversions, shared by the kernels of tensor_kernels.h and their CPU references.
+ *
+ * Like colorspace_info.h, the header doesn't depend on HIP, so the CPU references build and run without a GPU.
+ */
+
+/**
+ * @brief Per channel normalization applied after the color conversion: out[c] = (rgb[c] / max_value - mean[c]) / std_dev[c],
+ *        where rgb is in [0, max_value] and the channels are in output order (R, G, B or B, G, R)
+ */
+struct TensorNormParams {
+    float mean[3] = {0.0f, 0.0f, 0.0f};
+    float std_dev[3] = {1.0f, 1.0f, 1.0f};
+};
+
+/**
+ * @brief Per channel affine transform of the planar tensor outputs of YuvToPlanarTensor: out[c] = rgb[c] * scale[c] + bias[c], where rgb is in [0, 1]
+ *        and the channels are in output order. The defaults write the [0, 1] color values.
+ */
+struct TensorScaleBias {
+    float scale[3] = {1.0f, 1.0f, 1.0f};
+    float bias[3] = {0.0f, 0.0f, 0.0f};
+};
+
+/**
+ * @brief Conversion parameters passed by value to the kernels: no constant memory upload per call
+ */
+struct TensorConvertParams {
+    YuvToRgbParams color;   // YUV to RGB conversion of the source stream
+    float scale[3];         // 1 / (max_value * std_dev), in output channel order
+    float bias[3];          // -mean / std_dev, in output channel order
+    int bgr;                // output channel order
+    float fx_scale;         // src_width / dst_width
+    float fy_scale;         // src_height / dst_height
+};
+
+inline TensorConvertParams GetTensorConvertParams(int src_width, int src_height, int dst_width, int dst_height, bool bgr, const TensorNormParams &norm_params,
+                                                  const ColorSpaceInfo &color_info, int unit_bits) {
+    TensorConvertParams params;
+    params.color = GetYuvToRgbParams(color_info, unit_bits);
+    for (int c = 0; c < 3; c++) {
+        params.scale[c] = 1.0f / (params.color.max_value * norm_params.std_dev[c]);
+        params.bias[c] = -norm_params.mean[c] / norm_params.std_dev[c];
+    }
+    params.bgr = bgr;
+    params.fx_scale = static_cast<float>(src_width) / dst_width;
+    params.fy_scale = static_cast<float>(src_height) / dst_height;
+    return params;
+}
+
+inline TensorConvertParams GetPlanarTensorParams(bool bgr, const TensorScaleBias &scale_bias, const ColorSpaceInfo &color_info, int unit_bits) {
+    TensorConvertParams params = {};
+    params.color = GetYuvToRgbParams(color_info, unit_bits);
+    for (int c = 0; c < 3; c++) {
+        params.scale[c] = scale_bias.scale[c] / params.color.max_value;
+        params.bias[c] = scale_bias.bias[c];
+    }
+    params.bgr = bgr;
+    params.fx_scale = params.fy_scale = 1.0f;
+    return params;
+}
+
+/**
+ * @brief Bilinear sample of component comp of a plane with num_comp interleaved components, pixel centers aligned
+ */
+template<typename YuvUnit>
+COLORSPACE_HOST_DEVICE inline float BilinearSample(const uint8_t *p_plane, int pitch, int width, int height, int num_comp, int comp, float sx, float sy) {
+    sx = fminf(fmaxf(sx, 0.0f), static_cast<float>(width - 1));
+    sy = fminf(fmaxf(sy, 0.0f), static_cast<float>(height - 1));
+    int x0 = static_cast<int>(sx), y0 = static_cast<int>(sy);
+    int x1 = x0 + 1 < width ? x0 + 1 : x0, y1 = y0 + 1 < height ? y0 + 1 : y0;
+    float wx = sx - x0, wy = sy - y0;
+    const YuvUnit *row0 = reinterpret_cast<const YuvUnit *>(p_plane + y0 * pitch);
+    const YuvUnit *row1 = reinterpret_cast<const YuvUnit *>(p_plane + y1 * pitch);
+    float top = row0[x0 * num_comp + comp] + wx * (row0[x1 * num_comp + comp] - static_cast<float>(row0[x0 * num_comp + comp]));
+    float bottom = row1[x0 * num_comp + comp] + wx * (row1[x1 * num_comp + comp] - static_cast<float>(row1[x0 * num_comp + comp]));
+    return top + wy * (bottom - top);
+}
+
+/**
+ * @brief Bilinear sample of a 4:2:0 surface at the source position (sx, sy), in pixel edge coordinates, converted to RGB in [0, max_value]
+ */
+template<typename YuvUnit>
+COLORSPACE_HOST_DEVICE inline void SampleYuv420ToRgb(const uint8_t *p_y, const uint8_t *p_uv, int pitch, int src_width, int src_height,
+                                                  const YuvToRgbParams &color, float sx, float sy, float rgb[3]) {
+    float fy = BilinearSample<YuvUnit>(p_y, pitch, src_width, src_height, 1, 0, sx - 0.5f, sy - 0.5f);
+    int uv_width = (src_width + 1) >> 1, uv_height = (src_height + 1) >> 1;
+    float fu = BilinearSample<YuvUnit>(p_uv, pitch, uv_width, uv_height, 2, 0, sx * 0.5f - 0.5f, sy * 0.5f - 0.5f);
+    float fv = BilinearSample<YuvUnit>(p_uv, pitch, uv_width, uv_height, 2, 1, sx * 0.5f - 0.5f, sy * 0.5f - 0.5f);
+    YuvToRgbFloat(color, fy, fu, fv, rgb);
+}
+
+/**
+ * @brief Computes the 3 normalized output channels of the destination pixel (x, y). Shared by the kernels and the CPU reference.
+ */
+template<typename YuvUnit>
+COLORSPACE_HOST_DEVICE inline void YuvToTensorPixel(const uint8_t *p_y, const uint8_t *p_uv, int pitch, int src_width, int src_height,
+                                                 const TensorConvertParams &params, int x, int y, float out[3]) {
+    float rgb[3];
+    SampleYuv420ToRgb<YuvUnit>(p_y, p_uv, pitch, src_width, src_height, params.color, (x + 0.5f) * params.fx_scale, (y + 0.5f) * params.fy_scale, rgb);
+    for (int c = 0; c < 3; c++) {
+        out[c] = rgb[params.bgr ? 2 - c : c] * params.scale[c] + params.bias[c];
+    }
+}
+
+/**
+ * @brief Converts the pixel (x, y) of an NV12/P016 or YUV444/YUV444P16 surface at its size into the 3 output channels, with one chroma sample
+ *        per 2x2 block for 4:2:0 like the packed color conversion kernels
+ */
+template<typename YuvUnit>
+COLORSPACE_HOST_DEVICE inline void YuvToPlanarTensorPixel(const uint8_t *p_y, int pitch, int v_pitch, bool is_444, const TensorConvertParams &params,
+                                                       int x, int y, float out[3]) {
+    const uint8_t *p_chroma = p_y + static_cast<size_t>(v_pitch) * pitch;
+    float fy = reinterpret_cast<const YuvUnit *>(p_y + static_cast<size_t>(y) * pitch)[x];
+    float fu, fv;
+    if (is_444) {
+        fu = reinterpret_cast<const YuvUnit *>(p_chroma + static_cast<size_t>(y) * pitch)[x];
+        fv = reinterpret_cast<const YuvUnit *>(p_chroma + static_cast<size_t>(v_pitch + y) * pitch)[x];
+    } else {
+        const YuvUnit *p_uv = reinterpret_cast<const YuvUnit *>(p_chroma + static_cast<size_t>(y >> 1) * pitch) + (x & ~1);
+        fu = p_uv[0];
+        fv = p_uv[1];
+    }
+    float rgb[3];
+    YuvToRgbFloat(params.color, fy, fu, fv, rgb);
+    for (int c = 0; c < 3; c++) {
+        out[c] = rgb[params.bgr ? 2 - c : c] * params.scale[c] + params.bias[c];
+    }
+}
+
+template<typename YuvUnit>
+void ResizeYuvToTensorRef(const uint8_t *p_yuv, int yuv_pitch, int src_width, int src_height, int v_pitch, float *p_tensor,
+                          int dst_width, int dst_height, bool bgr, const TensorNormParams &norm_params, const ColorSpaceInfo &color_info) {
+    TensorConvertParams params = GetTensorConvertParams(src_width, src_height, dst_width, dst_height, bgr, norm_params, color_info,
+                                                        sizeof(YuvUnit) * 8);
+    const uint8_t *p_uv = p_yuv + static_cast<size_t>(v_pitch) * yuv_pitch;
+    size_t plane_size = static_cast<size_t>(dst_width) * dst_height;
+    for (int y = 0; y < dst_height; y++) {
+        for (int x = 0; x < dst_width; x++) {
+            float out[3];
+            YuvToTensorPixel<YuvUnit>(p_yuv, p_uv, yuv_pitch, src_width, src_height, params, x, y, out);
+            float *p_dst = p_tensor + static_cast<size_t>(y) * dst_width + x;
+            p_dst[0] = out[0];
+            p_dst[plane_size] = out[1];
+            p_dst[2 * plane_size] = out[2];
+        }
+    }
+}
+
+/**
+ * @brief CPU reference of ResizeNv12ToTensor/ResizeP016ToTensor on host memory; always writes FP32 values.
+ *        It uses the same per pixel code as the kernels, so the results only differ by the floating point contraction of the device compiler.
+ *
+ * @param p_yuv - source NV12/P016 surface (host memory)
+ * @param is_16bit - true for P016, false for NV12
+ * @param p_tensor - destination FP32 tensor of 3 * dst_height * dst_width elements (host memory)
+ */
+inline void ResizeYuv420ToTensorRef(const uint8_t *p_yuv, int yuv_pitch, int src_width, int src_height, int v_pitch, bool is_16bit, float *p_tensor,
+                                    int dst_width, int dst_height, bool bgr, const TensorNormParams &norm_params, const ColorSpaceInfo &color_info) {
+    if (is_16bit) {
+        ResizeYuvToTensorRef<uint16_t>(p_yuv, yuv_pitch, src_width, src_height, v_pitch, p_tensor, dst_width, dst_height, bgr, norm_params, color_info);
+    } else {
+        ResizeYuvToTensorRef<uint8_t>(p_yuv, yuv_pitch, src_width, src_height, v_pitch, p_tensor, dst_width, dst_height, bgr, norm_params, color_info);
+    }
+}
+
+/**
+ * @brief CPU reference of YuvToPlanarTensor (the floating point planar outputs of VideoPostProcess::ColorConvertYUV2RGB) on host memory; always
+ *        writes FP32 planes. It uses the same per pixel code as the kernel, so the results only differ by the floating point contraction of the
+ *        device compiler and the FP16/BF16 rounding of the kernel output.
+ *
+ * @param p_yuv - source NV12/P016 or YUV444/YUV444P16 surface (host memory)
+ * @param is_16bit - true for P016 and YUV444P16
+ * @param is_444 - true for YUV444 and YUV444P16
+ * @param p_tensor - destination FP32 planes of 3 * height * width elements (host memory)
+ */
+inline void YuvToPlanarTensorRef(const uint8_t *p_yuv, int yuv_pitch, int width, int height, int v_pitch, bool is_16bit, bool is_444, float *p_tensor,
+                                 bool bgr, const TensorScaleBias &scale_bias, const ColorSpaceInfo &color_info) {
+    TensorConvertParams params = GetPlanarTensorParams(bgr, scale_bias, color_info, is_16bit ? 16 : 8);
+    size_t plane_size = static_cast<size_t>(width) * height;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            float out[3];
+            if (is_16bit) {
+                YuvToPlanarTensorPixel<uint16_t>(p_yuv, yuv_pitch, v_pitch, is_444, params, x, y, out);
+            } else {
+                YuvToPlanarTensorPixel<uint8_t>(p_yuv, yuv_pitch, v_pitch, is_444, params, x, y, out);
+            }
+            float *p_dst = p_tensor + static_cast<size_t>(y) * width + x;
+            p_dst[0] = out[0];
+            p_dst[plane_size] = out[1];
+            p_dst[2 * plane_size] = out[2];
+        }
+    }
+}
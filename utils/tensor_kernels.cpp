@@ -0,0 +1,303 @@
+
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <vector>
+#include <hip/hip_fp16.h>
+#include "tensor_kernels.h"
+#include "roc_video_dec.h"
+
+template<typename T>
+__device__ inline T FromFloat(float value);
+template<>
+__device__ inline float FromFloat<float>(float value) { return value; }
+template<>
+__device__ inline __half FromFloat<__half>(float value) { return __float2half(value); }
+
+/**
+ * @brief bfloat16 storage: the upper 16 bits of the float value, rounded to nearest even
+ */
+struct Bfloat16 {
+    uint16_t bits;
+};
+template<>
+__device__ inline Bfloat16 FromFloat<Bfloat16>(float value) {
+    uint32_t u = __float_as_uint(value);
+    return Bfloat16{static_cast<uint16_t>((u + 0x7fffu + ((u >> 16) & 1u)) >> 16)};
+}
+
+/**
+ * @brief Writes the 3 channels of the pixel (x, y) into the tensor of one image
+ */
+template<typename TensorUnit>
+__device__ inline void StoreTensorPixel(TensorUnit *p_tensor, TensorLayout layout, int dst_width, int dst_height, int x, int y, const float out[3]) {
+    size_t pixel = static_cast<size_t>(y) * dst_width + x;
+    if (layout == TensorLayout_NHWC) {
+        TensorUnit *p_dst = p_tensor + 3 * pixel;
+        p_dst[0] = FromFloat<TensorUnit>(out[0]);
+        p_dst[1] = FromFloat<TensorUnit>(out[1]);
+        p_dst[2] = FromFloat<TensorUnit>(out[2]);
+    } else {
+        size_t plane_size = static_cast<size_t>(dst_width) * dst_height;
+        TensorUnit *p_dst = p_tensor + pixel;
+        p_dst[0] = FromFloat<TensorUnit>(out[0]);
+        p_dst[plane_size] = FromFloat<TensorUnit>(out[1]);
+        p_dst[2 * plane_size] = FromFloat<TensorUnit>(out[2]);
+    }
+}
+
+template<typename YuvUnit, typename TensorUnit>
+__global__ static void ResizeYuvToTensorKernel(const uint8_t *dp_y, const uint8_t *dp_uv, int pitch, int src_width, int src_height,
+                                               TensorUnit *dp_tensor, int dst_width, int dst_height, TensorConvertParams params) {
+    int x = blockIdx.x * blockDim.x + threadIdx.x;
+    int y = blockIdx.y * blockDim.y + threadIdx.y;
+    if (x >= dst_width || y >= dst_height) {
+        return;
+    }
+    float out[3];
+    YuvToTensorPixel<YuvUnit>(dp_y, dp_uv, pitch, src_width, src_height, params, x, y, out);
+    StoreTensorPixel<TensorUnit>(dp_tensor, TensorLayout_NCHW, dst_width, dst_height, x, y, out);
+}
+
+/**
+ * @brief Per surface descriptor of the batched kernel, read from device memory as the batch can exceed the kernel argument size
+ */
+struct TensorBatchDesc {
+    const uint8_t *dp_y;
+    const uint8_t *dp_uv;
+    int pitch;
+    int src_width;
+    int src_height;
+    int is_16bit;
+    TensorConvertParams params;
+};
+
+/**
+ * @brief blockIdx.z selects the surface, so the bit depth branch is uniform within a block
+ */
+template<typename TensorUnit>
+__global__ static void ResizeYuvBatchToTensorKernel(const TensorBatchDesc *dp_desc, TensorUnit *dp_tensor, TensorLayout layout, int dst_width, int dst_height) {
+    int x = blockIdx.x * blockDim.x + threadIdx.x;
+    int y = blockIdx.y * blockDim.y + threadIdx.y;
+    if (x >= dst_width || y >= dst_height) {
+        return;
+    }
+    const TensorBatchDesc &desc = dp_desc[blockIdx.z];
+    float out[3];
+    if (desc.is_16bit) {
+        YuvToTensorPixel<uint16_t>(desc.dp_y, desc.dp_uv, desc.pitch, desc.src_width, desc.src_height, desc.params, x, y, out);
+    } else {
+        YuvToTensorPixel<uint8_t>(desc.dp_y, desc.dp_uv, desc.pitch, desc.src_width, desc.src_height, desc.params, x, y, out);
+    }
+    TensorUnit *p_tensor = dp_tensor + static_cast<size_t>(blockIdx.z) * 3 * dst_width * dst_height;
+    StoreTensorPixel<TensorUnit>(p_tensor, layout, dst_width, dst_height, x, y, out);
+}
+
+template<typename YuvUnit>
+static void ResizeYuvToTensor(uint8_t *dp_yuv, int yuv_pitch, int src_width, int src_height, int v_pitch, void *dp_tensor, TensorDataType data_type,
+                              int dst_width, int dst_height, bool bgr, const TensorNormParams &norm_params, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    TensorConvertParams params = GetTensorConvertParams(src_width, src_height, dst_width, dst_height, bgr, norm_params, color_info,
+                                                        sizeof(YuvUnit) * 8);
+    uint8_t *dp_uv = dp_yuv + static_cast<size_t>(v_pitch) * yuv_pitch;
+    dim3 block(16, 16);
+    dim3 grid((dst_width + block.x - 1) / block.x, (dst_height + block.y - 1) / block.y);
+    if (data_type == TensorDataType_FP16) {
+        ResizeYuvToTensorKernel<YuvUnit, __half><<<grid, block, 0, hip_stream>>>(dp_yuv, dp_uv, yuv_pitch, src_width, src_height,
+            static_cast<__half *>(dp_tensor), dst_width, dst_height, params);
+    } else if (data_type == TensorDataType_BF16) {
+        ResizeYuvToTensorKernel<YuvUnit, Bfloat16><<<grid, block, 0, hip_stream>>>(dp_yuv, dp_uv, yuv_pitch, src_width, src_height,
+            static_cast<Bfloat16 *>(dp_tensor), dst_width, dst_height, params);
+    } else {
+        ResizeYuvToTensorKernel<YuvUnit, float><<<grid, block, 0, hip_stream>>>(dp_yuv, dp_uv, yuv_pitch, src_width, src_height,
+            static_cast<float *>(dp_tensor), dst_width, dst_height, params);
+    }
+}
+
+void ResizeNv12ToTensor(uint8_t *dp_nv12, int nv12_pitch, int src_width, int src_height, int v_pitch, void *dp_tensor, TensorDataType data_type,
+                        int dst_width, int dst_height, bool bgr, const TensorNormParams &norm_params, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    ResizeYuvToTensor<uint8_t>(dp_nv12, nv12_pitch, src_width, src_height, v_pitch, dp_tensor, data_type, dst_width, dst_height, bgr, norm_params,
+                               color_info, hip_stream);
+}
+
+void ResizeP016ToTensor(uint8_t *dp_p016, int p016_pitch, int src_width, int src_height, int v_pitch, void *dp_tensor, TensorDataType data_type,
+                        int dst_width, int dst_height, bool bgr, const TensorNormParams &norm_params, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    ResizeYuvToTensor<uint16_t>(dp_p016, p016_pitch, src_width, src_height, v_pitch, dp_tensor, data_type, dst_width, dst_height, bgr, norm_params,
+                                color_info, hip_stream);
+}
+
+size_t GetTensorBatchDescSize(int batch_size) {
+    return sizeof(TensorBatchDesc) * batch_size;
+}
+
+void ResizeYuv420BatchToTensor(const TensorBatchSrc *p_srcs, int batch_size, void *dp_batch_desc, void *dp_tensor, TensorDataType data_type,
+                               TensorLayout layout, int dst_width, int dst_height, bool bgr, const TensorNormParams &norm_params, hipStream_t hip_stream) {
+    if (batch_size <= 0) {
+        return;
+    }
+    std::vector<TensorBatchDesc> batch_desc(batch_size);
+    for (int i = 0; i < batch_size; i++) {
+        const TensorBatchSrc &src = p_srcs[i];
+        TensorBatchDesc &desc = batch_desc[i];
+        desc.dp_y = src.dp_yuv;
+        desc.dp_uv = src.dp_yuv + static_cast<size_t>(src.v_pitch) * src.pitch;
+        desc.pitch = src.pitch;
+        desc.src_width = src.width;
+        desc.src_height = src.height;
+        desc.is_16bit = src.is_16bit;
+        desc.params = GetTensorConvertParams(src.width, src.height, dst_width, dst_height, bgr, norm_params, src.color_info,
+                                             src.is_16bit ? 16 : 8);
+    }
+    // the pageable source is staged by the runtime before the call returns, so the local vector can go out of scope
+    HIP_API_CALL(hipMemcpyHtoDAsync(dp_batch_desc, batch_desc.data(), GetTensorBatchDescSize(batch_size), hip_stream));
+    dim3 block(16, 16);
+    dim3 grid((dst_width + block.x - 1) / block.x, (dst_height + block.y - 1) / block.y, batch_size);
+    if (data_type == TensorDataType_FP16) {
+        ResizeYuvBatchToTensorKernel<__half><<<grid, block, 0, hip_stream>>>(static_cast<const TensorBatchDesc *>(dp_batch_desc),
+            static_cast<__half *>(dp_tensor), layout, dst_width, dst_height);
+    } else if (data_type == TensorDataType_BF16) {
+        ResizeYuvBatchToTensorKernel<Bfloat16><<<grid, block, 0, hip_stream>>>(static_cast<const TensorBatchDesc *>(dp_batch_desc),
+            static_cast<Bfloat16 *>(dp_tensor), layout, dst_width, dst_height);
+    } else {
+        ResizeYuvBatchToTensorKernel<float><<<grid, block, 0, hip_stream>>>(static_cast<const TensorBatchDesc *>(dp_batch_desc),
+            static_cast<float *>(dp_tensor), layout, dst_width, dst_height);
+    }
+}
+
+template<typename YuvUnit, typename TensorUnit>
+__global__ static void YuvToPlanarTensorKernel(const uint8_t *dp_yuv, int pitch, int width, int height, int v_pitch, int is_444, TensorUnit *dp_tensor,
+                                               TensorConvertParams params) {
+    int x = blockIdx.x * blockDim.x + threadIdx.x;
+    int y = blockIdx.y * blockDim.y + threadIdx.y;
+    if (x >= width || y >= height) {
+        return;
+    }
+    float out[3];
+    YuvToPlanarTensorPixel<YuvUnit>(dp_yuv, pitch, v_pitch, is_444, params, x, y, out);
+    StoreTensorPixel<TensorUnit>(dp_tensor, TensorLayout_NCHW, width, height, x, y, out);
+}
+
+template<typename YuvUnit>
+static void YuvToPlanarTensorLaunch(const uint8_t *dp_yuv, int yuv_pitch, int width, int height, int v_pitch, bool is_444, void *dp_tensor,
+                                    TensorDataType data_type, const TensorConvertParams &params, hipStream_t hip_stream) {
+    dim3 block(64, 4);
+    dim3 grid((width + block.x - 1) / block.x, (height + block.y - 1) / block.y);
+    if (data_type == TensorDataType_FP16) {
+        YuvToPlanarTensorKernel<YuvUnit, __half><<<grid, block, 0, hip_stream>>>(dp_yuv, yuv_pitch, width, height, v_pitch, is_444,
+            static_cast<__half *>(dp_tensor), params);
+    } else if (data_type == TensorDataType_BF16) {
+        YuvToPlanarTensorKernel<YuvUnit, Bfloat16><<<grid, block, 0, hip_stream>>>(dp_yuv, yuv_pitch, width, height, v_pitch, is_444,
+            static_cast<Bfloat16 *>(dp_tensor), params);
+    } else {
+        YuvToPlanarTensorKernel<YuvUnit, float><<<grid, block, 0, hip_stream>>>(dp_yuv, yuv_pitch, width, height, v_pitch, is_444,
+            static_cast<float *>(dp_tensor), params);
+    }
+}
+
+void YuvToPlanarTensor(const uint8_t *dp_yuv, int yuv_pitch, int width, int height, int v_pitch, bool is_16bit, bool is_444, void *dp_tensor,
+                       TensorDataType data_type, bool bgr, const TensorScaleBias &scale_bias, const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+    TensorConvertParams params = GetPlanarTensorParams(bgr, scale_bias, color_info, is_16bit ? 16 : 8);
+    if (is_16bit) {
+        YuvToPlanarTensorLaunch<uint16_t>(dp_yuv, yuv_pitch, width, height, v_pitch, is_444, dp_tensor, data_type, params, hip_stream);
+    } else {
+        YuvToPlanarTensorLaunch<uint8_t>(dp_yuv, yuv_pitch, width, height, v_pitch, is_444, dp_tensor, data_type, params, hip_stream);
+    }
+}
+
+/**
+ * @brief Computes the 8-bit RGB/BGR values of the pixel (x, y) of a crop. Shared by the kernel and the CPU reference.
+ */
+template<typename YuvUnit>
+__host__ __device__ inline void RoiCropPixel(const uint8_t *p_y, const uint8_t *p_uv, int pitch, int src_width, int src_height, const YuvToRgbParams &color,
+                                             const RoiBox &box, int dst_width, int dst_height, bool bgr, int x, int y, uint8_t out[3]) {
+    float sx = box.left + (x + 0.5f) * (box.right - box.left) / dst_width;
+    float sy = box.top + (y + 0.5f) * (box.bottom - box.top) / dst_height;
+    float rgb[3];
+    SampleYuv420ToRgb<YuvUnit>(p_y, p_uv, pitch, src_width, src_height, color, sx, sy, rgb);
+    float scale = 255.0f / color.max_value;
+    for (int c = 0; c < 3; c++) {
+        out[c] = static_cast<uint8_t>(fminf(fmaxf(rgb[bgr ? 2 - c : c] * scale + 0.5f, 0.0f), 255.0f));
+    }
+}
+
+/**
+ * @brief blockIdx.z selects the box; every box reads the same surface, so the crops of one frame share the cached source lines
+ */
+template<typename YuvUnit>
+__global__ static void CropResizeYuvToRgbBatchKernel(const uint8_t *dp_y, const uint8_t *dp_uv, int pitch, int src_width, int src_height,
+                                                     const RoiBox *dp_rois, uint8_t *dp_rgb, int dst_width, int dst_height, int bgr, YuvToRgbParams color) {
+    int x = blockIdx.x * blockDim.x + threadIdx.x;
+    int y = blockIdx.y * blockDim.y + threadIdx.y;
+    if (x >= dst_width || y >= dst_height) {
+        return;
+    }
+    uint8_t out[3];
+    RoiCropPixel<YuvUnit>(dp_y, dp_uv, pitch, src_width, src_height, color, dp_rois[blockIdx.z], dst_width, dst_height, bgr, x, y, out);
+    uint8_t *p_dst = dp_rgb + (static_cast<size_t>(blockIdx.z) * dst_height * dst_width + static_cast<size_t>(y) * dst_width + x) * 3;
+    p_dst[0] = out[0];
+    p_dst[1] = out[1];
+    p_dst[2] = out[2];
+}
+
+void CropResizeYuv420ToRgbBatch(const uint8_t *dp_yuv, int yuv_pitch, int src_width, int src_height, int v_pitch, bool is_16bit, const RoiBox *p_rois,
+                                int num_rois, RoiBox *dp_rois, uint8_t *dp_rgb, int dst_width, int dst_height, bool bgr, const ColorSpaceInfo &color_info,
+                                hipStream_t hip_stream) {
+    if (num_rois <= 0) {
+        return;
+    }
+    // the pageable source is staged by the runtime before the call returns, so the caller can reuse p_rois at once
+    HIP_API_CALL(hipMemcpyHtoDAsync(dp_rois, const_cast<RoiBox *>(p_rois), num_rois * sizeof(RoiBox), hip_stream));
+    YuvToRgbParams color = GetYuvToRgbParams(color_info, is_16bit ? 16 : 8);
+    const uint8_t *dp_uv = dp_yuv + static_cast<size_t>(v_pitch) * yuv_pitch;
+    dim3 block(16, 16);
+    dim3 grid((dst_width + block.x - 1) / block.x, (dst_height + block.y - 1) / block.y, num_rois);
+    if (is_16bit) {
+        CropResizeYuvToRgbBatchKernel<uint16_t><<<grid, block, 0, hip_stream>>>(dp_yuv, dp_uv, yuv_pitch, src_width, src_height, dp_rois, dp_rgb,
+            dst_width, dst_height, bgr, color);
+    } else {
+        CropResizeYuvToRgbBatchKernel<uint8_t><<<grid, block, 0, hip_stream>>>(dp_yuv, dp_uv, yuv_pitch, src_width, src_height, dp_rois, dp_rgb,
+            dst_width, dst_height, bgr, color);
+    }
+}
+
+template<typename YuvUnit>
+static void CropResizeYuvToRgbBatchRef(const uint8_t *p_yuv, int yuv_pitch, int src_width, int src_height, int v_pitch, const RoiBox *p_rois, int num_rois,
+                                       uint8_t *p_rgb, int dst_width, int dst_height, bool bgr, const ColorSpaceInfo &color_info) {
+    YuvToRgbParams color = GetYuvToRgbParams(color_info, sizeof(YuvUnit) * 8);
+    const uint8_t *p_uv = p_yuv + static_cast<size_t>(v_pitch) * yuv_pitch;
+    for (int i = 0; i < num_rois; i++) {
+        for (int y = 0; y < dst_height; y++) {
+            for (int x = 0; x < dst_width; x++) {
+                RoiCropPixel<YuvUnit>(p_yuv, p_uv, yuv_pitch, src_width, src_height, color, p_rois[i], dst_width, dst_height, bgr, x, y, p_rgb);
+                p_rgb += 3;
+            }
+        }
+    }
+}
+
+void CropResizeYuv420ToRgbBatchRef(const uint8_t *p_yuv, int yuv_pitch, int src_width, int src_height, int v_pitch, bool is_16bit, const RoiBox *p_rois,
+                                   int num_rois, uint8_t *p_rgb, int dst_width, int dst_height, bool bgr, const ColorSpaceInfo &color_info) {
+    if (is_16bit) {
+        CropResizeYuvToRgbBatchRef<uint16_t>(p_yuv, yuv_pitch, src_width, src_height, v_pitch, p_rois, num_rois, p_rgb, dst_width, dst_height, bgr, color_info);
+    } else {
+        CropResizeYuvToRgbBatchRef<uint8_t>(p_yuv, yuv_pitch, src_width, src_height, v_pitch, p_rois, num_rois, p_rgb, dst_width, dst_height, bgr, color_info);
+    }
+}
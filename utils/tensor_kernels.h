@@ -0,0 +1,172 @@
+
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <stdint.h>
+#include <hip/hip_runtime.h>
+#include "colorspace_kernels.h"
+#include "tensor_convert.h"
+
+/*!
+ * \file
+ * \brief Fused post-processing kernels producing normalized tensors for inference.
+ *
+ * The decoded NV12/P016 surface is read once and resized (bilinear), color-converted and normalized in the same kernel,
+ * writing a planar (CHW) FP32/FP16/BF16 tensor without intermediate surfaces. The batched variant converts the surfaces of several decoders
+ * into one contiguous NCHW/NHWC batch tensor with a single kernel launch. The region of interest variant crops and resizes a list of boxes
+ * of one surface into a batch of 8-bit RGB images for second stage classifiers.
+ */
+
+typedef enum TensorDataType_ {
+    TensorDataType_FP32 = 0,
+    TensorDataType_FP16 = 1,
+    TensorDataType_BF16 = 2,    // bfloat16: upper 16 bits of the FP32 value, rounded to nearest even
+} TensorDataType;
+
+typedef enum TensorLayout_ {
+    TensorLayout_NCHW = 0,      // planar: all the values of a channel are contiguous
+    TensorLayout_NHWC = 1,      // interleaved: the channels of a pixel are contiguous
+} TensorLayout;
+
+/**
+ * @brief Resizes, color-converts and normalizes an NV12 surface into a planar (CHW) tensor in one kernel
+ *
+ * @param dp_nv12 - source NV12 surface (device memory)
+ * @param nv12_pitch - source pitch in bytes
+ * @param src_width - source width
+ * @param src_height - source height
+ * @param v_pitch - row of the UV plane relative to dp_nv12 (vertical stride of the luma plane)
+ * @param dp_tensor - destination tensor of 3 * dst_height * dst_width elements (device memory)
+ * @param data_type - destination element type
+ * @param dst_width - destination width
+ * @param dst_height - destination height
+ * @param bgr - channel order of the tensor: true for B, G, R planes; false for R, G, B planes
+ * @param norm_params - normalization parameters
+ * @param color_info - color description of the source stream
+ * @param hip_stream - stream for launching the kernel
+ */
+void ResizeNv12ToTensor(uint8_t *dp_nv12, int nv12_pitch, int src_width, int src_height, int v_pitch, void *dp_tensor, TensorDataType data_type,
+                        int dst_width, int dst_height, bool bgr, const TensorNormParams &norm_params, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+
+/**
+ * @brief Resizes, color-converts and normalizes a P016 surface (10/12-bit MSB aligned in 16-bit) into a planar (CHW) tensor in one kernel.
+ *        The parameters are the same as ResizeNv12ToTensor.
+ */
+void ResizeP016ToTensor(uint8_t *dp_p016, int p016_pitch, int src_width, int src_height, int v_pitch, void *dp_tensor, TensorDataType data_type,
+                        int dst_width, int dst_height, bool bgr, const TensorNormParams &norm_params, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+
+/**
+ * @brief Color-converts an NV12/P016 or YUV444/YUV444P16 surface into a planar (CHW) FP32/FP16/BF16 tensor of the same size in one kernel,
+ *        with the chroma sampling of the packed color conversions (one chroma sample per 2x2 block for 4:2:0)
+ *
+ * @param dp_yuv - source surface (device memory)
+ * @param yuv_pitch - source pitch in bytes
+ * @param width - surface and tensor width
+ * @param height - surface and tensor height
+ * @param v_pitch - row of the first chroma plane relative to dp_yuv (vertical stride of the luma plane)
+ * @param is_16bit - true for P016/YUV444P16 (MSB aligned in 16-bit), false for NV12/YUV444
+ * @param is_444 - true for YUV444/YUV444P16 (three planes), false for NV12/P016
+ * @param dp_tensor - destination tensor of 3 * height * width elements (device memory)
+ * @param data_type - destination element type
+ * @param bgr - channel order of the tensor: true for B, G, R planes; false for R, G, B planes
+ * @param scale_bias - affine transform of the [0, 1] color values
+ * @param color_info - color description of the source stream
+ * @param hip_stream - stream for launching the kernel
+ */
+void YuvToPlanarTensor(const uint8_t *dp_yuv, int yuv_pitch, int width, int height, int v_pitch, bool is_16bit, bool is_444, void *dp_tensor,
+                       TensorDataType data_type, bool bgr, const TensorScaleBias &scale_bias, const ColorSpaceInfo &color_info, hipStream_t hip_stream);
+
+/**
+ * @brief One source surface of a batched conversion
+ */
+struct TensorBatchSrc {
+    const uint8_t *dp_yuv;      // NV12 or P016 surface (device memory)
+    int pitch;                  // pitch in bytes
+    int width;
+    int height;
+    int v_pitch;                // row of the UV plane relative to dp_yuv
+    bool is_16bit;              // true for P016, false for NV12
+    ColorSpaceInfo color_info;  // color description of the source stream
+};
+
+/**
+ * @brief Returns the size in bytes of the device descriptor buffer needed by ResizeYuv420BatchToTensor for batch_size surfaces
+ */
+size_t GetTensorBatchDescSize(int batch_size);
+
+/**
+ * @brief Resizes, color-converts and normalizes batch_size NV12/P016 surfaces of any size (e.g. from different decoders) into one contiguous
+ *        batch tensor of batch_size x 3 x dst_height x dst_width elements with a single kernel launch
+ *
+ * @param p_srcs - source surfaces (host array of batch_size entries)
+ * @param batch_size - number of surfaces
+ * @param dp_batch_desc - device buffer of GetTensorBatchDescSize(batch_size) bytes receiving the per surface descriptors; it must not be in use
+ *                        by a previous launch on another stream
+ * @param dp_tensor - destination batch tensor (device memory)
+ * @param layout - NCHW or NHWC
+ * Other parameters are the same as ResizeNv12ToTensor.
+ */
+void ResizeYuv420BatchToTensor(const TensorBatchSrc *p_srcs, int batch_size, void *dp_batch_desc, void *dp_tensor, TensorDataType data_type,
+                               TensorLayout layout, int dst_width, int dst_height, bool bgr, const TensorNormParams &norm_params, hipStream_t hip_stream);
+
+/**
+ * @brief Region of interest in source pixel coordinates (e.g. a detection box); right and bottom are exclusive and the box may extend beyond
+ *        the surface, in which case the edge pixels are repeated
+ */
+struct RoiBox {
+    float left;
+    float top;
+    float right;
+    float bottom;
+};
+
+/**
+ * @brief Crops num_rois boxes of an NV12/P016 surface and resizes (bilinear) and color-converts each of them into a dst_width x dst_height packed
+ *        8-bit RGB/BGR image with a single kernel launch
+ *
+ * @param dp_yuv - source NV12/P016 surface (device memory)
+ * @param yuv_pitch - source pitch in bytes
+ * @param src_width - source width
+ * @param src_height - source height
+ * @param v_pitch - row of the UV plane relative to dp_yuv
+ * @param is_16bit - true for P016, false for NV12
+ * @param p_rois - boxes (host memory), num_rois entries
+ * @param num_rois - number of boxes
+ * @param dp_rois - device buffer of num_rois entries receiving the boxes; it must not be in use by a previous launch on another stream
+ * @param dp_rgb - destination batch of num_rois * dst_height * dst_width * 3 bytes (device memory)
+ * @param dst_width - crop width
+ * @param dst_height - crop height
+ * @param bgr - channel order: B, G, R if true; R, G, B otherwise
+ * @param color_info - color description of the source stream
+ * @param hip_stream - stream for launching the kernel
+ */
+void CropResizeYuv420ToRgbBatch(const uint8_t *dp_yuv, int yuv_pitch, int src_width, int src_height, int v_pitch, bool is_16bit, const RoiBox *p_rois,
+                                int num_rois, RoiBox *dp_rois, uint8_t *dp_rgb, int dst_width, int dst_height, bool bgr, const ColorSpaceInfo &color_info,
+                                hipStream_t hip_stream);
+
+/**
+ * @brief CPU reference of CropResizeYuv420ToRgbBatch on host memory, using the same per pixel code as the kernel.
+ *        The parameters are the same as CropResizeYuv420ToRgbBatch without the device buffers.
+ */
+void CropResizeYuv420ToRgbBatchRef(const uint8_t *p_yuv, int yuv_pitch, int src_width, int src_height, int v_pitch, bool is_16bit, const RoiBox *p_rois,
+                                   int num_rois, uint8_t *p_rgb, int dst_width, int dst_height, bool bgr, const ColorSpaceInfo &color_info);
@@ -23,6 +23,15 @@ THE SOFTWARE.
 #pragma once
 
 #include <iostream>
+#include <algorithm>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 extern "C" {
     #include <libavcodec/avcodec.h>
     #include <libavformat/avformat.h>
@@ -61,6 +70,19 @@ typedef enum SeekCriteriaEnum {
     SEEK_CRITERIA_NUM,
 } SeekCriteria;
 
+/**
+ * @brief Demuxed packet returned by VideoDemuxer::Demux(PacketSpan &). The data is owned by the demuxer and stays valid until the next Demux/Seek call.
+ *
+ */
+struct PacketSpan {
+    uint8_t *data = nullptr;
+    size_t size = 0;
+    int64_t pts = 0;            // presentation timestamp in milliseconds
+    int64_t dts = 0;            // decode timestamp in stream time base units
+    int64_t duration = 0;       // duration in stream time base units
+    bool is_key_frame = false;
+};
+
 struct PacketData {
     int32_t key;
     int64_t pts;
@@ -131,7 +153,20 @@ class VideoDemuxer {
         AVCodecID GetCodecID() { return av_video_codec_id_; };
         VideoDemuxer(const char *input_file_path) : VideoDemuxer(CreateFmtContextUtil(input_file_path)) {}
         VideoDemuxer(StreamProvider *stream_provider) : VideoDemuxer(CreateFmtContextUtil(stream_provider)) {av_io_ctx_ = av_fmt_input_ctx_->pb;}
+        /**
+         * @brief Memory-backed demuxer: packets are read directly from the user buffer, which has to stay valid for the lifetime of the demuxer
+         *
+         * @param data - pointer to the whole input stream (container or elementary stream) in memory
+         * @param data_size - size of the input in bytes
+         */
+        VideoDemuxer(const uint8_t *data, size_t data_size) : VideoDemuxer(CreateFmtContextUtil(new MemoryStream(data, data_size))) { InitMemoryStream(); }
+        /**
+         * @brief Memory-backed demuxer reading from a memory mapped file when use_mmap is set
+         */
+        VideoDemuxer(const char *input_file_path, bool use_mmap) : VideoDemuxer(use_mmap ? CreateFmtContextUtil(MemoryStream::MapFile(input_file_path)) :
+                                                                                      CreateFmtContextUtil(input_file_path)) { InitMemoryStream(); }
         ~VideoDemuxer() {
+            StopReadAhead();
             if (!av_fmt_input_ctx_) {
                 return;
             }
@@ -149,79 +184,57 @@ class VideoDemuxer {
                 av_freep(&av_io_ctx_->buffer);
                 av_freep(&av_io_ctx_);
             }
-            if (data_with_header_) {
-                av_free(data_with_header_);
+            if (mem_stream_) {
+                delete mem_stream_;
             }
         }
         bool Demux(uint8_t **video, int *video_size, int64_t *pts = nullptr) {
-            if (!av_fmt_input_ctx_) {
-                return false;
-            }
-            *video_size = 0;
-            if (packet_->data) {
-                av_packet_unref(packet_);
+            PacketSpan packet;
+            bool ret = Demux(packet);
+            *video = packet.data;
+            *video_size = static_cast<int>(packet.size);
+            if (pts) {
+                *pts = packet.pts;
             }
-            int ret = 0;
-            while ((ret = av_read_frame(av_fmt_input_ctx_, packet_)) >= 0 && packet_->stream_index != av_stream_) {
-                av_packet_unref(packet_);
-            }
-            if (ret < 0) {
-                return false;
-            }
-            if (is_h264_ || is_hevc_) {
-                if (packet_filtered_->data) {
-                    av_packet_unref(packet_filtered_);
-                }
-                if (av_bsf_send_packet(av_bsf_ctx_, packet_) != 0) {
-                    std::cerr << "ERROR: av_bsf_send_packet failed!" << std::endl;
-                    return false;
-                }
-                if (av_bsf_receive_packet(av_bsf_ctx_, packet_filtered_) != 0) {
-                    std::cerr << "ERROR: av_bsf_receive_packet failed!" << std::endl;
-                    return false;
-                }
-                *video = packet_filtered_->data;
-                *video_size = packet_filtered_->size;
-                if (packet_filtered_->dts != AV_NOPTS_VALUE) {
-                    pkt_dts_ = packet_filtered_->dts;
-                } else {
-                    pkt_dts_ = packet_filtered_->pts;
-                }
-                if (pts) {
-                    *pts = (int64_t) (packet_filtered_->pts * default_time_scale_ * time_base_);
-                    pkt_duration_ = packet_filtered_->duration;
-                }
+            return ret;
+        }
+        /**
+         * @brief Returns the next packet of the video stream. The packet points to the AVPacket payload, to the output of the mp4toannexb
+         *        bitstream filter (length prefixed H.264/HEVC) or to the demuxer's output arena (MPEG-4 header insertion). The arena is
+         *        reused and only grows; the bitstream filter still allocates an output buffer for every packet. In read-ahead mode the
+         *        packet is taken from the read-ahead ring.
+         *
+         * @param packet - the packet span, valid until the next Demux/Seek call; size is 0 at the end of the stream
+         * @return true - a packet is returned
+         * @return false - end of stream or error
+         */
+        bool Demux(PacketSpan &packet) {
+            bool ret = false;
+            if (read_ahead_depth_ > 0) {
+                ret = DemuxFromReadAhead(packet);
             } else {
-                if (is_mpeg4_ && (frame_count_ == 0)) {
-                    int ext_data_size = av_fmt_input_ctx_->streams[av_stream_]->codecpar->extradata_size;
-                    if (ext_data_size > 0) {
-                        data_with_header_ = (uint8_t *)av_malloc(ext_data_size + packet_->size - 3 * sizeof(uint8_t));
-                        if (!data_with_header_) {
-                            std::cerr << "ERROR: av_malloc failed!" << std::endl;
-                            return false;
-                        }
-                        memcpy(data_with_header_, av_fmt_input_ctx_->streams[av_stream_]->codecpar->extradata, ext_data_size);
-                        memcpy(data_with_header_ + ext_data_size, packet_->data + 3, packet_->size - 3 * sizeof(uint8_t));
-                        *video = data_with_header_;
-                        *video_size = ext_data_size + packet_->size - 3 * sizeof(uint8_t);
-                    }
-                } else {
-                    *video = packet_->data;
-                    *video_size = packet_->size;
-                }
-                if (packet_->dts != AV_NOPTS_VALUE) {
-                    pkt_dts_ = packet_->dts;
-                } else {
-                    pkt_dts_ = packet_->pts;
-                }
-                if (pts) {
-                    *pts = (int64_t)(packet_->pts * default_time_scale_ * time_base_);
-                    pkt_duration_ = packet_->duration;
-                }
+                ret = DemuxFromSource(packet);
             }
-            frame_count_++;
-            return true;
+            if (ret) {
+                is_key_frame_ = packet.is_key_frame;
+                pkt_dts_ = packet.dts;
+                pkt_duration_ = packet.duration;
+            }
+            return ret;
+        }
+        /**
+         * @brief Enables the read-ahead mode: a background thread demuxes up to depth packets ahead of the caller into a ring of recycled
+         *        packet buffers, so that Demux returns from memory without waiting for the file I/O and the container parsing.
+         *        A deeper read-ahead (e.g. 32 to 64 packets) hides the latency spikes of network file systems and spinning disks.
+         *        Seek stops the thread; it is restarted by the next Demux call.
+         *
+         * @param depth - number of packets demuxed ahead; 0 disables the read-ahead mode (default)
+         */
+        void SetReadAheadDepth(int depth) {
+            StopReadAhead();
+            read_ahead_depth_ = std::max(depth, 0);
         }
+        int GetReadAheadDepth() const { return read_ahead_depth_; }
         bool Seek(VideoSeekContext& seek_ctx, uint8_t** pp_video, int* video_size) {
             /* !!! IMPORTANT !!!
                 * Across this function, packet decode timestamp (DTS) values are used to
@@ -240,6 +253,22 @@ class VideoDemuxer {
                 return false;
             }
 
+            // The seek reads the packets synchronously; in read-ahead mode the thread restarts from the new position on the next Demux call
+            StopReadAhead();
+            auto demux_from_source = [&](uint8_t **video, int *video_size, int64_t *pts) {
+                PacketSpan packet;
+                bool ret = DemuxFromSource(packet);
+                if (ret) {
+                    is_key_frame_ = packet.is_key_frame;
+                    pkt_dts_ = packet.dts;
+                    pkt_duration_ = packet.duration;
+                }
+                *video = packet.data;
+                *video_size = static_cast<int>(packet.size);
+                *pts = packet.pts;
+                return ret;
+            };
+
             // Seek for single frame;
             auto seek_frame = [&](VideoSeekContext const& seek_ctx, int flags) {
                 bool seek_backward = true;
@@ -299,7 +328,7 @@ class VideoDemuxer {
 
                 int seek_done = 0;
                 do {
-                    if (!Demux(pp_video, video_size, &pkt_data.pts)) {
+                    if (!demux_from_source(pp_video, video_size, &pkt_data.pts)) {
                         throw std::runtime_error("ERROR: Demux failed trying to seek for specified frame number/timestamp");
                     }
                     seek_done = is_seek_done(pkt_data, seek_ctx);
@@ -323,7 +352,7 @@ class VideoDemuxer {
             // Seek for closest key frame in the past;
             auto seek_for_prev_key_frame = [&](PacketData& pkt_data, VideoSeekContext& seek_ctx) {
                 seek_frame(seek_ctx, AVSEEK_FLAG_BACKWARD);
-                Demux(pp_video, video_size, &pkt_data.pts);
+                demux_from_source(pp_video, video_size, &pkt_data.pts);
                 seek_ctx.num_frames_decoded_ = static_cast<uint64_t>(pkt_data.pts / 1000 * frame_rate_);
                 seek_ctx.out_frame_pts_ = pkt_data.pts;
                 seek_ctx.out_frame_duration_ = pkt_data.duration = pkt_duration_;
@@ -355,6 +384,8 @@ class VideoDemuxer {
         const uint32_t GetBitRate() const { return bit_rate_;}
         const double GetFrameRate() const {return frame_rate_;};
         bool IsVFR() const { return frame_rate_ != avg_frame_rate_; };
+        bool IsSeekable() const { return is_seekable_; };
+        bool IsKeyFrame() const { return is_key_frame_; };
         int64_t TsFromTime(double ts_sec) {
             // Convert integer timestamp representation to AV_TIME_BASE and switch to fixed_point
             auto const ts_tbu = llround(ts_sec * AV_TIME_BASE);
@@ -369,6 +400,207 @@ class VideoDemuxer {
         }
 
     private:
+        /**
+         * @brief Input held in memory (user buffer or memory mapped file) read through a seekable avio context.
+         *        The avio buffer is kept small so that packet payloads larger than it are copied once, directly from the input into the packet.
+         */
+        class MemoryStream {
+            public:
+                MemoryStream(const uint8_t *data, size_t data_size, bool is_mapped = false) : data_(data), data_size_(data_size), is_mapped_(is_mapped) {}
+                ~MemoryStream() {
+                    if (is_mapped_ && data_) {
+                        munmap(const_cast<uint8_t *>(data_), data_size_);
+                    }
+                }
+                static MemoryStream *MapFile(const char *input_file_path) {
+                    int fd = open(input_file_path, O_RDONLY);
+                    if (fd < 0) {
+                        std::cerr << "ERROR: failed to open " << input_file_path << std::endl;
+                        return nullptr;
+                    }
+                    struct stat file_stat;
+                    if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+                        std::cerr << "ERROR: failed to get the size of " << input_file_path << std::endl;
+                        close(fd);
+                        return nullptr;
+                    }
+                    void *addr = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                    close(fd);
+                    if (addr == MAP_FAILED) {
+                        std::cerr << "ERROR: mmap failed for " << input_file_path << std::endl;
+                        return nullptr;
+                    }
+                    madvise(addr, file_stat.st_size, MADV_SEQUENTIAL);
+                    return new MemoryStream(static_cast<const uint8_t *>(addr), file_stat.st_size, true);
+                }
+                static int Read(void *opaque, uint8_t *buf, int buf_size) {
+                    MemoryStream *stream = static_cast<MemoryStream *>(opaque);
+                    size_t remaining = stream->data_size_ - stream->pos_;
+                    if (remaining == 0) {
+                        return AVERROR_EOF;
+                    }
+                    size_t read_size = std::min(remaining, static_cast<size_t>(buf_size));
+                    memcpy(buf, stream->data_ + stream->pos_, read_size);
+                    stream->pos_ += read_size;
+                    return static_cast<int>(read_size);
+                }
+                static int64_t Seek(void *opaque, int64_t offset, int whence) {
+                    MemoryStream *stream = static_cast<MemoryStream *>(opaque);
+                    int64_t new_pos = 0;
+                    switch (whence & ~AVSEEK_FORCE) {
+                        case AVSEEK_SIZE: return static_cast<int64_t>(stream->data_size_);
+                        case SEEK_SET: new_pos = offset; break;
+                        case SEEK_CUR: new_pos = static_cast<int64_t>(stream->pos_) + offset; break;
+                        case SEEK_END: new_pos = static_cast<int64_t>(stream->data_size_) + offset; break;
+                        default: return -1;
+                    }
+                    if (new_pos < 0 || new_pos > static_cast<int64_t>(stream->data_size_)) {
+                        return -1;
+                    }
+                    stream->pos_ = static_cast<size_t>(new_pos);
+                    return new_pos;
+                }
+                const uint8_t *data_;
+                size_t data_size_;
+                size_t pos_ = 0;
+                bool is_mapped_;
+        };
+
+        bool DemuxFromSource(PacketSpan &packet) {
+            packet = PacketSpan();
+
+            if (!av_fmt_input_ctx_) {
+                return false;
+            }
+            if (packet_->data) {
+                av_packet_unref(packet_);
+            }
+            int ret = 0;
+            while ((ret = av_read_frame(av_fmt_input_ctx_, packet_)) >= 0 && packet_->stream_index != av_stream_) {
+                av_packet_unref(packet_);
+            }
+            if (ret < 0) {
+                return false;
+            }
+            AVPacket *out_packet = packet_;
+            if (is_h264_ || is_hevc_) {
+                // the filter allocates a new output buffer for every packet; packet_filtered_ holds it until the next call
+                if (packet_filtered_->data) {
+                    av_packet_unref(packet_filtered_);
+                }
+                if (av_bsf_send_packet(av_bsf_ctx_, packet_) != 0) {
+                    std::cerr << "ERROR: av_bsf_send_packet failed!" << std::endl;
+                    return false;
+                }
+                if (av_bsf_receive_packet(av_bsf_ctx_, packet_filtered_) != 0) {
+                    std::cerr << "ERROR: av_bsf_receive_packet failed!" << std::endl;
+                    return false;
+                }
+                out_packet = packet_filtered_;
+                packet.data = packet_filtered_->data;
+                packet.size = packet_filtered_->size;
+            } else if (is_mpeg4_ && (frame_count_ == 0) && av_fmt_input_ctx_->streams[av_stream_]->codecpar->extradata_size > 0) {
+                int ext_data_size = av_fmt_input_ctx_->streams[av_stream_]->codecpar->extradata_size;
+                size_t payload_size = packet_->size - 3 * sizeof(uint8_t);
+                uint8_t *data_with_header = GetArenaBuffer(ext_data_size + payload_size);
+                memcpy(data_with_header, av_fmt_input_ctx_->streams[av_stream_]->codecpar->extradata, ext_data_size);
+                memcpy(data_with_header + ext_data_size, packet_->data + 3, payload_size);
+                packet.data = data_with_header;
+                packet.size = ext_data_size + payload_size;
+            } else {
+                packet.data = packet_->data;
+                packet.size = packet_->size;
+            }
+            packet.is_key_frame = (out_packet->flags & AV_PKT_FLAG_KEY) != 0;
+            packet.dts = (out_packet->dts != AV_NOPTS_VALUE) ? out_packet->dts : out_packet->pts;
+            packet.pts = (int64_t)(out_packet->pts * default_time_scale_ * time_base_);
+            packet.duration = out_packet->duration;
+            frame_count_++;
+            return true;
+        }
+        /**
+         * @brief Takes the next packet from the read-ahead ring, starting the read-ahead thread if needed. The slot returned by the previous
+         *        call is handed back to the thread first.
+         */
+        bool DemuxFromReadAhead(PacketSpan &packet) {
+            if (!read_ahead_thread_.joinable()) {
+                StartReadAhead();
+            }
+            std::unique_lock<std::mutex> lock(read_ahead_mutex_);
+            if (read_ahead_slot_in_use_) {
+                if (read_ahead_ring_[read_ahead_head_].end_of_stream) {
+                    packet = PacketSpan();
+                    return false;
+                }
+                read_ahead_head_ = (read_ahead_head_ + 1) % read_ahead_ring_.size();
+                read_ahead_count_--;
+                read_ahead_slot_in_use_ = false;
+                read_ahead_cv_.notify_all();
+            }
+            read_ahead_cv_.wait(lock, [&] { return read_ahead_count_ > 0; });
+            read_ahead_slot_in_use_ = true;
+            ReadAheadSlot &slot = read_ahead_ring_[read_ahead_head_];
+            packet = slot.packet;
+            return !slot.end_of_stream;
+        }
+        void StartReadAhead() {
+            // one more slot than the depth: the slot held by the caller until the next Demux call
+            read_ahead_ring_.resize(read_ahead_depth_ + 1);
+            read_ahead_head_ = read_ahead_count_ = 0;
+            read_ahead_slot_in_use_ = false;
+            stop_read_ahead_ = false;
+            read_ahead_thread_ = std::thread(&VideoDemuxer::ReadAheadProc, this);
+        }
+        void StopReadAhead() {
+            if (read_ahead_thread_.joinable()) {
+                {
+                    std::lock_guard<std::mutex> lock(read_ahead_mutex_);
+                    stop_read_ahead_ = true;
+                }
+                read_ahead_cv_.notify_all();
+                read_ahead_thread_.join();
+            }
+            read_ahead_head_ = read_ahead_count_ = 0;
+            read_ahead_slot_in_use_ = false;
+        }
+        /**
+         * @brief Read-ahead thread: demuxes packets from the source and copies them into the free slots of the ring
+         */
+        void ReadAheadProc() {
+            size_t tail = 0;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(read_ahead_mutex_);
+                    read_ahead_cv_.wait(lock, [&] { return stop_read_ahead_ || read_ahead_count_ < read_ahead_ring_.size(); });
+                    if (stop_read_ahead_) {
+                        return;
+                    }
+                }
+                // the slot at the tail isn't visible to the caller until read_ahead_count_ is incremented
+                ReadAheadSlot &slot = read_ahead_ring_[tail];
+                PacketSpan packet;
+                slot.end_of_stream = !DemuxFromSource(packet);
+                if (!slot.end_of_stream) {
+                    // recycled buffer: grows to the largest packet seen in this slot and is reused afterwards
+                    if (slot.buffer.size() < packet.size + AV_INPUT_BUFFER_PADDING_SIZE) {
+                        slot.buffer.resize(packet.size + AV_INPUT_BUFFER_PADDING_SIZE);
+                    }
+                    memcpy(slot.buffer.data(), packet.data, packet.size);
+                    memset(slot.buffer.data() + packet.size, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+                    packet.data = slot.buffer.data();
+                }
+                slot.packet = packet;
+                {
+                    std::lock_guard<std::mutex> lock(read_ahead_mutex_);
+                    read_ahead_count_++;
+                }
+                read_ahead_cv_.notify_all();
+                if (slot.end_of_stream) {
+                    return;
+                }
+                tail = (tail + 1) % read_ahead_ring_.size();
+            }
+        }
         VideoDemuxer(AVFormatContext *av_fmt_input_ctx) : av_fmt_input_ctx_(av_fmt_input_ctx) {
             av_log_set_level(AV_LOG_QUIET);
             if (!av_fmt_input_ctx_) {
@@ -461,8 +693,9 @@ class VideoDemuxer {
             // Check if the input file allow seek functionality.
             is_seekable_ = av_fmt_input_ctx_->iformat->read_seek || av_fmt_input_ctx_->iformat->read_seek2;
 
-            if (is_h264_) {
-                const AVBitStreamFilter *bsf = av_bsf_get_by_name("h264_mp4toannexb");
+            // length prefixed H.264/HEVC is converted to annex-B by the mp4toannexb bitstream filter in Demux()
+            if (is_h264_ || is_hevc_) {
+                const AVBitStreamFilter *bsf = av_bsf_get_by_name(is_h264_ ? "h264_mp4toannexb" : "hevc_mp4toannexb");
                 if (!bsf) {
                     std::cerr << "ERROR: av_bsf_get_by_name() failed" << std::endl;
                     av_packet_free(&packet_);
@@ -470,24 +703,6 @@ class VideoDemuxer {
                     return;
                 }
                 if (av_bsf_alloc(bsf, &av_bsf_ctx_) != 0) {
-                    std::cerr << "ERROR: av_bsf_alloc failed!" << std::endl;
-                        return;
-                }
-                avcodec_parameters_copy(av_bsf_ctx_->par_in, av_fmt_input_ctx_->streams[av_stream_]->codecpar);
-                if (av_bsf_init(av_bsf_ctx_) < 0) {
-                    std::cerr << "ERROR: av_bsf_init failed!" << std::endl;
-                    return;
-                }
-            }
-            if (is_hevc_) {
-                const AVBitStreamFilter *bsf = av_bsf_get_by_name("hevc_mp4toannexb");
-                if (!bsf) {
-                    std::cerr << "ERROR: av_bsf_get_by_name() failed" << std::endl;
-                    av_packet_free(&packet_);
-                    av_packet_free(&packet_filtered_);
-                    return;
-                }
-                if (av_bsf_alloc(bsf, &av_bsf_ctx_) != 0 ) {
                     std::cerr << "ERROR: av_bsf_alloc failed!" << std::endl;
                     return;
                 }
@@ -498,6 +713,17 @@ class VideoDemuxer {
                 }
             }
         }
+        /**
+         * @brief Returns the output arena with room for size bytes (plus the FFmpeg input padding). The arena grows geometrically and is never shrunk.
+         */
+        uint8_t *GetArenaBuffer(size_t size) {
+            size_t required_size = size + AV_INPUT_BUFFER_PADDING_SIZE;
+            if (demux_arena_.size() < required_size) {
+                demux_arena_.resize(std::max(required_size, demux_arena_.size() * 2));
+            }
+            memset(demux_arena_.data() + size, 0, AV_INPUT_BUFFER_PADDING_SIZE);
+            return demux_arena_.data();
+        }
         AVFormatContext *CreateFmtContextUtil(StreamProvider *stream_provider) {
             AVFormatContext *ctx = nullptr;
             if (!(ctx = avformat_alloc_context())) {
@@ -525,6 +751,48 @@ class VideoDemuxer {
             }
             return ctx;
         }
+        AVFormatContext *CreateFmtContextUtil(MemoryStream *mem_stream) {
+            if (!mem_stream) {
+                return nullptr;
+            }
+            AVFormatContext *ctx = nullptr;
+            if (!(ctx = avformat_alloc_context())) {
+                std::cerr << "ERROR: avformat_alloc_context failed" << std::endl;
+                delete mem_stream;
+                return nullptr;
+            }
+            uint8_t *avioc_buffer = (uint8_t *)av_malloc(memory_avio_buffer_size_);
+            if (!avioc_buffer) {
+                std::cerr << "ERROR: av_malloc failed!" << std::endl;
+                avformat_free_context(ctx);
+                delete mem_stream;
+                return nullptr;
+            }
+            AVIOContext *av_io_ctx = avio_alloc_context(avioc_buffer, memory_avio_buffer_size_, 0, mem_stream, &MemoryStream::Read, nullptr, &MemoryStream::Seek);
+            if (!av_io_ctx) {
+                std::cerr << "ERROR: avio_alloc_context failed!" << std::endl;
+                av_free(avioc_buffer);
+                avformat_free_context(ctx);
+                delete mem_stream;
+                return nullptr;
+            }
+            ctx->pb = av_io_ctx;
+            if (avformat_open_input(&ctx, nullptr, nullptr, nullptr) != 0) {
+                // ctx is freed by avformat_open_input on failure
+                std::cerr << "ERROR: avformat_open_input failed!" << std::endl;
+                av_freep(&av_io_ctx->buffer);
+                avio_context_free(&av_io_ctx);
+                delete mem_stream;
+                return nullptr;
+            }
+            return ctx;
+        }
+        void InitMemoryStream() {
+            if (av_fmt_input_ctx_ && av_fmt_input_ctx_->pb && (av_fmt_input_ctx_->flags & AVFMT_FLAG_CUSTOM_IO)) {
+                av_io_ctx_ = av_fmt_input_ctx_->pb;
+                mem_stream_ = static_cast<MemoryStream *>(av_io_ctx_->opaque);
+            }
+        }
         AVFormatContext *CreateFmtContextUtil(const char *input_file_path) {
             avformat_network_init();
             AVFormatContext *ctx = nullptr;
@@ -539,19 +807,37 @@ class VideoDemuxer {
         }
         AVFormatContext *av_fmt_input_ctx_ = nullptr;
         AVIOContext *av_io_ctx_ = nullptr;
+        MemoryStream *mem_stream_ = nullptr;
+        static const int memory_avio_buffer_size_ = 32 * 1024;
         AVPacket* packet_ = nullptr;
-        AVPacket* packet_filtered_ = nullptr;
-        AVBSFContext *av_bsf_ctx_ = nullptr;
         AVCodecID av_video_codec_id_;
         AVPixelFormat chroma_format_;
         double frame_rate_ = 0.0;
         double avg_frame_rate_ = 0.0;
-        uint8_t *data_with_header_ = nullptr;
+        AVPacket* packet_filtered_ = nullptr;     // mp4toannexb output of the last packet
+        AVBSFContext *av_bsf_ctx_ = nullptr;
+        std::vector<uint8_t> demux_arena_;         // reusable output buffer for the MPEG-4 header insertion
+        // read-ahead mode
+        struct ReadAheadSlot {
+            std::vector<uint8_t> buffer;
+            PacketSpan packet;
+            bool end_of_stream = false;
+        };
+        int read_ahead_depth_ = 0;
+        std::vector<ReadAheadSlot> read_ahead_ring_;
+        size_t read_ahead_head_ = 0;               // slot returned by the next Demux (or held by the caller)
+        size_t read_ahead_count_ = 0;              // number of filled slots, including the one held by the caller
+        bool read_ahead_slot_in_use_ = false;
+        bool stop_read_ahead_ = false;
+        std::thread read_ahead_thread_;
+        std::mutex read_ahead_mutex_;
+        std::condition_variable read_ahead_cv_;
         int av_stream_ = 0;
         bool is_h264_ = false; 
         bool is_hevc_ = false;
         bool is_mpeg4_ = false;
         bool is_seekable_ = false;
+        bool is_key_frame_ = false;
         int64_t default_time_scale_ = 1000;
         double time_base_ = 0.0;
         uint32_t frame_count_ = 0;
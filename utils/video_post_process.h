@@ -24,91 +24,380 @@ THE SOFTWARE.
 
 #include "colorspace_kernels.h"
 #include "resize_kernels.h"
+#include "tensor_kernels.h"
+#include "host_colorspace.h"
 #include "rocvideodecode/roc_video_dec.h"       //for OutputSurfaceInfo
 
 enum OutputFormatEnum {
-    native = 0, bgr, bgr48, rgb, rgb48, bgra, bgra64, rgba, rgba64
+    native = 0, bgr, bgr48, rgb, rgb48, bgra, bgra64, rgba, rgba64,
+    // planar (CHW) outputs: the three color planes of height rows follow each other
+    bgr_planar, rgb_planar,                     // 8-bit planes with a pitch of the even rounded width
+    bgr_planar_fp32, rgb_planar_fp32,           // floating point planes of width elements, see SetPlanarScaleBias
+    bgr_planar_fp16, rgb_planar_fp16,
+    bgr_planar_bf16, rgb_planar_bf16
 };
 
 class VideoPostProcess {
     public:
         VideoPostProcess(){};
-        ~VideoPostProcess(){};
+        ~VideoPostProcess() {
+            if (dp_batch_desc_) {
+                hipError_t hip_status = hipFree(dp_batch_desc_);
+                if (hip_status != hipSuccess) {
+                    std::cerr << "ERROR: hipFree failed! (" << hip_status << ")" << std::endl;
+                }
+            }
+            if (dp_rois_) {
+                hipError_t hip_status = hipFree(dp_rois_);
+                if (hip_status != hipSuccess) {
+                    std::cerr << "ERROR: hipFree failed! (" << hip_status << ")" << std::endl;
+                }
+            }
+        };
         
+        /**
+         * @brief Selects whether PQ/HLG streams are tone mapped to SDR BT.709 RGB; by default the HDR encoded values are kept
+         */
+        void SetHdrToSdr(bool hdr_to_sdr) { hdr_to_sdr_ = hdr_to_sdr; };
+
+        /**
+         * @brief Derives the color description of the decoded stream from its VUI/sequence header values.
+         *        Unspecified matrix coefficients fall back to BT.601 for SD and BT.709 for HD resolutions.
+         */
+        ColorSpaceInfo GetColorSpaceInfo(OutputSurfaceInfo *surf_info) {
+            int col_standard = surf_info->matrix_coefficients;
+            if (col_standard < ColorSpaceStandard_BT709 || col_standard > ColorSpaceStandard_BT2020C ||
+                col_standard == ColorSpaceStandard_Unspecified || col_standard == ColorSpaceStandard_Reserved) {
+                col_standard = surf_info->output_height > 576 ? ColorSpaceStandard_BT709 : ColorSpaceStandard_BT601;
+            }
+            return ColorSpaceInfo(col_standard, surf_info->full_range != 0, surf_info->transfer_characteristics, surf_info->color_primaries, hdr_to_sdr_);
+        };
+
+        /**
+         * @brief Sets the per channel scale and bias of the floating point planar outputs: out[c] = rgb[c] * scale[c] + bias[c], where rgb is
+         *        in [0, 1] and the channels are in output order, e.g. scale = 1 / std_dev and bias = -mean / std_dev to normalize for inference
+         */
+        void SetPlanarScaleBias(const TensorScaleBias &scale_bias) { planar_scale_bias_ = scale_bias; };
+
         void ColorConvertYUV2RGB(uint8_t *p_src, OutputSurfaceInfo *surf_info, uint8_t *rgb_dev_mem_ptr, OutputFormatEnum e_output_format, hipStream_t hip_stream) {
             int  rgb_width = (surf_info->output_width + 1) & ~1;    // has to be a multiple of 2 for hip colorconvert kernels
-            // todo:: get color standard from the decoder
+            ColorSpaceInfo color_info = GetColorSpaceInfo(surf_info);
+            if (e_output_format >= bgr_planar) {
+                ColorConvertYUV2Planar(p_src, surf_info, rgb_dev_mem_ptr, e_output_format, color_info, hip_stream);
+                return;
+            }
             if (surf_info->surface_format == rocDecVideoSurfaceFormat_YUV444) {
                 if (e_output_format == bgr)
                 YUV444ToColor24<BGR24>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 3 * rgb_width, surf_info->output_width, 
-                                        surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                        surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == bgra)
                 YUV444ToColor32<BGRA32>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 4 * rgb_width, surf_info->output_width, 
-                                        surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                        surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == rgb)
                 YUV444ToColor24<RGB24>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 3 * rgb_width, surf_info->output_width, 
-                                        surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                        surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == rgba)
                 YUV444ToColor32<RGBA32>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 4 * rgb_width, surf_info->output_width, 
-                                        surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                        surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
             } else if (surf_info->surface_format == rocDecVideoSurfaceFormat_NV12) {
                 if (e_output_format == bgr)
                 Nv12ToColor24<BGR24>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 3 * rgb_width, surf_info->output_width, 
-                                    surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                    surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == bgra)
                 Nv12ToColor32<BGRA32>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 4 * rgb_width, surf_info->output_width, 
-                                    surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                    surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == rgb)
                 Nv12ToColor24<RGB24>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 3 * rgb_width, surf_info->output_width, 
-                                    surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                    surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == rgba)
                 Nv12ToColor32<RGBA32>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 4 * rgb_width, surf_info->output_width, 
-                                    surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                    surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
             }
             if (surf_info->surface_format == rocDecVideoSurfaceFormat_YUV444_16Bit) {
                 if (e_output_format == bgr)
                 YUV444P16ToColor24<BGR24>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 3 * rgb_width, surf_info->output_width, 
-                                        surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                        surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == rgb)
                 YUV444P16ToColor24<RGB24>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 3 * rgb_width, surf_info->output_width, 
-                                        surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                        surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == bgr48)
                 YUV444P16ToColor48<BGR48>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 6 * rgb_width, surf_info->output_width, 
-                                        surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                        surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == rgb48)
                 YUV444P16ToColor48<RGB48>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 6 * rgb_width, surf_info->output_width, 
-                                        surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                        surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == bgra64)
                 YUV444P16ToColor64<BGRA64>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 8 * rgb_width, surf_info->output_width, 
-                                        surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                        surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == rgba64)
                 YUV444P16ToColor64<RGBA64>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 8 * rgb_width, surf_info->output_width, 
-                                        surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                        surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
             } else if (surf_info->surface_format == rocDecVideoSurfaceFormat_P016) {
                 if (e_output_format == bgr)
                 P016ToColor24<BGR24>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 3 * rgb_width, surf_info->output_width, 
-                                    surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                    surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == rgb)
                 P016ToColor24<RGB24>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 3 * rgb_width, surf_info->output_width, 
-                                    surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                    surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == bgr48)
                 P016ToColor48<BGR48>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 6 * rgb_width, surf_info->output_width, 
-                                    surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                    surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == rgb48)
                 P016ToColor48<RGB48>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 6 * rgb_width, surf_info->output_width, 
-                                    surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                    surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == bgra64)
                 P016ToColor64<BGRA64>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 8 * rgb_width, surf_info->output_width, 
-                                    surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                    surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
                 else if (e_output_format == rgba64)
                 P016ToColor64<RGBA64>(p_src, surf_info->output_pitch, static_cast<uint8_t *>(rgb_dev_mem_ptr), 8 * rgb_width, surf_info->output_width, 
-                                    surf_info->output_height, surf_info->output_vstride, 0, hip_stream);
+                                    surf_info->output_height, surf_info->output_vstride, color_info, hip_stream);
             }   
         };
+        /**
+         * @brief Host counterpart of ColorConvertYUV2RGB for surfaces copied to host memory (OUT_SURFACE_MEM_HOST_COPIED): the conversion runs on
+         *        the CPU, split across num_threads threads, without copying the frame back to the device. The output layout and the supported
+         *        formats are the same as ColorConvertYUV2RGB.
+         *
+         * @param p_src - decoded surface (host memory)
+         * @param surf_info - output surface info of the decoder
+         * @param rgb_host_ptr - destination of GetRgbStride() * output_height bytes (host memory)
+         * @param e_output_format - output format
+         * @param num_threads - number of threads; 0 selects the number of hardware threads
+         * @return true - success; false - unsupported surface/output format combination
+         */
+        bool ColorConvertYUV2RGBHost(const uint8_t *p_src, OutputSurfaceInfo *surf_info, uint8_t *rgb_host_ptr, OutputFormatEnum e_output_format,
+                                     int num_threads = 0) {
+            int rgb_width = (surf_info->output_width + 1) & ~1;    // same layout as the device conversion
+            int pitch = surf_info->output_pitch, width = surf_info->output_width, height = surf_info->output_height, v_pitch = surf_info->output_vstride;
+            ColorSpaceInfo color_info = GetColorSpaceInfo(surf_info);
+            switch (surf_info->surface_format) {
+                case rocDecVideoSurfaceFormat_YUV444:
+                    if (e_output_format == bgr) {
+                        HostYUV444ToColor24<BGR24>(p_src, pitch, rgb_host_ptr, 3 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == bgra) {
+                        HostYUV444ToColor32<BGRA32>(p_src, pitch, rgb_host_ptr, 4 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == rgb) {
+                        HostYUV444ToColor24<RGB24>(p_src, pitch, rgb_host_ptr, 3 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == rgba) {
+                        HostYUV444ToColor32<RGBA32>(p_src, pitch, rgb_host_ptr, 4 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else {
+                        break;
+                    }
+                    return true;
+                case rocDecVideoSurfaceFormat_NV12:
+                    if (e_output_format == bgr) {
+                        HostNv12ToColor24<BGR24>(p_src, pitch, rgb_host_ptr, 3 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == bgra) {
+                        HostNv12ToColor32<BGRA32>(p_src, pitch, rgb_host_ptr, 4 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == rgb) {
+                        HostNv12ToColor24<RGB24>(p_src, pitch, rgb_host_ptr, 3 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == rgba) {
+                        HostNv12ToColor32<RGBA32>(p_src, pitch, rgb_host_ptr, 4 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else {
+                        break;
+                    }
+                    return true;
+                case rocDecVideoSurfaceFormat_YUV444_16Bit:
+                    if (e_output_format == bgr) {
+                        HostYUV444P16ToColor24<BGR24>(p_src, pitch, rgb_host_ptr, 3 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == rgb) {
+                        HostYUV444P16ToColor24<RGB24>(p_src, pitch, rgb_host_ptr, 3 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == bgr48) {
+                        HostYUV444P16ToColor48<BGR48>(p_src, pitch, rgb_host_ptr, 6 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == rgb48) {
+                        HostYUV444P16ToColor48<RGB48>(p_src, pitch, rgb_host_ptr, 6 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == bgra64) {
+                        HostYUV444P16ToColor64<BGRA64>(p_src, pitch, rgb_host_ptr, 8 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == rgba64) {
+                        HostYUV444P16ToColor64<RGBA64>(p_src, pitch, rgb_host_ptr, 8 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else {
+                        break;
+                    }
+                    return true;
+                case rocDecVideoSurfaceFormat_P016:
+                    if (e_output_format == bgr) {
+                        HostP016ToColor24<BGR24>(p_src, pitch, rgb_host_ptr, 3 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == rgb) {
+                        HostP016ToColor24<RGB24>(p_src, pitch, rgb_host_ptr, 3 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == bgr48) {
+                        HostP016ToColor48<BGR48>(p_src, pitch, rgb_host_ptr, 6 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == rgb48) {
+                        HostP016ToColor48<RGB48>(p_src, pitch, rgb_host_ptr, 6 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == bgra64) {
+                        HostP016ToColor64<BGRA64>(p_src, pitch, rgb_host_ptr, 8 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else if (e_output_format == rgba64) {
+                        HostP016ToColor64<RGBA64>(p_src, pitch, rgb_host_ptr, 8 * rgb_width, width, height, v_pitch, color_info, num_threads);
+                    } else {
+                        break;
+                    }
+                    return true;
+                default:
+                    break;
+            }
+            std::cerr << "ERROR: unsupported surface/output format combination for the host color conversion!" << std::endl;
+            return false;
+        };
+        /**
+         * @brief Resizes (bilinear) a decoded NV12/P016 surface in host memory into a surface of the same format on the CPU
+         *
+         * @param p_src - decoded surface (host memory)
+         * @param surf_info - output surface info of the decoder
+         * @param p_dst - destination Y plane followed by the UV plane at p_dst + dst_pitch * dst_height (host memory)
+         * @param dst_pitch - destination pitch in bytes
+         * @param dst_width - destination width
+         * @param dst_height - destination height
+         * @param num_threads - number of threads; 0 selects the number of hardware threads
+         * @return true - success; false - unsupported surface format
+         */
+        bool ResizeYUVHost(const uint8_t *p_src, OutputSurfaceInfo *surf_info, uint8_t *p_dst, int dst_pitch, int dst_width, int dst_height,
+                           int num_threads = 0) {
+            const uint8_t *p_src_uv = p_src + static_cast<size_t>(surf_info->output_pitch) * surf_info->output_vstride;
+            uint8_t *p_dst_uv = p_dst + static_cast<size_t>(dst_pitch) * dst_height;
+            if (surf_info->surface_format == rocDecVideoSurfaceFormat_NV12) {
+                HostResizeNv12(p_dst, dst_pitch, dst_width, dst_height, p_src, surf_info->output_pitch, surf_info->output_width, surf_info->output_height,
+                               p_src_uv, p_dst_uv, num_threads);
+            } else if (surf_info->surface_format == rocDecVideoSurfaceFormat_P016) {
+                HostResizeP016(p_dst, dst_pitch, dst_width, dst_height, p_src, surf_info->output_pitch, surf_info->output_width, surf_info->output_height,
+                               p_src_uv, p_dst_uv, num_threads);
+            } else {
+                std::cerr << "ERROR: ResizeYUVHost only supports NV12 and P016 surfaces!" << std::endl;
+                return false;
+            }
+            return true;
+        };
+        /**
+         * @brief Resizes, color-converts and normalizes a decoded NV12/P016 surface into a planar (CHW) FP32/FP16 tensor in a single kernel,
+         *        instead of a resize, a color conversion and a normalization pass each reading and writing the whole frame.
+         *
+         * @param p_src - decoded surface (device memory)
+         * @param surf_info - output surface info of the decoder
+         * @param tensor_dev_mem_ptr - destination tensor of GetTensorSize() bytes (device memory)
+         * @param data_type - tensor element type
+         * @param dst_width - tensor width
+         * @param dst_height - tensor height
+         * @param bgr - channel order of the tensor planes: B, G, R if true; R, G, B otherwise
+         * @param norm_params - mean/std_dev normalization applied on the [0, 1] color values
+         * @param hip_stream - stream for launching the kernel
+         * @return true - success; false - unsupported surface format
+         */
+        bool ResizeColorConvertNormalize(uint8_t *p_src, OutputSurfaceInfo *surf_info, void *tensor_dev_mem_ptr, TensorDataType data_type, int dst_width,
+                                         int dst_height, bool bgr, const TensorNormParams &norm_params, hipStream_t hip_stream) {
+            ColorSpaceInfo color_info = GetColorSpaceInfo(surf_info);
+            if (surf_info->surface_format == rocDecVideoSurfaceFormat_NV12) {
+                ResizeNv12ToTensor(p_src, surf_info->output_pitch, surf_info->output_width, surf_info->output_height, surf_info->output_vstride,
+                                   tensor_dev_mem_ptr, data_type, dst_width, dst_height, bgr, norm_params, color_info, hip_stream);
+            } else if (surf_info->surface_format == rocDecVideoSurfaceFormat_P016) {
+                ResizeP016ToTensor(p_src, surf_info->output_pitch, surf_info->output_width, surf_info->output_height, surf_info->output_vstride,
+                                   tensor_dev_mem_ptr, data_type, dst_width, dst_height, bgr, norm_params, color_info, hip_stream);
+            } else {
+                std::cerr << "ERROR: ResizeColorConvertNormalize only supports NV12 and P016 surfaces!" << std::endl;
+                return false;
+            }
+            return true;
+        };
+        /**
+         * @brief Resizes, color-converts and normalizes the decoded NV12/P016 surfaces of several decoders into one contiguous NCHW/NHWC batch tensor
+         *        with a single kernel launch. The surfaces can have different sizes and bit depths. The per surface descriptors are kept in a device
+         *        buffer owned by this object, so calls on the same object must be issued on the same stream.
+         *
+         * @param p_srcs - decoded surfaces (device memory), batch_size entries
+         * @param surf_infos - output surface info of the decoder of each surface, batch_size entries
+         * @param batch_size - number of surfaces
+         * @param tensor_dev_mem_ptr - destination batch tensor of batch_size * GetTensorSize() bytes (device memory)
+         * @param layout - NCHW or NHWC
+         * Other parameters are the same as ResizeColorConvertNormalize.
+         * @return true - success; false - unsupported surface format or allocation failure
+         */
+        bool ColorConvertBatchToTensor(uint8_t **p_srcs, OutputSurfaceInfo **surf_infos, int batch_size, void *tensor_dev_mem_ptr, TensorDataType data_type,
+                                       TensorLayout layout, int dst_width, int dst_height, bool bgr, const TensorNormParams &norm_params, hipStream_t hip_stream) {
+            batch_srcs_.resize(batch_size);
+            for (int i = 0; i < batch_size; i++) {
+                OutputSurfaceInfo *surf_info = surf_infos[i];
+                if (surf_info->surface_format != rocDecVideoSurfaceFormat_NV12 && surf_info->surface_format != rocDecVideoSurfaceFormat_P016) {
+                    std::cerr << "ERROR: ColorConvertBatchToTensor only supports NV12 and P016 surfaces!" << std::endl;
+                    return false;
+                }
+                batch_srcs_[i] = {p_srcs[i], static_cast<int>(surf_info->output_pitch), static_cast<int>(surf_info->output_width),
+                                  static_cast<int>(surf_info->output_height), static_cast<int>(surf_info->output_vstride),
+                                  surf_info->surface_format == rocDecVideoSurfaceFormat_P016, GetColorSpaceInfo(surf_info)};
+            }
+            size_t desc_size = GetTensorBatchDescSize(batch_size);
+            if (desc_size > batch_desc_size_) {
+                if (dp_batch_desc_) {
+                    // the previous launches may still read the descriptors
+                    HIP_API_CALL(hipStreamSynchronize(hip_stream));
+                    HIP_API_CALL(hipFree(dp_batch_desc_));
+                    dp_batch_desc_ = nullptr;
+                }
+                hipError_t hip_status = hipMalloc(&dp_batch_desc_, desc_size);
+                if (hip_status != hipSuccess) {
+                    std::cerr << "ERROR: hipMalloc failed to allocate the batch descriptors! (" << hip_status << ")" << std::endl;
+                    batch_desc_size_ = 0;
+                    return false;
+                }
+                batch_desc_size_ = desc_size;
+            }
+            ResizeYuv420BatchToTensor(batch_srcs_.data(), batch_size, dp_batch_desc_, tensor_dev_mem_ptr, data_type, layout, dst_width, dst_height, bgr,
+                                      norm_params, hip_stream);
+            return true;
+        };
+        /**
+         * @brief Crops a list of boxes of a decoded NV12/P016 surface and resizes and color-converts each of them into a packed 8-bit RGB/BGR image
+         *        of dst_width x dst_height with a single kernel launch. The boxes are copied into a device buffer owned by this object, so calls on
+         *        the same object must be issued on the same stream.
+         *
+         * @param p_src - decoded surface (device memory)
+         * @param surf_info - output surface info of the decoder
+         * @param p_rois - boxes in the coordinates of the decoded surface (host memory), num_rois entries
+         * @param num_rois - number of boxes
+         * @param rgb_dev_mem_ptr - destination of num_rois * dst_height * dst_width * 3 bytes (device memory)
+         * @param dst_width - crop width
+         * @param dst_height - crop height
+         * @param bgr - channel order: B, G, R if true; R, G, B otherwise
+         * @param hip_stream - stream for launching the kernel
+         * @return true - success; false - unsupported surface format or allocation failure
+         */
+        bool CropResizeToRgbBatch(uint8_t *p_src, OutputSurfaceInfo *surf_info, const RoiBox *p_rois, int num_rois, uint8_t *rgb_dev_mem_ptr,
+                                  int dst_width, int dst_height, bool bgr, hipStream_t hip_stream) {
+            if (surf_info->surface_format != rocDecVideoSurfaceFormat_NV12 && surf_info->surface_format != rocDecVideoSurfaceFormat_P016) {
+                std::cerr << "ERROR: CropResizeToRgbBatch only supports NV12 and P016 surfaces!" << std::endl;
+                return false;
+            }
+            if (num_rois > num_rois_alloc_) {
+                if (dp_rois_) {
+                    // the previous launches may still read the boxes
+                    HIP_API_CALL(hipStreamSynchronize(hip_stream));
+                    HIP_API_CALL(hipFree(dp_rois_));
+                    dp_rois_ = nullptr;
+                }
+                hipError_t hip_status = hipMalloc(&dp_rois_, num_rois * sizeof(RoiBox));
+                if (hip_status != hipSuccess) {
+                    std::cerr << "ERROR: hipMalloc failed to allocate the boxes! (" << hip_status << ")" << std::endl;
+                    num_rois_alloc_ = 0;
+                    return false;
+                }
+                num_rois_alloc_ = num_rois;
+            }
+            CropResizeYuv420ToRgbBatch(p_src, surf_info->output_pitch, surf_info->output_width, surf_info->output_height, surf_info->output_vstride,
+                                       surf_info->surface_format == rocDecVideoSurfaceFormat_P016, p_rois, num_rois, static_cast<RoiBox *>(dp_rois_),
+                                       rgb_dev_mem_ptr, dst_width, dst_height, bgr, GetColorSpaceInfo(surf_info), hip_stream);
+            return true;
+        };
+        size_t GetTensorSize(TensorDataType data_type, int width, int height) {
+            return static_cast<size_t>(3) * width * height * (data_type == TensorDataType_FP32 ? 4 : 2);
+        };
+        /**
+         * @brief Returns the bytes of one output row; for the planar formats, the bytes of one row of the three planes together, so
+         *        output_height * stride is the size of the image in every format
+         */
         uint32_t GetRgbStride(OutputFormatEnum e_output_format, OutputSurfaceInfo *surf_info) {
             uint32_t rgb_stride;
             uint32_t  rgb_width = (surf_info->output_width + 1) & ~1; // has to be a multiple of 2 for hip colorconvert kernels
-            if (surf_info->bit_depth == 8) {
+            if (e_output_format == bgr_planar || e_output_format == rgb_planar) {
+                rgb_stride = rgb_width * 3;
+            } else if (e_output_format >= bgr_planar_fp32) {
+                rgb_stride = surf_info->output_width * 3 * (e_output_format == bgr_planar_fp32 || e_output_format == rgb_planar_fp32 ? 4 : 2);
+            } else if (surf_info->bit_depth == 8) {
                 rgb_stride = ((e_output_format == bgr) || (e_output_format == rgb)) ? rgb_width * 3 : rgb_width * 4;        // bgr/bgra/rgb/rgba
             } else {
                 rgb_stride = ((e_output_format == bgr) || (e_output_format == rgb)) ? rgb_width * 3 : 
@@ -116,4 +405,55 @@ class VideoPostProcess {
             }
             return rgb_stride;
         };
+
+    private:
+        /**
+         * @brief Planar outputs of ColorConvertYUV2RGB: the 8-bit planes use the planar color conversion kernels and the floating point planes
+         *        are written by YuvToPlanarTensor, in a single kernel in both cases
+         */
+        void ColorConvertYUV2Planar(uint8_t *p_src, OutputSurfaceInfo *surf_info, uint8_t *rgb_dev_mem_ptr, OutputFormatEnum e_output_format,
+                                    const ColorSpaceInfo &color_info, hipStream_t hip_stream) {
+            int pitch = surf_info->output_pitch, width = surf_info->output_width, height = surf_info->output_height, v_pitch = surf_info->output_vstride;
+            bool is_16bit = surf_info->surface_format == rocDecVideoSurfaceFormat_P016 || surf_info->surface_format == rocDecVideoSurfaceFormat_YUV444_16Bit;
+            bool is_444 = surf_info->surface_format == rocDecVideoSurfaceFormat_YUV444 || surf_info->surface_format == rocDecVideoSurfaceFormat_YUV444_16Bit;
+            if (e_output_format == bgr_planar || e_output_format == rgb_planar) {
+                int plane_pitch = (width + 1) & ~1;
+                bool out_bgr = e_output_format == bgr_planar;
+                if (surf_info->surface_format == rocDecVideoSurfaceFormat_YUV444) {
+                    if (out_bgr)
+                    YUV444ToColorPlanar<BGRA32>(p_src, pitch, rgb_dev_mem_ptr, plane_pitch, width, height, v_pitch, color_info, hip_stream);
+                    else
+                    YUV444ToColorPlanar<RGBA32>(p_src, pitch, rgb_dev_mem_ptr, plane_pitch, width, height, v_pitch, color_info, hip_stream);
+                } else if (surf_info->surface_format == rocDecVideoSurfaceFormat_NV12) {
+                    if (out_bgr)
+                    Nv12ToColorPlanar<BGRA32>(p_src, pitch, rgb_dev_mem_ptr, plane_pitch, width, height, v_pitch, color_info, hip_stream);
+                    else
+                    Nv12ToColorPlanar<RGBA32>(p_src, pitch, rgb_dev_mem_ptr, plane_pitch, width, height, v_pitch, color_info, hip_stream);
+                } else if (surf_info->surface_format == rocDecVideoSurfaceFormat_YUV444_16Bit) {
+                    if (out_bgr)
+                    YUV444P16ToColorPlanar<BGRA32>(p_src, pitch, rgb_dev_mem_ptr, plane_pitch, width, height, v_pitch, color_info, hip_stream);
+                    else
+                    YUV444P16ToColorPlanar<RGBA32>(p_src, pitch, rgb_dev_mem_ptr, plane_pitch, width, height, v_pitch, color_info, hip_stream);
+                } else if (surf_info->surface_format == rocDecVideoSurfaceFormat_P016) {
+                    if (out_bgr)
+                    P016ToColorPlanar<BGRA32>(p_src, pitch, rgb_dev_mem_ptr, plane_pitch, width, height, v_pitch, color_info, hip_stream);
+                    else
+                    P016ToColorPlanar<RGBA32>(p_src, pitch, rgb_dev_mem_ptr, plane_pitch, width, height, v_pitch, color_info, hip_stream);
+                }
+                return;
+            }
+            TensorDataType data_type = (e_output_format == bgr_planar_fp16 || e_output_format == rgb_planar_fp16) ? TensorDataType_FP16 :
+                                       (e_output_format == bgr_planar_bf16 || e_output_format == rgb_planar_bf16) ? TensorDataType_BF16 : TensorDataType_FP32;
+            bool out_bgr = e_output_format == bgr_planar_fp32 || e_output_format == bgr_planar_fp16 || e_output_format == bgr_planar_bf16;
+            YuvToPlanarTensor(p_src, pitch, width, height, v_pitch, is_16bit, is_444, rgb_dev_mem_ptr, data_type, out_bgr, planar_scale_bias_, color_info,
+                              hip_stream);
+        };
+
+        bool hdr_to_sdr_ = false;
+        TensorScaleBias planar_scale_bias_;
+        void *dp_batch_desc_ = nullptr;     // per surface descriptors of ColorConvertBatchToTensor
+        size_t batch_desc_size_ = 0;
+        std::vector<TensorBatchSrc> batch_srcs_;
+        void *dp_rois_ = nullptr;           // boxes of CropResizeToRgbBatch
+        int num_rois_alloc_ = 0;
 };
\ No newline at end of file
@@ -0,0 +1,424 @@
+/*
+Copyright (c) 2023 - 2024 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include "video_demuxer.h"
+#include "rocvideodecode/roc_video_dec.h"
+
+/*!
+ * \file
+ * \brief Parallel segment decoder for rocDecode samples.
+ *
+ * The input file is split into key frame aligned segments. Every segment is decoded by its own
+ * VideoDemuxer/RocVideoDecoder pair (on its own device or decoder instance) and the decoded frames are
+ * handed back to the caller in global presentation order through a per segment reorder buffer.
+ */
+
+/**
+ * @brief Describes one key frame aligned segment of the input
+ *
+ */
+typedef struct VideoSegmentInfo_ {
+    int segment_id;                 /**< index of the segment in presentation order */
+    int device_id;                  /**< GPU device the segment is decoded on */
+    int64_t start_pts;              /**< pts of the key frame starting the segment */
+    int64_t end_pts;                /**< pts of the key frame starting the next segment (INT64_MAX for the last one) */
+    uint64_t start_frame_num;       /**< frame number used to seek to the start key frame */
+    uint32_t num_packets;           /**< number of packets found in the segment during the key frame scan */
+    int num_pics_decoded;           /**< number of pictures decoded (including pictures decoded only as references) */
+    int num_frames_output;          /**< number of frames within [start_pts, end_pts) handed to the caller */
+    double decode_time_ms;          /**< wall time spent by the segment thread */
+} VideoSegmentInfo;
+
+/**
+ * @brief Callback invoked in global presentation order for each decoded frame
+ *
+ * @param seg_info  - segment the frame belongs to
+ * @param p_frame   - copy of the decoded surface (device memory for OUT_SURFACE_MEM_DEV_*, host memory for OUT_SURFACE_MEM_HOST_COPIED)
+ * @param pts       - presentation timestamp of the frame
+ * @param surf_info - output surface info of the segment decoder
+ */
+typedef std::function<void(VideoSegmentInfo *seg_info, uint8_t *p_frame, int64_t pts, OutputSurfaceInfo *surf_info)> PFNSEGMENTFRAMECALLBACK;
+
+class VideoSegmentDecoder {
+    public:
+        /**
+         * @brief Construct a new Video Segment Decoder object
+         *
+         * @param input_file_path - input file; must be seekable and constant frame rate to be split in more than one segment
+         * @param num_segments - requested number of segments; may be reduced when the stream doesn't have enough key frames
+         * @param device_ids - devices to decode on, segments are assigned to them in a round robin fashion
+         * @param out_mem_type - output surface memory type of the segment decoders
+         * @param max_frames_in_flight - max number of decoded frames buffered per segment waiting for their turn
+         * @param disp_delay - display delay of the segment decoders
+         */
+        VideoSegmentDecoder(const char *input_file_path, int num_segments, const std::vector<int> &device_ids, OutputSurfaceMemoryType out_mem_type,
+                            uint32_t max_frames_in_flight = 16, uint32_t disp_delay = 0) : input_file_path_(input_file_path), out_mem_type_(out_mem_type),
+                            max_frames_in_flight_(max_frames_in_flight ? max_frames_in_flight : 1) {
+            if (device_ids.empty()) {
+                THROW("VideoSegmentDecoder: no device specified");
+            }
+            auto start_time = std::chrono::high_resolution_clock::now();
+            CreateSegments(num_segments > 0 ? num_segments : 1, device_ids);
+            auto end_time = std::chrono::high_resolution_clock::now();
+            scan_time_ms_ = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+            for (auto &seg : segments_) {
+                seg->demuxer.reset(new VideoDemuxer(input_file_path_.c_str()));
+                seg->decoder.reset(new RocVideoDecoder(seg->info.device_id, out_mem_type_, codec_id_, false, nullptr, false, disp_delay));
+                if (!seg->decoder->CodecSupported(seg->info.device_id, codec_id_, bit_depth_)) {
+                    THROW("VideoSegmentDecoder: codec not supported on device " + TOSTR(seg->info.device_id));
+                }
+            }
+        }
+
+        ~VideoSegmentDecoder() {
+            for (auto &seg : segments_) {
+                ReleaseFramePool(seg.get());
+            }
+        }
+
+        /**
+         * @brief Decodes all the segments in parallel and calls frame_cb for every frame in global presentation order.
+         *        Returns when all the segments are decoded.
+         *
+         * @param frame_cb - frame callback; not called with OUT_SURFACE_MEM_NOT_MAPPED since no output is available
+         * @return int - total number of frames output; -1 on failure
+         */
+        int Decode(PFNSEGMENTFRAMECALLBACK frame_cb = nullptr) {
+            std::vector<std::thread> seg_threads;
+            for (auto &seg : segments_) {
+                seg->done = false;
+                seg->error = false;
+                seg->info.num_pics_decoded = 0;
+                seg->info.num_frames_output = 0;
+                seg_threads.push_back(std::thread(&VideoSegmentDecoder::SegmentDecodeProc, this, seg.get()));
+            }
+
+            // reorder buffer: drain the segments one after the other, each of them in its own display order
+            int n_frames = 0;
+            bool error = false;
+            for (auto &seg : segments_) {
+                while (true) {
+                    SegmentFrame frame;
+                    {
+                        std::unique_lock<std::mutex> lock(seg->mtx);
+                        seg->cv.wait(lock, [&] { return !seg->ready_frames.empty() || seg->done; });
+                        if (seg->ready_frames.empty()) {
+                            break;
+                        }
+                        frame = seg->ready_frames.front();
+                        seg->ready_frames.pop_front();
+                    }
+                    if (frame_cb) {
+                        frame_cb(&seg->info, frame.frame_ptr, frame.pts, seg->surf_info);
+                    }
+                    n_frames++;
+                    {
+                        std::lock_guard<std::mutex> lock(seg->mtx);
+                        seg->free_frames.push_back(frame.frame_ptr);
+                    }
+                    seg->cv.notify_all();
+                }
+                if (seg->error) {
+                    error = true;
+                }
+                if (out_mem_type_ == OUT_SURFACE_MEM_NOT_MAPPED) {
+                    n_frames += seg->info.num_frames_output;
+                }
+            }
+            for (auto &thread : seg_threads) {
+                thread.join();
+            }
+            return error ? -1 : n_frames;
+        }
+
+        int GetNumSegments() { return static_cast<int>(segments_.size()); }
+        VideoSegmentInfo *GetSegmentInfo(int seg_idx) { return &segments_[seg_idx]->info; }
+        RocVideoDecoder *GetDecoder(int seg_idx) { return segments_[seg_idx]->decoder.get(); }
+        rocDecVideoCodec GetCodecId() { return codec_id_; }
+        uint32_t GetBitDepth() { return bit_depth_; }
+        double GetScanTime() { return scan_time_ms_; }
+
+    private:
+        typedef struct SegmentFrame_ {
+            uint8_t *frame_ptr;
+            int64_t pts;
+        } SegmentFrame;
+
+        struct Segment {
+            VideoSegmentInfo info;
+            std::unique_ptr<VideoDemuxer> demuxer;
+            std::unique_ptr<RocVideoDecoder> decoder;
+            OutputSurfaceInfo *surf_info = nullptr;
+            std::mutex mtx;
+            std::condition_variable cv;
+            std::deque<SegmentFrame> ready_frames;
+            std::vector<uint8_t *> free_frames;
+            std::vector<uint8_t *> frame_pool;
+            uint64_t frame_buffer_size = 0;
+            bool done = false;
+            bool error = false;
+        };
+
+        /**
+         * @brief Scans the packets of the input once to find the key frames and partitions the stream
+         *        into segments of about the same number of packets starting at key frames.
+         */
+        void CreateSegments(int num_segments, const std::vector<int> &device_ids) {
+            VideoDemuxer demuxer(input_file_path_.c_str());
+            codec_id_ = AVCodec2RocDecVideoCodec(demuxer.GetCodecID());
+            bit_depth_ = demuxer.GetBitDepth();
+            frame_rate_ = demuxer.GetFrameRate();
+            // seeking by frame number isn't possible for VFR streams, fall back to a single segment
+            if (!demuxer.IsSeekable() || demuxer.IsVFR() || frame_rate_ <= 0) {
+                num_segments = 1;
+            }
+
+            struct KeyFrame {
+                int64_t pts;
+                uint32_t packet_idx;
+            };
+            std::vector<KeyFrame> key_frames;
+            uint32_t num_packets = 0;
+            uint8_t *p_video = nullptr;
+            int n_video_bytes = 0;
+            int64_t pts = 0;
+            if (num_segments > 1) {
+                while (demuxer.Demux(&p_video, &n_video_bytes, &pts) && n_video_bytes) {
+                    if (demuxer.IsKeyFrame()) {
+                        key_frames.push_back({pts, num_packets});
+                    }
+                    num_packets++;
+                }
+            }
+
+            // pick the key frame closest to each evenly spaced packet position
+            std::vector<KeyFrame> boundaries;
+            for (int i = 1; i < num_segments && key_frames.size() > 1; i++) {
+                uint32_t target = static_cast<uint32_t>(static_cast<uint64_t>(num_packets) * i / num_segments);
+                const KeyFrame *best = &key_frames[1];
+                for (size_t k = 1; k < key_frames.size(); k++) {
+                    if (std::abs(static_cast<int64_t>(key_frames[k].packet_idx) - target) < std::abs(static_cast<int64_t>(best->packet_idx) - target)) {
+                        best = &key_frames[k];
+                    }
+                }
+                if (boundaries.empty() || boundaries.back().packet_idx < best->packet_idx) {
+                    boundaries.push_back(*best);
+                }
+            }
+
+            int64_t start_pts = INT64_MIN;
+            uint32_t start_packet = 0;
+            for (size_t i = 0; i <= boundaries.size(); i++) {
+                std::unique_ptr<Segment> seg(new Segment);
+                seg->info = {};
+                seg->info.segment_id = static_cast<int>(i);
+                seg->info.device_id = device_ids[i % device_ids.size()];
+                seg->info.start_pts = start_pts;
+                seg->info.end_pts = (i < boundaries.size()) ? boundaries[i].pts : INT64_MAX;
+                seg->info.start_frame_num = (i == 0) ? 0 : static_cast<uint64_t>(llround(start_pts * frame_rate_ / 1000));
+                uint32_t end_packet = (i < boundaries.size()) ? boundaries[i].packet_idx : num_packets;
+                seg->info.num_packets = end_packet - start_packet;
+                segments_.push_back(std::move(seg));
+                if (i < boundaries.size()) {
+                    start_pts = boundaries[i].pts;
+                    start_packet = boundaries[i].packet_idx;
+                }
+            }
+        }
+
+        /**
+         * @brief Segment thread: seeks to the start key frame and decodes until the key frame of the next segment.
+         *        Packets following the next key frame are decoded as well as long as they precede it in presentation order
+         *        (leading pictures of open GOPs); only frames within [start_pts, end_pts) are output.
+         */
+        void SegmentDecodeProc(Segment *seg) {
+            VideoSegmentInfo *info = &seg->info;
+            RocVideoDecoder *dec = seg->decoder.get();
+            VideoDemuxer *demuxer = seg->demuxer.get();
+            auto start_time = std::chrono::high_resolution_clock::now();
+            try {
+                HIP_API_CALL(hipSetDevice(info->device_id));
+                uint8_t *p_video = nullptr;
+                int n_video_bytes = 0, decoded_pics = 0;
+                int64_t pts = 0;
+                bool have_packet = false;
+                if (info->segment_id > 0) {
+                    VideoSeekContext seek_ctx(info->start_frame_num);
+                    try {
+                        have_packet = demuxer->Seek(seek_ctx, &p_video, &n_video_bytes);
+                        pts = seek_ctx.out_frame_pts_;
+                    } catch (const std::exception &ex) {
+                        have_packet = false;
+                    }
+                    if (have_packet && pts > info->start_pts) {
+                        // landed after the start key frame, decode from the beginning of the stream instead
+                        seg->demuxer.reset(new VideoDemuxer(input_file_path_.c_str()));
+                        demuxer = seg->demuxer.get();
+                        have_packet = false;
+                    }
+                }
+                if (!have_packet) {
+                    demuxer->Demux(&p_video, &n_video_bytes, &pts);
+                }
+
+                bool passed_end = false;
+                do {
+                    if (n_video_bytes && info->end_pts != INT64_MAX) {
+                        if (passed_end && pts > info->end_pts) {
+                            n_video_bytes = 0;      // flush
+                        } else if (demuxer->IsKeyFrame() && pts >= info->end_pts) {
+                            passed_end = true;
+                        }
+                    }
+                    int n_frame_returned = dec->DecodeFrame(n_video_bytes ? p_video : nullptr, n_video_bytes, 0, pts, &decoded_pics);
+                    info->num_pics_decoded += decoded_pics;
+                    if (n_frame_returned && !OutputFrames(seg, n_frame_returned)) {
+                        // no consumer abort path: the frame callback can't stop Decode(), so this is an output failure
+                        std::cerr << "ERROR: segment " << info->segment_id << " failed to output its frames" << std::endl;
+                        seg->error = true;
+                        break;
+                    }
+                    if (!n_video_bytes) {
+                        break;
+                    }
+                    demuxer->Demux(&p_video, &n_video_bytes, &pts);
+                } while (true);
+            } catch (const std::exception &ex) {
+                std::cerr << "ERROR: segment " << info->segment_id << " failed: " << ex.what() << std::endl;
+                seg->error = true;
+            }
+            auto end_time = std::chrono::high_resolution_clock::now();
+            info->decode_time_ms = std::chrono::duration<double, std::milli>(end_time - start_time).count();
+            {
+                std::lock_guard<std::mutex> lock(seg->mtx);
+                seg->done = true;
+            }
+            seg->cv.notify_all();
+        }
+
+        /**
+         * @brief Copies the frames within the segment range into the segment's frame pool and queues them in the reorder buffer
+         */
+        bool OutputFrames(Segment *seg, int n_frames) {
+            RocVideoDecoder *dec = seg->decoder.get();
+            VideoSegmentInfo *info = &seg->info;
+            if (out_mem_type_ == OUT_SURFACE_MEM_NOT_MAPPED) {
+                // no output available: frames can't be filtered by pts
+                info->num_frames_output += n_frames;
+                return true;
+            }
+            if (!seg->surf_info && !dec->GetOutputSurfaceInfo(&seg->surf_info)) {
+                std::cerr << "ERROR: Failed to get Output Surface Info!" << std::endl;
+                return false;
+            }
+            uint8_t *p_frame = nullptr;
+            int64_t pts = 0;
+            for (int i = 0; i < n_frames; i++) {
+                p_frame = dec->GetFrame(&pts);
+                if (p_frame && pts >= info->start_pts && pts < info->end_pts) {
+                    uint8_t *p_dst = AcquireFrameBuffer(seg);
+                    if (!p_dst) {
+                        return false;
+                    }
+                    HIP_API_CALL(hipMemcpyAsync(p_dst, p_frame, seg->surf_info->output_surface_size_in_bytes, hipMemcpyDefault, dec->GetStream()));
+                    HIP_API_CALL(hipStreamSynchronize(dec->GetStream()));
+                    {
+                        std::lock_guard<std::mutex> lock(seg->mtx);
+                        seg->ready_frames.push_back({p_dst, pts});
+                    }
+                    seg->cv.notify_all();
+                    info->num_frames_output++;
+                }
+                dec->ReleaseFrame(pts);
+            }
+            return true;
+        }
+
+        /**
+         * @brief Returns a free buffer of the segment's frame pool; blocks while max_frames_in_flight frames are waiting in the reorder buffer
+         */
+        uint8_t *AcquireFrameBuffer(Segment *seg) {
+            uint64_t frame_size = seg->surf_info->output_surface_size_in_bytes;
+            std::unique_lock<std::mutex> lock(seg->mtx);
+            if (frame_size > seg->frame_buffer_size) {
+                // output resolution changed: wait until all the frames are returned before growing the pool
+                seg->cv.wait(lock, [&] { return seg->free_frames.size() == seg->frame_pool.size(); });
+                lock.unlock();
+                ReleaseFramePool(seg);
+                lock.lock();
+                seg->frame_buffer_size = frame_size;
+            }
+            if (seg->free_frames.empty() && seg->frame_pool.size() < max_frames_in_flight_) {
+                uint8_t *p_buf = nullptr;
+                hipError_t hip_status = (out_mem_type_ == OUT_SURFACE_MEM_HOST_COPIED) ? hipHostMalloc((void **)&p_buf, seg->frame_buffer_size) :
+                                                                                          hipMalloc((void **)&p_buf, seg->frame_buffer_size);
+                if (hip_status != hipSuccess) {
+                    std::cerr << "ERROR: failed to allocate frame buffer (" << hip_status << ")" << std::endl;
+                    return nullptr;
+                }
+                seg->frame_pool.push_back(p_buf);
+                return p_buf;
+            }
+            seg->cv.wait(lock, [&] { return !seg->free_frames.empty(); });
+            uint8_t *p_buf = seg->free_frames.back();
+            seg->free_frames.pop_back();
+            return p_buf;
+        }
+
+        void ReleaseFramePool(Segment *seg) {
+            for (auto p_buf : seg->frame_pool) {
+                if (out_mem_type_ == OUT_SURFACE_MEM_HOST_COPIED) {
+                    hipHostFree(p_buf);
+                } else {
+                    hipFree(p_buf);
+                }
+            }
+            std::lock_guard<std::mutex> lock(seg->mtx);
+            seg->frame_pool.clear();
+            seg->free_frames.clear();
+            seg->frame_buffer_size = 0;
+        }
+
+        std::string input_file_path_;
+        OutputSurfaceMemoryType out_mem_type_;
+        uint32_t max_frames_in_flight_;
+        rocDecVideoCodec codec_id_ = rocDecVideoCodec_NumCodecs;
+        uint32_t bit_depth_ = 8;
+        double frame_rate_ = 0.0;
+        double scan_time_ms_ = 0.0;
+        std::vector<std::unique_ptr<Segment>> segments_;
+};